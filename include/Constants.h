@@ -4,4 +4,6 @@
 
 namespace Game3 {
 	constexpr int64_t CHUNK_SIZE = 64;
+	/** The width of a chunk plus a one-tile border on each side, as used by whole-chunk neighborhood kernels. */
+	constexpr int64_t PADDED_CHUNK_SIZE = CHUNK_SIZE + 2;
 }
@@ -1,10 +1,13 @@
 #pragma once
 
+#include "Constants.h"
 #include "types/Position.h"
 #include "types/Types.h"
 
 #include <array>
+#include <cstdint>
 #include <functional>
+#include <span>
 #include <unordered_map>
 
 namespace Game3 {
@@ -31,4 +34,10 @@ namespace Game3 {
 
 	TileID march8(const std::function<bool(int8_t, int8_t)> &);
 	TileID march4(const std::function<bool(int8_t, int8_t)> &);
+
+	/** Computes march8 for every tile of a chunk at once. `padded` is a PADDED_CHUNK_SIZE² row-major array that's nonzero
+	 *  wherever a tile (in the chunk or in the one-tile border around it) counts as a neighbor. Writes CHUNK_SIZE² results. */
+	void march8Chunk(std::span<const uint8_t> padded, std::span<uint8_t> out);
+	/** Like march8Chunk, but for march4. */
+	void march4Chunk(std::span<const uint8_t> padded, std::span<uint8_t> out);
 }
@@ -21,6 +21,8 @@ namespace Game3 {
 		double mystery = 1;
 		float uiScale = 1;
 		int logLevel = 1;
+		/** How much terrain the client keeps for chunks outside the player's view, in megabytes. */
+		size_t chunkCacheMegabytes = 64;
 		uint16_t port = 12255;
 		/** If a drag action's final displacement is less than this, it will count as a click. */
 		uint16_t dragThreshold = 2;
@@ -8,6 +8,7 @@
 
 #include <array>
 #include <span>
+#include <string>
 #include <vector>
 
 namespace Game3 {
@@ -28,13 +29,19 @@ namespace Game3 {
 			ChunkSet(std::span<const char>);
 			ChunkSet(std::span<const char> terrain_, std::span<const char> biomes_, std::span<const char> fluids_, std::span<const char> pathmap_);
 
+			/** These encode each part the same way as the TileProvider methods of the same names. */
+			std::string getRawTerrain() const;
+			std::string getRawBiomes() const;
+			std::string getRawFluids() const;
+			std::string getRawPathmap() const;
+
 			template <typename C>
 			C getBytes() const {
 				// Format:
 				//   - Terrain: [ChunkSize^2 x sizeof(TileID) bytes] x LayerCount
 				//   - Biomes:   ChunkSize^2 x sizeof(BiomeType)
 				//   - Fluids:   ChunkSize^2 x sizeof(FluidInt)
-				//   - Pathmap:  ChunkSize^2 x sizeof(uint8_t)
+				//   - Pathmap:  ChunkSize^2 x sizeof(uint8_t) (unpacked from the in-memory bitmap)
 				// Or, as of this writing:
 				//   - Terrain: [4096 x 2 bytes] x 4 = 32768 bytes
 				//   - Biomes:   4096 x 2 bytes      =  8192 bytes
@@ -62,7 +69,8 @@ namespace Game3 {
 
 				{
 					auto lock = pathmap.sharedLock();
-					appendSpan(raw, std::span(pathmap));
+					const std::vector<uint8_t> unpacked = unpackPathChunk(pathmap);
+					appendSpan(raw, std::span(unpacked));
 				}
 
 				return raw;
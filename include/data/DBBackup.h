@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <stop_token>
+#include <string>
+#include <unordered_map>
+
+#include <leveldb/db.h>
+
+namespace Game3 {
+	/** Copies a LevelDB database to a compressed archive from a point-in-time snapshot, so the game can keep writing
+	 *  while it runs, and restores such archives into a new database.
+	 *
+	 *  An archive is a header, a run of independently zstd-compressed blocks of records, an empty block, a compressed
+	 *  manifest and a trailer pointing at the manifest. The manifest lists a hash of every key's value as of the backup.
+	 *  An incremental backup reads only its base's manifest and stores just the keys whose values changed since, plus
+	 *  erasures for keys that are gone. Restoring applies a full archive followed by its increments in order. */
+	class DBBackup {
+		public:
+			/** Maps each key to a hash of its value. */
+			using Manifest = std::unordered_map<std::string, uint64_t>;
+
+			struct Stats {
+				size_t written = 0;
+				size_t erased = 0;
+				size_t unchanged = 0;
+				uint64_t rawBytes = 0;
+				uint64_t compressedBytes = 0;
+			};
+
+			/** How many bytes of records go into each block before it's compressed. Blocks are also the unit of
+			 *  parallel decoding during a restore. */
+			constexpr static size_t BLOCK_SIZE = 4 << 20;
+			constexpr static uint32_t FORMAT_VERSION = 1;
+
+			/** Writes the database as of the given snapshot to an archive. The archive appears at the given path only
+			 *  once it's complete. Every key and value read counts against a limit of roughly the given number of bytes
+			 *  per second (0 means no limit), including the unchanged ones an incremental backup doesn't write. Reads
+			 *  skip LevelDB's block cache so that the game's own reads stay fast. Throws on failure or if a stop is
+			 *  requested. */
+			static Stats backup(leveldb::DB &, const leveldb::Snapshot *, const std::filesystem::path &archive, const std::optional<std::filesystem::path> &base, uint64_t bytes_per_second, std::stop_token = {});
+
+			/** Applies archives in order to a database that must not exist yet. Each archive's blocks are read on the
+			 *  calling thread and handed through a bounded queue to workers that decode and write them in parallel, so
+			 *  memory use depends on the thread count rather than the archive size. */
+			static Stats restore(const std::filesystem::path &database, std::span<const std::filesystem::path> archives);
+
+			static Manifest readManifest(const std::filesystem::path &archive);
+	};
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+
+#include <leveldb/db.h>
+
+namespace Game3 {
+	/** Commits database writes on a thread of its own. Writes queued while a commit is in progress are grouped into the
+	 *  next WriteBatch, and repeated writes to the same key only keep the latest value. */
+	class DBWriter {
+		public:
+			explicit DBWriter(leveldb::DB &);
+			/** Commits everything still queued before returning. */
+			~DBWriter();
+
+			DBWriter(const DBWriter &) = delete;
+			DBWriter & operator=(const DBWriter &) = delete;
+
+			void put(std::string key, std::string value);
+			void erase(std::string key);
+
+			/** Blocks until everything queued before the call has been committed. Throws a DBError if a commit failed
+			 *  since the last flush. */
+			void flush();
+
+			/** Returns the queued value for a key if it hasn't been committed yet. A queued deletion is returned as an
+			 *  engaged optional holding std::nullopt. */
+			std::optional<std::optional<std::string>> peek(const std::string &key) const;
+
+		private:
+			using Writes = std::map<std::string, std::optional<std::string>>;
+
+			leveldb::DB &database;
+			mutable std::mutex mutex;
+			std::condition_variable_any wakeup;
+			std::condition_variable committed;
+			Writes pending;
+			/** The batch the writer thread is committing. Only modified with the mutex held. */
+			Writes committing;
+			uint64_t queuedCount = 0;
+			uint64_t committedCount = 0;
+			std::optional<leveldb::Status> failure;
+			std::jthread thread;
+
+			void enqueue(std::string key, std::optional<std::string> value);
+			void run(std::stop_token);
+	};
+}
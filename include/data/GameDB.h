@@ -1,6 +1,7 @@
 #pragma once
 
 #include "data/ChunkSet.h"
+#include "data/DBWriter.h"
 #include "game/Chunk.h"
 #include "math/Concepts.h"
 #include "threading/Lockable.h"
@@ -8,12 +9,15 @@
 #include "types/Types.h"
 #include "util/Math.h"
 
+#include <atomic>
 #include <filesystem>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <span>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include <leveldb/db.h>
@@ -58,6 +62,15 @@ namespace Game3 {
 		GameDBScope(GameDB &);
 	};
 
+	/** Chunk data copied out of a realm so that it can be encoded and written after the game starts ticking again. */
+	struct RealmSnapshot {
+		std::shared_ptr<Realm> realm;
+		/** The realm's page-out epoch before the chunks were copied. A chunk paged out after that has already had
+		 *  newer data written by the page-out, so its copy here is skipped. */
+		uint64_t pageOutEpoch = 0;
+		std::vector<std::pair<ChunkPosition, ChunkSet>> chunks;
+	};
+
 	template <typename T>
 	struct RawSlice {
 		T data;
@@ -102,12 +115,27 @@ namespace Game3 {
 			std::weak_ptr<ServerGame> weakGame;
 			std::filesystem::path path;
 			Lockable<std::unordered_set<std::string>> displayNames;
+			/** Every write and erase goes through here so that game threads never wait on LevelDB to write. */
+			std::unique_ptr<DBWriter> writer;
+			/** Held for the whole of writeAll and writeRealm. Overlapping saves would let one end the other's tick pause
+			 *  early, and an older save's chunks could be queued after a newer one's. */
+			std::mutex saveMutex;
+			std::jthread backupThread;
+			std::atomic_bool backingUp = false;
 
 			std::unique_ptr<leveldb::Iterator> getIterator();
 			std::unique_ptr<leveldb::Iterator> getStartIterator();
 			bool hasKey(std::string_view);
+			/** Returns the chunks players will appear in when they next log in: the overworld's spawn, each player's saved
+			 *  position and any release places. */
+			std::vector<std::pair<RealmID, ChunkPosition>> getLoginChunks();
+			/** Decodes stored chunks and absorbs them into their realms on the game's thread pool. */
+			void absorbChunks(std::vector<std::string> raw_chunks);
 
 		public:
+			/** How many stored chunks are held in memory at once while waiting to be decoded during a bulk load. */
+			constexpr static size_t CHUNK_LOAD_BATCH = 256;
+
 			Lockable<std::unique_ptr<leveldb::DB>, std::recursive_mutex> database;
 
 			GameDB(const std::shared_ptr<ServerGame> &);
@@ -119,6 +147,14 @@ namespace Game3 {
 
 			void open(std::filesystem::path);
 			void close();
+			/** Blocks until every write made so far is in the database. */
+			void flush();
+
+			/** Saves everything and then, on a thread of its own, copies the database as it was at that moment to an
+			 *  archive, reading at most about the given number of bytes per second. With a base archive, only what changed
+			 *  since the base is stored. Returns false without doing anything if a backup is already running. */
+			bool startBackup(std::filesystem::path archive, std::optional<std::filesystem::path> base, uint64_t bytes_per_second);
+			inline bool isBackingUp() const { return backingUp; }
 
 			template <typename T = std::string>
 			std::optional<T> tryRead(const leveldb::Slice &key);
@@ -180,6 +216,8 @@ namespace Game3 {
 			 *  >  0: this save is too new    */
 			int64_t getCompatibility();
 
+			/** Pauses ticking only while chunks are copied and small state is written, then writes the copies, entities,
+			 *  tile entities and villages while the game runs. */
 			void writeAll();
 			void readAll();
 
@@ -192,14 +230,28 @@ namespace Game3 {
 			void writeAllRealms();
 
 			void writeRealm(const std::shared_ptr<Realm> &);
+
+			/** Writes a realm's metadata and copies its resident chunks into the returned snapshot. Only this part needs
+			 *  ticking paused. Copying is proportional to the number of resident chunks, so the pause still grows with
+			 *  the loaded part of the world. */
+			RealmSnapshot snapshotRealm(const std::shared_ptr<Realm> &);
+			/** Writes a snapshot's chunks along with the realm's current entities and tile entities. Ticking doesn't
+			 *  need to be paused. */
+			void writeSnapshot(const RealmSnapshot &);
+
 			void deleteRealm(std::shared_ptr<Realm>);
 
 			void readVillages();
 			void writeVillages();
 
 			void writeChunk(const std::shared_ptr<Realm> &, ChunkPosition);
+			void writeChunk(RealmID, ChunkPosition, const ChunkSet &);
 
-			void readAllRealms();
+			/** Loads every realm along with its entities and tile entities. If lazy is true, the only chunks read are the
+			 *  ones near where players will log in, the ones holding or next to entities or tile entities and those of
+			 *  realms whose tiles need migrating. The rest are marked as paged out and read the first time something needs
+			 *  them. */
+			void readAllRealms(bool lazy = false);
 
 			/** Reads metadata from the database and returns an empty realm based on the metadata. */
 			std::shared_ptr<Realm> loadRealm(RealmID);
@@ -267,6 +319,7 @@ namespace Game3 {
 
 			template <Returns<void, std::string_view, std::string_view> Fn>
 			void iterate(std::string_view prefix, Fn &&function) {
+				flush();
 				auto it = getIterator();
 				leveldb::Slice slice{prefix.data(), prefix.size()};
 				for (it->Seek(slice); it->Valid(); it->Next()) {
@@ -284,6 +337,7 @@ namespace Game3 {
 			template <Returns<bool, std::string_view, std::string_view> Fn>
 			bool iterate(std::string_view prefix, Fn &&function) {
 				bool canceled = false;
+				flush();
 				auto it = getIterator();
 				leveldb::Slice slice{prefix.data(), prefix.size()};
 				for (it->Seek(slice); it->Valid(); it->Next()) {
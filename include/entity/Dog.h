@@ -39,7 +39,9 @@ namespace Game3 {
 			void iterateGenes(const std::function<void(Gene &)> &) override;
 			void iterateGenes(const std::function<void(const Gene &)> &) const override;
 
+#ifndef GAME3_HEADLESS
 			void render(const RendererContext &) override;
+#endif
 			void encode(Buffer &) override;
 			void decode(BasicBuffer &) override;
 
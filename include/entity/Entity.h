@@ -96,8 +96,14 @@ namespace Game3 {
 			/** Whether the entity is currently teleporting to its first position on realm change. */
 			Atomic<bool> firstTeleport = false;
 			Atomic<RealmID> inLimboFor{0};
+			/** Whether the entity is in its realm's KinematicsStore. */
+			Atomic<bool> kinematicsTracked = false;
 			Identifier customTexture;
 			Lockable<std::optional<Position>> pathfindGoal;
+			/** Where clients last heard this entity is (or will be once it finishes replaying its path). Server-side only. */
+			Lockable<Position> replicatedPosition;
+			/** The sub-tile offset that goes with replicatedPosition. Server-side only. */
+			Lockable<Vector3> replicatedOffset;
 			Atomic<float> age;
 			Atomic<float> baseSpeed{MAX_SPEED};
 			Atomic<float> speedMultiplier{1.0};
@@ -122,10 +128,12 @@ namespace Game3 {
 			virtual void absorbJSON(const std::shared_ptr<Game> &, const boost::json::value &);
 			virtual void toJSON(boost::json::value &) const;
 			virtual void init(const std::shared_ptr<Game> &);
+#ifndef GAME3_HEADLESS
 			virtual void render(const RendererContext &);
 			virtual void renderUpper(const RendererContext &);
 			virtual void renderLighting(const RendererContext &);
 			virtual void renderShadow(const RendererContext &);
+#endif
 			virtual void tick(const TickArgs &);
 			/** Whether the entity should be included in save data. */
 			virtual bool shouldPersist() const { return true; }
@@ -165,7 +173,9 @@ namespace Game3 {
 			inline Direction getDirection() const { return direction.load(); }
 			Entity & setRealm(const Game &, RealmID);
 			Entity & setRealm(const std::shared_ptr<Realm>);
+#ifndef GAME3_HEADLESS
 			void focus(Window &, bool is_autofocus);
+#endif
 			/** Returns whether the entity moved to a new chunk. */
 			bool teleport(const Position &, MovementContext = {});
 			virtual void teleport(const Position &, const std::shared_ptr<Realm> &, MovementContext);
@@ -206,7 +216,13 @@ namespace Game3 {
 			Lockable<WeakSet<Entity>> & getVisibleEntities(std::unique_lock<DefaultMutex> &outer_lock, bool recalculate = false);
 			std::pair<std::unique_lock<DefaultMutex>, std::unique_lock<DefaultMutex>> getVisibleEntitiesLocks();
 			virtual bool shouldBroadcastDestruction() const;
+			/** Hands the entity to its realm's KinematicsStore if it's moving. The motion itself is integrated in Realm::tick. */
 			virtual void applyMotion(float delta);
+			/** Called by the KinematicsStore when the entity leaves or lands on the ground. */
+			void groundedChanged(bool grounded);
+			/** Returns whether clients' idea of this entity's position is more than the given number of tiles away from the real one.
+			 *  Sub-tile offsets count unless compare_offsets is false, in which case only whole tiles are compared. */
+			bool needsMovementCorrection(double threshold, bool compare_offsets = true) const;
 			/** For players, this will return a valid direction if the player is moving diagonally. In any other case, it returns Direction::Invalid. */
 			virtual Direction getSecondaryDirection() const;
 
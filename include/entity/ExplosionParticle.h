@@ -14,8 +14,10 @@ namespace Game3 {
 			std::string getName() const override { return "Explosion"; }
 
 			void tick(const TickArgs &) override;
+#ifndef GAME3_HEADLESS
 			void render(const RendererContext &) override;
 			void renderShadow(const RendererContext &) override;
+#endif
 			bool isVisible() const override;
 			bool visibilityMatters() const override;
 			void encode(Buffer &) override;
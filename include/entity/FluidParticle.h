@@ -16,7 +16,9 @@ namespace Game3 {
 				return Entity::create<FluidParticle>(std::forward<Args>(args)...);
 			}
 
+#ifndef GAME3_HEADLESS
 			void render(const RendererContext &) final;
+#endif
 			bool shouldPersist() const final { return false; }
 			std::string getName() const final { return "Fluid Particle"; }
 
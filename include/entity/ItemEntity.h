@@ -23,7 +23,9 @@ namespace Game3 {
 			void toJSON(boost::json::value &) const override;
 			void init(const GamePtr &) override;
 			void tick(const TickArgs &) override;
+#ifndef GAME3_HEADLESS
 			void render(const RendererContext &) override;
+#endif
 			bool onInteractOn    (const PlayerPtr &player, Modifiers, const ItemStackPtr &, Hand) override { return interact(player); }
 			bool onInteractNextTo(const PlayerPtr &player, Modifiers, const ItemStackPtr &, Hand) override { return interact(player); }
 			bool interactable(const PlayerPtr &, Modifiers, const ItemStackPtr &, Hand) override { return true; }
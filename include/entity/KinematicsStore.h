@@ -0,0 +1,63 @@
+#pragma once
+
+#include "threading/MTQueue.h"
+#include "types/Position.h"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace Game3 {
+	class Entity;
+	class Realm;
+
+	/** Keeps the offsets and velocities of a realm's moving entities in parallel arrays so that motion can be integrated
+	 *  in a single pass per tick. Entities join when they start moving and leave once they come to rest, so idle item
+	 *  entities and animals don't cost anything here. */
+	class KinematicsStore {
+		public:
+			struct Arrays {
+				std::vector<double> offsetX;
+				std::vector<double> offsetY;
+				std::vector<double> offsetZ;
+				std::vector<double> velocityX;
+				std::vector<double> velocityY;
+				std::vector<double> velocityZ;
+				std::vector<float> speed;
+				/** Whole tiles crossed during the last integration, to be carried into the entity's position. */
+				std::vector<Position::IntType> stepRow;
+				std::vector<Position::IntType> stepColumn;
+				std::vector<uint8_t> groundedBefore;
+				std::vector<uint8_t> groundedAfter;
+
+				inline size_t size() const { return offsetX.size(); }
+				void resize(size_t);
+			};
+
+			KinematicsStore() = default;
+
+			/** Queues an entity for integration starting with the next step. Safe to call from any thread. */
+			void track(const std::shared_ptr<Entity> &);
+
+			/** Copies every tracked entity's motion state into the arrays, integrates it, writes it back and then lets the
+			 *  entities react to leaving or touching the ground. Must only be called from the realm's tick. */
+			void step(Realm &, float delta);
+
+			inline size_t size() const { return members.size(); }
+
+			/** Integrates every body in the arrays by the given time. Contains no calls and no data-dependent control flow. */
+			static void integrate(Arrays &, float delta);
+
+		private:
+			MTQueue<std::weak_ptr<Entity>> pending;
+			std::vector<std::weak_ptr<Entity>> members;
+			/** The strong references taken while gathering, kept parallel to the arrays for the rest of the step. */
+			std::vector<std::shared_ptr<Entity>> gathered;
+			Arrays arrays;
+			/** The state that was gathered, used to detect entities that were moved by something else mid-step. */
+			Arrays snapshot;
+
+			void gather(Realm &);
+			void scatter();
+	};
+}
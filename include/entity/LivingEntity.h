@@ -24,7 +24,9 @@ namespace Game3 {
 			void toJSON(boost::json::value &) const override;
 			void absorbJSON(const std::shared_ptr<Game> &, const boost::json::value &) override;
 			bool interactable(const std::shared_ptr<Player> &, Modifiers, const ItemStackPtr &used_item, Hand) override;
+#ifndef GAME3_HEADLESS
 			void renderUpper(const RendererContext &) override;
+#endif
 			void encode(Buffer &) override;
 			void decode(BasicBuffer &) override;
 			bool isAffectedByKnockback() const override;
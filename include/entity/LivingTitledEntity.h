@@ -6,7 +6,9 @@
 namespace Game3 {
 	class LivingTitledEntity: public LivingEntity, public TitledEntity {
 		public:
+#ifndef GAME3_HEADLESS
 			void renderUpper(const RendererContext &) override;
+#endif
 
 			float getTitleVerticalOffset() const override;
 	};
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "graphics/Color.h"
+#include "math/Vector.h"
+#include "threading/Lockable.h"
+#include "threading/MTQueue.h"
+#include "types/Position.h"
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace Game3 {
+	class RectangleRenderer;
+
+	/** Simulates a realm's cosmetic squares (blood, splashes, explosion debris) as plain records in parallel arrays instead
+	 *  of as entities. Particles exist only on the client; servers describe bursts with SquareParticlesPacket. */
+	class ParticleSystem {
+		public:
+			/** Everything needed to start a square. Positions are measured in tiles. */
+			struct Square {
+				double x = 0;
+				double y = 0;
+				float z = 0;
+				float velocityX = 0;
+				float velocityY = 0;
+				float velocityZ = 0;
+				float size = 0.5;
+				Color color{1, 1, 1, 1};
+				/** The height at which the square comes to rest. Negative values let it fall a little below the ground. */
+				float depth = 0;
+				/** How long the square stays on the ground before it disappears. */
+				float lingerTime = 1;
+			};
+
+			struct Arrays {
+				std::vector<double> x;
+				std::vector<double> y;
+				std::vector<float> z;
+				std::vector<float> velocityX;
+				std::vector<float> velocityY;
+				std::vector<float> velocityZ;
+				std::vector<float> sideLength;
+				std::vector<Color> color;
+				std::vector<float> depth;
+				std::vector<float> age;
+				std::vector<float> lingerTime;
+
+				inline size_t size() const { return x.size(); }
+				void push(const Square &);
+				void resize(size_t);
+				/** Moves the last particle into the given slot and drops the last slot. */
+				void swapRemove(size_t);
+			};
+
+			constexpr static float GRAVITY = 32;
+
+			ParticleSystem() = default;
+
+			/** Queues a square to join the simulation at the next step. Safe to call from any thread. */
+			void spawn(const Square &);
+
+			/** Queues the burst that spawnSquares used to make out of entities: the first half of the colors fly off to the
+			 *  left and the rest fly off to the right, each with a random velocity and resting depth. */
+			void spawnBurst(const Position &, const Vector3 &offset, std::span<const Color> colors, float linger_time, float size);
+
+			/** Absorbs queued squares, integrates every particle and retires the ones that have lingered long enough. */
+			void step(float delta);
+
+			size_t size() const;
+
+			/** Integrates every particle in the arrays by the given time. Contains no calls and no data-dependent control flow. */
+			static void simulate(Arrays &, float delta);
+
+			/** Removes the particles that have outlived their linger time. Returns the number removed. */
+			static size_t retire(Arrays &);
+
+#ifndef GAME3_HEADLESS
+			/** Draws every particle with a single instanced draw call. */
+			void render(RectangleRenderer &) const;
+#endif
+
+		private:
+			MTQueue<Square> pending;
+			/** Stepped on the tick thread and read by the render thread. */
+			Lockable<Arrays> arrays;
+	};
+}
@@ -80,7 +80,9 @@ namespace Game3 {
 			void removeStationType(const Identifier &);
 			bool hasStationType(const Identifier &) const;
 			std::shared_ptr<Player> getShared();
+#ifndef GAME3_HEADLESS
 			std::shared_ptr<ClientPlayer> toClient();
+#endif
 			std::shared_ptr<ServerPlayer> toServer();
 			void addKnownRealm(RealmID);
 			bool knowsRealm(RealmID) const;
@@ -17,7 +17,9 @@ namespace Game3 {
 			}
 
 			void tick(const TickArgs &) override;
+#ifndef GAME3_HEADLESS
 			void render(const RendererContext &) override;
+#endif
 			void onSpawn() override;
 			std::string getName() const override { return "Projectile"; }
 			bool shouldBroadcastDestruction() const override;
@@ -52,7 +54,9 @@ namespace Game3 {
 			Projectile(EntityType type, Identifier item_id, const Vector3 &initial_velocity = {}, double angular_velocity = 0, const std::optional<Position> &intendedTarget = std::nullopt, double linger_time = DEFAULT_LINGER_TIME);
 
 			std::shared_ptr<Texture> getTexture() override;
+#ifndef GAME3_HEADLESS
 			void setTexture(const ClientGamePtr &);
+#endif
 			virtual void applyKnockback(const EntityPtr &, float factor);
 
 		friend class Entity;
@@ -29,7 +29,9 @@ namespace Game3 {
 
 			std::string getName() const override { return "Sheep"; }
 
+#ifndef GAME3_HEADLESS
 			void render(const RendererContext &) override;
+#endif
 			Identifier getMilk() const override { return {"base", "fluid/milk"}; }
 
 			bool canAbsorbGenes(const boost::json::value &) const override;
@@ -54,7 +56,9 @@ namespace Game3 {
 		private:
 			std::shared_ptr<Texture> mask;
 
+#ifndef GAME3_HEADLESS
 			void renderBody(const RendererContext &, const RenderOptions &);
+#endif
 			static float sample();
 	};
 }
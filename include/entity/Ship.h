@@ -24,7 +24,9 @@ namespace Game3 {
 			bool onInteractOn(const std::shared_ptr<Player> &, Modifiers, const ItemStackPtr &, Hand) override;
 			bool onInteractNextTo(const std::shared_ptr<Player> &, Modifiers, const ItemStackPtr &, Hand) override;
 			bool interactable(const std::shared_ptr<Player> &, Modifiers, const ItemStackPtr &used_item, Hand) override;
+#ifndef GAME3_HEADLESS
 			void render(const RendererContext &) override;
+#endif
 			void encode(Buffer &) override;
 			void decode(BasicBuffer &) override;
 
@@ -19,8 +19,10 @@ namespace Game3 {
 
 			bool onInteractOn(const std::shared_ptr<Player> &, Modifiers, const ItemStackPtr &used_item, Hand) override;
 			bool onInteractNextTo(const std::shared_ptr<Player> &, Modifiers, const ItemStackPtr &used_item, Hand) override;
+#ifndef GAME3_HEADLESS
 			void renderShadow(const RendererContext &) override;
 			void render(const RendererContext &) override;
+#endif
 			void tick(const TickArgs &) override;
 			bool shouldPersist() const override { return false; }
 			void onSpawn() override;
@@ -1,7 +1,8 @@
 #pragma once
 
 #include "entity/Entity.h"
-#include "graphics/TextRenderer.h"
+#include "graphics/Color.h"
+#include "graphics/TextAlign.h"
 #include "types/UString.h"
 
 namespace Game3 {
@@ -18,8 +19,10 @@ namespace Game3 {
 				return Entity::create<TextParticle>(std::forward<Args>(args)...);
 			}
 
+#ifndef GAME3_HEADLESS
 			void renderShadow(const RendererContext &) override;
 			void render(const RendererContext &) override;
+#endif
 			void tick(const TickArgs &) override;
 			bool shouldPersist() const override { return false; }
 			void onSpawn() override;
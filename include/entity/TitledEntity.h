@@ -14,10 +14,14 @@ namespace Game3 {
 			Lockable<UString> lastMessage;
 			Atomic<Tick> lastMessageAge = std::numeric_limits<Tick>::max();
 
+#ifndef GAME3_HEADLESS
 			void renderUpper(const RendererContext &) override;
+#endif
 
 			virtual float getTitleVerticalOffset() const;
+#ifndef GAME3_HEADLESS
 			virtual Tick getMaxMessageAge(ClientGame &) const;
+#endif
 			virtual UString getDisplayName() = 0;
 	};
 }
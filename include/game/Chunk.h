@@ -1,8 +1,11 @@
 #pragma once
 
+#include "Constants.h"
 #include "types/Types.h"
 #include "threading/Lockable.h"
 
+#include <bit>
+#include <span>
 #include <vector>
 
 namespace Game3 {
@@ -14,5 +17,51 @@ namespace Game3 {
 
 	using TileChunk  = Chunk<TileID>;
 	using BiomeChunk = Chunk<BiomeType>;
-	using PathChunk  = Chunk<uint8_t>;
+	/** A walkability bitmap with one 64-bit word per row. Bit n of a row is set if the tile in column n is walkable. */
+	using PathChunk  = Chunk<uint64_t>;
+
+	static_assert(CHUNK_SIZE == 64, "PathChunk rows must fit in exactly one word");
+
+	/** You need to lock the chunk yourself when using this function. */
+	inline bool getPathBit(const PathChunk &chunk, int64_t row, int64_t column) {
+		return (chunk[row] >> column) & 1;
+	}
+
+	/** You need to lock the chunk yourself when using this function. Returns whether the bit changed. */
+	inline bool setPathBit(PathChunk &chunk, int64_t row, int64_t column, bool walkable) {
+		const uint64_t old_word = chunk[row];
+		const uint64_t mask = uint64_t(1) << column;
+		chunk[row] = walkable? (old_word | mask) : (old_word & ~mask);
+		return chunk[row] != old_word;
+	}
+
+	/** Counts the walkable tiles in a path chunk. Doesn't lock the chunk. */
+	inline size_t countPathBits(const PathChunk &chunk) {
+		size_t out = 0;
+		for (const uint64_t word: chunk)
+			out += std::popcount(word);
+		return out;
+	}
+
+	/** Converts a path chunk to the legacy one-byte-per-tile format used on disk. Doesn't lock the chunk. */
+	inline std::vector<uint8_t> unpackPathChunk(const PathChunk &chunk) {
+		std::vector<uint8_t> out(CHUNK_SIZE * CHUNK_SIZE);
+		for (int64_t row = 0; row < CHUNK_SIZE; ++row)
+			for (int64_t column = 0; column < CHUNK_SIZE; ++column)
+				out[row * CHUNK_SIZE + column] = getPathBit(chunk, row, column);
+		return out;
+	}
+
+	/** Converts one-byte-per-tile path data into a path chunk. */
+	template <typename T>
+	PathChunk packPathChunk(std::span<const T> bytes) {
+		static_assert(sizeof(T) == 1);
+		PathChunk out;
+		out.resize(CHUNK_SIZE, 0);
+		for (int64_t row = 0; row < CHUNK_SIZE; ++row)
+			for (int64_t column = 0; column < CHUNK_SIZE; ++column)
+				if (bytes[row * CHUNK_SIZE + column] != 0)
+					out[row] |= uint64_t(1) << column;
+		return out;
+	}
 }
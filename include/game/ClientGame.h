@@ -164,6 +164,9 @@ namespace Game3 {
 			Lockable<std::unordered_map<RealmID, std::unordered_map<EntityPtr, Position>>> entityLimbo;
 
 			void garbageCollect();
+			/** Drops every chunk of realms the player isn't in, then drops the least recently viewed chunks
+			 *  outside the player's view until the rest fit in the chunk cache budget. */
+			void evictChunks();
 	};
 
 	using ClientGamePtr = std::shared_ptr<ClientGame>;
@@ -2,7 +2,6 @@
 
 #include "recipe/CraftingRecipe.h"
 
-#include <map>
 #include <vector>
 
 namespace Game3 {
@@ -24,8 +23,5 @@ namespace Game3 {
 
 		private:
 			Player &player;
-			std::optional<std::multimap<Identifier, CraftingRecipePtr>> craftingRecipeIndex;
-
-			std::multimap<Identifier, CraftingRecipePtr> generateCraftingRecipeIndex() const;
 	};
 }
@@ -21,6 +21,9 @@ namespace Game3 {
 
 			bool canInsert(const ItemStackPtr &, const SlotPredicate &) const override;
 			bool canInsert(const ItemStackPtr &, Slot) const override;
+
+			/** Stacks here have no size limit, so this has to fall back to trying the exchange on a copy. */
+			bool canExchange(const std::vector<CraftingRequirement> &to_remove, const std::vector<ItemStackPtr> &to_add) const override;
 	};
 
 	template <typename T>
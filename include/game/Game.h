@@ -51,6 +51,8 @@ namespace Game3 {
 			size_t randomTicksPerChunk = 2;
 			bool dying = false;
 			std::atomic_bool tickingPaused = false;
+			/** Number of periodic tile entity ticks avoided by sleeping tile entities. */
+			Atomic<uint64_t> skippedTileEntityTicks = 0;
 
 			std::map<RealmType, std::shared_ptr<InteractionSet>> interactionSets;
 			std::map<Identifier, std::unordered_set<std::shared_ptr<Item>>> itemsByAttribute;
@@ -93,9 +95,11 @@ namespace Game3 {
 			void add(EntityFactory &&);
 			void add(TileEntityFactory &&);
 			void add(RealmFactory &&);
+#ifndef GAME3_HEADLESS
 			void add(LocalCommandFactory &&);
 			void add(ModuleFactory &&);
 			void add(MinigameFactory &&);
+#endif
 			void add(StatusEffectFactory &&);
 			void traverseData(const std::filesystem::path &);
 			void loadData(const boost::json::value &);
@@ -131,9 +135,11 @@ namespace Game3 {
 			static std::shared_ptr<Game> create(Side, const GameArgument &);
 			static std::shared_ptr<Game> fromJSON(Side, const boost::json::value &, const GameArgument &);
 
+#ifndef GAME3_HEADLESS
 			ClientGame & toClient();
 			const ClientGame & toClient() const;
 			std::shared_ptr<ClientGame> toClientPointer();
+#endif
 
 			ServerGame & toServer();
 			const ServerGame & toServer() const;
@@ -173,6 +173,14 @@ namespace Game3 {
 			 *  Doesn't take the output of the recipe into account. */
 			virtual ItemCount craftable(const CraftingRecipe &) const;
 
+			/** Returns whether all the given stacks could be added to the inventory after removing all the given requirements.
+			 *  Simulates the removal and insertion with slot counts alone, so nothing is copied and the inventory isn't modified.
+			 *  Assumes the requirements are present; check with count/contains first. */
+			virtual bool canExchange(const std::vector<CraftingRequirement> &to_remove, const std::vector<ItemStackPtr> &to_add) const;
+
+			/** Returns a counter that changes whenever the contents of the inventory change. */
+			virtual uint64_t getRevision() const = 0;
+
 			virtual Slot slotsOccupied() const = 0;
 
 			virtual void replace(const Inventory &) = 0;
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "types/Types.h"
+
+#include <map>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace Game3 {
+	class ItemStack;
+	using ItemStackPtr = std::shared_ptr<ItemStack>;
+
+	/** Keeps running totals of an inventory's contents by item, by item data and by attribute.
+	 *  A summary is built in a single pass over the storage and answers count queries in O(1) or O(distinct items). */
+	class InventorySummary {
+		public:
+			InventorySummary() = default;
+
+			void rebuild(const std::map<Slot, ItemStackPtr> &);
+			void clear();
+
+			ItemCount count(const ItemID &) const;
+			/** Ignores the given ItemStack's count. */
+			ItemCount count(const ItemStack &) const;
+			ItemCount countAttribute(const Identifier &) const;
+
+			/** Returns the lowest slot containing the given item. */
+			std::optional<Slot> find(const ItemID &) const;
+			/** Returns the lowest slot containing an item with the given attribute. */
+			std::optional<Slot> findAttribute(const Identifier &) const;
+
+			inline size_t distinctItems() const { return items.size(); }
+
+		private:
+			/** Stacks of the same item with mergeable data. */
+			struct Variant {
+				ItemStackPtr sample;
+				size_t dataHash{};
+				ItemCount count{};
+			};
+
+			struct ItemEntry {
+				ItemCount total{};
+				Slot firstSlot = -1;
+				std::vector<Variant> variants;
+			};
+
+			struct AttributeEntry {
+				ItemCount total{};
+				Slot firstSlot = -1;
+			};
+
+			std::unordered_map<ItemID, ItemEntry> items;
+			std::unordered_map<Identifier, AttributeEntry> attributes;
+	};
+}
@@ -58,6 +58,7 @@ namespace Game3 {
 			void notifyOwner(std::optional<std::variant<ItemStackPtr, Slot>>) override;
 			bool empty() const override;
 			Slot slotsOccupied() const override;
+			uint64_t getRevision() const override;
 			void replace(const Inventory &) override;
 			void replace(Inventory &&) override;
 
@@ -6,7 +6,11 @@
 #include "game/Game.h"
 #include "threading/Lockable.h"
 #include "threading/MTQueue.h"
+#include "util/MemoryStats.h"
 
+#include <array>
+#include <atomic>
+#include <chrono>
 #include <filesystem>
 #include <memory>
 #include <mutex>
@@ -24,12 +28,25 @@ namespace Game3 {
 	class ServerGame: public Game {
 		public:
 			constexpr static float GARBAGE_COLLECTION_TIME = 60;
+			/** How many packet types the netstats command and the periodic dump (every netStatsDumpSeconds, 0 to disable) list. */
+			constexpr static size_t NET_STATS_ROWS = 12;
+			/** The rules that set each subsystem's memory budget. Chunks share the paging budget. */
+			constexpr static std::array<std::pair<MemorySubsystem, const char *>, MemoryStats::SUBSYSTEM_COUNT> MEMORY_BUDGET_RULES{{
+				{MemorySubsystem::Chunks,       "chunkMemoryBudgetMB"},
+				{MemorySubsystem::Entities,     "entityMemoryBudgetMB"},
+				{MemorySubsystem::TileEntities, "tileEntityMemoryBudgetMB"},
+				{MemorySubsystem::Inventories,  "inventoryMemoryBudgetMB"},
+				{MemorySubsystem::ItemData,     "itemDataMemoryBudgetMB"},
+				{MemorySubsystem::Network,      "networkMemoryBudgetMB"},
+			}};
 
 			Lockable<std::unordered_set<ServerPlayerPtr>> players;
 			Lockable<std::unordered_map<std::string, ServerPlayerPtr>> playerMap;
 			Lockable<std::map<std::string, ssize_t>> gameRules;
 			std::weak_ptr<Server> weakServer;
 			float lastGarbageCollection = 0;
+			float lastNetStatsDump = 0;
+			const std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
 
 			ServerGame(const std::shared_ptr<Server> &, size_t pool_size);
 			~ServerGame() override;
@@ -40,18 +57,32 @@ namespace Game3 {
 			void addEntityFactories() override;
 			bool tick() final;
 			void garbageCollect();
+			/** Pages out chunks that no player has seen for the number of minutes given by the chunkIdleMinutes rule (default 10, negative to disable),
+			 *  then pages out the least recently seen chunks until resident terrain fits within the chunkMemoryBudgetMB rule (0 for no budget). */
+			void pageOutChunks();
+			/** Measures the memory held by chunks, entities, tile entities, inventories and item data for MemoryStats, then logs a warning
+			 *  for each subsystem over its budget. Budgets come from the rules in MEMORY_BUDGET_RULES, in megabytes (0 for no budget). */
+			void measureMemory();
 			void broadcastTileUpdate(RealmID, Layer, const Position &, TileID);
+			/** Sends each player one packet containing the updated tiles they can see. */
+			void broadcastTileUpdates(RealmID, const std::map<std::pair<Layer, Position>, TileID> &);
 			void broadcastFluidUpdate(RealmID, const Position &, FluidTile);
 			Side getSide() const override { return Side::Server; }
 			void queuePacket(std::shared_ptr<GenericClient>, std::shared_ptr<Packet>);
 			void runCommand(GenericClient &, const std::string &, GlobalID);
 			void entityChangingRealms(Entity &, const RealmPtr &new_realm, const Position &new_position);
 			void entityTeleported(Entity &, MovementContext);
+			/** Like entityTeleported, but only sends anything if clients' prediction of the entity's position has drifted
+			 *  past the movementCorrectionPercent rule (in hundredths of a tile). Offsets are ignored if compare_offsets
+			 *  is false, for entities that are still gliding into a tile that clients predicted correctly. */
+			void entityMotionSettled(Entity &, MovementContext, bool compare_offsets = true);
 			void entityDestroyed(const Entity &);
 			void tileEntitySpawned(const TileEntityPtr &);
 			void tileEntityDestroyed(const TileEntity &);
 			void remove(const ServerPlayerPtr &);
 			void addPlayer(const ServerPlayerPtr &);
+			/** Logs how long after startup the first player got in, which is mostly the time spent loading the world. */
+			void reportLogin();
 			bool hasPlayer(const std::string &username) const;
 			void queueRemoval(const ServerPlayerPtr &);
 			void openDatabase(std::filesystem::path);
@@ -81,13 +112,19 @@ namespace Game3 {
 
 			void broadcast(const Place &, const PacketPtr &);
 
+			/** Enqueues a tick for a tile entity woken from sleep. The tick queue isn't touched until the next
+			 *  game tick, so this is safe to call from any thread regardless of what locks are held. */
+			void queueWake(std::function<void(const TickArgs &)> tick_function);
+
 			static Token generateRandomToken();
 
 		private:
 			MTQueue<std::pair<std::weak_ptr<GenericClient>, std::shared_ptr<Packet>>> packetQueue;
 			MTQueue<std::weak_ptr<ServerPlayer>> playerRemovalQueue;
+			MTQueue<std::function<void(const TickArgs &)>> wakeQueue;
 			double timeSinceTimeUpdate = 0;
 			std::unique_ptr<GameDB> database;
+			std::atomic_bool loginReported = false;
 			Token omnitoken = generateRandomToken();
 			bool databaseValid = false;
 
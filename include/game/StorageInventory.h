@@ -1,11 +1,14 @@
 #pragma once
 
 #include "game/Inventory.h"
+#include "game/InventorySummary.h"
 
 #include <functional>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <optional>
+#include <utility>
 
 namespace Game3 {
 	class StorageInventory: public Inventory {
@@ -67,12 +70,21 @@ namespace Game3 {
 
 			bool contains(Slot) const override;
 
+			/** Returns whether the inventory contains at least a minimum amount of a given item. */
+			bool contains(const ItemStackPtr &) const override;
+
 			/** Returns whether the inventory contains at least a minimum amount of a given item, given a predicate. */
 			bool contains(const ItemStackPtr &, const Predicate &) const override;
 
+			/** Returns the slot containing a given item ID if one exists. */
+			std::optional<Slot> find(const ItemID &) const override;
+
 			/** Returns the slot containing a given item ID if one exists. */
 			std::optional<Slot> find(const ItemID &, const Predicate &) const override;
 
+			/** Returns the first slot containing an item with the given attribute if one exists. */
+			std::optional<Slot> findAttribute(const Identifier &) const override;
+
 			/** Returns the first slot containing an item with the given attribute if one exists. */
 			std::optional<Slot> findAttribute(const Identifier &, const Predicate &) const override;
 
@@ -83,18 +95,40 @@ namespace Game3 {
 
 			Slot slotsOccupied() const override;
 
+			uint64_t getRevision() const override;
+
 			void replace(const Inventory &) override;
 			void replace(Inventory &&) override;
 
-			inline auto & getStorage() { return storage; }
+			/** Assumes the caller may modify the storage, so the summary is invalidated. */
+			inline auto & getStorage() { invalidateSummary(); return storage; }
 			inline const auto & getStorage() const { return storage; }
-			inline void setStorage(Lockable<Storage> &&new_storage) { storage = std::move(new_storage); }
-			inline void setStorage(Storage &&new_storage) { storage = std::move(new_storage); }
+			inline void setStorage(Lockable<Storage> &&new_storage) { storage = std::move(new_storage); invalidateSummary(); }
+			inline void setStorage(Storage &&new_storage) { storage = std::move(new_storage); invalidateSummary(); }
 
 		protected:
 			Atomic<Slot> slotCount = 0;
 
 			/** Removes every slot whose item count is zero from the storage map. */
 			void compact() override;
+
+			/** Must be called after anything changes the storage map or the count or data of a stored stack.
+			 *  Bumps the revision, and the summary will be rebuilt the next time it's needed. */
+			inline void invalidateSummary() const { ++revision; summaryValid = false; }
+
+			template <typename Fn>
+			decltype(auto) withSummary(Fn &&function) const {
+				std::unique_lock lock(summaryMutex);
+				if (!summaryValid.exchange(true)) {
+					summary.rebuild(storage);
+				}
+				return function(std::as_const(summary));
+			}
+
+		private:
+			mutable std::mutex summaryMutex;
+			mutable InventorySummary summary;
+			mutable Atomic<bool> summaryValid = false;
+			mutable Atomic<uint64_t> revision = 0;
 	};
 }
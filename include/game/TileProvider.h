@@ -2,6 +2,7 @@
 
 #include <array>
 #include <shared_mutex>
+#include <span>
 #include <unordered_map>
 #include <vector>
 
@@ -56,6 +57,9 @@ namespace Game3 {
 			TileProvider() = default;
 			TileProvider(Identifier tileset_id);
 
+			/** The approximate number of bytes of terrain, biome, fluid and path data held for one resident chunk. */
+			static constexpr size_t CHUNK_BYTE_COUNT = CHUNK_SIZE * CHUNK_SIZE * (LAYER_COUNT * sizeof(TileID) + sizeof(BiomeType) + sizeof(FluidTile)) + CHUNK_SIZE * sizeof(uint64_t);
+
 			void clear();
 			bool contains(ChunkPosition) const;
 
@@ -81,18 +85,30 @@ namespace Game3 {
 
 			std::optional<TileID> tryTile(Layer layer, const Position &position) const;
 
+			/** Fills a PADDED_CHUNK_SIZE² row-major array with a chunk's tiles and a one-tile border taken from its neighbors.
+			 *  Tiles in missing chunks are 0. Takes the layer lock once instead of once per tile. */
+			void copyPaddedChunk(Layer, ChunkPosition, std::span<TileID> out) const;
+
 			/** Returns a copy of the biome type at a given tile position. */
 			std::optional<BiomeType> copyBiomeType(Position) const;
 
 			/** Returns a copy of the path state at a given tile position. */
 			std::optional<uint8_t> copyPathState(Position) const;
 
+			/** Returns the pathmap word for the chunk row containing the given position.
+			 *  Bit n of the result corresponds to column n of the chunk. */
+			std::optional<uint64_t> copyPathRow(Position) const;
+
 			/** Returns a copy of the fluid ID/amount at a given tile position. */
 			std::optional<FluidTile> copyFluidTile(Position) const;
 			std::optional<FluidTile> copyFluidTileUnsafe(Position) const;
 
 			ChunkSet getChunkSet(ChunkPosition) const;
 
+			/** Copies the chunk sets at the given positions, taking each map's lock once for the whole batch instead of
+			 *  once per chunk. Positions missing from any map are left out. */
+			std::vector<std::pair<ChunkPosition, ChunkSet>> copyChunkSets(std::span<const ChunkPosition>) const;
+
 			/** An empty vector indicates failure. */
 			std::string getRawChunks(ChunkPosition) const;
 
@@ -134,18 +150,9 @@ namespace Game3 {
 				return findBiomeType(position, created, lock_out, mode);
 			}
 
-			/** Returns a reference to the path state at a given tile position and sets up a shared lock. */
-			uint8_t & findPathState(Position, bool &created, std::shared_lock<std::shared_mutex> *lock_out, PathMode = PathMode::Create);
-
-			/** Returns a reference to the path state at a given tile position and sets up a unique lock. */
-			uint8_t & findPathState(Position, bool &created, std::unique_lock<std::shared_mutex> *lock_out, PathMode = PathMode::Create);
-
-			/** Returns a reference to the path state at a given tile position. */
-			template <typename T>
-			uint8_t & findPathState(Position position, T *lock_out, PathMode mode = PathMode::Create) {
-				bool created{};
-				return findPathState(position, created, lock_out, mode);
-			}
+			/** Sets the path state at a given tile position and bumps the path chunk's update counter if it changed.
+			 *  Returns whether the state changed. */
+			bool setPathState(Position, bool walkable, PathMode = PathMode::Create);
 
 			FluidTile & findFluid(Position, std::shared_lock<std::shared_mutex> *lock_out, FluidMode mode = FluidMode::Create);
 
@@ -160,13 +167,13 @@ namespace Game3 {
 			const Chunk<BiomeType> & getBiomeChunk(ChunkPosition) const;
 			Chunk<BiomeType> & getBiomeChunk(ChunkPosition);
 
-			const Chunk<uint8_t> & getPathChunk(ChunkPosition) const;
-			Chunk<uint8_t> & getPathChunk(ChunkPosition);
+			const PathChunk & getPathChunk(ChunkPosition) const;
+			PathChunk & getPathChunk(ChunkPosition);
 
 			void setPathChunk(ChunkPosition, PathChunk);
 
-			const Chunk<uint8_t> * tryPathChunk(ChunkPosition) const;
-			Chunk<uint8_t> * tryPathChunk(ChunkPosition);
+			const PathChunk * tryPathChunk(ChunkPosition) const;
+			PathChunk * tryPathChunk(ChunkPosition);
 
 			const Chunk<FluidTile> & getFluidChunk(ChunkPosition) const;
 			Chunk<FluidTile> & getFluidChunk(ChunkPosition);
@@ -190,6 +197,12 @@ namespace Game3 {
 
 			void ensureAllChunks(Position);
 
+			/** Drops the terrain, biome, fluid and path data for a chunk. The chunk's update counter is kept. */
+			void evict(ChunkPosition);
+
+			/** Returns the number of chunks with terrain data in memory. */
+			size_t getResidentChunkCount() const;
+
 			void toJSON(boost::json::value &, bool full_data = false) const;
 			void absorbJSON(const boost::json::value &, bool full_data = false);
 
@@ -232,7 +245,7 @@ namespace Game3 {
 			void validateLayer(Layer) const;
 			void initTileChunk(Layer, TileChunk &, ChunkPosition);
 			void initBiomeChunk(Chunk<BiomeType> &, ChunkPosition);
-			void initPathChunk(Chunk<uint8_t> &, ChunkPosition);
+			void initPathChunk(PathChunk &, ChunkPosition);
 			void initFluidChunk(Chunk<FluidTile> &, ChunkPosition);
 
 			template <typename M>
@@ -9,9 +9,11 @@
 #include "types/TickArgs.h"
 #include "types/VillageOptions.h"
 
+#include <map>
 #include <memory>
 #include <optional>
 #include <string>
+#include <tuple>
 
 namespace Game3 {
 	class BasicBuffer;
@@ -37,19 +39,27 @@ namespace Game3 {
 			inline auto getLabor() const { return labor.load(); }
 			inline auto getRandomValue() const { return randomValue; }
 			inline auto getGreed() const { return greed; }
+			inline auto getResourcesRevision() const { return resourcesRevision.load(); }
 			inline const auto & getName() const { return name; }
 			inline const auto & getOptions() const { return options; }
 			inline const auto & getRichness() const { return richness; }
 			inline const auto & getResources() const { return resources; }
 
 			inline void setLabor(auto value) { labor = value; }
-			inline void setGreed(auto value) { greed = value; }
-			inline void setResources(auto value) { resources = std::move(value); }
+			inline void setGreed(auto value) { greed = value; ++resourcesRevision; }
+			inline void setResources(auto value) { resources = std::move(value); ++resourcesRevision; }
 
 			std::optional<double> getRichness(const Identifier &) const;
 			std::optional<double> getResourceAmount(const Identifier &) const;
 			void setResourceAmount(const Identifier &, double);
 
+			/** Returns what the village would pay for the given amount of a resource, as totalSellPrice computes it.
+			 *  Quotes are cached until the village's resources or greed change. */
+			std::optional<MoneyCount> quoteSell(const Identifier &, double base_price, ItemCount amount) const;
+			/** Returns what the village would charge for the given amount of a resource, as totalBuyPrice computes it.
+			 *  Quotes are cached until the village's resources or greed change. */
+			std::optional<MoneyCount> quoteBuy(const Identifier &, double base_price, ItemCount amount) const;
+
 			Tick enqueueTick() override;
 			void tick(const TickArgs &);
 
@@ -78,7 +88,17 @@ namespace Game3 {
 			double greed{};
 
 			Lockable<std::unordered_set<PlayerPtr>> subscribedPlayers;
+			/** Incremented after every change to the resources or the greed. */
+			Atomic<uint64_t> resourcesRevision{};
+
+			/** Keyed by resource, amount and whether the quote is for selling. */
+			using QuoteKey = std::tuple<Identifier, ItemCount, bool>;
+			struct QuoteCache: std::map<QuoteKey, std::optional<MoneyCount>> {
+				uint64_t revision = 0;
+			};
+			mutable Lockable<QuoteCache> quotes;
 
+			std::optional<MoneyCount> quote(const Identifier &, double base_price, ItemCount amount, bool is_sell) const;
 			void produce(BiomeType, const ProductionRule &);
 			void produce(BiomeType, const ProductionRuleRegistry &);
 			bool consume(const ConsumptionRule &);
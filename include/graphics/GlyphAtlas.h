@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace Game3 {
+	/** Packs glyph bitmaps into shelves (rows as tall as their tallest glyph) of a single-channel image that doubles in
+	 *  height when it runs out of room. Contains no OpenGL; TextRenderer uploads the image whenever the revision changes. */
+	class GlyphAtlas {
+		public:
+			struct Region {
+				uint32_t x = 0;
+				uint32_t y = 0;
+				uint32_t width = 0;
+				uint32_t height = 0;
+			};
+
+			/** Empty texels kept between neighboring glyphs so that linear filtering doesn't bleed one into another. */
+			constexpr static uint32_t PADDING = 1;
+
+			GlyphAtlas(uint32_t width = 1024, uint32_t height = 256, uint32_t max_height = 8192);
+
+			/** Copies a bitmap with the given row pitch into the atlas. Returns std::nullopt only if the bitmap can't fit
+			 *  even after the atlas has grown as far as it's allowed to. */
+			std::optional<Region> insert(uint32_t width, uint32_t height, const uint8_t *pixels, int pitch);
+
+			/** Forgets every glyph and shrinks back to the initial size. */
+			void clear();
+
+			inline uint32_t getWidth() const { return width; }
+			inline uint32_t getHeight() const { return height; }
+			inline const std::vector<uint8_t> & getPixels() const { return pixels; }
+			inline size_t getShelfCount() const { return shelves.size(); }
+			/** Changes whenever the pixels or the dimensions change. */
+			inline uint64_t getRevision() const { return revision; }
+
+		private:
+			struct Shelf {
+				uint32_t y = 0;
+				uint32_t height = 0;
+				uint32_t used = 0;
+			};
+
+			uint32_t width;
+			uint32_t height;
+			uint32_t initialHeight;
+			uint32_t maxHeight;
+			uint64_t revision = 0;
+			std::vector<uint8_t> pixels;
+			std::vector<Shelf> shelves;
+
+			std::optional<Region> allocate(uint32_t width, uint32_t height);
+			bool grow();
+	};
+}
@@ -1,17 +1,29 @@
 #pragma once
 
+#include "graphics/Color.h"
 #include "graphics/HasBackbuffer.h"
 #include "graphics/Shader.h"
 
+#include <span>
+
 namespace Game3 {
 	class Window;
-	struct Color;
 	struct Rectangle;
 	struct RenderOptions;
 
+	/** One rectangle of a batch drawn by RectangleRenderer::drawBatchOnMap. Positions and sizes are in tiles, as with drawOnMap. */
+	struct RectangleInstance {
+		float x = 0;
+		float y = 0;
+		float width = 0;
+		float height = 0;
+		Color color;
+	};
+
 	class RectangleRenderer: public HasBackbuffer {
 		public:
 			Shader shader;
+			Shader instancedShader;
 
 			RectangleRenderer(Window &);
 
@@ -21,6 +33,8 @@ namespace Game3 {
 			void update(int width, int height) override;
 
 			void drawOnMap(const RenderOptions &);
+			/** Draws any number of unrotated rectangles on the map with a single instanced draw call. */
+			void drawBatchOnMap(std::span<const RectangleInstance>);
 			void drawOnScreen(const Color &, float x, float y, float width, float height, float angle = 0.f);
 			void drawOnScreen(const Color &, const Rectangle &, float angle = 0.f);
 
@@ -31,6 +45,9 @@ namespace Game3 {
 			Window &window;
 			glm::mat4 projection;
 			GLuint quadVAO = 0;
+			GLuint quadVBO = 0;
+			GLuint instanceVAO = 0;
+			GLuint instanceVBO = 0;
 			bool initialized = false;
 
 			void initRenderData();
@@ -0,0 +1,5 @@
+#pragma once
+
+namespace Game3 {
+	enum class TextAlign {Left, Center, Right};
+}
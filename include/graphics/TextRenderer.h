@@ -4,13 +4,18 @@
 
 #include "graphics/Color.h"
 #include "graphics/GL.h"
+#include "graphics/GlyphAtlas.h"
 #include "graphics/HasBackbuffer.h"
 #include "graphics/Shader.h"
+#include "graphics/TextAlign.h"
 #include "math/Vector.h"
 #include "types/Position.h"
 #include "types/Types.h"
 
 #include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 #include <ft2build.h>
 #include FT_FREETYPE_H
@@ -22,8 +27,6 @@ namespace Game3 {
 	class UStringSpan;
 	class Window;
 
-	enum class TextAlign {Left, Center, Right};
-
 	struct TextRenderOptions {
 		double x      = 0;
 		double y      = 0;
@@ -49,13 +52,32 @@ namespace Game3 {
 			uint32_t fontScale = 48;
 
 			struct Character {
-				GLuint     textureID; // ID handle of the glyph texture
-				glm::ivec2 size;      // Size of glyph
-				glm::ivec2 bearing;   // Offset from baseline to left/top of glyph
-				FT_Pos     advance;   // Offset to advance to next glyph
+				glm::ivec2 size;          // Size of glyph
+				glm::ivec2 bearing;       // Offset from baseline to left/top of glyph
+				FT_Pos     advance;       // Offset to advance to next glyph
+				glm::ivec2 atlasPosition; // Top left corner of the glyph's bitmap in the atlas
+			};
+
+			/** A string laid out relative to its starting pen position. */
+			struct Layout {
+				struct Quad {
+					float x;
+					float y;
+					float width;
+					float height;
+					glm::ivec2 atlasPosition;
+					glm::ivec2 size;
+				};
+
+				/** Glyphs with nothing to draw (spaces, for example) are left out. */
+				std::vector<Quad> quads;
+				/** The vertical offset of the last line's baseline, which is zero or negative. */
+				float lastLineY = 0;
+				float highestOnFirstLine = 0;
 			};
 
-			std::unordered_map<uint32_t, Character> characters;
+			/** Glyphs are rasterized into the atlas the first time they're needed. */
+			mutable std::unordered_map<uint32_t, Character> characters;
 
 			TextRenderer(Window &, uint32_t fontScale = 96);
 			~TextRenderer();
@@ -77,6 +99,15 @@ namespace Game3 {
 			float textHeight(UStringSpan text, float scale, float wrap_width) const;
 			float getIHeight() const;
 
+			/** Lays out a string, or returns the cached layout if the same string was laid out with the same options
+			 *  since the cache was last cleared. The reference is valid until the next call. */
+			const Layout & layOut(UStringSpan text, float scale_x, float scale_y, float wrap_width = 0, bool ignore_newline = false) const;
+
+			inline const GlyphAtlas & getAtlas() const { return atlas; }
+			/** Returns the number of draw calls made since the last call to resetDrawCalls. */
+			inline size_t getDrawCalls() const { return drawCalls; }
+			inline void resetDrawCalls() { drawCalls = 0; }
+
 			void reset();
 			void initRenderData();
 
@@ -100,8 +131,30 @@ namespace Game3 {
 				}
 			};
 
+			struct LayoutKey {
+				std::string text;
+				float scaleX;
+				float scaleY;
+				float wrapWidth;
+				bool ignoreNewline;
+
+				bool operator==(const LayoutKey &) const = default;
+			};
+
+			struct LayoutKeyHash {
+				size_t operator()(const LayoutKey &) const noexcept;
+			};
+
+			/** Dropped wholesale when full. Most frames redraw the same few hundred strings. */
+			constexpr static size_t MAX_CACHED_LAYOUTS = 1024;
+
 			GLuint vao = 0;
 			GLuint vbo = 0;
+			GLuint atlasTexture = 0;
+			uint64_t uploadedRevision = 0;
+			uint32_t uploadedHeight = 0;
+			size_t vboCapacity = 0;
+			size_t drawCalls = 0;
 			bool initialized = false;
 			bool fake = false;
 			mutable std::optional<float> cachedIHeight;
@@ -110,8 +163,19 @@ namespace Game3 {
 
 			std::unique_ptr<FT_Library, FreeLibrary> freetypeLibrary;
 			std::unique_ptr<FT_Face, FreeFace> freetypeFace;
+			mutable GlyphAtlas atlas;
+			mutable std::unordered_map<LayoutKey, Layout, LayoutKeyHash> layouts;
+			/** Vertices of the glyphs queued for the next flush: position, texture coordinates and color. */
+			std::vector<float> batch;
 
 			const Character & getCharacter(uint32_t) const;
 			const Character & getCharacter(uint32_t);
+			/** Rasterizes a glyph into the atlas. Returns nullptr if the font doesn't have it. */
+			const Character * loadCharacter(uint32_t) const;
+			void queueOnMap(const UStringSpan &text, TextRenderOptions);
+			void queueOnScreen(const UString &text, TextRenderOptions);
+			void enqueue(const Layout &, float x, float y, const Color &);
+			/** Uploads the atlas if it has changed and draws everything queued with a single draw call. */
+			void flush();
 	};
 }
@@ -16,6 +16,12 @@ namespace GL {
 namespace Game3 {
 	class Texture: public NamedRegisterable {
 		public:
+			/** OpenGL's values for the filters and formats Texture uses, so that code that only describes textures doesn't need OpenGL. */
+			constexpr static int NEAREST = 0x2600;
+			constexpr static int LINEAR  = 0x2601;
+			constexpr static int RGB     = 0x1907;
+			constexpr static int RGBA    = 0x1908;
+
 			unsigned id = 0;
 			int width   = 0;
 			int height  = 0;
@@ -34,6 +40,7 @@ namespace Game3 {
 			Texture & operator=(const Texture &) = delete;
 			Texture & operator=(Texture &&) = delete;
 
+#ifndef GAME3_HEADLESS
 			void init();
 			void init(std::shared_ptr<uint8_t[]>, int data_width, int data_height);
 			void init(std::span<const uint8_t>, int data_width, int data_height);
@@ -42,9 +49,12 @@ namespace Game3 {
 			void repeat();
 			bool upload(std::span<const uint8_t>);
 			void bind(int bind_id = -1);
+#endif
 			bool getValid() const { return valid; }
 			void dump(const std::filesystem::path &);
+#ifndef GAME3_HEADLESS
 			void destroy();
+#endif
 
 			static std::string filterToString(int);
 			static int stringToFilter(std::string_view);
@@ -20,7 +20,13 @@ namespace Game3 {
 	struct AutotileSet {
 		Identifier identifier;
 		std::unordered_set<Identifier> members;
+		/** The members compiled into a bitset indexed by TileID. Filled in by Tileset::compileAutotiles. */
+		std::vector<bool> memberIDs;
 		bool omni = false;
+
+		inline bool hasMember(TileID tile_id) const {
+			return tile_id < memberIDs.size() && memberIDs[tile_id];
+		}
 	};
 
 	struct MarchableInfo {
@@ -40,6 +46,14 @@ namespace Game3 {
 			eight(eight) {}
 	};
 
+	/** A MarchableInfo resolved to tile IDs so that autotiling doesn't need to look anything up by name. */
+	struct CompiledMarchable {
+		const AutotileSet *autotileSet = nullptr;
+		TileID start = 0;
+		bool tall = false;
+		bool eight = false;
+	};
+
 	class Tileset: public NamedRegisterable {
 		public:
 			bool isWalkable(const Identifier &) const;
@@ -58,6 +72,17 @@ namespace Game3 {
 			bool isMarchable(TileID);
 			bool isCategoryMarchable(const Identifier &category) const;
 			const MarchableInfo * getMarchableInfo(const Identifier &tilename) const;
+			/** Returns null if the tile doesn't autotile. */
+			inline const CompiledMarchable * getCompiledMarchable(TileID tile_id) const {
+				if (tile_id < compiledMarchables.size() && compiledMarchables[tile_id].autotileSet != nullptr) {
+					return &compiledMarchables[tile_id];
+				}
+				return nullptr;
+			}
+			/** Whether the tile is in base:category/no_omni and therefore doesn't connect to omni autotiles like fences. */
+			inline bool isNoOmni(TileID tile_id) const {
+				return tile_id < noOmniIDs.size() && noOmniIDs[tile_id];
+			}
 			void clearCache();
 			const std::unordered_set<Identifier> & getCategories(const Identifier &) const;
 			const std::unordered_set<TileID> getCategoryIDs(const Identifier &) const;
@@ -128,8 +153,14 @@ namespace Game3 {
 			std::unordered_map<Identifier, std::shared_ptr<AutotileSet>> autotileSetMap;
 			/** Maps base tile IDs for the lower portions of tall tiles to the tile IDs for the upper portions. */
 			std::unordered_map<TileID, TileID> uppers;
+			/** Indexed by TileID. */
+			std::vector<CompiledMarchable> compiledMarchables;
+			/** Indexed by TileID. */
+			std::vector<bool> noOmniIDs;
 
 			void setAutotile(const Identifier &tilename, const Identifier &autotile_name);
+			/** Builds the TileID-indexed autotiling tables once every tile has been assigned an ID. */
+			void compileAutotiles();
 
 		friend Tileset tileStitcher(const std::filesystem::path &, Identifier, Side, std::string *);
 	};
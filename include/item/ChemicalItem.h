@@ -12,8 +12,10 @@ namespace Game3 {
 
 			using Item::Item;
 
+#ifndef GAME3_HEADLESS
 			TexturePtr getTexture(const Game &, const ConstItemStackPtr &) const override;
 			TexturePtr makeTexture(const Game &, const ConstItemStackPtr &) const override;
+#endif
 
 			std::string getTooltip(const ConstItemStackPtr &) override;
 
@@ -13,7 +13,9 @@ namespace Game3 {
 			using Item::Item;
 			bool use(Slot, const ItemStackPtr &, const std::shared_ptr<Player> &, Modifiers) override;
 			bool drag(Slot, const ItemStackPtr &, const Place &, Modifiers, std::pair<float, float>, DragAction) override;
+#ifndef GAME3_HEADLESS
 			void renderEffects(Window &, const RendererContext &, const Position &, Modifiers, const ItemStackPtr &) const override;
+#endif
 			// bool populateMenu(const InventoryPtr &, Slot, const ItemStackPtr &, Glib::RefPtr<Gio::Menu>, Glib::RefPtr<Gio::SimpleActionGroup>) const override;
 
 			static std::string getString(const ItemStackPtr &, const std::shared_ptr<Realm> &);
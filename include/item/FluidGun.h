@@ -10,8 +10,10 @@ namespace Game3 {
 			std::string getTooltip(const ConstItemStackPtr &) override;
 			bool use(Slot, const ItemStackPtr &, const Place &, Modifiers, std::pair<float, float>) override;
 			bool drag(Slot, const ItemStackPtr &, const Place &, Modifiers, std::pair<float, float>, DragAction) override;
+#ifndef GAME3_HEADLESS
 			bool fire(Slot, const ItemStackPtr &, const Place &, Modifiers, std::pair<float, float>) override;
 			void renderEffects(Window &, const RendererContext &, const Position &, Modifiers, const ItemStackPtr &) const override;
+#endif
 
 			bool fireGun(Slot, const ItemStackPtr &, const Place &, Modifiers, std::pair<float, float>, uint16_t tick_frequency);
 	};
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "data/Identifier.h"
+#include "item/ItemStackData.h"
 #include "registry/Registerable.h"
 #include "threading/Lockable.h"
 #include "types/Types.h"
@@ -46,10 +47,14 @@ namespace Game3 {
 
 			virtual bool isTextureCacheable() const { return true; }
 
+#ifndef GAME3_HEADLESS
 			virtual TexturePtr getTexture(const Game &, const ConstItemStackPtr &) const;
 			virtual TexturePtr makeTexture(const Game &, const ConstItemStackPtr &) const;
+#endif
 			virtual Identifier getTextureIdentifier(const ConstItemStackPtr &) const;
+#ifndef GAME3_HEADLESS
 			virtual void getOffsets(const Game &, std::shared_ptr<Texture> &, float &x_offset, float &y_offset);
+#endif
 			virtual Item & addAttribute(Identifier) &;
 			virtual Item && addAttribute(Identifier) &&;
 			virtual bool hasAttribute(const Identifier &) const;
@@ -79,7 +84,9 @@ namespace Game3 {
 
 			virtual void onDestroy(Game &, const ItemStackPtr &) const {}
 
+#ifndef GAME3_HEADLESS
 			virtual void renderEffects(Window &, const RendererContext &, const Position &, Modifiers, const ItemStackPtr &) const {}
+#endif
 
 			// virtual bool populateMenu(const InventoryPtr &, Slot, const ItemStackPtr &, Glib::RefPtr<Gio::Menu>, Glib::RefPtr<Gio::SimpleActionGroup>) const { return false; }
 
@@ -95,11 +102,18 @@ namespace Game3 {
 		public:
 			std::shared_ptr<Item> item;
 			ItemCount count = 1;
-			Lockable<boost::json::value> data;
+			ItemStackData data;
 
+			/** Allocates the stack and its reference count together, which halves the allocations per stack. */
 			template <typename... Args>
 			static std::shared_ptr<ItemStack> create(Args &&...args) {
-				return std::shared_ptr<ItemStack>(new ItemStack(std::forward<Args>(args)...));
+				// A local class has the same access as the enclosing member function, so it can reach the private constructors.
+				struct Constructible: ItemStack {
+					Constructible(Args &&...args):
+						ItemStack(std::forward<Args>(args)...) {}
+				};
+
+				return std::make_shared<Constructible>(std::forward<Args>(args)...);
 			}
 
 			template <typename... Args>
@@ -108,10 +122,14 @@ namespace Game3 {
 				return stack->spawn(place);
 			}
 
+#ifndef GAME3_HEADLESS
 			TexturePtr getTexture() const;
 			TexturePtr getTexture(const Game &) const;
+#endif
 
 			bool canMerge(const ItemStack &) const;
+			/** Returns a hash of the stack's data, or zero if the stack has no data. Mergeable stacks always have equal hashes. */
+			size_t getDataHash() const;
 			/** Returns a copy of the ItemStack with a different count. */
 			ItemStackPtr withCount(ItemCount) const;
 
@@ -153,7 +171,9 @@ namespace Game3 {
 			void onDestroy();
 			void onDestroy(Game &);
 
+#ifndef GAME3_HEADLESS
 			void renderEffects(Window &, const RendererContext &, const Position &, Modifiers);
+#endif
 
 			void encode(Game &, Buffer &);
 			void decode(Game &, BasicBuffer &);
@@ -170,9 +190,9 @@ namespace Game3 {
 			ItemStack() = default;
 			ItemStack(const std::shared_ptr<Game> &);
 			ItemStack(const std::shared_ptr<Game> &, std::shared_ptr<Item> item_, ItemCount count_ = 1);
-			ItemStack(const std::shared_ptr<Game> &, std::shared_ptr<Item> item_, ItemCount count_, boost::json::value data_);
+			ItemStack(const std::shared_ptr<Game> &, std::shared_ptr<Item> item_, ItemCount count_, ItemStackData data_);
 			ItemStack(const std::shared_ptr<Game> &, const ItemID &, ItemCount = 1);
-			ItemStack(const std::shared_ptr<Game> &, const ItemID &, ItemCount, boost::json::value data_);
+			ItemStack(const std::shared_ptr<Game> &, const ItemID &, ItemCount, ItemStackData data_);
 
 			void absorbGame(Game &);
 
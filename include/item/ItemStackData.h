@@ -0,0 +1,74 @@
+#pragma once
+
+#include "threading/Lockable.h"
+#include "util/Defer.h"
+
+#include <boost/json.hpp>
+
+#include <concepts>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+
+namespace Game3 {
+	/** The JSON data attached to an item stack. Copies share one value along with its hash, which is computed whenever
+	 *  the value changes rather than whenever stacks are compared. Writing to a value that another copy still shares
+	 *  clones it first, so copying a stack (to split it, to store it in an inventory or to send it in a packet) never
+	 *  copies its data. */
+	class ItemStackData {
+		public:
+			ItemStackData() = default;
+			ItemStackData(boost::json::value);
+			ItemStackData(const ItemStackData &);
+			ItemStackData(ItemStackData &&) noexcept;
+
+			ItemStackData & operator=(const ItemStackData &);
+			ItemStackData & operator=(ItemStackData &&) noexcept;
+			ItemStackData & operator=(boost::json::value);
+
+			/** Returns the data, or a null value if there isn't any. The reference is valid until the next write. */
+			const boost::json::value & get() const;
+			inline const boost::json::value & operator*() const { return get(); }
+			inline const boost::json::value * operator->() const { return &get(); }
+
+			inline bool isNull() const { return !value || value->is_null(); }
+			/** Returns zero if there's no data. */
+			inline size_t getHash() const { return hash; }
+
+			/** Calls a function with mutable access to the data while holding a unique lock. The data is cloned first if
+			 *  another copy shares it and rehashed afterwards. */
+			template <typename Fn>
+			requires std::invocable<Fn, boost::json::value &>
+			decltype(auto) mutate(Fn &&function) {
+				auto lock = uniqueLock();
+				detach();
+				Defer rehasher([this] { rehash(); });
+				return function(*value);
+			}
+
+			template <typename Fn>
+			requires std::invocable<Fn, const boost::json::value &>
+			decltype(auto) withShared(Fn &&function) const {
+				auto lock = sharedLock();
+				return function(get());
+			}
+
+			inline auto sharedLock() const { return std::shared_lock(mutex); }
+			inline auto uniqueLock() const { return std::unique_lock(mutex); }
+
+			/** Shared data is equal without being compared. Otherwise, the hashes are compared before the values. */
+			bool operator==(const ItemStackData &) const;
+			bool operator==(const boost::json::value &) const;
+
+		private:
+			mutable DefaultMutex mutex;
+			std::shared_ptr<boost::json::value> value;
+			size_t hash = 0;
+
+			/** Makes the value safe to modify in place by cloning it if it's shared or creating it if it's missing. */
+			void detach();
+			void rehash();
+	};
+
+	void tag_invoke(boost::json::value_from_tag, boost::json::value &, const ItemStackData &);
+}
@@ -16,7 +16,9 @@ namespace Game3 {
 
 			Mushroom(ItemID id_, std::string name_, MoneyCount base_price, ID sub_id);
 
+#ifndef GAME3_HEADLESS
 			void getOffsets(const Game &, std::shared_ptr<Texture> &, float &x_offset, float &y_offset) override;
 			TexturePtr makeTexture(const Game &, const ConstItemStackPtr &) const override;
+#endif
 	};
 }
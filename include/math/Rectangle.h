@@ -27,8 +27,10 @@ namespace Game3 {
 			Rectangle(pos.x, pos.y, size, size) {}
 
 		int area() const;
+#ifndef GAME3_HEADLESS
 		void scissor(int outer_height) const;
 		void viewport(int outer_height) const;
+#endif
 		bool contains(int x, int y) const;
 		void reposition(int x, int y) &;
 		Rectangle && reposition(int x, int y) &&;
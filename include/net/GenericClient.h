@@ -1,5 +1,6 @@
 #pragma once
 
+#include "net/NetStats.h"
 #include "net/SendBuffer.h"
 #include "packet/ErrorPacket.h"
 #include "packet/Packet.h"
@@ -29,6 +30,8 @@ namespace Game3 {
 			int id = -1;
 			std::string ip;
 			SendBuffer sendBuffer;
+			/** Outgoing traffic to this client. Also counted in NetStats::global(). */
+			NetStats netStats;
 
 			GenericClient(const GenericClient &) = delete;
 			GenericClient(GenericClient &&) = delete;
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "types/Types.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Game3 {
+	/** Counters for outgoing packets, broken down by packet type. Everything is a relaxed atomic add into a fixed table,
+	 *  so it's cheap enough to record every packet sent without a lock. */
+	class NetStats {
+		public:
+			/** Packet IDs at or above this share the last row. */
+			constexpr static size_t TRACKED_IDS = 256;
+
+			struct Row {
+				PacketID packetID = 0;
+				uint64_t packets = 0;
+				uint64_t encodeNanoseconds = 0;
+				/** Bytes before any packet-level compression. */
+				uint64_t rawBytes = 0;
+				/** Bytes actually written, including the packet header. */
+				uint64_t wireBytes = 0;
+			};
+
+			NetStats() = default;
+
+			NetStats(const NetStats &) = delete;
+			NetStats & operator=(const NetStats &) = delete;
+
+			void record(PacketID, std::chrono::nanoseconds encode_time, size_t raw_bytes, size_t wire_bytes);
+			void recordQueueDepth(size_t);
+			/** Returns a row for each packet type sent so far, sorted by descending wire bytes. */
+			std::vector<Row> snapshot() const;
+			/** Returns one line per packet type for the heaviest max_rows types, followed by a line of totals. */
+			std::string summarize(size_t max_rows) const;
+			void reset();
+
+			inline size_t getQueueDepth() const { return queueDepth.load(std::memory_order_relaxed); }
+			inline size_t getMaxQueueDepth() const { return maxQueueDepth.load(std::memory_order_relaxed); }
+
+			/** Server-wide totals across all clients. */
+			static NetStats & global();
+
+			/** Called by packets that compress their own payload while encoding so that the bytes they saved are
+			 *  attributed to them. Applies to the packet being encoded on the current thread. */
+			static void noteCompression(size_t uncompressed, size_t compressed);
+			/** Returns and clears the bytes saved by compression on the current thread since the last call. */
+			static size_t takeCompressionSavings();
+
+		private:
+			struct Counters {
+				std::atomic_uint64_t packets = 0;
+				std::atomic_uint64_t encodeNanoseconds = 0;
+				std::atomic_uint64_t rawBytes = 0;
+				std::atomic_uint64_t wireBytes = 0;
+			};
+
+			std::array<Counters, TRACKED_IDS> counters;
+			std::atomic_size_t queueDepth = 0;
+			std::atomic_size_t maxQueueDepth = 0;
+	};
+}
@@ -19,6 +19,8 @@ namespace Game3 {
 		void encode(Game &, Buffer &buffer) const override { buffer << itemID; }
 		void decode(Game &, BasicBuffer &buffer)  override { buffer >> itemID; }
 
+#ifndef GAME3_HEADLESS
 		void handle(const std::shared_ptr<ClientGame> &) override;
+#endif
 	};
 }
@@ -20,6 +20,8 @@ namespace Game3 {
 		void encode(Game &, Buffer &buffer) const override { buffer << globalID << message; }
 		void decode(Game &, BasicBuffer &buffer)  override { buffer >> globalID >> message; }
 
+#ifndef GAME3_HEADLESS
 		void handle(const std::shared_ptr<ClientGame> &) override;
+#endif
 	};
 }
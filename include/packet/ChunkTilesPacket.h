@@ -5,6 +5,9 @@
 #include "net/Buffer.h"
 #include "packet/Packet.h"
 
+#include <memory>
+#include <vector>
+
 namespace Game3 {
 	struct ChunkTilesPacket: Packet {
 		static PacketID ID() { return 8; }
@@ -14,19 +17,27 @@ namespace Game3 {
 		uint64_t updateCounter = 0;
 		std::vector<TileID> tiles;
 		std::vector<FluidTile> fluids;
-		std::vector<uint8_t> pathmap;
+		/** Set by precompress. Once set, encode sends this payload as is and tiles and fluids are left empty; handle
+		 *  unpacks it into locals for local clients, which receive the packet object itself. */
+		std::shared_ptr<const std::vector<uint8_t>> compressed;
+		size_t uncompressedSize = 0;
 
 		ChunkTilesPacket() = default;
 		ChunkTilesPacket(Realm &, ChunkPosition, uint64_t update_counter);
 		ChunkTilesPacket(Realm &, ChunkPosition);
-		ChunkTilesPacket(RealmID realm_id, ChunkPosition chunk_position, uint64_t update_counter, std::vector<TileID> tiles, std::vector<FluidTile> fluids, std::vector<uint8_t> pathmap):
-			realmID(realm_id), chunkPosition(chunk_position), updateCounter(update_counter), tiles(std::move(tiles)), fluids(std::move(fluids)), pathmap(std::move(pathmap)) {}
+		ChunkTilesPacket(RealmID realm_id, ChunkPosition chunk_position, uint64_t update_counter, std::vector<TileID> tiles, std::vector<FluidTile> fluids):
+			realmID(realm_id), chunkPosition(chunk_position), updateCounter(update_counter), tiles(std::move(tiles)), fluids(std::move(fluids)) {}
 
 		PacketID getID() const override { return ID(); }
 
+		/** Compresses the payload ahead of time so that a packet cached and sent to many clients is only compressed once. */
+		void precompress();
+
 		void encode(Game &, Buffer &buffer) const override;
 		void decode(Game &, BasicBuffer &buffer)  override;
 
+#ifndef GAME3_HEADLESS
 		void handle(const std::shared_ptr<ClientGame> &) override;
+#endif
 	};
 }
@@ -3,7 +3,10 @@
 #include "types/Position.h"
 #include "net/Buffer.h"
 #include "packet/Packet.h"
+
+#ifndef GAME3_HEADLESS
 #include "ui/Modifiers.h"
+#endif
 
 namespace Game3 {
 	struct ClickPacket: Packet {
@@ -21,6 +21,8 @@ namespace Game3 {
 		void encode(Game &, Buffer &buffer) const override { buffer << commandID << success << message; }
 		void decode(Game &, BasicBuffer &buffer)  override { buffer >> commandID >> success >> message; }
 
+#ifndef GAME3_HEADLESS
 		void handle(const std::shared_ptr<ClientGame> &) override;
+#endif
 	};
 }
@@ -4,7 +4,10 @@
 
 #include "game/Game.h"
 #include "packet/Packet.h"
+
+#ifndef GAME3_HEADLESS
 #include "ui/Modifiers.h"
+#endif
 
 namespace Game3 {
 	struct ContinuousInteractionPacket: Packet {
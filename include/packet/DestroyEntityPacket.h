@@ -27,6 +27,8 @@ namespace Game3 {
 		void encode(Game &, Buffer &buffer) const override { buffer << globalID << realmRequirement; }
 		void decode(Game &, BasicBuffer &buffer)  override { buffer >> globalID >> realmRequirement; }
 
+#ifndef GAME3_HEADLESS
 		void handle(const std::shared_ptr<ClientGame> &) override;
+#endif
 	};
 }
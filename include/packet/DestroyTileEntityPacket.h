@@ -21,6 +21,8 @@ namespace Game3 {
 		void encode(Game &, Buffer &buffer) const override { buffer << globalID; }
 		void decode(Game &, BasicBuffer &buffer)  override { buffer >> globalID; }
 
+#ifndef GAME3_HEADLESS
 		void handle(const std::shared_ptr<ClientGame> &) override;
+#endif
 	};
 }
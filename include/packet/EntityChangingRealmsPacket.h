@@ -25,6 +25,8 @@ namespace Game3 {
 		void encode(Game &, Buffer &buffer) const override { buffer << globalID << newRealmID << newPosition; }
 		void decode(Game &, BasicBuffer &buffer)  override { buffer >> globalID >> newRealmID >> newPosition; }
 
+#ifndef GAME3_HEADLESS
 		void handle(const std::shared_ptr<ClientGame> &) override;
+#endif
 	};
 }
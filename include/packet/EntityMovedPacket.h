@@ -34,6 +34,8 @@ namespace Game3 {
 		void encode(Game &, Buffer &) const override;
 		void decode(Game &, BasicBuffer &) override;
 
+#ifndef GAME3_HEADLESS
 		void handle(const std::shared_ptr<ClientGame> &) override;
+#endif
 	};
 }
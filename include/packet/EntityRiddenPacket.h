@@ -24,6 +24,8 @@ namespace Game3 {
 		void encode(Game &, Buffer &buffer) const override { buffer << riderID << riddenID; }
 		void decode(Game &, BasicBuffer &buffer)  override { buffer >> riderID >> riddenID; }
 
+#ifndef GAME3_HEADLESS
 		void handle(const std::shared_ptr<ClientGame> &) override;
+#endif
 	};
 }
@@ -23,9 +23,13 @@ namespace Game3 {
 
 		PacketID getID() const override { return ID(); }
 
-		void encode(Game &, Buffer &buffer) const override { buffer << globalID << realmID << position << path << newCounter; }
-		void decode(Game &, BasicBuffer &buffer)  override { buffer >> globalID >> realmID >> position >> path >> newCounter; }
+		/** The path is sent as runs of repeated directions, each packed as (length << 3) | direction, since villagers
+		 *  and monsters mostly walk in long straight lines. */
+		void encode(Game &, Buffer &) const override;
+		void decode(Game &, BasicBuffer &) override;
 
+#ifndef GAME3_HEADLESS
 		void handle(const std::shared_ptr<ClientGame> &) override;
+#endif
 	};
 }
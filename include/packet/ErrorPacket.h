@@ -19,6 +19,8 @@ namespace Game3 {
 		void encode(Game &, Buffer &buffer) const override { buffer << error; }
 		void decode(Game &, BasicBuffer &buffer)  override { buffer >> error; }
 
+#ifndef GAME3_HEADLESS
 		void handle(const std::shared_ptr<ClientGame> &) override;
+#endif
 	};
 }
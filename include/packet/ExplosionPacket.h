@@ -6,6 +6,7 @@
 
 namespace Game3 {
 	class Entity;
+	class Realm;
 	struct ExplosionOptions;
 
 	struct ExplosionPacket: Packet {
@@ -28,6 +29,12 @@ namespace Game3 {
 		void encode(Game &, Buffer &) const override;
 		void decode(Game &, BasicBuffer &) override;
 
+#ifndef GAME3_HEADLESS
 		void handle(const std::shared_ptr<ClientGame> &) final;
+#endif
+
+		private:
+			/** Spawns the explosion's squares in the realm's particle system instead of as entities. */
+			void spawnSquareParticles(Realm &);
 	};
 }
@@ -22,6 +22,8 @@ namespace Game3 {
 		void encode(Game &, Buffer &buffer) const override { buffer << realmID << entityID << leftHand << slot << newCounter; }
 		void decode(Game &, BasicBuffer &buffer)  override { buffer >> realmID >> entityID >> leftHand >> slot >> newCounter; }
 
+#ifndef GAME3_HEADLESS
 		void handle(const std::shared_ptr<ClientGame> &) override;
+#endif
 	};
 }
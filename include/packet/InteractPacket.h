@@ -2,7 +2,10 @@
 
 #include "net/Buffer.h"
 #include "packet/Packet.h"
+
+#ifndef GAME3_HEADLESS
 #include "ui/Modifiers.h"
+#endif
 
 namespace Game3 {
 	struct InteractPacket: Packet {
@@ -24,6 +27,8 @@ namespace Game3 {
 		void decode(Game &, BasicBuffer &buffer)  override { buffer >> direct >> hand >> modifiers >> globalID >> direction; }
 
 		void handle(const std::shared_ptr<ServerGame> &, GenericClient &) override;
+#ifndef GAME3_HEADLESS
 		void handle(const std::shared_ptr<ClientGame> &) override;
+#endif
 	};
 }
@@ -4,7 +4,10 @@
 #include "item/Item.h"
 #include "net/Buffer.h"
 #include "packet/Packet.h"
+
+#ifndef GAME3_HEADLESS
 #include "ui/Modifiers.h"
+#endif
 
 namespace Game3 {
 	struct InventorySlotUpdatePacket: Packet {
@@ -22,6 +25,8 @@ namespace Game3 {
 		void encode(Game &, Buffer &buffer) const override { buffer << slot << stack; }
 		void decode(Game &, BasicBuffer &buffer)  override { buffer >> slot >> stack; }
 
+#ifndef GAME3_HEADLESS
 		void handle(const std::shared_ptr<ClientGame> &) override;
+#endif
 	};
 }
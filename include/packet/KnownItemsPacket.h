@@ -21,6 +21,8 @@ namespace Game3 {
 		void encode(Game &, Buffer &buffer) const override { buffer << itemIDs; }
 		void decode(Game &, BasicBuffer &buffer)  override { buffer >> itemIDs; }
 
+#ifndef GAME3_HEADLESS
 		void handle(const std::shared_ptr<ClientGame> &) override;
+#endif
 	};
 }
@@ -23,6 +23,8 @@ namespace Game3 {
 		void encode(Game &, Buffer &buffer) const override { buffer << realmID << position << direction << removeOnMove; }
 		void decode(Game &, BasicBuffer &buffer)  override { buffer >> realmID >> position >> direction >> removeOnMove; }
 
+#ifndef GAME3_HEADLESS
 		void handle(const std::shared_ptr<ClientGame> &) override;
+#endif
 	};
 }
@@ -21,6 +21,8 @@ namespace Game3 {
 		void encode(Game &, Buffer &buffer) const override { buffer << minigameID << gameWidth << gameHeight; }
 		void decode(Game &, BasicBuffer &buffer)  override { buffer >> minigameID >> gameWidth >> gameHeight; }
 
+#ifndef GAME3_HEADLESS
 		void handle(const std::shared_ptr<ClientGame> &) override;
+#endif
 	};
 }
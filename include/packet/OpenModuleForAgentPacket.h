@@ -20,6 +20,8 @@ namespace Game3 {
 		void encode(Game &, Buffer &buffer) const override { buffer << moduleID << agentGID << removeOnMove; }
 		void decode(Game &, BasicBuffer &buffer)  override { buffer >> moduleID >> agentGID >> removeOnMove; }
 
+#ifndef GAME3_HEADLESS
 		void handle(const std::shared_ptr<ClientGame> &) override;
+#endif
 	};
 }
@@ -21,6 +21,8 @@ namespace Game3 {
 		void encode(Game &, Buffer &buffer) const override { buffer << villageID << removeOnMove; }
 		void decode(Game &, BasicBuffer &buffer)  override { buffer >> villageID >> removeOnMove; }
 
+#ifndef GAME3_HEADLESS
 		void handle(const std::shared_ptr<ClientGame> &) override;
+#endif
 	};
 }
@@ -24,6 +24,8 @@ namespace Game3 {
 		void encode(Game &, Buffer &buffer) const override { buffer << soundID << soundOrigin << pitch << maximumDistance; }
 		void decode(Game &, BasicBuffer &buffer)  override { buffer >> soundID >> soundOrigin >> pitch >> maximumDistance; }
 
+#ifndef GAME3_HEADLESS
 		void handle(const std::shared_ptr<ClientGame> &) override;
+#endif
 	};
 }
@@ -21,6 +21,8 @@ namespace Game3 {
 		void encode(Game &, Buffer &buffer) const final { buffer << success; }
 		void decode(Game &, BasicBuffer &buffer)       final { buffer >> success; }
 
+#ifndef GAME3_HEADLESS
 		void handle(const std::shared_ptr<ClientGame> &) final;
+#endif
 	};
 }
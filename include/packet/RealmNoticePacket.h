@@ -26,6 +26,8 @@ namespace Game3 {
 		void encode(Game &, Buffer &buffer) const override { buffer << realmID << type << tileset << seed << outdoors; }
 		void decode(Game &, BasicBuffer &buffer)  override { buffer >> realmID >> type >> tileset >> seed >> outdoors; }
 
+#ifndef GAME3_HEADLESS
 		void handle(const std::shared_ptr<ClientGame> &) override;
+#endif
 	};
 }
@@ -3,7 +3,10 @@
 #include "types/Position.h"
 #include "net/Buffer.h"
 #include "packet/Packet.h"
+
+#ifndef GAME3_HEADLESS
 #include "ui/Modifiers.h"
+#endif
 
 namespace Game3 {
 	struct CraftingRecipeRegistry;
@@ -24,7 +27,9 @@ namespace Game3 {
 			void encode(Game &, Buffer &buffer) const override { buffer << recipeType << recipes; }
 			void decode(Game &, BasicBuffer &buffer)  override { buffer >> recipeType >> recipes; }
 
+#ifndef GAME3_HEADLESS
 			void handle(const std::shared_ptr<ClientGame> &) override;
+#endif
 
 		private:
 			static std::vector<boost::json::value> getRecipes(const CraftingRecipeRegistry &, const GamePtr &);
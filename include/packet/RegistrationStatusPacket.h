@@ -20,6 +20,8 @@ namespace Game3 {
 		void encode(Game &, Buffer &buffer) const override { buffer << username << displayName << token; }
 		void decode(Game &, BasicBuffer &buffer)  override { buffer >> username >> displayName >> token; }
 
+#ifndef GAME3_HEADLESS
 		void handle(const std::shared_ptr<ClientGame> &) override;
+#endif
 	};
 }
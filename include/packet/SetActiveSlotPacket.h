@@ -19,6 +19,8 @@ namespace Game3 {
 		void decode(Game &, BasicBuffer &buffer)       final { buffer >> slot; }
 
 		void handle(const std::shared_ptr<ServerGame> &, GenericClient &) final;
+#ifndef GAME3_HEADLESS
 		void handle(const std::shared_ptr<ClientGame> &) final;
+#endif
 	};
 }
@@ -4,7 +4,10 @@
 #include "net/Buffer.h"
 #include "packet/Packet.h"
 #include "pipes/ItemFilter.h"
+
+#ifndef GAME3_HEADLESS
 #include "ui/Modifiers.h"
+#endif
 
 namespace Game3 {
 	struct SetItemFiltersPacket: Packet {
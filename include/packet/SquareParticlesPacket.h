@@ -0,0 +1,36 @@
+#pragma once
+
+#include "graphics/Color.h"
+#include "math/Vector.h"
+#include "net/Buffer.h"
+#include "packet/Packet.h"
+#include "types/Position.h"
+
+#include <vector>
+
+namespace Game3 {
+	/** Tells a client to spawn a burst of cosmetic squares. Velocities and resting depths are rolled on the client. */
+	struct SquareParticlesPacket: Packet {
+		static PacketID ID() { return 76; }
+
+		RealmID realmID = -1;
+		Position origin;
+		Vector3 offset;
+		float size = 0.5;
+		float lingerTime = 1;
+		std::vector<Color> colors;
+
+		SquareParticlesPacket() = default;
+		SquareParticlesPacket(RealmID realm_id, Position origin, Vector3 offset, float size, float linger_time, std::vector<Color> colors):
+			realmID(realm_id), origin(origin), offset(offset), size(size), lingerTime(linger_time), colors(std::move(colors)) {}
+
+		PacketID getID() const override { return ID(); }
+
+		void encode(Game &, Buffer &buffer) const override { buffer << realmID << origin << offset << size << lingerTime << colors; }
+		void decode(Game &, BasicBuffer &buffer)  override { buffer >> realmID >> origin >> offset >> size >> lingerTime >> colors; }
+
+#ifndef GAME3_HEADLESS
+		void handle(const std::shared_ptr<ClientGame> &) override;
+#endif
+	};
+}
@@ -22,6 +22,8 @@ namespace Game3 {
 		void encode(Game &, Buffer &buffer) const final { buffer << globalID << map; }
 		void decode(Game &, BasicBuffer &buffer)       final { buffer >> globalID >> map; }
 
+#ifndef GAME3_HEADLESS
 		void handle(const std::shared_ptr<ClientGame> &) final;
+#endif
 	};
 }
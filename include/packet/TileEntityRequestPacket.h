@@ -5,7 +5,10 @@
 
 #include "game/Game.h"
 #include "packet/Packet.h"
+
+#ifndef GAME3_HEADLESS
 #include "ui/Modifiers.h"
+#endif
 
 // Sorry about the ugly duplication from EntityRequestPacket.
 
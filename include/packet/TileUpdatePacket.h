@@ -22,6 +22,8 @@ namespace Game3 {
 		void encode(Game &, Buffer &buffer) const override { buffer << realmID << layer << position << tileID; }
 		void decode(Game &, BasicBuffer &buffer)  override { buffer >> realmID >> layer >> position >> tileID; }
 
+#ifndef GAME3_HEADLESS
 		void handle(const std::shared_ptr<ClientGame> &) override;
+#endif
 	};
 }
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "types/Layer.h"
+#include "types/Position.h"
+#include "net/Buffer.h"
+#include "packet/Packet.h"
+
+#include <vector>
+
+namespace Game3 {
+	/** Carries every tile changed by a batched tile update that's visible to the receiving player. */
+	struct TileUpdatesPacket: Packet {
+		static PacketID ID() { return 75; }
+
+		RealmID realmID = -1;
+		std::vector<Layer> layers;
+		std::vector<Position> positions;
+		std::vector<TileID> tileIDs;
+
+		TileUpdatesPacket() = default;
+		TileUpdatesPacket(RealmID realm_id):
+			realmID(realm_id) {}
+
+		PacketID getID() const override { return ID(); }
+
+		void add(Layer layer, const Position &position, TileID tile_id) {
+			layers.push_back(layer);
+			positions.push_back(position);
+			tileIDs.push_back(tile_id);
+		}
+
+		inline bool empty() const { return positions.empty(); }
+
+		void encode(Game &, Buffer &buffer) const override { buffer << realmID << layers << positions << tileIDs; }
+		void decode(Game &, BasicBuffer &buffer)  override { buffer >> realmID >> layers >> positions >> tileIDs; }
+
+#ifndef GAME3_HEADLESS
+		void handle(const std::shared_ptr<ClientGame> &) override;
+#endif
+	};
+}
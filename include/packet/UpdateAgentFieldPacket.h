@@ -29,6 +29,8 @@ namespace Game3 {
 		void decode(Game &, BasicBuffer &)       override;
 
 		void handle(const std::shared_ptr<ServerGame> &, GenericClient &) override;
+#ifndef GAME3_HEADLESS
 		void handle(const std::shared_ptr<ClientGame> &) final;
+#endif
 	};
 }
@@ -29,6 +29,8 @@ namespace Game3 {
 		void encode(Game &, Buffer &buffer) const override { buffer << villageID << realmID << chunkPosition << position << name << labor << greed << resources; }
 		void decode(Game &, BasicBuffer &buffer)  override { buffer >> villageID >> realmID >> chunkPosition >> position >> name >> labor >> greed >> resources; }
 
+#ifndef GAME3_HEADLESS
 		void handle(const std::shared_ptr<ClientGame> &) override;
+#endif
 	};
 }
@@ -18,7 +18,9 @@ namespace Game3 {
 			RealmID parentRealm;
 			std::atomic_size_t entranceCount = 1;
 
+#ifndef GAME3_HEADLESS
 			void clearLighting(float) override;
+#endif
 			void onRemove() override;
 			void reveal(const Position &, bool force = false);
 			void generateChunk(const ChunkPosition &) override;
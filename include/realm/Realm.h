@@ -2,13 +2,17 @@
 
 #include "container/WeakSet.h"
 #include "entity/EntityZCompare.h"
+#include "entity/KinematicsStore.h"
+#include "entity/ParticleSystem.h"
 #include "error/MultipleFoundError.h"
 #include "error/NoneFoundError.h"
 #include "game/BiomeMap.h"
 #include "game/TileProvider.h"
 #include "game/Village.h"
+#ifndef GAME3_HEADLESS
 #include "graphics/ElementBufferedRenderer.h"
 #include "graphics/UpperRenderer.h"
+#endif
 #include "packet/ChunkTilesPacket.h"
 #include "packet/EntityPacket.h"
 #include "packet/RealmNoticePacket.h"
@@ -25,15 +29,21 @@
 
 #include <boost/json/fwd.hpp>
 
+#include <atomic>
+#include <chrono>
+#include <functional>
 #include <limits>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <optional>
 #include <random>
 #include <set>
+#include <span>
 #include <thread>
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
 
 namespace Game3 {
 	constexpr int64_t REALM_DIAMETER = 3;
@@ -69,7 +79,14 @@ namespace Game3 {
 			struct GenerationGuard {
 				std::shared_ptr<Realm> realm;
 				GenerationGuard(std::shared_ptr<Realm> realm_): realm(realm_) { ++realm->generationDepth; }
-				~GenerationGuard() { --realm->generationDepth; }
+				~GenerationGuard() { if (--realm->generationDepth == 0) ++realm->generationEpoch; }
+			};
+
+			struct TileBatchGuard {
+				std::shared_ptr<Realm> realm;
+				bool active;
+				TileBatchGuard(std::shared_ptr<Realm> realm_): realm(realm_), active(realm->beginTileBatch()) {}
+				~TileBatchGuard() { if (active) realm->endTileBatch(); }
 			};
 
 		public:
@@ -77,8 +94,13 @@ namespace Game3 {
 			RealmType type;
 			TileProvider tileProvider;
 			PipeLoader pipeLoader;
+			KinematicsStore kinematics;
+			/** Cosmetic particles. Only ever populated on the client. */
+			ParticleSystem particles;
+#ifndef GAME3_HEADLESS
 			std::optional<std::array<std::array<ElementBufferedRenderer, REALM_DIAMETER>, REALM_DIAMETER>> baseRenderers;
 			std::optional<std::array<std::array<UpperRenderer, REALM_DIAMETER>, REALM_DIAMETER>> upperRenderers;
+#endif
 			Lockable<std::unordered_map<Position, TileEntityPtr>, SharedRecursiveMutex> tileEntities;
 			Lockable<std::unordered_map<GlobalID, TileEntityPtr>> tileEntitiesByGID;
 			Lockable<std::unordered_set<EntityPtr>, SharedRecursiveMutex> entities;
@@ -91,6 +113,15 @@ namespace Game3 {
 			int64_t seed = 0;
 			Lockable<std::unordered_set<ChunkPosition>> generatedChunks;
 			Lockable<std::unordered_set<ChunkPosition>> visibleChunks;
+
+			struct PagingStats {
+				std::atomic_size_t pagedIn = 0;
+				std::atomic_size_t pagedOut = 0;
+				std::atomic_uint64_t totalPageInMicroseconds = 0;
+				std::atomic_uint64_t maxPageInMicroseconds = 0;
+			};
+
+			PagingStats pagingStats;
 			Lockable<std::unordered_set<ChunkPosition>> pathmapUpdateSet;
 
 			std::atomic_bool wakeupPending = false;
@@ -121,6 +152,7 @@ namespace Game3 {
 			virtual void onBlur();
 			/** Called when the realm is to be removed from the game. */
 			virtual void onRemove();
+#ifndef GAME3_HEADLESS
 			void createRenderers();
 			bool prerender();
 			void render(int width, int height, const std::pair<double, double> &center, float scale, const RendererContext &, float game_time);
@@ -128,6 +160,7 @@ namespace Game3 {
 			virtual void clearLighting(float game_time);
 			/** Reuploads fluids and terrain in all layers. */
 			void reupload();
+#endif
 			EntityPtr add(const EntityPtr &, const Position &);
 			TileEntityPtr add(const TileEntityPtr &);
 			void initEntities();
@@ -193,12 +226,37 @@ namespace Game3 {
 			EntityPtr getEntity(GlobalID);
 			TileEntityPtr getTileEntity(GlobalID);
 			Side getSide() const;
+#ifndef GAME3_HEADLESS
 			/** Client-side. */
 			std::set<ChunkPosition> getMissingChunks() const;
+#endif
 			void addPlayer(const PlayerPtr &);
 			void removePlayer(const PlayerPtr &);
 			void sendTo(GenericClient &);
 			void requestChunk(ChunkPosition, const std::shared_ptr<GenericClient> &);
+			/** Server-side. Reads a paged-out chunk back from the database. Returns whether the chunk was paged in. */
+			bool ensureResident(ChunkPosition);
+			/** Server-side. Writes a chunk to the database and drops its terrain from memory. Returns false if the chunk isn't resident. */
+			bool pageOut(ChunkPosition);
+			/** Server-side. Returns the resident chunks that could be paged out along with when a player last could see them.
+			 *  Chunks that are currently visible or contain entities or tile entities are left out, along with the chunks
+			 *  next to them. */
+			std::vector<std::pair<std::chrono::steady_clock::time_point, ChunkPosition>> getPageableChunks();
+			/** Server-side. Records that a chunk is only in the database so that ensureResident reads it when it's first needed. */
+			void markPagedOut(ChunkPosition);
+			bool isPagedOut(ChunkPosition) const;
+			/** Server-side. Increases every time a chunk is paged out. */
+			inline uint64_t getPageOutEpoch() const { return pageOutEpoch; }
+			/** Server-side. Calls the function unless the chunk has been paged out since the given page-out epoch, holding
+			 *  off page-outs while it runs. Returns whether the function was called. */
+			bool unlessPagedOutSince(ChunkPosition, uint64_t epoch, const std::function<void()> &);
+			/** Returns whether any entities or tile entities are in the chunk. These keep reading the terrain around them. */
+			bool holdsAgents(ChunkPosition);
+			size_t getPagedOutChunkCount() const;
+			/** Client-side. Returns the resident chunks outside the player's view along with when they were last in view. */
+			std::vector<std::pair<std::chrono::steady_clock::time_point, ChunkPosition>> getEvictableChunks();
+			/** Client-side. Drops a received chunk from memory. It's requested again once it's back in view. */
+			void evictChunk(ChunkPosition);
 			/** Removes an entity from entitiesByChunk. */
 			void detach(const EntityPtr &, ChunkPosition);
 			/** Removes an entity from entitiesByChunk based on the entity's current chunk position. */
@@ -214,12 +272,28 @@ namespace Game3 {
 			std::shared_ptr<Lockable<std::unordered_set<TileEntityPtr>>> getTileEntities(ChunkPosition);
 			void sendToMany(const std::unordered_set<std::shared_ptr<GenericClient>> &, ChunkPosition);
 			void sendToOne(GenericClient &, ChunkPosition);
+			/** Server-side. Returns a precompressed ChunkTilesPacket for a resident chunk, shared with every other client
+			 *  that asked for the chunk since it last changed. */
+			std::shared_ptr<ChunkTilesPacket> getChunkTilesPacket(ChunkPosition);
 			void recalculateVisibleChunks();
+#ifndef GAME3_HEADLESS
 			void queueReupload();
+#endif
 			void autotile(const Position &, Layer, TileUpdateContext = {});
+			/** Autotiles every tile of a chunk in one pass over a snapshot of the chunk and its border.
+			 *  Changed tiles are set without running the neighbor helper: autotiling only swaps a tile for another variant
+			 *  of itself, so neighbors' autotile results and walkability can't change as a result. */
+			void autotileChunk(ChunkPosition, Layer, TileUpdateContext = {});
+			/** Writes the autotiled ID of every tile in a chunk to a CHUNK_SIZE² array without changing anything.
+			 *  Tiles that don't autotile keep their current ID. */
+			void computeAutotiles(ChunkPosition, Layer, std::span<TileID> out) const;
+#ifndef GAME3_HEADLESS
 			/** Should be called in the UI thread. */
 			void remakeStaticLightingTexture(GameUI &);
 			void queueStaticLightingTexture();
+#endif
+			/** Takes a padded snapshot of a layer as produced by TileProvider::copyPaddedChunk. */
+			void computeAutotiles(std::span<const TileID> padded, std::span<TileID> out) const;
 			/** Server-side only. */
 			void playSound(const Position &, const Identifier &, float pitch = 1, uint16_t maximum_distance = 65535) const;
 			bool isChunkGenerated(ChunkPosition) const;
@@ -227,6 +301,10 @@ namespace Game3 {
 			inline const auto & getPlayers() const { return players; }
 			inline auto pauseUpdates() { return Pauser(shared_from_this()); }
 			inline auto guardGeneration() { return GenerationGuard(shared_from_this()); }
+			/** While the returned guard is alive, setTile calls made by this thread only record their changes.
+			 *  Pathmap updates, neighbor updates, autotiling and broadcasts then run once over the changed region
+			 *  when the outermost guard is destroyed. Does nothing on the client. */
+			inline auto batchTileUpdates() { return TileBatchGuard(shared_from_this()); }
 			inline bool isClient() const { return getSide() == Side::Client; }
 			inline bool isServer() const { return getSide() == Side::Server; }
 
@@ -237,7 +315,9 @@ namespace Game3 {
 			/** Generates additional chunks for the infinite map after the initial worldgen of the realm. */
 			virtual void generateChunk(const ChunkPosition &) {}
 			virtual bool canSpawnMonsters() const;
+#ifndef GAME3_HEADLESS
 			virtual std::unique_ptr<RealmRenderer> getRenderer();
+#endif
 
 			/** Full data doesn't include terrain, entities or tile entities. */
 			virtual void toJSON(boost::json::value &, bool full_data) const;
@@ -369,13 +449,50 @@ namespace Game3 {
 			ChunkPosition lastPlayerChunk{INT32_MIN, INT32_MIN};
 
 			Lockable<std::map<ChunkPosition, WeakSet<GenericClient>>> chunkRequests;
+			struct CachedChunkPacket {
+				uint64_t updateCounter = 0;
+				uint64_t generationEpoch = 0;
+				std::shared_ptr<ChunkTilesPacket> packet;
+			};
+			Lockable<std::unordered_map<ChunkPosition, CachedChunkPacket>> chunkPacketCache;
+			/** Incremented whenever a worldgen pass ends. Worldgen doesn't touch chunk update counters, so cached chunk
+			 *  packets built before the pass can't be trusted afterwards. */
+			std::atomic_uint64_t generationEpoch = 0;
+			/** The last time each resident chunk was visible to a player (or, on the client, to the client's player). */
+			Lockable<std::unordered_map<ChunkPosition, std::chrono::steady_clock::time_point>> chunkLastSeen;
+			/** Chunks that have been written to the database and dropped from memory. */
+			Lockable<std::unordered_set<ChunkPosition>> pagedOutChunks;
+			/** Mirrors pagedOutChunks.size() so that ensureResident can skip locking when nothing is paged out. */
+			std::atomic_size_t pagedOutCount = 0;
+			std::atomic_uint64_t pageOutEpoch = 0;
+			/** The page-out epoch at which each chunk was last paged out. Guarded by pagedOutChunks' lock. */
+			std::unordered_map<ChunkPosition, uint64_t> pageOutEpochs;
+
+			struct TileBatch {
+				/** The thread whose setTile calls are being collected. Other threads aren't affected by the batch. */
+				std::atomic<std::thread::id> owner;
+				size_t depth = 0;
+				/** Changed tiles whose neighbors still need updating, with the update context they were set with. */
+				std::map<std::pair<Layer, Position>, TileUpdateContext> pendingUpdates;
+				/** Changed tiles yet to be broadcast. */
+				std::map<std::pair<Layer, Position>, TileID> pendingBroadcasts;
+			};
+
+			TileBatch tileBatch;
 
 			SharedRecursiveMutex tileEntityMutex;
 
+#ifndef GAME3_HEADLESS
 			void initRendererRealms();
 			void initRendererTileProviders();
+#endif
 			bool isWalkable(Index row, Index column, const Tileset &);
 			void setLayerHelper(Index row, Index col, Layer, TileUpdateContext = {});
+			/** Returns false if another thread is already batching tile updates for this realm. */
+			bool beginTileBatch();
+			void endTileBatch();
+			bool isBatchingTiles() const;
+			void flushTileBatch();
 			ChunkPackets getChunkPackets(ChunkPosition);
 			void initEntity(const EntityPtr &, const Position &);
 			bool isActive() const;
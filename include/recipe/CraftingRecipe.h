@@ -8,6 +8,9 @@
 
 #include <boost/json/fwd.hpp>
 
+#include <unordered_map>
+#include <vector>
+
 namespace Game3 {
 	struct CraftingRecipe: Recipe<std::vector<CraftingRequirement>, std::vector<ItemStackPtr>> {
 		Input input;
@@ -35,5 +38,22 @@ namespace Game3 {
 	struct CraftingRecipeRegistry: UnnamedJSONRegistry<CraftingRecipe> {
 		static Identifier ID() { return {"base", "registry/crafting_recipe"}; }
 		CraftingRecipeRegistry(): UnnamedJSONRegistry(ID()) {}
+
+		void onAdd(const CraftingRecipe &) override;
+		void clear() override;
+
+		/** Returns all recipes that output the given item. */
+		const std::vector<CraftingRecipePtr> & getByOutput(const ItemID &) const;
+		/** Returns all recipes that take the given item as an explicit ingredient. */
+		const std::vector<CraftingRecipePtr> & getByIngredient(const ItemID &) const;
+		/** Returns all recipes with an attribute requirement for the given attribute. */
+		const std::vector<CraftingRecipePtr> & getByAttribute(const Identifier &) const;
+
+		inline const auto & getOutputIndex() const { return byOutput; }
+
+		private:
+			std::unordered_map<ItemID, std::vector<CraftingRecipePtr>> byOutput;
+			std::unordered_map<ItemID, std::vector<CraftingRecipePtr>> byIngredient;
+			std::unordered_map<Identifier, std::vector<CraftingRecipePtr>> byAttribute;
 	};
 }
@@ -315,7 +315,8 @@ namespace Game3 {
 				return byCounter.at(counter);
 			}
 
-			inline void clear() {
+			/** Virtual so that subclasses with their own indices (like CraftingRecipeRegistry) clear them too. */
+			virtual void clear() {
 				items.clear();
 				byCounter.clear();
 				nextCounter = 0;
@@ -0,0 +1,118 @@
+#pragma once
+
+#ifdef GAME3_ENABLE_SCRIPTING
+#include "threading/Lockable.h"
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-parameter"
+#include <v8.h>
+#pragma GCC diagnostic pop
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+namespace Game3 {
+	/** A V8 isolate that can host the contexts of several script engines, along with the templates those contexts share. */
+	class ScriptIsolate {
+		public:
+			using TemplateBuilder = std::function<v8::Local<v8::FunctionTemplate>(v8::Isolate *)>;
+
+			/** Limits on a single script run. */
+			struct Budget {
+				std::chrono::milliseconds cpu{50};
+				size_t heapBytes = 16 << 20;
+			};
+
+			/** Enforces a budget for as long as it lives. Must be constructed while the isolate is locked and entered.
+			 *  Guards constructed while another guard is active defer to the outer one. */
+			class Guard {
+				public:
+					Guard(ScriptIsolate &, Budget);
+					~Guard();
+
+					Guard(const Guard &) = delete;
+					Guard(Guard &&) = delete;
+					Guard & operator=(const Guard &) = delete;
+					Guard & operator=(Guard &&) = delete;
+
+					/** Returns a description of the budget that was exceeded, or nullptr if the run has stayed within it. */
+					const char * exceeded() const;
+
+				private:
+					ScriptIsolate &host;
+					Budget budget;
+					Guard *outer = nullptr;
+					std::chrono::steady_clock::time_point deadline;
+					size_t heapBaseline = 0;
+					std::atomic<const char *> reason = nullptr;
+
+				friend class IsolatePool;
+				friend class ScriptIsolate;
+			};
+
+			~ScriptIsolate();
+
+			ScriptIsolate(const ScriptIsolate &) = delete;
+			ScriptIsolate & operator=(const ScriptIsolate &) = delete;
+
+			inline v8::Isolate * get() const { return isolate; }
+			inline size_t getContextCount() const { return contextCount; }
+
+			/** Returns the template registered under the given name, building it the first time it's asked for. The caller
+			 *  must hold a v8::Locker for the isolate and have a handle scope open; the builder is called under both. */
+			v8::Local<v8::FunctionTemplate> getTemplate(const std::string &name, const TemplateBuilder &builder);
+
+			/** Creates an isolate with an optional heap limit in bytes. Isolates made here aren't shared through the pool. */
+			static std::shared_ptr<ScriptIsolate> create(size_t heap_limit = 0);
+
+		private:
+			v8::Isolate *isolate = nullptr;
+			std::atomic_size_t contextCount = 0;
+			/** Protected by the isolate's v8::Locker. */
+			std::map<std::string, v8::Global<v8::FunctionTemplate>> templates;
+			/** The outermost guard of the run in progress. Only touched by the thread holding the isolate's v8::Locker. */
+			Guard *activeGuard = nullptr;
+
+			explicit ScriptIsolate(v8::Isolate *);
+
+			static void gcEpilogue(v8::Isolate *, v8::GCType, v8::GCCallbackFlags, void *data);
+			static size_t nearHeapLimit(void *data, size_t current_limit, size_t initial_limit);
+
+		friend class ScriptEngine;
+	};
+
+	/** Hands out shared isolates so that every computer in a world doesn't pay for a whole V8 heap of its own, and runs
+	 *  the watchdog that terminates scripts that overrun their CPU budget. */
+	class IsolatePool {
+		public:
+			/** Once every isolate hosts this many contexts, the pool creates another isolate (up to MAX_ISOLATES). */
+			constexpr static size_t CONTEXTS_PER_ISOLATE = 32;
+			constexpr static size_t MAX_ISOLATES = 4;
+			constexpr static size_t ISOLATE_HEAP_LIMIT = 256 << 20;
+			constexpr static std::chrono::milliseconds WATCHDOG_PERIOD{5};
+
+			static IsolatePool & get();
+
+			/** Returns the least loaded isolate in the pool, creating one if all of them are full. */
+			std::shared_ptr<ScriptIsolate> acquire();
+
+		private:
+			Lockable<std::vector<std::weak_ptr<ScriptIsolate>>> isolates;
+			Lockable<std::unordered_set<ScriptIsolate::Guard *>> guards;
+			std::jthread watchdog;
+
+			IsolatePool();
+
+			void watch(std::stop_token);
+
+		friend class ScriptIsolate::Guard;
+	};
+}
+#endif
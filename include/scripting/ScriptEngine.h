@@ -1,6 +1,8 @@
 #pragma once
 
 #ifdef GAME3_ENABLE_SCRIPTING
+#include "scripting/IsolatePool.h"
+
 #include <boost/json/fwd.hpp>
 
 #pragma GCC diagnostic push
@@ -42,6 +44,8 @@ namespace Game3 {
 
 		public:
 			std::weak_ptr<Game> game;
+			/** Limits applied to each script run. Engines without a budget let scripts run for as long as they like. */
+			std::optional<ScriptIsolate::Budget> budget;
 			std::function<void(std::string_view)> onPrint = [](std::string_view text) { std::cout << text << '\n'; };
 
 			struct Value;
@@ -59,6 +63,8 @@ namespace Game3 {
 			ScriptEngine(std::shared_ptr<Game>);
 			ScriptEngine(std::shared_ptr<Game>, FunctionAdder);
 			ScriptEngine(std::shared_ptr<Game>, GlobalMutator);
+			/** Creates a context of its own inside a shared isolate, such as one acquired from the IsolatePool. */
+			ScriptEngine(std::shared_ptr<Game>, std::shared_ptr<ScriptIsolate>, GlobalMutator);
 
 			~ScriptEngine();
 
@@ -84,6 +90,10 @@ namespace Game3 {
 
 			void addToBuffer(Buffer &, v8::Local<v8::Value> type_value, std::span<v8::Local<v8::Value>> values, bool in_container = false);
 
+			/** Associates an object with this engine's context so that callbacks in shared templates can find it. */
+			void setOwner(void *);
+
+			inline ScriptIsolate & getHost() const { return *host; }
 			inline v8::Isolate * getIsolate() const { return isolate; }
 			inline v8::Local<v8::Context> getContext() const { return globalContext.Get(isolate); }
 			inline v8::Local<v8::FunctionTemplate> getBufferTemplate() const { return bufferTemplate.Get(isolate); }
@@ -91,6 +101,15 @@ namespace Game3 {
 			static void init(const char *argv0);
 			static void deinit();
 
+			/** Returns the engine that created the given context. */
+			static ScriptEngine & fromContext(v8::Local<v8::Context>);
+
+			/** Returns the object passed to setOwner on the engine that created the given context. */
+			template <typename T>
+			static T * getOwner(v8::Local<v8::Context> context) {
+				return static_cast<T *>(context->GetAlignedPointerFromEmbedderData(OWNER_INDEX));
+			}
+
 		private:
 			struct TypeDescription {
 				std::string name;
@@ -98,7 +117,12 @@ namespace Game3 {
 				v8::Local<v8::Value> secondary;
 			};
 
+			constexpr static int ENGINE_INDEX = 1;
+			constexpr static int OWNER_INDEX = 2;
+
+			std::shared_ptr<ScriptIsolate> host;
 			v8::Isolate *isolate = nullptr;
+			void *owner = nullptr;
 			v8::Global<v8::FunctionTemplate> bufferTemplate;
 			v8::Global<v8::Context> globalContext;
 
@@ -106,7 +130,7 @@ namespace Game3 {
 			v8::Global<v8::Context> makeContext(GlobalMutator = {});
 			v8::Global<v8::Context> makeContext(FunctionAdder);
 
-			v8::Global<v8::FunctionTemplate> makeBufferTemplate();
+			v8::Global<v8::FunctionTemplate> shareBufferTemplate();
 
 			void addToBuffer(Buffer &, const TypeDescription &, std::span<v8::Local<v8::Value>> values, bool in_container = false);
 			TypeDescription describeType(v8::Local<v8::Value>);
@@ -116,8 +140,11 @@ namespace Game3 {
 			static std::unique_ptr<v8::Platform> platform;
 			static v8::Isolate::CreateParams createParams;
 
-			static v8::Isolate * makeIsolate();
+			static v8::Isolate * makeIsolate(size_t heap_limit = 0);
 			static const char * toCString(const v8::String::Utf8Value &);
+			static v8::Local<v8::FunctionTemplate> makeBufferTemplate(v8::Isolate *);
+
+		friend class ScriptIsolate;
 	};
 }
 #endif
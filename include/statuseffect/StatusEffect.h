@@ -38,7 +38,9 @@ namespace Game3 {
 
 			virtual std::unique_ptr<StatusEffect> copy() const = 0;
 
+#ifndef GAME3_HEADLESS
 			virtual std::shared_ptr<Texture> getTexture(const std::shared_ptr<ClientGame> &);
+#endif
 
 		protected:
 			StatusEffect(Identifier identifier);
@@ -7,7 +7,9 @@ namespace Game3 {
 		public:
 			TexturedStatusEffect(Identifier identifier, Identifier itemID);
 
+#ifndef GAME3_HEADLESS
 			std::shared_ptr<Texture> getTexture(const std::shared_ptr<ClientGame> &) override;
+#endif
 
 		private:
 			Identifier itemID;
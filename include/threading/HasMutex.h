@@ -2,6 +2,13 @@
 
 #include "threading/Lockable.h"
 
+#ifdef GAME3_LOCK_PROFILING
+#include "util/Demangle.h"
+
+#include <string>
+#include <typeinfo>
+#endif
+
 #include <mutex>
 #include <shared_mutex>
 
@@ -12,7 +19,17 @@ namespace Game3 {
 		protected:
 			mutable M internalMutex;
 
+#ifdef GAME3_LOCK_PROFILING
+			HasMutex() {
+				// HasMutex locks don't pass through Lockable, so group them by the owning type instead.
+				if constexpr (std::same_as<M, SharedRecursiveMutex>) {
+					static const std::string name = DEMANGLE(T);
+					internalMutex.setName(name);
+				}
+			}
+#else
 			HasMutex() = default;
+#endif
 
 		public:
 			virtual ~HasMutex() = default;
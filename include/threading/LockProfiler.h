@@ -0,0 +1,74 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <optional>
+#include <source_location>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Game3 {
+	/** Counts lock acquisitions and measures how long threads wait for locks and hold them, grouped into sites: either
+	 *  the source location that took the lock or a name given to the mutex. The locking primitives only report to it
+	 *  when built with the lock_profiling meson option, which defines GAME3_LOCK_PROFILING. */
+	class LockProfiler {
+		public:
+			struct Site {
+				std::string name;
+				std::atomic<uint64_t> acquisitions{0};
+				std::atomic<uint64_t> contended{0};
+				std::atomic<uint64_t> waitNanos{0};
+				std::atomic<uint64_t> maxWaitNanos{0};
+				std::atomic<uint64_t> holds{0};
+				std::atomic<uint64_t> holdNanos{0};
+				std::atomic<uint64_t> maxHoldNanos{0};
+
+				Site(std::string name);
+
+				/** Counts are weighted by the sample interval so that they estimate the true totals while sampling. */
+				void recordAcquisition(bool was_contended, uint64_t wait_nanos);
+				void recordHold(uint64_t hold_nanos);
+			};
+
+			struct Entry {
+				std::string name;
+				uint64_t acquisitions;
+				uint64_t contended;
+				uint64_t waitNanos;
+				uint64_t maxWaitNanos;
+				uint64_t holds;
+				uint64_t holdNanos;
+				uint64_t maxHoldNanos;
+			};
+
+			/** Sites are never destroyed, so the references stay valid for the life of the program. */
+			static Site & getSite(const std::source_location &);
+			static Site & getSite(std::string_view name);
+
+			/** Makes the next lock or shared lock taken on this thread count toward the given site. A null site means
+			 *  the caller has already decided not to sample the acquisition. */
+			static void setNextSite(Site *);
+			/** Returns and clears the site set by setNextSite, or returns std::nullopt if none was set. */
+			static std::optional<Site *> takeNextSite();
+
+			/** With an interval of 1, every acquisition is measured. With an interval of n, only every nth acquisition
+			 *  on each thread is, which keeps the clock reads and site lookups off most lock operations. */
+			static void setSampleInterval(uint32_t);
+			static uint32_t getSampleInterval();
+			/** Returns whether the current acquisition on this thread should be measured. */
+			static bool shouldSample();
+
+			/** Returns every site, sorted by total wait time in descending order. */
+			static std::vector<Entry> snapshot();
+			/** Formats the sites with the longest total waits as a table. */
+			static std::string report(size_t limit = 20);
+			static void reset();
+
+			/** Returns a monotonic timestamp in nanoseconds. */
+			static uint64_t now();
+
+		private:
+			static std::atomic<uint32_t> sampleInterval;
+	};
+}
@@ -6,6 +6,7 @@
 #include <concepts>
 #include <mutex>
 #include <shared_mutex>
+#include <source_location>
 
 #include <boost/json.hpp>
 
@@ -65,8 +66,8 @@ namespace Game3 {
 			return *this;
 		}
 
-		inline auto uniqueLock() const { return std::unique_lock(mutex); }
-		inline auto sharedLock() const { return std::shared_lock(mutex); }
+		inline auto uniqueLock(std::source_location location = std::source_location::current()) const { profile(location); return std::unique_lock(mutex); }
+		inline auto sharedLock(std::source_location location = std::source_location::current()) const { profile(location); return std::shared_lock(mutex); }
 		inline auto tryUniqueLock() const { return std::unique_lock(mutex, std::try_to_lock); }
 		inline auto trySharedLock() const { return std::shared_lock(mutex, std::try_to_lock); }
 
@@ -81,50 +82,59 @@ namespace Game3 {
 
 		template <typename Fn>
 		requires std::invocable<Fn>
-		decltype(auto) withShared(Fn &&function) const {
-			auto lock = sharedLock();
+		decltype(auto) withShared(Fn &&function, std::source_location location = std::source_location::current()) const {
+			auto lock = sharedLock(location);
 			return function();
 		}
 
 		template <typename Fn>
 		requires std::invocable<Fn, const T &>
-		decltype(auto) withShared(Fn &&function) const {
-			auto lock = sharedLock();
+		decltype(auto) withShared(Fn &&function, std::source_location location = std::source_location::current()) const {
+			auto lock = sharedLock(location);
 			return function(getBase());
 		}
 
 		template <typename Fn>
 		requires (std::invocable<Fn, T &> && !std::invocable<Fn, const T &>)
-		decltype(auto) withShared(Fn &&function) {
-			auto lock = sharedLock();
+		decltype(auto) withShared(Fn &&function, std::source_location location = std::source_location::current()) {
+			auto lock = sharedLock(location);
 			return function(getBase());
 		}
 
 		template <typename Fn>
 		requires std::invocable<Fn>
-		decltype(auto) withUnique(Fn &&function) const {
-			auto lock = uniqueLock();
+		decltype(auto) withUnique(Fn &&function, std::source_location location = std::source_location::current()) const {
+			auto lock = uniqueLock(location);
 			return function();
 		}
 
 		template <typename Fn>
 		requires std::invocable<Fn, const T &>
-		decltype(auto) withUnique(Fn &&function) const {
-			auto lock = uniqueLock();
+		decltype(auto) withUnique(Fn &&function, std::source_location location = std::source_location::current()) const {
+			auto lock = uniqueLock(location);
 			return function(getBase());
 		}
 
 		template <typename Fn>
 		requires (std::invocable<Fn, T &> && !std::invocable<Fn, const T &>)
-		decltype(auto) withUnique(Fn &&function) {
-			auto lock = uniqueLock();
+		decltype(auto) withUnique(Fn &&function, std::source_location location = std::source_location::current()) {
+			auto lock = uniqueLock(location);
 			return function(getBase());
 		}
 
-		inline T copyBase() const {
-			auto lock = sharedLock();
+		inline T copyBase(std::source_location location = std::source_location::current()) const {
+			auto lock = sharedLock(location);
 			return static_cast<T>(*this);
 		}
+
+		/** Attributes the lock about to be taken to the caller's source location in lock profiling builds. */
+		static inline void profile([[maybe_unused]] const std::source_location &location) {
+#ifdef GAME3_LOCK_PROFILING
+			if constexpr (std::same_as<M, SharedRecursiveMutex>) {
+				LockProfiler::setNextSite(LockProfiler::shouldSample()? &LockProfiler::getSite(location) : nullptr);
+			}
+#endif
+		}
 	};
 
 	template <typename T, typename M>
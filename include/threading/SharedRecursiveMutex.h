@@ -1,10 +1,17 @@
 #pragma once
 
+#include "config.h"
+
 #include <atomic>
 #include <mutex>
 #include <shared_mutex>
+#include <string_view>
 #include <thread>
 
+#ifdef GAME3_LOCK_PROFILING
+#include "threading/LockProfiler.h"
+#endif
+
 namespace Game3 {
 	// https://stackoverflow.com/a/36624355
 	class SharedRecursiveMutex: private std::shared_mutex, private std::recursive_mutex {
@@ -16,8 +23,22 @@ namespace Game3 {
 			bool try_lock_shared();
 			bool try_lock();
 
+			/** When lock profiling is enabled, locks taken without a call site (through std::unique_lock directly, for
+			 *  instance) are reported under this name instead of being lumped together. */
+			void setName(std::string_view);
+
 		private:
 			std::atomic<std::thread::id> owner;
 			std::atomic_int count;
+
+#ifdef GAME3_LOCK_PROFILING
+			LockProfiler::Site *namedSite = nullptr;
+			/** Only touched by the thread holding the lock exclusively. */
+			LockProfiler::Site *holdSite = nullptr;
+			uint64_t acquiredAt = 0;
+
+			/** Returns the site to report the current acquisition to, or nullptr if it isn't being sampled. */
+			LockProfiler::Site * pickSite() const;
+#endif
 	};
 }
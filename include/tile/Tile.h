@@ -32,7 +32,9 @@ namespace Game3 {
 			/** Should be between 0 and 1 (inclusive). */
 			virtual float getMonsterSpawnProbability() const;
 
+#ifndef GAME3_HEADLESS
 			virtual void renderStaticLighting(const Place &, Layer, const RendererContext &);
+#endif
 
 			/** Returns true iff renderStaticLighting actually does anything. */
 			virtual bool hasStaticLighting() const;
@@ -9,7 +9,9 @@ namespace Game3 {
 
 			TorchTile();
 
+#ifndef GAME3_HEADLESS
 			void renderStaticLighting(const Place &, Layer, const RendererContext &) override;
+#endif
 
 			bool hasStaticLighting() const override { return true; }
 	};
@@ -13,8 +13,10 @@ namespace Game3 {
 			std::string getName() const override { return "Arcade Machine"; }
 
 			bool onInteractNextTo(const std::shared_ptr<Player> &, Modifiers, const ItemStackPtr &, Hand) override;
+#ifndef GAME3_HEADLESS
 			bool mouseOver() final;
 			void mouseOut() final;
+#endif
 
 			void encode(Game &, Buffer &) override;
 			void decode(Game &, BasicBuffer &) override;
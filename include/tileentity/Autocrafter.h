@@ -1,5 +1,6 @@
 #pragma once
 
+#include "threading/Atomic.h"
 #include "threading/Lockable.h"
 #include "threading/LockableSharedPtr.h"
 #include "tileentity/EnergeticTileEntity.h"
@@ -28,8 +29,10 @@ namespace Game3 {
 			void tick(const TickArgs &) override;
 			bool onInteractNextTo(const std::shared_ptr<Player> &, Modifiers, const ItemStackPtr &, Hand) override;
 
+#ifndef GAME3_HEADLESS
 			void render(SpriteRenderer &) override;
 			void renderUpper(SpriteRenderer &) override;
+#endif
 
 			void toJSON(boost::json::value &) const override;
 			void absorbJSON(const std::shared_ptr<Game> &, const boost::json::value &) override;
@@ -50,6 +53,8 @@ namespace Game3 {
 			Lockable<Identifier> target;
 			Lockable<std::shared_ptr<Inventory>> stationInventory;
 			Lockable<Identifier> station;
+			/** The inventory revision at which no cached recipe could be crafted. Crafting isn't retried until the revision changes. */
+			Atomic<uint64_t> idleRevision = -1;
 			TileID cachedArmLower = -1;
 			TileID cachedArmUpper = -1;
 			LockableSharedPtr<Texture> stationTexture;
@@ -62,7 +67,8 @@ namespace Game3 {
 			Autocrafter(Identifier tile_id, Position);
 			Autocrafter(Position);
 
-			void autocraft();
+			/** Returns whether anything was crafted. */
+			bool autocraft();
 			void cacheRecipes();
 			bool stationSet();
 			void setStationTexture(const ItemStackPtr &);
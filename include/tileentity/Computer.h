@@ -33,7 +33,6 @@ namespace Game3 {
 
 		private:
 			std::unique_ptr<ScriptEngine> engine;
-			v8::Global<v8::FunctionTemplate> tileEntityTemplate;
 			Lockable<std::multimap<std::string, v8::Global<v8::Function>>> listeners;
 
 			Computer() = default;
@@ -43,7 +42,10 @@ namespace Game3 {
 			/** Attempts to find a tile entity connected to the computer via a data cable. */
 			TileEntityPtr searchFor(GlobalID);
 
-			v8::Global<v8::FunctionTemplate> makeTileEntityTemplate(v8::Isolate *);
+			/** Requires the engine's isolate to be locked and a handle scope to be open. */
+			v8::Local<v8::FunctionTemplate> getTileEntityTemplate();
+
+			static v8::Local<v8::FunctionTemplate> makeTileEntityTemplate(v8::Isolate *);
 
 		friend class TileEntity;
 	};
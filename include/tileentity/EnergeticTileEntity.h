@@ -35,8 +35,18 @@ namespace Game3 {
 			std::shared_ptr<SetTileEntityEnergyPacket> makeEnergyPacket() const;
 
 		protected:
+			/** Energy updates won't wake this tile entity until it holds at least this much energy. */
+			Atomic<EnergyAmount> wakeEnergy = 0;
+
 			void broadcast(const std::shared_ptr<SetTileEntityEnergyPacket> &);
 			using HasEnergy::addEnergy;
 			using HasEnergy::getEnergy;
+
+			/** Sleeps until the stored energy reaches the given threshold. */
+			template <Duration D>
+			void sleepUntilEnergy(EnergyAmount threshold, D period) {
+				wakeEnergy = threshold;
+				sleepUntil(WakeCondition::Energy, period);
+			}
 	};
 }
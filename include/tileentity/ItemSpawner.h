@@ -17,7 +17,9 @@ namespace Game3 {
 			void toJSON(boost::json::value &) const override;
 			void absorbJSON(const std::shared_ptr<Game> &, const boost::json::value &) override;
 			void tick(const TickArgs &) override;
+#ifndef GAME3_HEADLESS
 			void render(SpriteRenderer &) override;
+#endif
 
 			void encode(Game &, Buffer &) override;
 			void decode(Game &, BasicBuffer &) override;
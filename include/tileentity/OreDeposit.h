@@ -31,7 +31,9 @@ namespace Game3 {
 			void absorbJSON(const std::shared_ptr<Game> &, const boost::json::value &) override;
 			void tick(const TickArgs &) override;
 			bool onInteractNextTo(const std::shared_ptr<Player> &, Modifiers, const ItemStackPtr &, Hand) override;
+#ifndef GAME3_HEADLESS
 			void render(SpriteRenderer &) override;
+#endif
 			const Ore & getOre(const Game &) const;
 
 			void encode(Game &, Buffer &) override;
@@ -90,7 +90,9 @@ namespace Game3 {
 			std::shared_ptr<Pipe> getConnected(Substance, Direction) const;
 
 			void tick(const TickArgs &) override;
+#ifndef GAME3_HEADLESS
 			void render(SpriteRenderer &) override;
+#endif
 			void onNeighborUpdated(Position offset) override;
 
 			inline auto & getDirections() { return directions; }
@@ -7,6 +7,7 @@
 #include "types/Position.h"
 #include "types/TickArgs.h"
 #include "types/Types.h"
+#include "types/WakeCondition.h"
 #include "ui/Modifiers.h"
 
 #include <boost/json.hpp>
@@ -58,12 +59,15 @@ namespace Game3 {
 			/** Called after the tile entity is loaded from disk. */
 			virtual void onLoad() {}
 			virtual void onRemove();
-			virtual void onNeighborUpdated(Position /* offset */) {}
+			/** Overrides should call this to wake tile entities sleeping on neighbor updates. */
+			virtual void onNeighborUpdated(Position offset);
 			/** Returns the TileEntity ID. This is not the tile ID, which corresponds to a tile in the tileset. */
 			inline Identifier getID() const { return tileEntityID; }
+#ifndef GAME3_HEADLESS
 			virtual void render(SpriteRenderer &);
 			virtual void renderUpper(SpriteRenderer &);
 			virtual void renderLighting(const RendererContext &);
+#endif
 			/** Handles when an entity steps on this tile entity's position. */
 			virtual void onOverlap(const EntityPtr &);
 			/** Handles when an entity stops being on this tile entity's position.
@@ -91,6 +95,11 @@ namespace Game3 {
 			void setTileID(Identifier);
 			void resetTileCache();
 
+			/** If the tile entity is sleeping on any of the given conditions, enqueues a tick and returns true.
+			 *  Safe to call from any thread. */
+			bool wake(WakeCondition = WakeCondition::Any);
+			bool isSleeping() const;
+
 			void handleMessage(const std::shared_ptr<Agent> &source, const std::string &name, std::any &) override;
 
 			virtual void encode(Game &, Buffer &);
@@ -147,13 +156,33 @@ namespace Game3 {
 			Tick enqueueTick(std::chrono::nanoseconds);
 			Tick enqueueTick() override;
 
+			/** To be called from tick() instead of enqueueTick(period) when there's nothing to do.
+			 *  No further ticks will happen until one of the given conditions is signaled via wake(). */
+			template <Duration D>
+			requires (!std::is_same_v<D, std::chrono::nanoseconds>)
+			void sleepUntil(WakeCondition conditions, D period) {
+				sleepUntil(conditions, std::chrono::duration_cast<std::chrono::nanoseconds>(period));
+			}
+
+			void sleepUntil(WakeCondition, std::chrono::nanoseconds period);
+
 			virtual void absorbJSON(const std::shared_ptr<Game> &, const boost::json::value &);
 
 			friend void tag_invoke(boost::json::value_from_tag, boost::json::value &, const TileEntity &);
 
 		private:
+			/** Nonzero while sleeping. */
+			Atomic<uint8_t> sleepConditions = 0;
+			/** Conditions signaled since the start of the current tick. Keeps a signal that arrives
+			 *  between a failed check in tick() and the call to sleepUntil() from being lost. */
+			Atomic<uint8_t> pendingWakes = 0;
+			Atomic<Tick> sleepTick = 0;
+			Atomic<Tick> sleepPeriod = 0;
+
 			bool spawnIn(const Place &);
 
+		friend class Realm;
+
 		public:
 			struct Ticker {
 				TileEntity &parent;
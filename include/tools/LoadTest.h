@@ -0,0 +1,12 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace Game3 {
+	/** Runs an in-process server with a number of headless bots and prints one JSON object of metrics per second (TPS,
+	 *  tick time percentiles, bytes sent per player, resident memory) to stdout. Arguments:
+	 *  `<bots> <scenario> [seconds] [transport]`, where the scenario is one of walk, explore, mine, pipes, chat or mixed
+	 *  and the transport is direct (in memory, the default) or tls (the server's socket over loopback). */
+	int loadTest(const std::vector<std::string> &args);
+}
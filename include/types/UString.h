@@ -33,7 +33,9 @@ namespace Game3 {
 			operator UStringSpan() const;
 
 			std::vector<UStringSpan> split(const UString &delimiter, Glib::ustring::size_type(UString::*finder)(const Glib::ustring &, Glib::ustring::size_type) const = &Glib::ustring::find) const;
+#ifndef GAME3_HEADLESS
 			UString wrap(const TextRenderer &, float max_width, float text_scale) const;
+#endif
 
 			UStringSpan span(size_t pos, size_t n = npos);
 
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Game3 {
+	/** Signals that a sleeping tile entity can wait on. Combine with `|`. */
+	enum class WakeCondition: uint8_t {
+		None      = 0,
+		Inventory = 1 << 0,
+		Energy    = 1 << 1,
+		Fluids    = 1 << 2,
+		Neighbor  = 1 << 3,
+		Any       = Inventory | Energy | Fluids | Neighbor,
+	};
+
+	constexpr inline WakeCondition operator|(WakeCondition lhs, WakeCondition rhs) {
+		return static_cast<WakeCondition>(static_cast<uint8_t>(lhs) | static_cast<uint8_t>(rhs));
+	}
+}
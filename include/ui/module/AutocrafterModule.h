@@ -2,6 +2,7 @@
 
 #include "types/Types.h"
 #include "ui/module/Module.h"
+#include "ui/module/ModuleIDs.h"
 
 #include <any>
 #include <memory>
@@ -14,7 +15,7 @@ namespace Game3 {
 
 	class AutocrafterModule: public Module {
 		public:
-			static Identifier ID() { return {"base", "module/autocrafter"}; }
+			static Identifier ID() { return ModuleID::autocrafter(); }
 
 			AutocrafterModule(UIContext &, float selfScale, const ClientGamePtr &, const std::any &);
 			AutocrafterModule(UIContext &, float selfScale, const ClientGamePtr &, std::shared_ptr<Autocrafter>);
@@ -2,6 +2,7 @@
 
 #include "types/Types.h"
 #include "ui/module/Module.h"
+#include "ui/module/ModuleIDs.h"
 
 #include <any>
 #include <memory>
@@ -16,7 +17,7 @@ namespace Game3 {
 
 	class ChemicalReactorModule: public Module {
 		public:
-			static Identifier ID() { return {"base", "module/chemical_reactor"}; }
+			static Identifier ID() { return ModuleID::chemicalReactor(); }
 
 			ChemicalReactorModule(UIContext &, float selfScale, const ClientGamePtr &, const std::any &);
 			ChemicalReactorModule(UIContext &, float selfScale, const ClientGamePtr &, std::shared_ptr<ChemicalReactor>);
@@ -2,6 +2,7 @@
 
 #include "types/Types.h"
 #include "ui/module/Module.h"
+#include "ui/module/ModuleIDs.h"
 #include "ui/module/MultiModule.h"
 
 namespace Game3 {
@@ -11,7 +12,7 @@ namespace Game3 {
 
 	class CombinerModule: public Module {
 		public:
-			static Identifier ID() { return {"base", "module/combiner"}; }
+			static Identifier ID() { return ModuleID::combiner(); }
 
 			CombinerModule(UIContext &, float selfScale, const ClientGamePtr &, const std::any &);
 			CombinerModule(UIContext &, float selfScale, const ClientGamePtr &, std::shared_ptr<Combiner>);
@@ -2,6 +2,7 @@
 
 #include "types/Types.h"
 #include "ui/module/Module.h"
+#include "ui/module/ModuleIDs.h"
 
 #include <any>
 #include <memory>
@@ -17,7 +18,7 @@ namespace Game3 {
 			EnergyModule(UIContext &, float selfScale, const std::shared_ptr<ClientGame> &, const std::any &, bool show_header = true);
 			EnergyModule(UIContext &, float selfScale, const AgentPtr &, bool show_header = true);
 
-			static Identifier ID() { return {"base", "module/energy_level"}; }
+			static Identifier ID() { return ModuleID::energy(); }
 
 			Identifier getID() const final { return ID(); }
 			void init() final;
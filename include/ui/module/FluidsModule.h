@@ -2,6 +2,7 @@
 
 #include "types/Types.h"
 #include "ui/module/Module.h"
+#include "ui/module/ModuleIDs.h"
 
 #include <any>
 #include <map>
@@ -22,7 +23,7 @@ namespace Game3 {
 			FluidsModule(UIContext &, float selfScale, const AgentPtr &, bool show_header = true);
 			FluidsModule(UIContext &, float selfScale, std::shared_ptr<HasFluids>, bool show_header = true);
 
-			static Identifier ID() { return {"base", "module/fluid_levels"}; }
+			static Identifier ID() { return ModuleID::fluids(); }
 
 			Identifier getID() const final { return ID(); }
 			void init() final;
@@ -3,6 +3,7 @@
 #include "game/InventoryGetter.h"
 #include "types/Types.h"
 #include "ui/module/Module.h"
+#include "ui/module/ModuleIDs.h"
 #include "ui/widget/ItemSlot.h"
 
 #include <any>
@@ -24,7 +25,7 @@ namespace Game3 {
 			InventoryModule(UIContext &, float selfScale, const std::shared_ptr<ClientGame> &, const std::any &);
 			InventoryModule(UIContext &, float selfScale, const std::shared_ptr<ClientInventory> &);
 
-			static Identifier ID() { return {"base", "module/inventory"}; }
+			static Identifier ID() { return ModuleID::inventory(); }
 
 			Identifier getID() const final { return ID(); }
 			void init() final;
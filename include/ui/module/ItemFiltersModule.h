@@ -4,6 +4,7 @@
 #include "types/DirectedPlace.h"
 #include "types/Types.h"
 #include "ui/module/Module.h"
+#include "ui/module/ModuleIDs.h"
 
 #include <any>
 #include <memory>
@@ -25,7 +26,7 @@ namespace Game3 {
 			ItemFiltersModule(UIContext &, float selfScale, const std::shared_ptr<ClientGame> &, const std::any &);
 			ItemFiltersModule(UIContext &, float selfScale, const std::shared_ptr<ClientGame> &, const DirectedPlace &);
 
-			static Identifier ID() { return {"base", "module/item_filters"}; }
+			static Identifier ID() { return ModuleID::itemFilters(); }
 
 			Identifier getID() const final { return ID(); }
 			void init() final;
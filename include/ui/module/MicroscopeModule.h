@@ -7,6 +7,7 @@
 #include "ui/module/InventoryModule.h"
 #include "ui/module/MicroscopeModule.h"
 #include "ui/module/Module.h"
+#include "ui/module/ModuleIDs.h"
 #include "ui/module/MultiModule.h"
 #include "ui/widget/Box.h"
 #include "ui/widget/Label.h"
@@ -26,7 +27,7 @@ namespace Game3 {
 			using Submodule = MultiModule<Substance::Item, ExtraSubstances...>;
 
 		public:
-			static Identifier ID() { return {"base", std::format("module/microscope/{}{}", S, Submodule::getSuffix())}; }
+			static Identifier ID() { return ModuleID::microscope<S, ExtraSubstances...>(); }
 
 			MicroscopeModule(UIContext &ui, float selfScale, const ClientGamePtr &game, const std::any &argument):
 				MicroscopeModule(ui, selfScale, game, std::dynamic_pointer_cast<InventoriedTileEntity>(std::any_cast<AgentPtr>(argument))) {}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "data/Identifier.h"
+#include "types/Types.h"
+
+#include <format>
+#include <map>
+#include <string>
+
+namespace Game3 {
+	/** Identifiers of the UI modules. These live apart from the modules themselves so that the server can tell clients which module to open
+	 *  without compiling any UI code. */
+	namespace ModuleID {
+		inline Identifier autocrafter()     { return {"base", "module/autocrafter"};      }
+		inline Identifier chemicalReactor() { return {"base", "module/chemical_reactor"}; }
+		inline Identifier combiner()        { return {"base", "module/combiner"};         }
+		inline Identifier energy()          { return {"base", "module/energy_level"};     }
+		inline Identifier fluids()          { return {"base", "module/fluid_levels"};     }
+		inline Identifier inventory()       { return {"base", "module/inventory"};        }
+		inline Identifier itemFilters()     { return {"base", "module/item_filters"};     }
+		inline Identifier mutator()         { return {"base", "module/mutator"};          }
+		inline Identifier radiusMachine()   { return {"base", "module/radius_machine"};   }
+		inline Identifier villageTrade()    { return {"base", "module/village_trade"};    }
+
+		template <Substance... S>
+		std::string multiSuffix() {
+			const static std::map<Substance, char> substances{
+				{Substance::Item,   'i'},
+				{Substance::Fluid,  'f'},
+				{Substance::Energy, 'e'},
+			};
+
+			std::string suffix;
+			for (Substance substance: {S...}) {
+				suffix += substances.at(substance);
+			}
+
+			return suffix;
+		}
+
+		template <Substance... S>
+		Identifier multi() {
+			return {"base", "module/multi/" + multiSuffix<S...>()};
+		}
+
+		template <Slot S, Substance... ExtraSubstances>
+		Identifier microscope() {
+			return {"base", std::format("module/microscope/{}{}", S, multiSuffix<Substance::Item, ExtraSubstances...>())};
+		}
+	}
+}
@@ -9,12 +9,12 @@
 #include "ui/module/FluidsModule.h"
 #include "ui/module/InventoryModule.h"
 #include "ui/module/Module.h"
+#include "ui/module/ModuleIDs.h"
 #include "ui/widget/Box.h"
 #include "ui/UIContext.h"
 #include "util/Cast.h"
 
 #include <any>
-#include <map>
 #include <string>
 
 namespace Game3 {
@@ -22,22 +22,11 @@ namespace Game3 {
 	class MultiModule: public Module {
 		public:
 			static Identifier ID() {
-				return {"base", "module/multi/" + getSuffix()};
+				return ModuleID::multi<S...>();
 			}
 
 			static std::string getSuffix() {
-				const static std::map<Substance, char> substances{
-					{Substance::Item,   'i'},
-					{Substance::Fluid,  'f'},
-					{Substance::Energy, 'e'},
-				};
-
-				std::string suffix;
-				for (Substance substance: {S...}) {
-					suffix += substances.at(substance);
-				}
-
-				return suffix;
+				return ModuleID::multiSuffix<S...>();
 			}
 
 			MultiModule(UIContext &ui, float selfScale, const ClientGamePtr &game, const std::any &argument):
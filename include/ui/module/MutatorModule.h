@@ -2,6 +2,7 @@
 
 #include "types/Types.h"
 #include "ui/module/Module.h"
+#include "ui/module/ModuleIDs.h"
 
 #include <any>
 #include <memory>
@@ -21,7 +22,7 @@ namespace Game3 {
 			MutatorModule(UIContext &, float selfScale, const ClientGamePtr &, const std::any &);
 			MutatorModule(UIContext &, float selfScale, const ClientGamePtr &, std::shared_ptr<Mutator>);
 
-			static Identifier ID() { return {"base", "module/mutator"}; }
+			static Identifier ID() { return ModuleID::mutator(); }
 
 			Identifier getID() const final { return ID(); }
 			void init() final;
@@ -3,6 +3,7 @@
 #include "mixin/HasRadius.h"
 #include "types/Types.h"
 #include "ui/module/Module.h"
+#include "ui/module/ModuleIDs.h"
 
 namespace Game3 {
 	class EnergyModule;
@@ -11,7 +12,7 @@ namespace Game3 {
 
 	class RadiusMachineModule: public Module {
 		public:
-			static Identifier ID() { return {"base", "module/radius_machine"}; }
+			static Identifier ID() { return ModuleID::radiusMachine(); }
 
 			RadiusMachineModule(UIContext &, float selfScale, const ClientGamePtr &, const std::any &);
 			RadiusMachineModule(UIContext &, float selfScale, const ClientGamePtr &, TileEntityPtr);
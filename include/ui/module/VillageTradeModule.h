@@ -1,6 +1,7 @@
 #pragma once
 
 #include "ui/module/Module.h"
+#include "ui/module/ModuleIDs.h"
 #include "ui/widget/Box.h"
 
 namespace Game3 {
@@ -38,7 +39,7 @@ namespace Game3 {
 
 	class VillageTradeModule: public Module {
 		public:
-			static Identifier ID() { return {"base", "module/village_trade"}; }
+			static Identifier ID() { return ModuleID::villageTrade(); }
 
 			VillageTradeModule(UIContext &, float selfScale, const std::shared_ptr<ClientGame> &, const std::any &);
 
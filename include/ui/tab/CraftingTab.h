@@ -3,9 +3,13 @@
 #include "ui/tab/Tab.h"
 #include "ui/widget/Box.h"
 
+#include <cstdint>
 #include <memory>
+#include <optional>
+#include <vector>
 
 namespace Game3 {
+	class CraftingSlider;
 	class CraftingTab;
 	class InventoryModule;
 	struct CraftingRecipe;
@@ -16,8 +20,11 @@ namespace Game3 {
 
 			void init() final;
 
+			inline const auto & getSlider() const { return slider; }
+
 		private:
 			std::shared_ptr<CraftingRecipe> recipe;
+			std::shared_ptr<CraftingSlider> slider;
 	};
 
 	class CraftingTab: public Tab {
@@ -39,5 +46,10 @@ namespace Game3 {
 			std::shared_ptr<Box> hbox;
 			std::shared_ptr<InventoryModule> inventoryModule;
 			std::shared_ptr<Box> recipeList;
+			std::vector<std::shared_ptr<RecipeRow>> recipeRows;
+			/** The player inventory's revision when the rows' craftable counts were last computed. */
+			std::optional<uint64_t> inventoryRevision;
+
+			void updateCraftable();
 	};
 }
@@ -5,6 +5,7 @@
 #include <memory>
 
 namespace Game3 {
+	class Button;
 	class IntegerInput;
 	class Slider;
 	struct CraftingRecipe;
@@ -15,15 +16,24 @@ namespace Game3 {
 
 			void init() final;
 
+			/** Recomputes how many times the player's inventory can craft the recipe. Called by CraftingTab only when the
+			 *  inventory's revision changes, so craftability isn't recounted every frame. */
+			void updateMaximum();
+
 		private:
 			std::shared_ptr<CraftingRecipe> recipe;
 			std::shared_ptr<IntegerInput> valueInput;
 			std::shared_ptr<Slider> valueSlider;
+			std::shared_ptr<Button> maxButton;
 			std::size_t value = 1;
+			std::size_t maximum = 1;
 
 			void setValue(std::size_t);
 			void increment(ssize_t delta);
 			void craft();
+			void computeMaximum();
 			std::size_t getMaximum() const;
+
+			static constexpr std::size_t DEFAULT_MAXIMUM = 64;
 	};
 }
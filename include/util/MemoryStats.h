@@ -0,0 +1,77 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <boost/json.hpp>
+
+namespace Game3 {
+	enum class MemorySubsystem: uint8_t {Chunks, Entities, TileEntities, Inventories, ItemData, Network};
+
+	/** Approximate heap usage broken down by subsystem. Network buffers are counted as bytes are queued and sent; the
+	 *  rest are measured by ServerGame::measureMemory walking the game state, since adding hooks to every entity, tile
+	 *  entity and inventory subclass would cost more than the occasional walk. Like NetStats, every counter is a relaxed
+	 *  atomic, so recording is cheap enough to do on every queued message. */
+	class MemoryStats {
+		public:
+			constexpr static size_t SUBSYSTEM_COUNT = 6;
+			/** A rough allowance for the allocator bookkeeping and links that come with each node of a set or map. */
+			constexpr static size_t NODE_OVERHEAD = 4 * sizeof(void *);
+
+			struct Row {
+				MemorySubsystem subsystem{};
+				uint64_t bytes = 0;
+				uint64_t peakBytes = 0;
+				/** Zero means there's no budget. */
+				uint64_t budgetBytes = 0;
+			};
+
+			MemoryStats() = default;
+
+			MemoryStats(const MemoryStats &) = delete;
+			MemoryStats & operator=(const MemoryStats &) = delete;
+
+			void add(MemorySubsystem, size_t bytes);
+			void subtract(MemorySubsystem, size_t bytes);
+			/** Replaces a subsystem's total with a fresh measurement. */
+			void set(MemorySubsystem, size_t bytes);
+			uint64_t get(MemorySubsystem) const;
+
+			void setBudget(MemorySubsystem, size_t bytes);
+			/** Returns a warning for each subsystem that has gone over its budget since the last check. A subsystem has to
+			 *  drop back under its budget before it can be warned about again. */
+			std::vector<std::string> checkBudgets();
+
+			std::vector<Row> snapshot() const;
+			/** Returns one line per subsystem followed by a line of totals. */
+			std::string summarize() const;
+			void resetPeaks();
+
+			/** Server-wide totals. */
+			static MemoryStats & global();
+
+			static std::string_view getName(MemorySubsystem);
+			static std::optional<MemorySubsystem> parseSubsystem(std::string_view);
+
+			/** Estimates the heap bytes owned by a JSON value, not counting the value itself. */
+			static size_t estimate(const boost::json::value &);
+
+		private:
+			struct Counters {
+				std::atomic_uint64_t bytes = 0;
+				std::atomic_uint64_t peakBytes = 0;
+				std::atomic_uint64_t budgetBytes = 0;
+				std::atomic_bool overBudget = false;
+			};
+
+			std::array<Counters, SUBSYSTEM_COUNT> counters;
+
+			Counters & operator[](MemorySubsystem);
+			const Counters & operator[](MemorySubsystem) const;
+	};
+}
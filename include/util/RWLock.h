@@ -5,14 +5,16 @@
 #include <condition_variable>
 #include <mutex>
 #include <shared_mutex>
+#include <source_location>
 #include <thread>
 
 namespace Game3 {
 	class RWLock {
 		public:
-			std::shared_lock<std::shared_timed_mutex> lockRead();
+			/** The source locations are used only for lock profiling. */
+			std::shared_lock<std::shared_timed_mutex> lockRead(std::source_location = std::source_location::current());
 			/** If the writer has been waiting for at least `patience`, new read lock attempts will block until after the writer has acquired and released the lock. */
-			std::unique_lock<std::shared_timed_mutex> lockWrite(std::chrono::milliseconds patience);
+			std::unique_lock<std::shared_timed_mutex> lockWrite(std::chrono::milliseconds patience, std::source_location = std::source_location::current());
 
 		private:
 			std::atomic_bool blockReaders {false};
@@ -0,0 +1,18 @@
+#version 330 core
+
+layout (location = 0) in vec4 vertex;
+layout (location = 1) in vec4 instanceRect;  // x, y, width, height in tiles
+layout (location = 2) in vec4 instanceColor;
+
+out vec4 rectColor;
+
+uniform mat4 projection;
+uniform float positionScale;
+uniform vec2 mapOrigin;
+uniform float sizeScale;
+
+void main() {
+	vec2 corner = instanceRect.xy * positionScale + mapOrigin;
+	rectColor = instanceColor;
+	gl_Position = projection * vec4(corner + vertex.xy * instanceRect.zw * sizeScale, 0.0, 1.0);
+}
@@ -3,10 +3,10 @@
 #version 330 core
 
 in vec2 TexCoords;
+in vec4 textColor;
 out vec4 color;
 
 uniform sampler2D text;
-uniform vec4 textColor;
 
 void main() {
 	vec4 sampled = vec4(1.0, 1.0, 1.0, texture(text, TexCoords).r);
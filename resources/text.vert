@@ -3,11 +3,15 @@
 #version 330 core
 
 layout (location = 0) in vec4 vertex; // <vec2 pos, vec2 tex>
+layout (location = 1) in vec4 inColor;
 out vec2 TexCoords;
+out vec4 textColor;
 
 uniform mat4 projection;
+uniform vec2 atlasSize;
 
 void main() {
-	TexCoords = vertex.zw;
+	TexCoords = vertex.zw / atlasSize;
+	textColor = inColor;
 	gl_Position = projection * vec4(vertex.xy, 0.0, 1.0);
 }
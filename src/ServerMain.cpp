@@ -0,0 +1,74 @@
+#include "config.h"
+
+#ifdef GAME3_HEADLESS
+#include "util/Log.h"
+#include "data/DBBackup.h"
+#include "net/CertGen.h"
+#include "net/Server.h"
+#include "scripting/ScriptEngine.h"
+#include "threading/ThreadContext.h"
+#include "util/Crypto.h"
+#include "util/Defer.h"
+#include "util/FS.h"
+#include "util/Timer.h"
+
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/** Entry point of game3-server, which is built without any of the client's windowing, UI, audio or OpenGL code.
+ *  Usage: game3-server [port] [world path], or --gen-cert / --token <username> / --restore like the full binary. */
+int main(int argc, char **argv) {
+	using namespace Game3;
+
+	threadContext.rename("Main");
+
+#ifdef GAME3_ENABLE_SCRIPTING
+	ScriptEngine::init(argv[0]);
+	Defer v8_deinit(ScriptEngine::deinit);
+#endif
+
+	if (2 <= argc) {
+		const std::string_view arg1{argv[1]};
+
+		if (arg1 == "--gen-cert") {
+			generateCertPair("private.crt", "private.key");
+			return 0;
+		}
+
+		if (arg1 == "--restore") {
+			if (argc < 4) {
+				std::cerr << "Usage: " << argv[0] << " --restore <new world path> <full backup> [incremental backups...]\n";
+				return 1;
+			}
+
+			const std::vector<std::filesystem::path> archives(argv + 3, argv + argc);
+			const DBBackup::Stats stats = DBBackup::restore(argv[2], archives);
+			SUCCESS("Restored {} records and {} erasures into {}.", stats.written, stats.erased, argv[2]);
+			return 0;
+		}
+
+		if (arg1 == "--token" && argc == 3) {
+			if (!std::filesystem::exists(".secret")) {
+				std::cerr << "Can't find .secret\n";
+				return 1;
+			}
+
+			const std::string secret = readFile(".secret");
+			std::cout << computeSHA3_512<Token>(secret + '/' + argv[2]) << '\n';
+			return 0;
+		}
+	}
+
+	// Server::main expects the arguments to follow the full binary's -s flag.
+	std::string server_flag = "-s";
+	std::vector<char *> server_argv{argv[0], server_flag.data()};
+	server_argv.insert(server_argv.end(), argv + 1, argv + argc);
+
+	const auto out = Server::main(static_cast<int>(server_argv.size()), server_argv.data());
+	Timer::summary();
+	return out;
+}
+#endif
@@ -4,6 +4,7 @@
 
 #include <algorithm>
 #include <queue>
+#include <unordered_map>
 #include <vector>
 
 namespace Game3 {
@@ -32,11 +33,34 @@ namespace Game3 {
 			return std::abs(a.row - b.row) + std::abs(a.column - b.column);
 		}
 
-		inline void getNeighbors(const std::shared_ptr<Realm> &realm, const Position &position, std::vector<Position> &next) {
+		/** Holds on to pathmap rows for the duration of a search so that each row is fetched from the
+		 *  tile provider once and the tiles in it are tested as bits of a single word afterwards.
+		 *  Rows in paged-out chunks are paged back in rather than treated as unwalkable. */
+		class PathRowCache {
+			public:
+				explicit PathRowCache(Realm &realm_):
+					realm(realm_) {}
+
+				bool isWalkable(const Position &position) {
+					const Position key{position.row, TileProvider::divide<Index>(position.column)};
+					auto [iter, inserted] = rows.try_emplace(key, 0);
+					if (inserted) {
+						realm.ensureResident(position.getChunk());
+						iter->second = realm.tileProvider.copyPathRow(position).value_or(0);
+					}
+					return (iter->second >> TileProvider::remainder(position.column)) & 1;
+				}
+
+			private:
+				Realm &realm;
+				std::unordered_map<Position, uint64_t> rows;
+		};
+
+		inline void getNeighbors(const std::shared_ptr<Realm> &realm, PathRowCache &cache, const Position &position, std::vector<Position> &next) {
 			next.clear();
 
 			auto check = [&](const Position &pos) {
-				if (auto state = realm->tileProvider.copyPathState(pos); state && *state != 0 && !realm->hasFluid(pos)) {
+				if (cache.isWalkable(pos) && !realm->hasFluid(pos)) {
 					next.emplace_back(pos);
 				}
 			};
@@ -61,6 +85,8 @@ namespace Game3 {
 		std::vector<Position> next_positions;
 		next_positions.reserve(4);
 
+		PathRowCache path_rows(*realm);
+
 		for (size_t loops = 0; loops < loop_max && !frontier.empty(); ++loops) {
 			Position current = frontier.get();
 			if (current == goal) {
@@ -78,7 +104,7 @@ namespace Game3 {
 				return true;
 			}
 
-			getNeighbors(realm, current, next_positions);
+			getNeighbors(realm, path_rows, current, next_positions);
 
 			for (const Position &next: next_positions) {
 				const auto new_cost = costs[current] + 1;
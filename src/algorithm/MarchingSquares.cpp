@@ -1,6 +1,7 @@
 #include "algorithm/MarchingSquares.h"
 
 #include <array>
+#include <cassert>
 #include <unordered_map>
 #include <unordered_set>
 
@@ -42,4 +43,51 @@ namespace Game3 {
 		const uint8_t bottom = get( 1,  0)? 8 : 0;
 		return top | left | right | bottom;
 	}
+
+	void march8Chunk(std::span<const uint8_t> padded, std::span<uint8_t> out) {
+		assert(padded.size() == static_cast<size_t>(PADDED_CHUNK_SIZE * PADDED_CHUNK_SIZE));
+		assert(out.size() == static_cast<size_t>(CHUNK_SIZE * CHUNK_SIZE));
+
+		for (int64_t row = 0; row < CHUNK_SIZE; ++row) {
+			const uint8_t *above = &padded[row * PADDED_CHUNK_SIZE + 1];
+			const uint8_t *middle = above + PADDED_CHUNK_SIZE;
+			const uint8_t *below = middle + PADDED_CHUNK_SIZE;
+			uint8_t *out_row = &out[row * CHUNK_SIZE];
+
+			for (int64_t column = 0; column < CHUNK_SIZE; ++column) {
+				const uint8_t center = middle[column] != 0;
+				const uint8_t top    = above[column] != 0;
+				const uint8_t left   = middle[column - 1] != 0;
+				const uint8_t right  = middle[column + 1] != 0;
+				const uint8_t bottom = below[column] != 0;
+				// Corners only count when both of the edges next to them do.
+				const uint8_t top_left     = (above[column - 1] != 0) & top & left;
+				const uint8_t top_right    = (above[column + 1] != 0) & top & right;
+				const uint8_t bottom_left  = (below[column - 1] != 0) & bottom & left;
+				const uint8_t bottom_right = (below[column + 1] != 0) & bottom & right;
+				const int sum = top_left | (top << 1) | (top_right << 2) | (left << 3) | (right << 4) | (bottom_left << 5) | (bottom << 6) | (bottom_right << 7);
+				out_row[column] = static_cast<uint8_t>(marchingArray8[center? sum : 0]);
+			}
+		}
+	}
+
+	void march4Chunk(std::span<const uint8_t> padded, std::span<uint8_t> out) {
+		assert(padded.size() == static_cast<size_t>(PADDED_CHUNK_SIZE * PADDED_CHUNK_SIZE));
+		assert(out.size() == static_cast<size_t>(CHUNK_SIZE * CHUNK_SIZE));
+
+		for (int64_t row = 0; row < CHUNK_SIZE; ++row) {
+			const uint8_t *above = &padded[row * PADDED_CHUNK_SIZE + 1];
+			const uint8_t *middle = above + PADDED_CHUNK_SIZE;
+			const uint8_t *below = middle + PADDED_CHUNK_SIZE;
+			uint8_t *out_row = &out[row * CHUNK_SIZE];
+
+			for (int64_t column = 0; column < CHUNK_SIZE; ++column) {
+				out_row[column] = static_cast<uint8_t>(
+					(above[column] != 0) |
+					((middle[column - 1] != 0) << 1) |
+					((middle[column + 1] != 0) << 2) |
+					((below[column] != 0) << 3));
+			}
+		}
+	}
 }
@@ -4,15 +4,39 @@
 #include "game/Inventory.h"
 #include "item/Item.h"
 
+#include <array>
 #include <cmath>
 
 namespace Game3 {
 	namespace {
 		constexpr double E = 2.71828182845904523536;
+		constexpr size_t SCARCITY_TABLE_SIZE = 8192;
+		constexpr size_t MONEY_TABLE_SIZE = 8192;
+
+		/** Bulk quotes evaluate the same exponentials for consecutive counts over and over. These tables hold them for
+		 *  small arguments, computed with exactly the expressions below so a lookup gives the same bits as the call. */
+		template <size_t N>
+		std::array<double, N> makeDivisorTable(double scale) {
+			std::array<double, N> table;
+			for (size_t i = 0; i < N; ++i) {
+				table[i] = pow(E, uint64_t(i) / scale);
+			}
+			return table;
+		}
+
+		inline double scarcityDivisor(ItemCount item_count) {
+			static const std::array<double, SCARCITY_TABLE_SIZE> table = makeDivisorTable<SCARCITY_TABLE_SIZE>(100.);
+			return item_count < SCARCITY_TABLE_SIZE? table[item_count] : pow(E, item_count / 100.);
+		}
+
+		inline double moneyDivisor(MoneyCount merchant_money) {
+			static const std::array<double, MONEY_TABLE_SIZE> table = makeDivisorTable<MONEY_TABLE_SIZE>(50.);
+			return merchant_money < MONEY_TABLE_SIZE? table[merchant_money] : pow(E, merchant_money / 50.);
+		}
 	}
 
 	bool isSellable(const ItemStackPtr &stack) {
-		return stack->data.is_null();
+		return stack->data.isNull();
 	}
 
 	double buyPriceToSellPrice(double buy_price, double greed) {
@@ -23,11 +47,11 @@ namespace Game3 {
 		if (merchant_money == MoneyCount(-1)) {
 			return base_price;
 		}
-		return base_price / pow(E, merchant_money / 50.);
+		return base_price / moneyDivisor(merchant_money);
 	}
 
 	double applyScarcity(double base_price, ItemCount item_count) {
-		return base_price / pow(E, item_count / 100.);
+		return base_price / scarcityDivisor(item_count);
 	}
 
 	double buyPrice(double base_price, ItemCount item_count, MoneyCount merchant_money) {
@@ -0,0 +1,123 @@
+#include "game/ClientGame.h"
+#include "game/ServerInventory.h"
+#include "item/Item.h"
+#include "threading/ThreadContext.h"
+#include "util/Timer.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <utility>
+
+// This file is built into its own executable (see the item_benchmark option) so that it can replace the global
+// allocation functions without counting allocations in the game itself.
+
+namespace {
+	std::atomic_size_t allocationCount{0};
+
+	void * countedAllocate(std::size_t size) {
+		allocationCount.fetch_add(1, std::memory_order_relaxed);
+
+		if (void *pointer = std::malloc(size == 0? 1 : size)) {
+			return pointer;
+		}
+
+		throw std::bad_alloc();
+	}
+}
+
+void * operator new(std::size_t size) {
+	return countedAllocate(size);
+}
+
+void * operator new[](std::size_t size) {
+	return countedAllocate(size);
+}
+
+void operator delete(void *pointer) noexcept {
+	std::free(pointer);
+}
+
+void operator delete[](void *pointer) noexcept {
+	std::free(pointer);
+}
+
+void operator delete(void *pointer, std::size_t) noexcept {
+	std::free(pointer);
+}
+
+void operator delete[](void *pointer, std::size_t) noexcept {
+	std::free(pointer);
+}
+
+namespace Game3 {
+	namespace {
+		constexpr Slot SLOT_COUNT = 30;
+		constexpr size_t TRANSFER_COUNT = 1'000'000;
+
+		/** Moves stacks back and forth between two inventories the way ItemNetwork does: take the first stack out of the
+		 *  source (all of it or a pipe-sized portion of it) and add it to the destination. */
+		size_t shuttle(InventoryPtr source, InventoryPtr destination, ItemCount max) {
+			size_t moved = 0;
+
+			for (size_t i = 0; i < TRANSFER_COUNT; ++i) {
+				Slot slot = -1;
+				ItemStackPtr stack = source->firstItem(&slot);
+				if (!stack) {
+					// Everything has arrived, so send it all back.
+					std::swap(source, destination);
+					continue;
+				}
+
+				if (stack->count <= max) {
+					source->erase(slot);
+				} else {
+					stack->count -= max;
+					stack = stack->withCount(max);
+				}
+
+				if (ItemStackPtr leftover = destination->add(stack)) {
+					source->add(leftover, slot);
+				} else {
+					++moved;
+				}
+			}
+
+			return moved;
+		}
+
+		/** Measures the time and the allocations that item transfers cost for plain stacks and stacks with data. */
+		void itemTransferBenchmark() {
+			auto game = Game::create(Side::Client, nullptr);
+
+			auto run = [&](const char *name, const ItemStackPtr &prototype, ItemCount max) {
+				InventoryPtr source = std::make_shared<ServerInventory>(nullptr, SLOT_COUNT);
+				InventoryPtr destination = std::make_shared<ServerInventory>(nullptr, SLOT_COUNT);
+
+				for (Slot slot = 0; slot < SLOT_COUNT / 2; ++slot) {
+					source->add(prototype->copy(), slot);
+				}
+
+				Timer timer{name};
+				const size_t allocations_before = allocationCount.load(std::memory_order_relaxed);
+				const size_t moved = shuttle(source, destination, max);
+				const size_t allocations = allocationCount.load(std::memory_order_relaxed) - allocations_before;
+				const auto elapsed = timer.difference();
+				std::cout << name << ": " << moved << " transfers, " << elapsed.count() / double(TRANSFER_COUNT) << " ns and "
+				          << allocations / double(TRANSFER_COUNT) << " allocations per attempt\n";
+			};
+
+			run("WholePlainStacks", ItemStack::create(game, "base:item/stone", 64), 64);
+			run("PartialPlainStacks", ItemStack::create(game, "base:item/stone", 64), 1);
+			run("WholeStacksWithData", ItemStack::withDurability(game, "base:item/iron_pickaxe"), 1);
+
+			Timer::summary();
+		}
+	}
+}
+
+int main() {
+	Game3::threadContext.rename("Main");
+	Game3::itemTransferBenchmark();
+}
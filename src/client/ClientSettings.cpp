@@ -62,6 +62,7 @@ namespace Game3 {
 		get("uiScale", &ClientSettings::uiScale);
 		get("dragThreshold", &ClientSettings::dragThreshold);
 		get("lastWorldPath", &ClientSettings::lastWorldPath);
+		get("chunkCacheMegabytes", &ClientSettings::chunkCacheMegabytes);
 
 		return out;
 	}
@@ -85,5 +86,6 @@ namespace Game3 {
 		object["uiScale"] = settings.uiScale;
 		object["dragThreshold"] = settings.dragThreshold;
 		object["lastWorldPath"] = settings.lastWorldPath;
+		object["chunkCacheMegabytes"] = settings.chunkCacheMegabytes;
 	}
 }
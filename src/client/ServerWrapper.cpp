@@ -209,9 +209,7 @@ namespace Game3 {
 
 					if (running && (forceSave.exchange(false) || save_period <= std::chrono::system_clock::now() - last_save)) {
 						INFO(2, "Saving...");
-						game->tickingPaused = true;
 						game->getDatabase().writeAll();
-						game->tickingPaused = false;
 						INFO(2, "Saved.");
 						last_save = std::chrono::system_clock::now();
 					}
@@ -1,8 +1,11 @@
 #include "command/local/ChemicalCommand.h"
-#include "game/ClientGame.h"
 #include "lib/JSON.h"
 #include "net/LocalClient.h"
 
+#ifndef GAME3_HEADLESS
+#include "game/ClientGame.h"
+#endif
+
 namespace Game3 {
 	void ChemicalCommand::operator()(LocalClient &client) {
 		if (pieces.size() != 2 && pieces.size() != 3) {
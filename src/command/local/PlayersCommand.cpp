@@ -1,11 +1,14 @@
 #include "util/Log.h"
 #include "command/local/PlayersCommand.h"
-#include "entity/ClientPlayer.h"
-#include "game/ClientGame.h"
 #include "net/LocalClient.h"
 #include "packet/LoginPacket.h"
 #include "util/Util.h"
 
+#ifndef GAME3_HEADLESS
+#include "entity/ClientPlayer.h"
+#include "game/ClientGame.h"
+#endif
+
 namespace Game3 {
 	void PlayersCommand::operator()(LocalClient &client) {
 		auto game = client.weakGame.lock();
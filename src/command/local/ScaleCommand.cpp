@@ -1,9 +1,12 @@
 #include "command/local/ScaleCommand.h"
-#include "game/ClientGame.h"
 #include "net/LocalClient.h"
-#include "ui/Window.h"
 #include "util/Util.h"
 
+#ifndef GAME3_HEADLESS
+#include "game/ClientGame.h"
+#include "ui/Window.h"
+#endif
+
 namespace Game3 {
 	void ScaleCommand::operator()(LocalClient &client) {
 		if (pieces.size() < 2) {
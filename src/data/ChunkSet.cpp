@@ -1,6 +1,7 @@
 #include "data/ChunkSet.h"
 #include "fluid/Fluid.h"
 #include "util/Log.h"
+#include "util/Util.h"
 
 #include <bit>
 #include <cstddef>
@@ -83,9 +84,39 @@ namespace Game3 {
 			assert(fluids.size() == CHUNK_SIZE * CHUNK_SIZE);
 		}
 
-		static_assert(sizeof(decltype(pathmap)::value_type) == 1);
-		pathmap.resize(CHUNK_SIZE * CHUNK_SIZE);
-		std::memcpy(pathmap.data(), pathmap_.data(), PATHMAP_BYTE_COUNT);
+		pathmap = packPathChunk(pathmap_.first(PATHMAP_BYTE_COUNT));
+	}
+
+	std::string ChunkSet::getRawTerrain() const {
+		std::string raw;
+		raw.reserve(LAYER_COUNT * LAYER_BYTE_COUNT);
+		for (const TileChunk &chunk: terrain) {
+			auto lock = chunk.sharedLock();
+			appendSpan(raw, std::span(chunk));
+		}
+		return raw;
+	}
+
+	std::string ChunkSet::getRawBiomes() const {
+		std::string raw;
+		raw.reserve(BIOMES_BYTE_COUNT);
+		auto lock = biomes.sharedLock();
+		appendSpan(raw, std::span(biomes));
+		return raw;
+	}
+
+	std::string ChunkSet::getRawFluids() const {
+		const FluidsArray array = getFluids();
+		return std::string(reinterpret_cast<const char *>(array.data()), array.size());
+	}
+
+	std::string ChunkSet::getRawPathmap() const {
+		std::string raw;
+		raw.reserve(PATHMAP_BYTE_COUNT);
+		auto lock = pathmap.sharedLock();
+		const std::vector<uint8_t> unpacked = unpackPathChunk(pathmap);
+		appendSpan(raw, std::span(unpacked));
+		return raw;
 	}
 
 	ChunkSet::FluidsArray ChunkSet::getFluids() const {
@@ -0,0 +1,483 @@
+#include "util/Log.h"
+#include "data/DBBackup.h"
+#include "data/GameDB.h"
+#include "util/Math.h"
+#include "util/Zstd.h"
+
+#include <leveldb/write_batch.h>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <fstream>
+#include <mutex>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace Game3 {
+	namespace {
+		constexpr std::string_view MAGIC{"G3BACKUP"};
+
+		enum class RecordKind: uint8_t {Put = 0, Erase = 1};
+
+		uint64_t hashValue(std::string_view value) {
+			uint64_t hash = 0xcbf29ce484222325;
+			for (const char byte: value) {
+				hash = (hash ^ uint8_t(byte)) * 0x100000001b3;
+			}
+			return hash;
+		}
+
+		template <typename T>
+		void appendNumber(std::string &out, T number) {
+			number = toLittle(number);
+			out.append(reinterpret_cast<const char *>(&number), sizeof(number));
+		}
+
+		void appendString(std::string &out, std::string_view string) {
+			appendNumber(out, uint32_t(string.size()));
+			out.append(string);
+		}
+
+		template <typename T>
+		T takeNumber(std::string_view &in) {
+			if (in.size() < sizeof(T)) {
+				throw std::runtime_error("Backup archive is truncated");
+			}
+			T number{};
+			std::memcpy(&number, in.data(), sizeof(T));
+			in.remove_prefix(sizeof(T));
+			return toNative(number);
+		}
+
+		std::string_view takeString(std::string_view &in) {
+			const uint32_t size = takeNumber<uint32_t>(in);
+			if (in.size() < size) {
+				throw std::runtime_error("Backup archive is truncated");
+			}
+			std::string_view out = in.substr(0, size);
+			in.remove_prefix(size);
+			return out;
+		}
+
+		template <typename T>
+		T readNumber(std::istream &stream) {
+			T number{};
+			if (!stream.read(reinterpret_cast<char *>(&number), sizeof(T))) {
+				throw std::runtime_error("Backup archive is truncated");
+			}
+			return toNative(number);
+		}
+
+		/** Returns std::nullopt at the empty block that ends the records. */
+		std::optional<std::vector<uint8_t>> readBlock(std::istream &stream) {
+			const uint32_t size = readNumber<uint32_t>(stream);
+			if (size == 0) {
+				return std::nullopt;
+			}
+
+			std::vector<uint8_t> compressed(size);
+			if (!stream.read(reinterpret_cast<char *>(compressed.data()), size)) {
+				throw std::runtime_error("Backup archive is truncated");
+			}
+			return compressed;
+		}
+
+		void readHeader(std::istream &stream, const std::filesystem::path &path) {
+			std::string magic(MAGIC.size(), '\0');
+			if (!stream.read(magic.data(), magic.size()) || magic != MAGIC) {
+				throw std::runtime_error(std::format("{} isn't a backup archive", path.string()));
+			}
+
+			if (const uint32_t version = readNumber<uint32_t>(stream); version != DBBackup::FORMAT_VERSION) {
+				throw std::runtime_error(std::format("{} has unsupported backup format version {}", path.string(), version));
+			}
+		}
+
+		std::ifstream openArchive(const std::filesystem::path &path) {
+			std::ifstream stream(path, std::ios::binary);
+			if (!stream) {
+				throw std::runtime_error(std::format("Couldn't open {}", path.string()));
+			}
+			readHeader(stream, path);
+			return stream;
+		}
+
+		class ArchiveWriter {
+			public:
+				ArchiveWriter(const std::filesystem::path &path):
+					stream(path, std::ios::binary | std::ios::trunc) {
+						if (!stream) {
+							throw std::runtime_error(std::format("Couldn't open {} for writing", path.string()));
+						}
+						stream.write(MAGIC.data(), MAGIC.size());
+						writeNumber(DBBackup::FORMAT_VERSION);
+					}
+
+				void put(std::string_view key, std::string_view value) {
+					pending.push_back(char(RecordKind::Put));
+					appendString(pending, key);
+					appendString(pending, value);
+					maybeFlush();
+				}
+
+				void erase(std::string_view key) {
+					pending.push_back(char(RecordKind::Erase));
+					appendString(pending, key);
+					maybeFlush();
+				}
+
+				/** Writes the last block, the end marker, the manifest and the trailer. */
+				DBBackup::Stats finish(const DBBackup::Manifest &manifest) {
+					flushBlock();
+					writeNumber(uint32_t(0));
+
+					const uint64_t manifest_offset = uint64_t(stream.tellp());
+					for (const auto &[key, hash]: manifest) {
+						appendString(pending, key);
+						appendNumber(pending, hash);
+					}
+
+					// An empty manifest still needs its (empty) block so that readManifest finds one there.
+					if (pending.empty()) {
+						writeNumber(uint32_t(0));
+					} else {
+						flushBlock();
+					}
+
+					writeNumber(manifest_offset);
+					stream.write(MAGIC.data(), MAGIC.size());
+					stream.flush();
+
+					if (!stream) {
+						throw std::runtime_error("Couldn't write backup archive");
+					}
+
+					return stats;
+				}
+
+				DBBackup::Stats stats;
+
+			private:
+				std::ofstream stream;
+				std::string pending;
+
+				template <typename T>
+				void writeNumber(T number) {
+					number = toLittle(number);
+					stream.write(reinterpret_cast<const char *>(&number), sizeof(number));
+				}
+
+				void maybeFlush() {
+					if (DBBackup::BLOCK_SIZE <= pending.size()) {
+						flushBlock();
+					}
+				}
+
+				void flushBlock() {
+					if (pending.empty()) {
+						return;
+					}
+
+					const std::vector<uint8_t> compressed = compress(std::span(reinterpret_cast<const uint8_t *>(pending.data()), pending.size()));
+					writeNumber(uint32_t(compressed.size()));
+					stream.write(reinterpret_cast<const char *>(compressed.data()), compressed.size());
+
+					stats.rawBytes += pending.size();
+					stats.compressedBytes += compressed.size();
+					pending.clear();
+				}
+		};
+
+		/** Charges every byte read from the database, whether or not it ends up in the archive, against a rate limit.
+		 *  Also checks for cancellation, so an incremental backup that writes nothing can still be stopped. */
+		class ReadThrottle {
+			public:
+				ReadThrottle(uint64_t bytes_per_second, std::stop_token stop_token):
+					bytesPerSecond(bytes_per_second),
+					stopToken(std::move(stop_token)) {}
+
+				void charge(uint64_t bytes) {
+					charged += bytes;
+					if (nextCheck <= charged) {
+						nextCheck = charged + CHECK_INTERVAL;
+						wait();
+					}
+				}
+
+			private:
+				/** How many bytes can be read between checks. Small enough to keep the rate smooth, large enough that
+				 *  checking the clock costs nothing next to the reads. */
+				constexpr static uint64_t CHECK_INTERVAL = 64 << 10;
+
+				uint64_t bytesPerSecond;
+				std::stop_token stopToken;
+				uint64_t charged = 0;
+				uint64_t nextCheck = CHECK_INTERVAL;
+				std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+				/** Sleeps until the average rate since the start is back under the limit. */
+				void wait() {
+					if (stopToken.stop_requested()) {
+						throw std::runtime_error("Backup cancelled");
+					}
+
+					if (bytesPerSecond == 0) {
+						return;
+					}
+
+					const auto due = start + std::chrono::microseconds(charged * 1'000'000 / bytesPerSecond);
+					while (std::chrono::steady_clock::now() < due) {
+						if (stopToken.stop_requested()) {
+							throw std::runtime_error("Backup cancelled");
+						}
+						std::this_thread::sleep_for(std::min<std::chrono::steady_clock::duration>(due - std::chrono::steady_clock::now(), std::chrono::milliseconds(100)));
+					}
+				}
+		};
+
+		/** Hands blocks from the thread reading an archive to the threads applying them. The reader waits while the
+		 *  queue is full, so only a few blocks per worker are in memory at once however large the archive is. */
+		class BlockQueue {
+			public:
+				explicit BlockQueue(size_t capacity):
+					capacity(capacity) {}
+
+				/** Returns false if the queue was aborted. */
+				bool push(std::vector<uint8_t> block) {
+					std::unique_lock lock(mutex);
+					notFull.wait(lock, [this] { return aborted || blocks.size() < capacity; });
+					if (aborted) {
+						return false;
+					}
+					blocks.push_back(std::move(block));
+					notEmpty.notify_one();
+					return true;
+				}
+
+				/** Returns std::nullopt once the queue has been closed and drained or has been aborted. */
+				std::optional<std::vector<uint8_t>> pop() {
+					std::unique_lock lock(mutex);
+					notEmpty.wait(lock, [this] { return aborted || closed || !blocks.empty(); });
+					if (aborted || blocks.empty()) {
+						return std::nullopt;
+					}
+					std::vector<uint8_t> block = std::move(blocks.front());
+					blocks.pop_front();
+					notFull.notify_one();
+					return block;
+				}
+
+				/** Signals that no more blocks are coming. */
+				void close() {
+					std::unique_lock lock(mutex);
+					closed = true;
+					notEmpty.notify_all();
+				}
+
+				/** Drops the queued blocks and wakes everyone up. */
+				void abort() {
+					std::unique_lock lock(mutex);
+					aborted = true;
+					blocks.clear();
+					notFull.notify_all();
+					notEmpty.notify_all();
+				}
+
+			private:
+				size_t capacity;
+				std::mutex mutex;
+				std::condition_variable notFull;
+				std::condition_variable notEmpty;
+				std::deque<std::vector<uint8_t>> blocks;
+				bool closed = false;
+				bool aborted = false;
+		};
+	}
+
+	DBBackup::Stats DBBackup::backup(leveldb::DB &database, const leveldb::Snapshot *snapshot, const std::filesystem::path &archive, const std::optional<std::filesystem::path> &base, uint64_t bytes_per_second, std::stop_token stop_token) {
+		const Manifest base_manifest = base? readManifest(*base) : Manifest{};
+
+		std::filesystem::path partial = archive;
+		partial += ".partial";
+
+		Manifest manifest;
+		Stats stats;
+
+		try {
+			ArchiveWriter writer(partial);
+			ReadThrottle throttle(bytes_per_second, std::move(stop_token));
+
+			leveldb::ReadOptions read_options;
+			read_options.snapshot = snapshot;
+			// A backup reads everything once, so caching it would only push out the blocks the game actually uses.
+			read_options.fill_cache = false;
+
+			std::unique_ptr<leveldb::Iterator> iterator(database.NewIterator(read_options));
+
+			for (iterator->SeekToFirst(); iterator->Valid(); iterator->Next()) {
+				const std::string_view key(iterator->key().data(), iterator->key().size());
+				const std::string_view value(iterator->value().data(), iterator->value().size());
+				throttle.charge(key.size() + value.size());
+				const uint64_t hash = hashValue(value);
+				manifest.emplace(key, hash);
+
+				if (auto iter = base_manifest.find(std::string(key)); iter != base_manifest.end() && iter->second == hash) {
+					++writer.stats.unchanged;
+				} else {
+					writer.put(key, value);
+					++writer.stats.written;
+				}
+			}
+
+			DBStatus(iterator->status()).assertOK();
+			iterator.reset();
+
+			for (const auto &[key, hash]: base_manifest) {
+				if (!manifest.contains(key)) {
+					writer.erase(key);
+					++writer.stats.erased;
+				}
+			}
+
+			stats = writer.finish(manifest);
+		} catch (...) {
+			std::error_code error_code;
+			std::filesystem::remove(partial, error_code);
+			throw;
+		}
+
+		std::filesystem::rename(partial, archive);
+		return stats;
+	}
+
+	DBBackup::Stats DBBackup::restore(const std::filesystem::path &database_path, std::span<const std::filesystem::path> archives) {
+		if (archives.empty()) {
+			throw std::invalid_argument("No backup archives given");
+		}
+
+		leveldb::Options options;
+		options.create_if_missing = true;
+		options.error_if_exists = true;
+
+		leveldb::DB *raw_database = nullptr;
+		DBStatus(leveldb::DB::Open(options, database_path.string(), &raw_database)).assertOK();
+		std::unique_ptr<leveldb::DB> database(raw_database);
+
+		Stats stats;
+		std::mutex stats_mutex;
+		const size_t thread_count = std::max(1u, std::thread::hardware_concurrency());
+
+		for (const std::filesystem::path &archive: archives) {
+			// Each key appears at most once per archive, so blocks can be applied in any order. Archives can't.
+			BlockQueue queue(2 * thread_count);
+			std::exception_ptr error;
+			size_t block_count = 0;
+
+			auto fail = [&] {
+				{
+					std::unique_lock lock(stats_mutex);
+					if (!error) {
+						error = std::current_exception();
+					}
+				}
+				queue.abort();
+			};
+
+			auto work = [&] {
+				while (std::optional<std::vector<uint8_t>> block = queue.pop()) {
+					try {
+						const std::vector<uint8_t> decompressed = decompress8(*block);
+						std::string_view records(reinterpret_cast<const char *>(decompressed.data()), decompressed.size());
+						leveldb::WriteBatch batch;
+						Stats block_stats;
+
+						while (!records.empty()) {
+							const auto kind = RecordKind(takeNumber<uint8_t>(records));
+							const std::string_view key = takeString(records);
+							if (kind == RecordKind::Put) {
+								const std::string_view value = takeString(records);
+								batch.Put(leveldb::Slice(key.data(), key.size()), leveldb::Slice(value.data(), value.size()));
+								++block_stats.written;
+							} else if (kind == RecordKind::Erase) {
+								batch.Delete(leveldb::Slice(key.data(), key.size()));
+								++block_stats.erased;
+							} else {
+								throw std::runtime_error(std::format("Invalid record kind in {}: {}", archive.string(), int(kind)));
+							}
+						}
+
+						DBStatus(database->Write(leveldb::WriteOptions{}, &batch)).assertOK();
+
+						std::unique_lock lock(stats_mutex);
+						stats.written += block_stats.written;
+						stats.erased += block_stats.erased;
+						stats.rawBytes += decompressed.size();
+						stats.compressedBytes += block->size();
+					} catch (...) {
+						fail();
+					}
+				}
+			};
+
+			{
+				std::vector<std::jthread> threads;
+				for (size_t i = 0; i < thread_count; ++i) {
+					threads.emplace_back(work);
+				}
+
+				// Meanwhile, this thread reads the archive one block at a time.
+				try {
+					std::ifstream stream = openArchive(archive);
+					while (std::optional<std::vector<uint8_t>> block = readBlock(stream)) {
+						if (!queue.push(std::move(*block))) {
+							break;
+						}
+						++block_count;
+					}
+				} catch (...) {
+					fail();
+				}
+
+				queue.close();
+			}
+
+			if (error) {
+				std::rethrow_exception(error);
+			}
+
+			INFO("Restored {} ({} blocks).", archive.string(), block_count);
+		}
+
+		return stats;
+	}
+
+	DBBackup::Manifest DBBackup::readManifest(const std::filesystem::path &archive) {
+		std::ifstream stream = openArchive(archive);
+
+		stream.seekg(-std::streamoff(sizeof(uint64_t) + MAGIC.size()), std::ios::end);
+		const uint64_t manifest_offset = readNumber<uint64_t>(stream);
+		std::string magic(MAGIC.size(), '\0');
+		if (!stream.read(magic.data(), magic.size()) || magic != MAGIC) {
+			throw std::runtime_error(std::format("{} is incomplete", archive.string()));
+		}
+
+		stream.seekg(std::streamoff(manifest_offset));
+		Manifest manifest;
+
+		if (std::optional<std::vector<uint8_t>> block = readBlock(stream)) {
+			const std::vector<uint8_t> decompressed = decompress8(*block);
+			std::string_view entries(reinterpret_cast<const char *>(decompressed.data()), decompressed.size());
+			while (!entries.empty()) {
+				const std::string_view key = takeString(entries);
+				manifest.emplace(key, takeNumber<uint64_t>(entries));
+			}
+		}
+
+		return manifest;
+	}
+}
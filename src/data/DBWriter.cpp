@@ -0,0 +1,97 @@
+#include "util/Log.h"
+#include "data/DBWriter.h"
+#include "data/GameDB.h"
+
+#include <leveldb/write_batch.h>
+
+#include <utility>
+
+namespace Game3 {
+	DBWriter::DBWriter(leveldb::DB &database_):
+		database(database_),
+		thread([this](std::stop_token stop_token) { run(std::move(stop_token)); }) {}
+
+	DBWriter::~DBWriter() {
+		// The writer thread commits whatever's left before it notices the stop request.
+		thread.request_stop();
+		thread.join();
+	}
+
+	void DBWriter::put(std::string key, std::string value) {
+		enqueue(std::move(key), std::move(value));
+	}
+
+	void DBWriter::erase(std::string key) {
+		enqueue(std::move(key), std::nullopt);
+	}
+
+	void DBWriter::flush() {
+		std::unique_lock lock(mutex);
+		const uint64_t target = queuedCount;
+		committed.wait(lock, [&] { return target <= committedCount; });
+
+		if (std::optional<leveldb::Status> status = std::exchange(failure, std::nullopt)) {
+			throw DBError(*status);
+		}
+	}
+
+	std::optional<std::optional<std::string>> DBWriter::peek(const std::string &key) const {
+		std::unique_lock lock(mutex);
+
+		if (auto iter = pending.find(key); iter != pending.end()) {
+			return iter->second;
+		}
+
+		if (auto iter = committing.find(key); iter != committing.end()) {
+			return iter->second;
+		}
+
+		return std::nullopt;
+	}
+
+	void DBWriter::enqueue(std::string key, std::optional<std::string> value) {
+		{
+			std::unique_lock lock(mutex);
+			pending[std::move(key)] = std::move(value);
+			++queuedCount;
+		}
+
+		wakeup.notify_one();
+	}
+
+	void DBWriter::run(std::stop_token stop_token) {
+		std::unique_lock lock(mutex);
+
+		while (wakeup.wait(lock, stop_token, [this] { return !pending.empty(); })) {
+			committing = std::move(pending);
+			pending.clear();
+			const uint64_t batch_end = queuedCount;
+			lock.unlock();
+
+			// Other threads only read committing while this one builds the batch, so it's safe to do without the lock.
+			leveldb::WriteBatch batch;
+			for (const auto &[key, value]: committing) {
+				if (value) {
+					batch.Put(key, *value);
+				} else {
+					batch.Delete(key);
+				}
+			}
+
+			leveldb::Status status = database.Write(leveldb::WriteOptions{}, &batch);
+
+			lock.lock();
+
+			if (!status.ok()) {
+				ERR("Couldn't commit {} database writes: {}", committing.size(), status.ToString());
+				if (!failure) {
+					failure = status;
+				}
+			}
+
+			committing.clear();
+			committedCount = batch_end;
+			committed.notify_all();
+		}
+	}
+}
@@ -1,3 +1,4 @@
+#include "data/DBBackup.h"
 #include "data/GameDB.h"
 #include "entity/Entity.h"
 #include "entity/EntityFactory.h"
@@ -6,12 +7,21 @@
 #include "game/ServerGame.h"
 #include "graphics/Tileset.h"
 #include "net/Buffer.h"
+#include "realm/Realm.h"
+#include "threading/ThreadContext.h"
+#include "threading/ThreadPool.h"
+#include "threading/Waiter.h"
 #include "tileentity/TileEntity.h"
 #include "tileentity/TileEntityFactory.h"
 #include "util/JSON.h"
 #include "util/Timer.h"
 
-#include <leveldb/write_batch.h>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <set>
+#include <unordered_set>
+#include <utility>
 
 namespace Game3 {
 	namespace {
@@ -57,10 +67,22 @@ namespace Game3 {
 			return options;
 		}
 
-		inline leveldb::WriteOptions getWriteOptions() {
-			leveldb::WriteOptions options;
-			return options;
-		}
+		/** Pauses ticking for as long as it exists. Leaves ticking paused if it already was. Not safe to nest across
+		 *  threads, which is why writeAll holds saveMutex around it. */
+		struct TickPause {
+			Game &game;
+			bool wasPaused;
+
+			TickPause(Game &game):
+				game(game),
+				wasPaused(game.tickingPaused.exchange(true)) {}
+
+			~TickPause() {
+				if (!wasPaused) {
+					game.tickingPaused = false;
+				}
+			}
+		};
 	}
 
 	GameDBScope::GameDBScope(GameDB &game_db) {
@@ -83,6 +105,11 @@ namespace Game3 {
 	template <>
 	std::optional<std::string> GameDB::tryRead<std::string>(const leveldb::Slice &key) {
 		GameDBScope scope{*this};
+
+		if (std::optional<std::optional<std::string>> queued = writer->peek(key.ToString())) {
+			return std::move(*queued);
+		}
+
 		std::string out;
 		DBStatus status(database->Get(getReadOptions(), key, &out));
 		if (status.status.IsNotFound()) {
@@ -108,29 +135,76 @@ namespace Game3 {
 		DBStatus status = leveldb::DB::Open(getOpenOptions(), path.string(), &db);
 		status.assertOK();
 		database.reset(db);
+		writer = std::make_unique<DBWriter>(*db);
 	}
 
 	void GameDB::close() {
+		// The backup thread takes the database lock itself, so it has to finish before the lock is taken here.
+		if (backupThread.joinable()) {
+			backupThread.request_stop();
+			backupThread.join();
+		}
+
 		auto db_lock = database.uniqueLock();
+		// Destroying the writer commits whatever it still has queued.
+		writer.reset();
 		database.reset();
 	}
 
+	bool GameDB::startBackup(std::filesystem::path archive, std::optional<std::filesystem::path> base, uint64_t bytes_per_second) {
+		if (backingUp.exchange(true)) {
+			return false;
+		}
+
+		backupThread = std::jthread([this, archive = std::move(archive), base = std::move(base), bytes_per_second](std::stop_token stop_token) {
+			threadContext.rename("Backup");
+			const leveldb::Snapshot *snapshot = nullptr;
+
+			try {
+				writeAll();
+				flush();
+				snapshot = database->GetSnapshot();
+				const DBBackup::Stats stats = DBBackup::backup(*database, snapshot, archive, base, bytes_per_second, std::move(stop_token));
+				SUCCESS("Backed up to {}: {} written, {} unchanged, {} erased, {} bytes compressed to {}.", archive.string(),
+					stats.written, stats.unchanged, stats.erased, stats.rawBytes, stats.compressedBytes);
+			} catch (const std::exception &err) {
+				ERR("Backup to {} failed: {}", archive.string(), err.what());
+			}
+
+			if (snapshot != nullptr) {
+				database->ReleaseSnapshot(snapshot);
+			}
+
+			backingUp = false;
+		});
+
+		return true;
+	}
+
+	void GameDB::flush() {
+		if (writer) {
+			writer->flush();
+		}
+	}
+
 	template <>
 	std::string GameDB::read<std::string>(const leveldb::Slice &key) {
-		GameDBScope scope{*this};
-		std::string out;
-		DBStatus(database->Get(getReadOptions(), key, &out)).assertOK();
-		return out;
+		if (std::optional<std::string> out = tryRead(key)) {
+			return std::move(*out);
+		}
+
+		DBStatus(leveldb::Status::NotFound(key)).assertOK();
+		return {};
 	}
 
 	void GameDB::write(const leveldb::Slice &key, const leveldb::Slice &value) {
 		GameDBScope scope{*this};
-		DBStatus(database->Put(getWriteOptions(), key, value)).assertOK();
+		writer->put(key.ToString(), value.ToString());
 	}
 
 	void GameDB::erase(const leveldb::Slice &key) {
 		GameDBScope scope{*this};
-		DBStatus(database->Delete(getWriteOptions(), key)).assertOK();
+		writer->erase(key.ToString());
 	}
 
 	int64_t GameDB::getCompatibility() {
@@ -142,17 +216,32 @@ namespace Game3 {
 	}
 
 	void GameDB::writeAll() {
-		writeRules();
-		writeAllRealms();
-		writeMisc();
+		std::unique_lock save_lock(saveMutex);
 		ServerGamePtr game = getGame();
-		auto player_lock = game->players.sharedLock();
-		writeUsers(game->players);
+		std::vector<RealmSnapshot> snapshots;
+
+		{
+			Timer timer{"SnapshotAll"};
+			TickPause pause{*game};
+			writeRules();
+			game->iterateRealms([&](const RealmPtr &realm) {
+				snapshots.push_back(snapshotRealm(realm));
+			});
+			writeMisc();
+			auto player_lock = game->players.sharedLock();
+			writeUsers(game->players);
+		}
+
+		Timer timer{"WriteSnapshots"};
+		for (const RealmSnapshot &snapshot: snapshots) {
+			writeSnapshot(snapshot);
+		}
+		writeVillages();
 	}
 
 	void GameDB::readAll() {
 		readRules();
-		readAllRealms();
+		readAllRealms(true);
 	}
 
 	void GameDB::writeMisc() {
@@ -191,21 +280,53 @@ namespace Game3 {
 
 	void GameDB::writeRealm(const RealmPtr &realm) {
 		Timer timer{"WriteRealm"};
-		ServerGamePtr game = getGame();
+		std::unique_lock save_lock(saveMutex);
+		writeSnapshot(snapshotRealm(realm));
+		writeVillages();
+	}
+
+	RealmSnapshot GameDB::snapshotRealm(const RealmPtr &realm) {
+		Timer timer{"SnapshotRealm"};
 		auto lock = database.uniqueLock();
 		writeRealmMeta(realm);
+
+		const uint64_t page_out_epoch = realm->getPageOutEpoch();
+		std::vector<ChunkPosition> chunk_positions;
 		{
 			std::shared_lock lock(realm->tileProvider.chunkMutexes[0]);
+			chunk_positions.reserve(realm->tileProvider.chunkMaps[0].size());
 			for (const auto &[chunk_position, chunk]: realm->tileProvider.chunkMaps[0]) {
-				writeChunk(realm, chunk_position);
+				// Something may have created an empty chunk over one that hasn't been read back yet.
+				if (!realm->isPagedOut(chunk_position)) {
+					chunk_positions.push_back(chunk_position);
+				}
 			}
 		}
-		writeTileEntities(realm);
-		writeEntities(realm);
+
+		RealmSnapshot snapshot{realm, page_out_epoch, realm->tileProvider.copyChunkSets(chunk_positions)};
+
 		if (const Tileset &tileset = realm->getTileset(); !hasTileset(tileset.getHash())) {
 			writeTilesetMeta(tileset);
 		}
-		writeVillages();
+		return snapshot;
+	}
+
+	void GameDB::writeSnapshot(const RealmSnapshot &snapshot) {
+		Timer timer{"WriteSnapshot"};
+		const RealmPtr &realm = snapshot.realm;
+		const RealmID realm_id = realm->getID();
+		for (const auto &[chunk_position, chunk_set]: snapshot.chunks) {
+			// Ticking resumes before this runs. Checking and queueing with page-outs held off means that a page-out's
+			// newer write is either skipped over here or queued after this one, so it always wins.
+			realm->unlessPagedOutSince(chunk_position, snapshot.pageOutEpoch, [&] {
+				writeChunk(realm_id, chunk_position, chunk_set);
+			});
+		}
+
+		// These are encoded from the live sets while holding their locks. Entities and tile entities are taken out of
+		// the sets before their records are erased, so an erase is always queued after any write of the same record.
+		writeTileEntities(realm);
+		writeEntities(realm);
 	}
 
 	void GameDB::deleteRealm(RealmPtr realm) {
@@ -241,13 +362,9 @@ namespace Game3 {
 		DBStatus(it->status()).assertOK();
 		it.reset();
 
-		leveldb::WriteBatch batch;
-
 		for (const std::string &key: keys) {
-			batch.Delete(key);
+			erase(key);
 		}
-
-		DBStatus(database->Write(getWriteOptions(), &batch)).assertOK();
 	}
 
 	void GameDB::readVillages() {
@@ -296,56 +413,95 @@ namespace Game3 {
 			Timer{"GetRawPathmap"}([&] { return provider.getRawPathmap(chunk_position); }),
 		};
 
-		auto db_lock = database.uniqueLock();
 		write(getKey(realm->getID(), chunk_position), buffer);
 	}
 
-	void GameDB::readAllRealms() {
+	void GameDB::writeChunk(RealmID realm_id, ChunkPosition chunk_position, const ChunkSet &chunk_set) {
+		GameDBScope scope{*this};
+		write(getKey(realm_id, chunk_position), Buffer{Side::Server,
+			realm_id,
+			chunk_position,
+			chunk_set.getRawTerrain(),
+			chunk_set.getRawBiomes(),
+			chunk_set.getRawFluids(),
+			chunk_set.getRawPathmap(),
+		});
+	}
+
+	void GameDB::readAllRealms(bool lazy) {
 		assert(database);
 		ServerGamePtr game = getGame();
 		auto db_lock = database.uniqueLock();
 
-		iterate(CHUNK_PREFIX, [&](std::string_view, std::string_view value) {
-			Timer iteration_timer{"ChunkLoad"};
-			ViewBuffer buffer(value, Side::Server);
-
-			RealmID realm_id;
-			ChunkPosition chunk_position;
-			std::span<const char> raw_terrain;
-			std::span<const char> raw_biomes;
-			std::span<const char> raw_fluids;
-			std::span<const char> raw_pathmap;
-
-			buffer >> realm_id >> chunk_position >> raw_terrain >> raw_biomes >> raw_fluids >> raw_pathmap;
-
-			auto chunk_set = Timer{"ChunkSet"}([&] {
-				return ChunkSet{
-					raw_terrain,
-					raw_biomes,
-					raw_fluids,
-					raw_pathmap,
-				};
+		// Realms are all loaded up front so that their chunks can be absorbed from worker threads.
+		Timer{"LoadRealms"}([&] {
+			iterate(REALM_PREFIX, [&](std::string_view, std::string_view value) {
+				RealmID realm_id = ViewBuffer{value, Side::Server}.take<RealmID>();
+				game->getRealm(realm_id, [&] { return loadRealm(realm_id); });
 			});
+		});
 
-			RealmPtr realm = Timer{"GetRealm"}([&] {
-				return game->getRealm(realm_id, [&] {
-					return loadRealm(realm_id);
-				});
+		std::unordered_set<RealmID> eager_realms;
+		std::set<std::pair<RealmID, ChunkPosition>> eager_chunks;
+
+		if (lazy) {
+			// Tile migration rewrites every chunk of the realm, so those realms have to be read in full.
+			game->iterateRealms([&](const RealmPtr &realm) {
+				if (realm->getTileset().getHash() != readRealmTilesetHash(realm->id)) {
+					eager_realms.insert(realm->id);
+				}
 			});
 
-			Timer{"Absorb"}([&] {
-				realm->tileProvider.absorb(chunk_position, std::move(chunk_set));
+			for (const auto &[realm_id, chunk_position]: getLoginChunks()) {
+				ChunkRange(chunk_position).iterate([&](ChunkPosition nearby) {
+					eager_chunks.emplace(realm_id, nearby);
+				});
+			}
+		}
+
+		// Entities and tile entities were loaded along with their realms. Their neighbouring chunks are read too so that
+		// they don't start out boxed in by paged-out chunks; getPageableChunks keeps the same margin afterwards.
+		auto near_agents = [](Realm &realm, ChunkPosition chunk_position) {
+			bool found = false;
+			ChunkRange(chunk_position).iterate([&](ChunkPosition nearby) {
+				found = found || realm.holdsAgents(nearby);
 			});
-		});
+			return found;
+		};
+
+		std::vector<std::string> batch;
+		size_t loaded = 0;
+		size_t deferred = 0;
+
+		Timer{"ReadChunks"}([&] {
+			iterate(CHUNK_PREFIX, [&](std::string_view, std::string_view value) {
+				ViewBuffer buffer(value, Side::Server);
+				const auto realm_id = buffer.take<RealmID>();
+				const auto chunk_position = buffer.take<ChunkPosition>();
+
+				RealmPtr realm = game->getRealm(realm_id, [&] {
+					return loadRealm(realm_id);
+				});
+
+				if (lazy && !eager_realms.contains(realm_id) && !eager_chunks.contains({realm_id, chunk_position}) && !near_agents(*realm, chunk_position)) {
+					realm->markPagedOut(chunk_position);
+					++deferred;
+					return;
+				}
 
-		// If a realm has no chunks, it won't get loaded above, so we have to go through all realms
-		// and load the ones that haven't been loaded yet.
+				batch.emplace_back(value);
+				++loaded;
 
-		iterate(REALM_PREFIX, [&](std::string_view, std::string_view value) {
-			RealmID realm_id = ViewBuffer{value, Side::Server}.take<RealmID>();
-			game->getRealm(realm_id, [&] { return loadRealm(realm_id); });
+				if (CHUNK_LOAD_BATCH <= batch.size()) {
+					absorbChunks(std::exchange(batch, {}));
+				}
+			});
+
+			absorbChunks(std::move(batch));
 		});
 
+		INFO("Read {} chunks from the database; {} more will be read when first needed.", loaded, deferred);
+
 		Timer{"LoadVillages"}([&] {
 			readVillages();
 		});
@@ -447,9 +603,7 @@ namespace Game3 {
 				}
 
 				for (ChunkPosition chunk_position: all_chunk_positions) {
-					chunk_position.iterate([&](Position position) {
-						realm->autotile(position, layer, TileUpdateContext{9});
-					});
+					realm->autotileChunk(chunk_position, layer, TileUpdateContext{9});
 				}
 			}
 
@@ -457,20 +611,107 @@ namespace Game3 {
 		});
 	}
 
+	std::vector<std::pair<RealmID, ChunkPosition>> GameDB::getLoginChunks() {
+		ServerGamePtr game = getGame();
+		std::vector<std::pair<RealmID, ChunkPosition>> out;
+
+		// New players are placed here.
+		if (RealmPtr overworld = game->tryRealm(1)) {
+			out.emplace_back(1, overworld->randomLand.getChunk());
+		}
+
+		iterate(USER_PREFIX, [&](std::string_view, std::string_view value) {
+			try {
+				ViewBuffer buffer{value, Side::Server};
+				buffer.take<std::string_view>(); // username
+				buffer.take<std::string_view>(); // display name
+
+				auto release_position = buffer.take<std::optional<Position>>();
+				auto release_realm = buffer.take<std::optional<RealmID>>();
+				if (release_position && release_realm) {
+					out.emplace_back(*release_realm, release_position->getChunk());
+				}
+
+				// The rest is the encoded player, which begins the way every encoded entity does.
+				buffer.take<EntityType>();
+				buffer.take<GlobalID>();
+				const auto realm_id = buffer.take<RealmID>();
+				const auto position = buffer.take<Position>();
+				out.emplace_back(realm_id, position.getChunk());
+			} catch (const std::exception &err) {
+				WARN("Couldn't find where a player will log in: {}", err.what());
+			}
+		});
+
+		return out;
+	}
+
+	void GameDB::absorbChunks(std::vector<std::string> raw_chunks) {
+		if (raw_chunks.empty()) {
+			return;
+		}
+
+		ServerGamePtr game = getGame();
+		ThreadPool &pool = game->getPool();
+		const size_t job_count = std::max<size_t>(1, std::min(pool.getSize(), raw_chunks.size()));
+
+		Waiter waiter(job_count);
+		std::atomic_size_t next = 0;
+		std::mutex error_mutex;
+		std::exception_ptr error;
+
+		// Decompressing the terrain is the slow part and absorbing only takes the tile provider's own locks,
+		// so each job pulls chunks off the shared list until it runs out.
+		auto work = [&] {
+			for (size_t i = next++; i < raw_chunks.size(); i = next++) {
+				try {
+					ViewBuffer buffer(raw_chunks[i], Side::Server);
+
+					RealmID realm_id;
+					ChunkPosition chunk_position;
+					std::span<const char> raw_terrain, raw_biomes, raw_fluids, raw_pathmap;
+					buffer >> realm_id >> chunk_position >> raw_terrain >> raw_biomes >> raw_fluids >> raw_pathmap;
+
+					ChunkSet chunk_set{raw_terrain, raw_biomes, raw_fluids, raw_pathmap};
+					game->getRealm(realm_id)->tileProvider.absorb(chunk_position, std::move(chunk_set));
+				} catch (...) {
+					std::unique_lock lock(error_mutex);
+					if (!error) {
+						error = std::current_exception();
+					}
+				}
+			}
+
+			--waiter;
+		};
+
+		for (size_t job = 0; job < job_count; ++job) {
+			if (!pool.add([&work](ThreadPool &, size_t) { work(); })) {
+				work();
+			}
+		}
+
+		waiter.wait();
+
+		if (error) {
+			std::rethrow_exception(error);
+		}
+	}
+
 	RealmPtr GameDB::loadRealm(RealmID realm_id) {
 		GameDBScope scope{*this};
 		ServerGamePtr game = getGame();
 
-		std::string raw;
-		DBStatus status = database->Get(getReadOptions(), getKey(realm_id), &raw);
+		std::optional<std::string> raw = tryRead(getKey(realm_id));
 
-		if (!status) {
+		if (!raw) {
 			throw std::out_of_range(std::format("Couldn't find realm {} in database", realm_id));
 		}
 
-		Buffer buffer(raw, Side::Server);
+		Buffer buffer(std::move(*raw), Side::Server);
 
-		assert(realm_id == buffer.take<RealmID>());
+		[[maybe_unused]] const auto stored_realm_id = buffer.take<RealmID>();
+		assert(stored_realm_id == realm_id);
 		auto json = buffer.take<boost::json::value>();
 		auto tileset_hash = buffer.take<std::string>();
 
@@ -550,8 +791,8 @@ namespace Game3 {
 
 		ViewBuffer buffer(*raw, Side::Server);
 		std::span<const char> raw_terrain, raw_biomes, raw_fluids, raw_pathmap;
-		assert(realm_id == buffer.take<RealmID>());
-		buffer.take<ChunkPosition>();
+		[[maybe_unused]] const auto stored_realm_id = buffer.take<RealmID>();
+		assert(realm_id == stored_realm_id);
 		buffer >> chunk_position >> raw_terrain >> raw_biomes >> raw_fluids >> raw_pathmap;
 
 		return Timer{"ChunkSet"}([&] {
@@ -570,7 +811,8 @@ namespace Game3 {
 
 		ViewBuffer buffer{*raw, Side::Server};
 
-		assert(username == buffer.take<std::string_view>());
+		[[maybe_unused]] const auto stored_username = buffer.take<std::string_view>();
+		assert(stored_username == username);
 
 		if (display_name_out) {
 			buffer >> *display_name_out;
@@ -842,12 +1084,17 @@ namespace Game3 {
 	}
 
 	std::unique_ptr<leveldb::Iterator> GameDB::getStartIterator() {
+		flush();
 		auto it = getIterator();
 		it->SeekToFirst();
 		return it;
 	}
 
 	bool GameDB::hasKey(std::string_view key) {
+		if (std::optional<std::optional<std::string>> queued = writer->peek(std::string(key))) {
+			return queued->has_value();
+		}
+
 		auto it = getIterator();
 		leveldb::Slice slice(key.data(), key.size());
 		it->Seek(slice);
@@ -2,13 +2,16 @@
 #include "entity/Animal.h"
 #include "entity/Player.h"
 #include "game/Game.h"
-#include "graphics/TextRenderer.h"
 #include "net/Buffer.h"
 #include "threading/ThreadContext.h"
 #include "tileentity/Building.h"
 #include "tileentity/Chest.h"
 #include "tileentity/Teleporter.h"
 
+#ifndef GAME3_HEADLESS
+#include "graphics/TextRenderer.h"
+#endif
+
 namespace Game3 {
 	ThreadPool Animal::threadPool{2};
 
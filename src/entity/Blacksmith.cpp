@@ -2,8 +2,6 @@
 #include "entity/Blacksmith.h"
 #include "entity/Merchant.h"
 #include "entity/Player.h"
-#include "game/ClientGame.h"
-#include "game/ClientInventory.h"
 #include "game/Game.h"
 #include "game/Inventory.h"
 #include "graphics/Tileset.h"
@@ -14,9 +12,14 @@
 #include "tileentity/Chest.h"
 #include "tileentity/OreDeposit.h"
 #include "tileentity/Teleporter.h"
-#include "ui/Window.h"
 #include "util/Util.h"
 
+#ifndef GAME3_HEADLESS
+#include "game/ClientGame.h"
+#include "game/ClientInventory.h"
+#include "ui/Window.h"
+#endif
+
 namespace Game3 {
 	Blacksmith::Blacksmith():
 		Entity(ID()), Worker(ID()), Merchant(ID()) {}
@@ -32,6 +32,7 @@ namespace Game3 {
 		function(breed);
 	}
 
+#ifndef GAME3_HEADLESS
 	void Crab::render(const RendererContext &renderers) {
 		if (!texture) {
 			// It's assumed they're all the same variety.
@@ -49,6 +50,7 @@ namespace Game3 {
 
 		Animal::render(renderers);
 	}
+#endif
 
 	bool Crab::wander() {
 		if (!attemptingWander.exchange(true)) {
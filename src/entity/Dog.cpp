@@ -26,6 +26,7 @@ namespace Game3 {
 		function(breed);
 	}
 
+#ifndef GAME3_HEADLESS
 	void Dog::render(const RendererContext &renderers) {
 		if (!texture) {
 			// It's assumed they're all the same variety.
@@ -35,6 +36,7 @@ namespace Game3 {
 
 		Animal::render(renderers);
 	}
+#endif
 
 	void Dog::encode(Buffer &buffer) {
 		Animal::encode(buffer);
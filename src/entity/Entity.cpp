@@ -1,20 +1,14 @@
 #include "algorithm/AStar.h"
 #include "data/Identifier.h"
-#include "entity/ClientPlayer.h"
 #include "entity/Entity.h"
 #include "entity/EntityFactory.h"
 #include "entity/ServerPlayer.h"
 #include "entity/SquareParticle.h"
 #include "entity/Util.h"
-#include "game/ClientGame.h"
-#include "game/ClientInventory.h"
 #include "game/Game.h"
 #include "game/ServerGame.h"
 #include "game/ServerInventory.h"
-#include "graphics/CircleRenderer.h"
 #include "graphics/ItemTexture.h"
-#include "graphics/RendererContext.h"
-#include "graphics/SpriteRenderer.h"
 #include "graphics/Tileset.h"
 #include "lib/JSON.h"
 #include "net/Buffer.h"
@@ -29,12 +23,21 @@
 #include "threading/ThreadContext.h"
 #include "tile/Tile.h"
 #include "types/Position.h"
-#include "ui/Window.h"
 #include "util/Cast.h"
 #include "util/ConstexprHash.h"
 #include "util/Log.h"
 #include "util/Util.h"
 
+#ifndef GAME3_HEADLESS
+#include "entity/ClientPlayer.h"
+#include "game/ClientGame.h"
+#include "game/ClientInventory.h"
+#include "graphics/CircleRenderer.h"
+#include "graphics/RendererContext.h"
+#include "graphics/SpriteRenderer.h"
+#include "ui/Window.h"
+#endif
+
 #include <cassert>
 #include <iostream>
 #include <sstream>
@@ -126,9 +129,12 @@ namespace Game3 {
 
 		if (const InventoryPtr inventory = getInventory(0)) {
 			// TODO: move JSONification to StorageInventory
+#ifndef GAME3_HEADLESS
 			if (getSide() == Side::Client) {
 				object["inventory"] = boost::json::value_from(static_cast<ClientInventory &>(*inventory));
-			} else {
+			} else
+#endif
+			{
 				object["inventory"] = boost::json::value_from(static_cast<ServerInventory &>(*inventory));
 			}
 		}
@@ -239,7 +245,9 @@ namespace Game3 {
 		}
 
 		if (GamePtr game = args.getGame(); path_drained && game->getSide() == Side::Server) {
-			game->toServer().entityTeleported(*this, MovementContext{.clearOffset = false});
+			// The last step has just set the offset to a whole tile back toward the previous position. Clients glide
+			// through the same offset down to zero, so only the tile itself can disagree with what they predicted.
+			game->toServer().entityMotionSettled(*this, MovementContext{.clearOffset = false}, false);
 		}
 
 		const auto delta = args.delta;
@@ -428,6 +436,7 @@ namespace Game3 {
 		movedToNewChunk(std::nullopt);
 	}
 
+#ifndef GAME3_HEADLESS
 	void Entity::render(const RendererContext &renderers) {
 		if (texture == nullptr || !isVisible()) {
 			return;
@@ -603,6 +612,7 @@ namespace Game3 {
 			.color{"#00000044"},
 		});
 	}
+#endif
 
 	bool Entity::move(Direction move_direction, MovementContext context) {
 		if (EntityPtr ridden = getRidden()) {
@@ -742,6 +752,9 @@ namespace Game3 {
 		iterateTiles([&, position_offset = place.position - getPosition()](const Position &occupied) {
 			const Position candidate = occupied + position_offset;
 
+			// A paged-out tile would read as missing and therefore solid.
+			realm->ensureResident(candidate.getChunk());
+
 			for (const Layer layer: {Layer::Submerged, Layer::Objects, Layer::Highest}) {
 				if (std::optional<TileID> tile = realm->tryTile(layer, candidate); !tile || tileset.isSolid(*tile)) {
 					out = false;
@@ -786,6 +799,7 @@ namespace Game3 {
 		return true;
 	}
 
+#ifndef GAME3_HEADLESS
 	void Entity::focus(Window &window, bool is_autofocus) {
 		if (EntityPtr ridden = getRidden()) {
 			ridden->focus(window, is_autofocus);
@@ -809,6 +823,7 @@ namespace Game3 {
 			window.center.second = -(row    - map_length / 2. + .5) - offset.y;
 		}
 	}
+#endif
 
 	bool Entity::teleport(const Position &new_position, MovementContext context) {
 		const auto old_chunk_position = position.getChunk();
@@ -856,9 +871,15 @@ namespace Game3 {
 			});
 		}
 
-		if (is_server && !context.fromPath && !context.suppressPackets) {
-			GamePtr game = realm->getGame();
-			game->toServer().entityTeleported(*this, context);
+		if (is_server && !context.fromPath) {
+			if (context.suppressPackets) {
+				// Clients move riders along with their mounts on their own.
+				replicatedPosition = new_position;
+				replicatedOffset = getOffset();
+			} else {
+				GamePtr game = realm->getGame();
+				game->toServer().entityTeleported(*this, context);
+			}
 		}
 
 		return in_different_chunk;
@@ -963,6 +984,10 @@ namespace Game3 {
 
 		if (out == PathResult::Success && getSide() == Side::Server) {
 			increaseUpdateCounter();
+			// Clients replay the path themselves, so the goal is where they'll expect to find the entity afterwards.
+			replicatedPosition = goal;
+			// Each step of the path ends on a whole tile.
+			replicatedOffset = Vector3{};
 			auto shared = getSelf();
 			const auto packet = make<EntitySetPathPacket>(*this);
 			auto lock = visiblePlayers.sharedLock();
@@ -1003,12 +1028,14 @@ namespace Game3 {
 		const auto pos = getPosition();
 		auto realm = getRealm();
 
+#ifndef GAME3_HEADLESS
 		GamePtr game = getGame();
 
 		if (game->getSide() == Side::Client) {
 			ClientGame &client_game = game->toClient();
 			return client_game.getWindow()->inBounds(pos) && ChunkRange(client_game.getPlayer()->getChunk()).contains(pos.getChunk());
 		}
+#endif
 
 		return realm->isVisible(pos);
 	}
@@ -1561,85 +1588,60 @@ namespace Game3 {
 		return true;
 	}
 
-	void Entity::applyMotion(float delta) {
-		if (getRidden()) {
+	void Entity::applyMotion(float) {
+		if (kinematicsTracked || getRidden()) {
 			return;
 		}
 
-		auto offset_lock = offset.uniqueLock();
-
-		auto &x = offset.x;
-		auto &y = offset.y;
-		auto &z = offset.z;
-		const auto speed = getMovementSpeed();
-
-		if (x < 0.) {
-			x = std::min(x + delta * speed, 0.);
-		} else if (0. < x) {
-			x = std::max(x - delta * speed, 0.);
-		}
-
-		if (y < 0.) {
-			y = std::min(y + delta * speed, 0.);
-		} else if (0. < y) {
-			y = std::max(y - delta * speed, 0.);
+		{
+			auto offset_lock = offset.sharedLock();
+			auto velocity_lock = velocity.sharedLock();
+			if (!offset && !velocity) {
+				return;
+			}
 		}
 
-		auto velocity_lock = velocity.uniqueLock();
-
-		bool old_grounded = offset.isGrounded();
-
-		z = std::max(z + delta * velocity.z, 0.);
-
-		if (z > 0) {
-			x += delta * velocity.x;
-			y += delta * velocity.y;
-		} else {
-			velocity.x = 0;
-			velocity.y = 0;
+		if (RealmPtr realm = weakRealm.lock()) {
+			realm->kinematics.track(getSelf());
 		}
+	}
 
-		bool new_grounded = offset.isGrounded();
-
+	void Entity::groundedChanged(bool grounded) {
 		GamePtr game = getGame();
+		RealmPtr realm = getRealm();
+		const Position position = getPosition();
 
-		if (old_grounded != new_grounded) {
-			RealmPtr realm = getRealm();
-			if (std::optional<FluidTile> fluid_tile = realm->tryFluid(getPosition()); fluid_tile && 0 < fluid_tile->level) {
-				if (FluidPtr fluid = game->getFluid(fluid_tile->id)) {
-					splash(*this, fluid->color, true);
-				}
+		if (std::optional<FluidTile> fluid_tile = realm->tryFluid(position); fluid_tile && 0 < fluid_tile->level) {
+			if (FluidPtr fluid = game->getFluid(fluid_tile->id)) {
+				splash(*this, fluid->color, true);
 			}
 		}
 
-		if (!old_grounded && new_grounded) {
-			if (TileEntityPtr tile_entity = getRealm()->tileEntityAt(getPosition())) {
-				tile_entity->onOverlap(getSelf());
-			}
-
-			if (game->getSide() == Side::Server) {
-				game->toServer().entityTeleported(*this, MovementContext{
-					.excludePlayer = isPlayer()? getGID() : -1,
-					.clearOffset = false,
-				});
-			}
+		if (!grounded) {
+			return;
 		}
 
-		if (z == 0.) {
-			velocity.z = 0;
-		} else {
-			velocity.z -= 32 * delta;
+		if (TileEntityPtr tile_entity = realm->tileEntityAt(position)) {
+			tile_entity->onOverlap(getSelf());
 		}
 
-		position.withUnique([&offset = offset](Position &position) {
-			using I = Position::IntType;
-			position.column += offset.x < 0? -static_cast<I>(-offset.x) : static_cast<I>(offset.x);
-			position.row    += offset.y < 0? -static_cast<I>(-offset.y) : static_cast<I>(offset.y);
-		});
+		if (game->getSide() == Side::Server) {
+			game->toServer().entityMotionSettled(*this, MovementContext{
+				.excludePlayer = isPlayer()? getGID() : -1,
+				.clearOffset = false,
+			});
+		}
+	}
 
-		double dummy;
-		offset.x = std::modf(offset.x, &dummy);
-		offset.y = std::modf(offset.y, &dummy);
+	bool Entity::needsMovementCorrection(double threshold, bool compare_offsets) const {
+		const Position actual = getPosition();
+		const Position predicted = replicatedPosition.copyBase();
+		const Vector3 actual_offset = compare_offsets? getOffset() : Vector3{};
+		const Vector3 predicted_offset = compare_offsets? replicatedOffset.copyBase() : Vector3{};
+		const double row_difference = actual.row + actual_offset.y - predicted.row - predicted_offset.y;
+		const double column_difference = actual.column + actual_offset.x - predicted.column - predicted_offset.x;
+		const double height_difference = actual_offset.z - predicted_offset.z;
+		return threshold * threshold < row_difference * row_difference + column_difference * column_difference + height_difference * height_difference;
 	}
 
 	Direction Entity::getSecondaryDirection() const {
@@ -1,8 +1,11 @@
 #include "entity/ExplosionParticle.h"
 #include "game/Game.h"
+#include "realm/Realm.h"
+
+#ifndef GAME3_HEADLESS
 #include "graphics/RendererContext.h"
 #include "graphics/SingleSpriteRenderer.h"
-#include "realm/Realm.h"
+#endif
 
 namespace Game3 {
 	namespace {
@@ -21,6 +24,7 @@ namespace Game3 {
 		}
 	}
 
+#ifndef GAME3_HEADLESS
 	void ExplosionParticle::render(const RendererContext &context) {
 		if (!texture || !isVisible() || age < 0) {
 			return;
@@ -48,6 +52,7 @@ namespace Game3 {
 	}
 
 	void ExplosionParticle::renderShadow(const RendererContext &) {}
+#endif
 
 	bool ExplosionParticle::isVisible() const {
 		return age >= 0 && Entity::isVisible();
@@ -1,11 +1,14 @@
 #include "entity/FluidParticle.h"
 #include "entity/LivingEntity.h"
 #include "game/Game.h"
+#include "threading/ThreadContext.h"
+
+#ifndef GAME3_HEADLESS
 #include "graphics/CircleRenderer.h"
 #include "graphics/RectangleRenderer.h"
 #include "graphics/RendererContext.h"
 #include "graphics/RenderOptions.h"
-#include "threading/ThreadContext.h"
+#endif
 
 namespace Game3 {
 	FluidParticle::FluidParticle(FluidID fluidID, const Vector3 &initialVelocity, float size, Color color, double depth, double lingerTime):
@@ -15,6 +18,7 @@ namespace Game3 {
 		color(color),
 		fluidID(fluidID) {}
 
+#ifndef GAME3_HEADLESS
 	void FluidParticle::render(const RendererContext &renderers) {
 		if (!isVisible()) {
 			return;
@@ -31,6 +35,7 @@ namespace Game3 {
 			.color = color,
 		});
 	}
+#endif
 
 	std::shared_ptr<Texture> FluidParticle::getTexture() {
 		return {};
@@ -1,17 +1,20 @@
 #include "entity/ItemEntity.h"
 #include "entity/Player.h"
-#include "game/ClientGame.h"
 #include "game/Inventory.h"
 #include "graphics/ItemTexture.h"
-#include "graphics/RendererContext.h"
-#include "graphics/SpriteRenderer.h"
 #include "item/Item.h"
 #include "net/Buffer.h"
 #include "realm/Realm.h"
 #include "registry/Registries.h"
-#include "ui/Window.h"
 #include "util/Log.h"
 
+#ifndef GAME3_HEADLESS
+#include "game/ClientGame.h"
+#include "graphics/RendererContext.h"
+#include "graphics/SpriteRenderer.h"
+#include "ui/Window.h"
+#endif
+
 namespace Game3 {
 	ItemEntity::ItemEntity(const GamePtr &game):
 		Entity(ID()), stack(ItemStack::create(game)) {}
@@ -25,6 +28,9 @@ namespace Game3 {
 	}
 
 	void ItemEntity::setTexture(const GamePtr &game) {
+#ifdef GAME3_HEADLESS
+		(void) game;
+#else
 		if (getSide() != Side::Client) {
 			return;
 		}
@@ -35,6 +41,7 @@ namespace Game3 {
 		offsetY = item_texture->y / 2.f;
 		sizeX = float(item_texture->width);
 		sizeY = float(item_texture->height);
+#endif
 	}
 
 	std::shared_ptr<ItemEntity> ItemEntity::create(const GamePtr &) {
@@ -63,9 +70,12 @@ namespace Game3 {
 		Entity::init(game);
 		if (!stack) {
 			stack = ItemStack::create(game);
-		} else if (stack->item && getSide() == Side::Client) {
+		}
+#ifndef GAME3_HEADLESS
+		else if (stack->item && getSide() == Side::Client) {
 			stack->item->getOffsets(*game, texture, offsetX, offsetY);
 		}
+#endif
 	}
 
 	void ItemEntity::tick(const TickArgs &args) {
@@ -83,6 +93,7 @@ namespace Game3 {
 		}
 	}
 
+#ifndef GAME3_HEADLESS
 	void ItemEntity::render(const RendererContext &renderers) {
 		SpriteRenderer &sprite_renderer = renderers.batchSprite;
 
@@ -113,6 +124,7 @@ namespace Game3 {
 			.scaleY = .75f * 16.f / sizeY,
 		});
 	}
+#endif
 
 	bool ItemEntity::interact(const std::shared_ptr<Player> &player) {
 		if (getSide() != Side::Server) {
@@ -0,0 +1,193 @@
+#include "entity/Entity.h"
+#include "entity/KinematicsStore.h"
+#include "realm/Realm.h"
+
+#include <algorithm>
+
+namespace Game3 {
+	void KinematicsStore::Arrays::resize(size_t new_size) {
+		offsetX.resize(new_size);
+		offsetY.resize(new_size);
+		offsetZ.resize(new_size);
+		velocityX.resize(new_size);
+		velocityY.resize(new_size);
+		velocityZ.resize(new_size);
+		speed.resize(new_size);
+		stepRow.resize(new_size);
+		stepColumn.resize(new_size);
+		groundedBefore.resize(new_size);
+		groundedAfter.resize(new_size);
+	}
+
+	void KinematicsStore::track(const std::shared_ptr<Entity> &entity) {
+		if (!entity->kinematicsTracked.exchange(true)) {
+			pending.push(entity);
+		}
+	}
+
+	void KinematicsStore::step(Realm &realm, float delta) {
+		gather(realm);
+
+		if (gathered.empty()) {
+			return;
+		}
+
+		integrate(arrays, delta);
+		scatter();
+
+		for (size_t i = 0; i < gathered.size(); ++i) {
+			if (arrays.groundedBefore[i] != arrays.groundedAfter[i]) {
+				gathered[i]->groundedChanged(arrays.groundedAfter[i] != 0);
+			}
+		}
+
+		// Retire entities that have come to rest. The speed array stays aligned with the members for the next step.
+		size_t kept = 0;
+		for (size_t i = 0; i < gathered.size(); ++i) {
+			const bool at_rest =
+				arrays.offsetX[i] == 0. && arrays.offsetY[i] == 0. && arrays.offsetZ[i] == 0. &&
+				arrays.velocityX[i] == 0. && arrays.velocityY[i] == 0. && arrays.velocityZ[i] == 0.;
+
+			if (at_rest) {
+				gathered[i]->kinematicsTracked = false;
+				continue;
+			}
+
+			members[kept] = gathered[i];
+			arrays.speed[kept] = arrays.speed[i];
+			++kept;
+		}
+
+		members.resize(kept);
+		arrays.speed.resize(kept);
+		gathered.clear();
+	}
+
+	void KinematicsStore::integrate(Arrays &arrays, float delta) {
+		const size_t count = arrays.size();
+		double *offset_x = arrays.offsetX.data();
+		double *offset_y = arrays.offsetY.data();
+		double *offset_z = arrays.offsetZ.data();
+		double *velocity_x = arrays.velocityX.data();
+		double *velocity_y = arrays.velocityY.data();
+		double *velocity_z = arrays.velocityZ.data();
+		const float *speed = arrays.speed.data();
+		Position::IntType *step_row = arrays.stepRow.data();
+		Position::IntType *step_column = arrays.stepColumn.data();
+		uint8_t *grounded_before = arrays.groundedBefore.data();
+		uint8_t *grounded_after = arrays.groundedAfter.data();
+
+		for (size_t i = 0; i < count; ++i) {
+			// Walking offsets decay toward zero at the entity's movement speed.
+			const double decay = delta * speed[i];
+			double x = offset_x[i];
+			double y = offset_y[i];
+			x = x < 0.? std::min(x + decay, 0.) : std::max(x - decay, 0.);
+			y = y < 0.? std::min(y + decay, 0.) : std::max(y - decay, 0.);
+
+			grounded_before[i] = offset_z[i] < 0.01;
+			const double z = std::max(offset_z[i] + delta * velocity_z[i], 0.);
+			const bool airborne = z > 0.;
+			x += airborne? delta * velocity_x[i] : 0.;
+			y += airborne? delta * velocity_y[i] : 0.;
+			velocity_x[i] = airborne? velocity_x[i] : 0.;
+			velocity_y[i] = airborne? velocity_y[i] : 0.;
+			grounded_after[i] = z < 0.01;
+			velocity_z[i] = z == 0.? 0. : velocity_z[i] - 32. * delta;
+			offset_z[i] = z;
+
+			// Carry whole tiles into the position and keep the fractional part (truncating toward zero, like std::modf).
+			const auto whole_x = static_cast<Position::IntType>(x);
+			const auto whole_y = static_cast<Position::IntType>(y);
+			step_column[i] = whole_x;
+			step_row[i] = whole_y;
+			offset_x[i] = x - whole_x;
+			offset_y[i] = y - whole_y;
+		}
+	}
+
+	void KinematicsStore::gather(Realm &realm) {
+		const size_t known = members.size();
+
+		for (std::weak_ptr<Entity> &weak: pending.steal()) {
+			members.push_back(std::move(weak));
+		}
+
+		arrays.resize(members.size());
+		gathered.clear();
+		gathered.reserve(members.size());
+
+		for (size_t i = 0; i < members.size(); ++i) {
+			EntityPtr entity = members[i].lock();
+
+			if (!entity) {
+				continue;
+			}
+
+			// Ridden entities are carried by their riders, and entities that have left the realm are some other store's problem.
+			if (entity->realmID != realm.id || entity->getRidden()) {
+				entity->kinematicsTracked = false;
+				continue;
+			}
+
+			const size_t index = gathered.size();
+			// Speeds are sampled once when an entity starts moving rather than through a virtual call every tick.
+			arrays.speed[index] = i < known? arrays.speed[i] : entity->getMovementSpeed();
+
+			{
+				auto offset_lock = entity->offset.sharedLock();
+				arrays.offsetX[index] = entity->offset.x;
+				arrays.offsetY[index] = entity->offset.y;
+				arrays.offsetZ[index] = entity->offset.z;
+			}
+
+			{
+				auto velocity_lock = entity->velocity.sharedLock();
+				arrays.velocityX[index] = entity->velocity.x;
+				arrays.velocityY[index] = entity->velocity.y;
+				arrays.velocityZ[index] = entity->velocity.z;
+			}
+
+			gathered.push_back(std::move(entity));
+		}
+
+		arrays.resize(gathered.size());
+		snapshot = arrays;
+	}
+
+	void KinematicsStore::scatter() {
+		for (size_t i = 0; i < gathered.size(); ++i) {
+			Entity &entity = *gathered[i];
+
+			auto offset_lock = entity.offset.uniqueLock();
+			auto velocity_lock = entity.velocity.uniqueLock();
+
+			Vector3 &offset = entity.offset;
+			Vector3 &velocity = entity.velocity;
+
+			// Something else (a move, a knockback, a teleport) changed the entity since it was gathered.
+			// Its write wins; the entity is integrated again next step with its new state.
+			if (offset.x != snapshot.offsetX[i] || offset.y != snapshot.offsetY[i] || offset.z != snapshot.offsetZ[i] ||
+			    velocity.x != snapshot.velocityX[i] || velocity.y != snapshot.velocityY[i] || velocity.z != snapshot.velocityZ[i]) {
+				arrays.groundedAfter[i] = arrays.groundedBefore[i];
+				arrays.offsetX[i] = offset.x;
+				arrays.offsetY[i] = offset.y;
+				arrays.offsetZ[i] = offset.z;
+				arrays.velocityX[i] = velocity.x;
+				arrays.velocityY[i] = velocity.y;
+				arrays.velocityZ[i] = velocity.z;
+				continue;
+			}
+
+			offset = {arrays.offsetX[i], arrays.offsetY[i], arrays.offsetZ[i]};
+			velocity = {arrays.velocityX[i], arrays.velocityY[i], arrays.velocityZ[i]};
+
+			if (arrays.stepRow[i] != 0 || arrays.stepColumn[i] != 0) {
+				entity.position.withUnique([&](Position &position) {
+					position.row += arrays.stepRow[i];
+					position.column += arrays.stepColumn[i];
+				});
+			}
+		}
+	}
+}
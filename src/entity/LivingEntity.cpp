@@ -3,9 +3,6 @@
 #include "entity/TextParticle.h"
 #include "entity/Util.h"
 #include "game/ServerGame.h"
-#include "graphics/RectangleRenderer.h"
-#include "graphics/RenderOptions.h"
-#include "graphics/RendererContext.h"
 #include "lib/JSON.h"
 #include "packet/LivingEntityHealthChangedPacket.h"
 #include "packet/StatusEffectsPacket.h"
@@ -14,6 +11,12 @@
 #include "threading/ThreadContext.h"
 #include "util/ConstexprHash.h"
 
+#ifndef GAME3_HEADLESS
+#include "graphics/RectangleRenderer.h"
+#include "graphics/RenderOptions.h"
+#include "graphics/RendererContext.h"
+#endif
+
 namespace {
 	constexpr float BASE_EXPLOSION_DAMAGE = 10;
 	constexpr std::chrono::milliseconds MUTATION_PERIOD{200};
@@ -85,6 +88,7 @@ namespace Game3 {
 		return true;
 	}
 
+#ifndef GAME3_HEADLESS
 	void LivingEntity::renderUpper(const RendererContext &renderers) {
 		Entity::renderUpper(renderers);
 
@@ -130,6 +134,7 @@ namespace Game3 {
 			.color = {1, 0, 0, 1},
 		});
 	}
+#endif
 
 	void LivingEntity::encode(Buffer &buffer) {
 		auto this_lock = sharedLock();
@@ -1,7 +1,11 @@
 #include "entity/LivingTitledEntity.h"
+
+#ifndef GAME3_HEADLESS
 #include "game/ClientGame.h"
+#endif
 
 namespace Game3 {
+#ifndef GAME3_HEADLESS
 	void LivingTitledEntity::renderUpper(const RendererContext &renderers) {
 		if (!isVisible()) {
 			return;
@@ -10,6 +14,7 @@ namespace Game3 {
 		LivingEntity::renderUpper(renderers);
 		TitledEntity::renderUpper(renderers);
 	}
+#endif
 
 	float LivingTitledEntity::getTitleVerticalOffset() const {
 		return  canShowHealthBar()? -.5 : 0;
@@ -1,10 +1,14 @@
 #include "entity/Merchant.h"
-#include "game/ClientGame.h"
-#include "game/ClientInventory.h"
+#include "game/Game.h"
 #include "lib/JSON.h"
 #include "net/Buffer.h"
 #include "realm/Realm.h"
+
+#ifndef GAME3_HEADLESS
+#include "game/ClientGame.h"
+#include "game/ClientInventory.h"
 #include "ui/Window.h"
+#endif
 
 namespace Game3 {
 	Merchant::Merchant(EntityType type_):
@@ -2,8 +2,7 @@
 
 #include "algorithm/Stonks.h"
 #include "entity/Miner.h"
-#include "game/ClientGame.h"
-#include "game/ClientInventory.h"
+#include "game/Game.h"
 #include "game/Inventory.h"
 #include "graphics/Tileset.h"
 #include "lib/JSON.h"
@@ -14,9 +13,14 @@
 #include "tileentity/Chest.h"
 #include "tileentity/OreDeposit.h"
 #include "tileentity/Teleporter.h"
-#include "ui/Window.h"
 #include "util/Util.h"
 
+#ifndef GAME3_HEADLESS
+#include "game/ClientGame.h"
+#include "game/ClientInventory.h"
+#include "ui/Window.h"
+#endif
+
 namespace Game3 {
 	Miner::Miner():
 		Entity(ID()), Worker(ID()) {}
@@ -0,0 +1,168 @@
+#include "entity/ParticleSystem.h"
+#include "threading/ThreadContext.h"
+
+#ifndef GAME3_HEADLESS
+#include "graphics/RectangleRenderer.h"
+#endif
+
+#include <algorithm>
+
+namespace Game3 {
+	void ParticleSystem::Arrays::push(const Square &square) {
+		x.push_back(square.x);
+		y.push_back(square.y);
+		z.push_back(square.z);
+		velocityX.push_back(square.velocityX);
+		velocityY.push_back(square.velocityY);
+		velocityZ.push_back(square.velocityZ);
+		sideLength.push_back(square.size);
+		color.push_back(square.color);
+		depth.push_back(square.depth);
+		age.push_back(0);
+		lingerTime.push_back(square.lingerTime);
+	}
+
+	void ParticleSystem::Arrays::resize(size_t new_size) {
+		x.resize(new_size);
+		y.resize(new_size);
+		z.resize(new_size);
+		velocityX.resize(new_size);
+		velocityY.resize(new_size);
+		velocityZ.resize(new_size);
+		sideLength.resize(new_size);
+		color.resize(new_size);
+		depth.resize(new_size);
+		age.resize(new_size);
+		lingerTime.resize(new_size);
+	}
+
+	void ParticleSystem::Arrays::swapRemove(size_t index) {
+		const size_t last = x.size() - 1;
+
+		if (index != last) {
+			x[index] = x[last];
+			y[index] = y[last];
+			z[index] = z[last];
+			velocityX[index] = velocityX[last];
+			velocityY[index] = velocityY[last];
+			velocityZ[index] = velocityZ[last];
+			sideLength[index] = sideLength[last];
+			color[index] = color[last];
+			depth[index] = depth[last];
+			age[index] = age[last];
+			lingerTime[index] = lingerTime[last];
+		}
+
+		resize(last);
+	}
+
+	void ParticleSystem::spawn(const Square &square) {
+		pending.push(square);
+	}
+
+	void ParticleSystem::spawnBurst(const Position &position, const Vector3 &offset, std::span<const Color> colors, float linger_time, float size) {
+		std::uniform_real_distribution y_distribution(-0.15f, 0.15f);
+		std::uniform_real_distribution z_distribution(6.f, 10.f);
+		std::uniform_real_distribution depth_distribution(-0.5f, 0.f);
+		std::uniform_real_distribution left_distribution(-2.f, 0.f);
+		std::uniform_real_distribution right_distribution(0.f, 2.f);
+
+		for (size_t i = 0; i < colors.size(); ++i) {
+			spawn(Square{
+				.x = position.column + offset.x,
+				.y = position.row + offset.y,
+				.z = static_cast<float>(offset.z),
+				.velocityX = 2 * i < colors.size()? left_distribution(threadContext.rng) : right_distribution(threadContext.rng),
+				.velocityY = y_distribution(threadContext.rng),
+				.velocityZ = z_distribution(threadContext.rng),
+				.size = size,
+				.color = colors[i],
+				.depth = depth_distribution(threadContext.rng),
+				.lingerTime = linger_time,
+			});
+		}
+	}
+
+	void ParticleSystem::step(float delta) {
+		std::deque<Square> stolen = pending.steal();
+
+		auto lock = arrays.uniqueLock();
+
+		for (const Square &square: stolen) {
+			arrays.push(square);
+		}
+
+		if (arrays.size() == 0) {
+			return;
+		}
+
+		simulate(arrays, delta);
+		retire(arrays);
+	}
+
+	size_t ParticleSystem::size() const {
+		auto lock = arrays.sharedLock();
+		return arrays.size();
+	}
+
+	void ParticleSystem::simulate(Arrays &arrays, float delta) {
+		const size_t count = arrays.size();
+		double *x = arrays.x.data();
+		double *y = arrays.y.data();
+		float *z = arrays.z.data();
+		float *velocity_x = arrays.velocityX.data();
+		float *velocity_y = arrays.velocityY.data();
+		float *velocity_z = arrays.velocityZ.data();
+		const float *depth = arrays.depth.data();
+		float *age = arrays.age.data();
+
+		for (size_t i = 0; i < count; ++i) {
+			velocity_z[i] -= GRAVITY * delta;
+			z[i] = std::max(z[i] + delta * velocity_z[i], depth[i]);
+			x[i] += delta * velocity_x[i];
+			y[i] += delta * velocity_y[i];
+
+			// Squares stop dead when they land and only start aging once they're on the ground.
+			const bool landed = z[i] <= depth[i];
+			velocity_x[i] = landed? 0.f : velocity_x[i];
+			velocity_y[i] = landed? 0.f : velocity_y[i];
+			velocity_z[i] = landed? 0.f : velocity_z[i];
+			age[i] += landed? delta : 0.f;
+		}
+	}
+
+	size_t ParticleSystem::retire(Arrays &arrays) {
+		size_t removed = 0;
+
+		for (size_t i = arrays.size(); 0 < i--;) {
+			if (arrays.lingerTime[i] <= arrays.age[i]) {
+				arrays.swapRemove(i);
+				++removed;
+			}
+		}
+
+		return removed;
+	}
+
+#ifndef GAME3_HEADLESS
+	void ParticleSystem::render(RectangleRenderer &rectangle) const {
+		std::vector<RectangleInstance> instances;
+
+		{
+			auto lock = arrays.sharedLock();
+			instances.reserve(arrays.size());
+			for (size_t i = 0; i < arrays.size(); ++i) {
+				instances.push_back({
+					.x = static_cast<float>(arrays.x[i] + .5),
+					.y = static_cast<float>(arrays.y[i] - arrays.z[i]),
+					.width = arrays.sideLength[i],
+					.height = arrays.sideLength[i],
+					.color = arrays.color[i],
+				});
+			}
+		}
+
+		rectangle.drawBatchOnMap(instances);
+	}
+#endif
+}
@@ -1,12 +1,15 @@
 #include "entity/Pig.h"
 #include "game/Game.h"
-#include "graphics/BatchSpriteRenderer.h"
 #include "graphics/Color.h"
-#include "graphics/Recolor.h"
-#include "graphics/RendererContext.h"
 #include "threading/ThreadContext.h"
 #include "util/Util.h"
 
+#ifndef GAME3_HEADLESS
+#include "graphics/BatchSpriteRenderer.h"
+#include "graphics/Recolor.h"
+#include "graphics/RendererContext.h"
+#endif
+
 namespace Game3 {
 	std::vector<Identifier> Pig::variants{
 		"base:texture/pig_pink",
@@ -45,6 +48,7 @@ namespace Game3 {
 		function(species);
 	}
 
+#ifndef GAME3_HEADLESS
 	void Pig::render(const RendererContext &renderers) {
 		if (!texture) {
 			// It's assumed they're all the same variety.
@@ -54,6 +58,7 @@ namespace Game3 {
 
 		Animal::render(renderers);
 	}
+#endif
 
 	void Pig::encode(Buffer &buffer) {
 		Animal::encode(buffer);
@@ -1,24 +1,27 @@
-#include "entity/ClientPlayer.h"
 #include "entity/ItemEntity.h"
 #include "entity/Player.h"
 #include "entity/ServerPlayer.h"
 #include "error/InsufficientFundsError.h"
-#include "game/ClientGame.h"
 #include "game/Inventory.h"
 #include "game/ServerGame.h"
 #include "item/Tool.h"
 #include "lib/JSON.h"
 #include "net/Buffer.h"
-#include "net/LocalClient.h"
 #include "net/RemoteClient.h"
 #include "packet/AddKnownItemPacket.h"
 #include "packet/RealmNoticePacket.h"
 #include "packet/SetPlayerStationTypesPacket.h"
 #include "realm/Realm.h"
-#include "ui/Window.h"
 #include "util/Cast.h"
 #include "util/Log.h"
 
+#ifndef GAME3_HEADLESS
+#include "entity/ClientPlayer.h"
+#include "game/ClientGame.h"
+#include "net/LocalClient.h"
+#include "ui/Window.h"
+#endif
+
 namespace Game3 {
 	Player::Player():
 		Entity(ID()),
@@ -181,6 +184,7 @@ namespace Game3 {
 		Entity::teleport(position, new_realm, context);
 
 		if ((old_realm_id == 0 || old_realm_id != nextRealm) && nextRealm != 0) {
+#ifndef GAME3_HEADLESS
 			if (game->getSide() == Side::Client) {
 				ClientGame &client_game = game->toClient();
 				// Second condition is a hack. Sometimes the player gets interrealm teleported twice in the same tick.
@@ -195,7 +199,9 @@ namespace Game3 {
 					focus(*client_game.getWindow(), true);
 					client_game.requestFromLimbo(new_realm->id);
 				}
-			} else {
+			} else
+#endif
+			{
 				if (locked_realm) {
 					locked_realm->queuePlayerRemoval(getShared());
 				}
@@ -319,10 +325,13 @@ namespace Game3 {
 				locked->send(packet);
 				return true;
 			}
-		} else {
+		}
+#ifndef GAME3_HEADLESS
+		else {
 			getGame()->toClient().getClient()->send(packet);
 			return true;
 		}
+#endif
 
 		return false;
 	}
@@ -359,9 +368,11 @@ namespace Game3 {
 		return safeDynamicCast<Player>(shared_from_this());
 	}
 
+#ifndef GAME3_HEADLESS
 	std::shared_ptr<ClientPlayer> Player::toClient() {
 		return safeDynamicCast<ClientPlayer>(shared_from_this());
 	}
+#endif
 
 	std::shared_ptr<ServerPlayer> Player::toServer() {
 		return safeDynamicCast<ServerPlayer>(shared_from_this());
@@ -1,11 +1,14 @@
 #include "entity/Projectile.h"
+#include "graphics/ItemTexture.h"
+#include "registry/Registries.h"
+
+#ifndef GAME3_HEADLESS
 #include "game/ClientGame.h"
 #include "graphics/BatchSpriteRenderer.h"
-#include "graphics/ItemTexture.h"
 #include "graphics/RendererContext.h"
 #include "graphics/SpriteRenderer.h"
-#include "registry/Registries.h"
 #include "ui/Window.h"
+#endif
 
 namespace {
 	constexpr double GRAVITY = 32;
@@ -66,6 +69,7 @@ namespace Game3 {
 		enqueueTick();
 	}
 
+#ifndef GAME3_HEADLESS
 	void Projectile::render(const RendererContext &renderers) {
 		SpriteRenderer &sprite_renderer = renderers.batchSprite;
 
@@ -97,6 +101,7 @@ namespace Game3 {
 			.angle = angle,
 		});
 	}
+#endif
 
 	void Projectile::onSpawn() {
 		Entity::onSpawn();
@@ -155,6 +160,7 @@ namespace Game3 {
 		return ItemStack::create(game, getItemID())->getItemTexture(*game)->getTexture();
 	}
 
+#ifndef GAME3_HEADLESS
 	void Projectile::setTexture(const ClientGamePtr &game) {
 		std::shared_ptr<ItemTexture> item_texture = game->registry<ItemTextureRegistry>().at(getItemID());
 		texture = getTexture();
@@ -164,6 +170,7 @@ namespace Game3 {
 		sizeX = float(item_texture->width);
 		sizeY = float(item_texture->height);
 	}
+#endif
 
 	void Projectile::applyKnockback(const EntityPtr &target, float factor) {
 		assert(target.get() != this);
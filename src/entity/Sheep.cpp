@@ -1,12 +1,15 @@
 #include "entity/Sheep.h"
 #include "game/Game.h"
-#include "graphics/BatchSpriteRenderer.h"
 #include "graphics/Color.h"
-#include "graphics/Recolor.h"
-#include "graphics/RendererContext.h"
 #include "threading/ThreadContext.h"
 #include "util/Util.h"
 
+#ifndef GAME3_HEADLESS
+#include "graphics/BatchSpriteRenderer.h"
+#include "graphics/Recolor.h"
+#include "graphics/RendererContext.h"
+#endif
+
 namespace Game3 {
 	Sheep::Sheep():
 		Entity(ID()),
@@ -16,6 +19,7 @@ namespace Game3 {
 		valueMultiplier("valueMultiplier", .1f, 1.f, sample()),
 		species("species", ID().str()) {}
 
+#ifndef GAME3_HEADLESS
 	void Sheep::render(const RendererContext &renderers) {
 		if (texture == nullptr || !isVisible())
 			return;
@@ -123,6 +127,7 @@ namespace Game3 {
 		}
 		renderers.recolor.drawOnMap(texture, mask, options, hue.getValue(), saturation.getValue(), valueMultiplier.getValue());
 	}
+#endif
 
 	bool Sheep::canAbsorbGenes(const boost::json::value &genes) const {
 		return checkGenes(genes, {"hue", "saturation", "valueMultiplier", "species"});
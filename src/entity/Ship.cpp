@@ -1,11 +1,14 @@
 #include "entity/Player.h"
 #include "entity/Ship.h"
 #include "game/Game.h"
+#include "realm/Realm.h"
+#include "realm/ShipRealm.h"
+
+#ifndef GAME3_HEADLESS
 #include "graphics/BatchSpriteRenderer.h"
 #include "graphics/RendererContext.h"
 #include "graphics/SingleSpriteRenderer.h"
-#include "realm/Realm.h"
-#include "realm/ShipRealm.h"
+#endif
 
 namespace Game3 {
 	namespace {
@@ -110,6 +113,7 @@ namespace Game3 {
 		return true;
 	}
 
+#ifndef GAME3_HEADLESS
 	void Ship::render(const RendererContext &context) {
 		if (!texture || !isVisible())
 			return;
@@ -133,6 +137,7 @@ namespace Game3 {
 			.sizeY = 16.f * y_dimension,
 		});
 	}
+#endif
 
 	void Ship::encode(Buffer &buffer) {
 		Entity::encode(buffer);
@@ -1,8 +1,11 @@
 #include "entity/SquareParticle.h"
+#include "threading/ThreadContext.h"
+
+#ifndef GAME3_HEADLESS
 #include "graphics/RendererContext.h"
 #include "graphics/RenderOptions.h"
 #include "graphics/RectangleRenderer.h"
-#include "threading/ThreadContext.h"
+#endif
 
 namespace {
 	constexpr double GRAVITY = 32;
@@ -21,6 +24,7 @@ namespace Game3 {
 		return false;
 	}
 
+#ifndef GAME3_HEADLESS
 	void SquareParticle::renderShadow(const RendererContext &) {}
 
 	void SquareParticle::render(const RendererContext &renderers) {
@@ -39,6 +43,7 @@ namespace Game3 {
 			.color = color,
 		});
 	}
+#endif
 
 	void SquareParticle::tick(const TickArgs &args) {
 		auto offset_lock = offset.uniqueLock();
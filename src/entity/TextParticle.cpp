@@ -1,7 +1,10 @@
 #include "entity/TextParticle.h"
-#include "graphics/RendererContext.h"
 #include "threading/ThreadContext.h"
 
+#ifndef GAME3_HEADLESS
+#include "graphics/RendererContext.h"
+#endif
+
 namespace {
 	constexpr double GRAVITY = 32;
 	constexpr double DEPTH = -1.666;
@@ -14,6 +17,7 @@ namespace Game3 {
 	TextParticle::TextParticle(UString text, Color color, double linger_time, TextAlign align):
 		Entity(ID()), text(std::move(text)), color(color), lingerTime(linger_time), align(align) {}
 
+#ifndef GAME3_HEADLESS
 	void TextParticle::renderShadow(const RendererContext &) {}
 
 	void TextParticle::render(const RendererContext &renderers) {
@@ -31,6 +35,7 @@ namespace Game3 {
 			.align = align,
 		});
 	}
+#endif
 
 	void TextParticle::tick(const TickArgs &args) {
 
@@ -1,9 +1,13 @@
 #include "entity/TitledEntity.h"
+
+#ifndef GAME3_HEADLESS
 #include "game/ClientGame.h"
 #include "graphics/RendererContext.h"
 #include "graphics/TextRenderer.h"
+#endif
 
 namespace Game3 {
+#ifndef GAME3_HEADLESS
 	void TitledEntity::renderUpper(const RendererContext &renderers) {
 		GamePtr game = getGame();
 		TextRenderer &text = renderers.text;
@@ -30,12 +34,15 @@ namespace Game3 {
 			.align = TextAlign::Center,
 		});
 	}
+#endif
 
 	float TitledEntity::getTitleVerticalOffset() const {
 		return 0;
 	}
 
+#ifndef GAME3_HEADLESS
 	Tick TitledEntity::getMaxMessageAge(ClientGame &game) const {
 		return 7 * game.getSettings().tickFrequency;
 	}
+#endif
 }
@@ -1,32 +1,37 @@
 #include "entity/Entity.h"
-#include "entity/SquareParticle.h"
+#include "entity/Player.h"
 #include "entity/Util.h"
+#include "packet/SquareParticlesPacket.h"
 #include "realm/Realm.h"
-#include "threading/ThreadContext.h"
 
 namespace Game3 {
 	void spawnSquares(Entity &entity, size_t count, std::function<Color()> &&color_function, double linger_time, float size) {
 		RealmPtr realm = entity.getRealm();
 		Position position = entity.getPosition();
 
-		std::uniform_real_distribution y_distribution(-0.15, 0.15);
-		std::uniform_real_distribution z_distribution(6., 10.);
-		std::uniform_real_distribution depth_distribution(-0.5, 0.0);
+		Vector3 offset = entity.offset.copyBase();
+		offset.y += 0.5;
 
-		for (double x: {-1, +1}) {
-			std::uniform_real_distribution x_distribution(x - 1.0, x + 1.0);
-			for (size_t i = 0; i < count; ++i) {
-				Vector3 velocity{
-					x_distribution(threadContext.rng),
-					y_distribution(threadContext.rng),
-					z_distribution(threadContext.rng),
-				};
-				double depth = depth_distribution(threadContext.rng);
-				realm->spawn<SquareParticle>(position, velocity, size, color_function(), depth, linger_time)->offset.withUnique([&](Vector3 &offset) {
-					offset.x = entity.offset.x;
-					offset.y = entity.offset.y + 0.5;
-					offset.z = entity.offset.z;
-				});
+		// Half of the squares fly to the left and half to the right.
+		std::vector<Color> colors;
+		colors.reserve(2 * count);
+		for (size_t i = 0; i < 2 * count; ++i) {
+			colors.push_back(color_function());
+		}
+
+		if (realm->getSide() == Side::Client) {
+			realm->particles.spawnBurst(position, offset, colors, linger_time, size);
+			return;
+		}
+
+		if (WeakSet<Player> players = realm->getPlayers().copyBase(); !players.empty()) {
+			const RealmID realm_id = realm->getID();
+			auto packet = make<SquareParticlesPacket>(realm_id, position, offset, size, float(linger_time), std::move(colors));
+			// Only players who could have seen the old particle entities get the burst.
+			for (const std::weak_ptr<Player> &weak_player: players) {
+				if (PlayerPtr player = weak_player.lock(); player && player->canSee(realm_id, position)) {
+					player->send(packet);
+				}
 			}
 		}
 	}
@@ -2,8 +2,6 @@
 
 #include "algorithm/Stonks.h"
 #include "entity/Woodcutter.h"
-#include "game/ClientGame.h"
-#include "game/ClientInventory.h"
 #include "game/Game.h"
 #include "game/Inventory.h"
 #include "graphics/Tileset.h"
@@ -15,9 +13,14 @@
 #include "tileentity/Chest.h"
 #include "tileentity/OreDeposit.h"
 #include "tileentity/Teleporter.h"
+#include "util/Util.h"
+
+#ifndef GAME3_HEADLESS
+#include "game/ClientGame.h"
+#include "game/ClientInventory.h"
 #include "ui/GameUI.h"
 #include "ui/Window.h"
-#include "util/Util.h"
+#endif
 
 namespace Game3 {
 	Woodcutter::Woodcutter():
@@ -65,6 +68,7 @@ namespace Game3 {
 	bool Woodcutter::onInteractNextTo(const std::shared_ptr<Player> &player, Modifiers, const ItemStackPtr &, Hand) {
 		(void) player;
 
+#ifndef GAME3_HEADLESS
 		if (getSide() == Side::Client) {
 			GamePtr game = getGame();
 			auto window = game->toClient().getWindow();
@@ -78,6 +82,7 @@ namespace Game3 {
 				game_ui->showExternalInventory(std::dynamic_pointer_cast<ClientInventory>(getInventory(0)));
 			}
 		}
+#endif
 		return true;
 	}
 
@@ -1,5 +1,4 @@
 #include "game/Agent.h"
-#include "game/ClientGame.h"
 #include "game/Game.h"
 #include "game/ServerGame.h"
 #include "net/LocalClient.h"
@@ -8,6 +7,10 @@
 #include "util/ConstexprHash.h"
 #include "util/Log.h"
 
+#ifndef GAME3_HEADLESS
+#include "game/ClientGame.h"
+#endif
+
 #include <mutex>
 #include <random>
 
@@ -26,6 +26,10 @@
 #include "util/Log.h"
 #include "util/Util.h"
 
+#include <algorithm>
+#include <chrono>
+#include <tuple>
+
 namespace Game3 {
 	namespace {
 		constexpr float GARBAGE_COLLECTION_TIME = 60;
@@ -424,5 +428,52 @@ namespace Game3 {
 
 	void ClientGame::garbageCollect() {
 		sounds.cleanup();
+		evictChunks();
+	}
+
+	void ClientGame::evictChunks() {
+		if (!player) {
+			return;
+		}
+
+		RealmPtr current_realm = player->getRealm();
+		size_t budget_megabytes{};
+		{
+			auto &settings = getSettings();
+			auto lock = settings.sharedLock();
+			budget_megabytes = settings.chunkCacheMegabytes;
+		}
+
+		const size_t budget_chunks = budget_megabytes * 1024 * 1024 / TileProvider::CHUNK_BYTE_COUNT;
+		std::vector<std::tuple<std::chrono::steady_clock::time_point, RealmPtr, ChunkPosition>> cached;
+		size_t evicted = 0;
+
+		iterateRealms([&](const RealmPtr &realm) {
+			for (const auto &[last_seen, chunk_position]: realm->getEvictableChunks()) {
+				if (realm == current_realm) {
+					cached.emplace_back(last_seen, realm, chunk_position);
+				} else {
+					// The realm stays known so that the server doesn't need to announce it again; only its terrain goes.
+					realm->evictChunk(chunk_position);
+					++evicted;
+				}
+			}
+		});
+
+		if (budget_chunks < cached.size()) {
+			std::ranges::sort(cached, [](const auto &left, const auto &right) {
+				return std::get<0>(left) < std::get<0>(right);
+			});
+
+			for (size_t i = 0, count = cached.size() - budget_chunks; i < count; ++i) {
+				const auto &[last_seen, realm, chunk_position] = cached[i];
+				realm->evictChunk(chunk_position);
+				++evicted;
+			}
+		}
+
+		if (evicted != 0) {
+			INFO("Evicted {} cached chunk{}", evicted, evicted == 1? "" : "s");
+		}
 	}
 }
@@ -67,6 +67,7 @@ namespace Game3 {
 
 	void ClientInventory::clear() {
 		storage.clear();
+		invalidateSummary();
 	}
 
 	ItemCount ClientInventory::remove(const ItemStackPtr &) {
@@ -102,6 +103,8 @@ namespace Game3 {
 	}
 
 	void ClientInventory::notifyOwner(std::optional<std::variant<ItemStackPtr, Slot>>) {
+		invalidateSummary();
+
 		if (AgentPtr owner = weakOwner.lock()) {
 			owner->inventoryUpdated(index);
 
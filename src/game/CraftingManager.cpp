@@ -13,20 +13,30 @@ namespace Game3 {
 	KnownCraftingRecipes CraftingManager::getKnownRecipes() {
 		Timer timer{"GetKnownRecipes"};
 
-		if (!craftingRecipeIndex) {
-			craftingRecipeIndex = generateCraftingRecipeIndex();
-		}
+		GamePtr game = player.getGame();
+		auto &recipe_registry = game->registry<CraftingRecipeRegistry>();
+		auto &item_registry = *game->itemRegistry;
 
 		std::set<CraftingRecipePtr> all;
 
-		for (const auto &item_id: player.getKnownItems()) {
-			auto [iter, end] = craftingRecipeIndex->equal_range(item_id);
-			for (; iter != end; ++iter) {
-				all.emplace(iter->second);
+		{
+			auto &known_items = player.getKnownItems();
+			auto lock = known_items.sharedLock();
+			for (const auto &item_id: known_items) {
+				for (const CraftingRecipePtr &recipe: recipe_registry.getByIngredient(item_id)) {
+					all.emplace(recipe);
+				}
+
+				if (ItemPtr item = item_registry.maybe(item_id)) {
+					for (const Identifier &attribute: item->attributes) {
+						for (const CraftingRecipePtr &recipe: recipe_registry.getByAttribute(attribute)) {
+							all.emplace(recipe);
+						}
+					}
+				}
 			}
 		}
 
-		GamePtr game = player.getGame();
 		KnownCraftingRecipes out;
 		auto &known_items = player.getKnownItems();
 		auto lock = known_items.sharedLock();
@@ -75,53 +85,4 @@ namespace Game3 {
 
 		return out;
 	}
-
-	std::multimap<Identifier, CraftingRecipePtr> CraftingManager::generateCraftingRecipeIndex() const {
-		Timer timer{"IndexRecipes"};
-		std::multimap<Identifier, CraftingRecipePtr> out;
-
-		GamePtr game = player.getGame();
-		auto &recipe_registry = game->registry<CraftingRecipeRegistry>();
-		auto &item_registry = *game->itemRegistry;
-
-		// Maps attributes to item IDs.
-		std::multimap<Identifier, Identifier> attribute_index;
-
-		std::set<Identifier> all_attributes;
-
-		for (const CraftingRecipePtr &recipe: recipe_registry.items) {
-			for (const CraftingRequirement &requirement: recipe->input) {
-				if (requirement.is<AttributeRequirement>()) {
-					const AttributeRequirement &attribute_requirement = requirement.get<AttributeRequirement>();
-					all_attributes.emplace(attribute_requirement.attribute);
-				}
-			}
-		}
-
-		for (const Identifier &attribute: all_attributes) {
-			for (const auto &[item_id, item]: item_registry) {
-				if (item->hasAttribute(attribute)) {
-					attribute_index.emplace(attribute, item_id);
-				}
-			}
-		}
-
-		for (const CraftingRecipePtr &recipe: recipe_registry.items) {
-			for (const CraftingRequirement &requirement: recipe->input) {
-				if (requirement.is<ItemStackPtr>()) {
-					const ItemStackPtr &item = requirement.get<ItemStackPtr>();
-					out.emplace(item->getID(), recipe);
-				} else {
-					const AttributeRequirement &attribute_requirement = requirement.get<AttributeRequirement>();
-					auto [iter, end] = attribute_index.equal_range(attribute_requirement.attribute);
-					assert(iter != end);
-					for (; iter != end; ++iter) {
-						out.emplace(iter->second, recipe);
-					}
-				}
-			}
-		}
-
-		return out;
-	}
 }
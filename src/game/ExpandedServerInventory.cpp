@@ -3,7 +3,13 @@
 
 namespace Game3 {
 	std::unique_ptr<Inventory> ExpandedServerInventory::copy() const {
-		return std::make_unique<ExpandedServerInventory>(*this);
+		auto out = std::make_unique<ExpandedServerInventory>(*this);
+		for (auto &[slot, stack]: out->storage) {
+			if (stack) {
+				stack = stack->copy();
+			}
+		}
+		return out;
 	}
 
 	ItemStackPtr ExpandedServerInventory::add(const ItemStackPtr &stack, const std::function<bool(Slot)> &predicate, Slot start) {
@@ -83,6 +89,22 @@ namespace Game3 {
 		return iter->second->canMerge(*stack);
 	}
 
+	bool ExpandedServerInventory::canExchange(const std::vector<CraftingRequirement> &to_remove, const std::vector<ItemStackPtr> &to_add) const {
+		std::unique_ptr<Inventory> simulated = copy();
+
+		for (const CraftingRequirement &requirement: to_remove) {
+			simulated->remove(requirement);
+		}
+
+		for (const ItemStackPtr &stack: to_add) {
+			if (simulated->add(stack)) {
+				return false;
+			}
+		}
+
+		return true;
+	}
+
 	template <>
 	std::string BasicBuffer::getType(const ExpandedServerInventory &, bool) {
 		return "\xe1";
@@ -1,12 +1,17 @@
 #include "algorithm/AStar.h"
 #include "fluid/Fluid.h"
-#include "game/ClientGame.h"
 #include "game/Game.h"
 #include "game/InteractionSet.h"
 #include "game/Inventory.h"
 #include "game/ServerGame.h"
 #include "graphics/Tileset.h"
 #include "lib/JSON.h"
+#include "util/FS.h"
+#include "util/Timer.h"
+#include "util/Util.h"
+
+#ifndef GAME3_HEADLESS
+#include "game/ClientGame.h"
 #include "ui/module/AutocrafterModule.h"
 #include "ui/module/ChemicalReactorModule.h"
 #include "ui/module/CombinerModule.h"
@@ -22,9 +27,7 @@
 #include "ui/module/RadiusMachineModule.h"
 #include "ui/module/TextModule.h"
 #include "ui/module/VillageTradeModule.h"
-#include "util/FS.h"
-#include "util/Timer.h"
-#include "util/Util.h"
+#endif
 
 namespace Game3 {
 	namespace {
@@ -54,6 +57,7 @@ namespace Game3 {
 	}
 
 	void Game::addModuleFactories() {
+#ifndef GAME3_HEADLESS
 		add(ModuleFactory::create<AutocrafterModule>());
 		add(ModuleFactory::create<ChemicalReactorModule>());
 		add(ModuleFactory::create<CombinerModule>());
@@ -75,6 +79,7 @@ namespace Game3 {
 		add(ModuleFactory::create<VillageTradeModule>());
 #ifdef GAME3_ENABLE_SCRIPTING
 		// add(GTKModuleFactory::create<ComputerModule>());
+#endif
 #endif
 	}
 
@@ -115,10 +120,12 @@ namespace Game3 {
 		}
 	}
 
+#ifndef GAME3_HEADLESS
 	void Game::add(ModuleFactory &&factory) {
 		auto shared = std::make_shared<ModuleFactory>(std::move(factory));
 		registry<ModuleFactoryRegistry>().add(shared->identifier, shared);
 	}
+#endif
 
 	void Game::addRecipe(const boost::json::value &json) {
 		Identifier identifier(std::string_view(json.at(0).as_string()));
@@ -182,7 +189,11 @@ namespace Game3 {
 		GamePtr out;
 
 		if (side == Side::Client) {
+#ifdef GAME3_HEADLESS
+			throw std::invalid_argument("Can't create a client game in a headless build");
+#else
 			out = GamePtr(new ClientGame(std::get<std::shared_ptr<Window>>(argument)));
+#endif
 		} else {
 			const auto [server_ptr, pool_size] = std::get<std::pair<std::shared_ptr<Server>, size_t>>(argument);
 			ServerGamePtr server_game = std::make_shared<ServerGame>(server_ptr, pool_size);
@@ -226,6 +237,7 @@ namespace Game3 {
 		return out;
 	}
 
+#ifndef GAME3_HEADLESS
 	ClientGame & Game::toClient() {
 		return dynamic_cast<ClientGame &>(*this);
 	}
@@ -238,6 +250,7 @@ namespace Game3 {
 		assert(getSide() == Side::Client);
 		return std::static_pointer_cast<ClientGame>(shared_from_this());
 	}
+#endif
 
 	ServerGame & Game::toServer() {
 		return dynamic_cast<ServerGame &>(*this);
@@ -1,3 +1,6 @@
+#include "game/Game.h"
+
+#ifndef GAME3_HEADLESS
 #include "command/local/ChemicalCommand.h"
 #include "command/local/LocalCommandFactory.h"
 #include "command/local/LoginCommand.h"
@@ -7,15 +10,18 @@
 #include "command/local/SegfaultCommand.h"
 #include "command/local/UsageCommand.h"
 #include "command/local/WikiCommand.h"
-#include "game/Game.h"
+#endif
 
 namespace Game3 {
+#ifndef GAME3_HEADLESS
 	void Game::add(LocalCommandFactory &&factory) {
 		auto shared = std::make_shared<LocalCommandFactory>(std::move(factory));
 		registry<LocalCommandFactoryRegistry>().add(shared->name, shared);
 	}
+#endif
 
 	void Game::addLocalCommandFactories() {
+#ifndef GAME3_HEADLESS
 		add(LocalCommandFactory::create<RegisterCommand>());
 		add(LocalCommandFactory::create<LoginCommand>());
 		add(LocalCommandFactory::create<UsageCommand>());
@@ -24,5 +30,6 @@ namespace Game3 {
 		add(LocalCommandFactory::create<SegfaultCommand>());
 		add(LocalCommandFactory::create<ScaleCommand>());
 		add(LocalCommandFactory::create<WikiCommand>());
+#endif
 	}
 }
@@ -184,7 +184,9 @@ namespace Game3 {
 						texture = std::make_shared<Texture>(texture_key, std::move(path), value.at(1).as_bool(), getNumber<int>(value.at(2)));
 					}
 
+#ifndef GAME3_HEADLESS
 					texture->init();
+#endif
 					textures.add(std::move(texture_key), std::move(texture));
 				}
 			} else {
@@ -1,21 +1,28 @@
 #include "game/Game.h"
+
+#ifndef GAME3_HEADLESS
 #include "minigame/Breakout.h"
 #include "minigame/FlappyBird.h"
 #include "minigame/MathGame.h"
 #include "minigame/Minigame.h"
 #include "minigame/MinigameFactory.h"
+#endif
 
 namespace Game3 {
 	void Game::addMinigameFactories() {
+#ifndef GAME3_HEADLESS
 		add(MinigameFactory::create<Breakout>());
 		add(MinigameFactory::create<MathGame>());
 #ifdef ENABLE_ZIP8
 		add(MinigameFactory::create<FlappyBird>());
+#endif
 #endif
 	}
 
+#ifndef GAME3_HEADLESS
 	void Game::add(MinigameFactory &&factory) {
 		auto shared = std::make_shared<MinigameFactory>(std::move(factory));
 		registry<MinigameFactoryRegistry>().add(shared->identifier, shared);
 	}
+#endif
 }
@@ -58,6 +58,7 @@
 #include "packet/SetItemFiltersPacket.h"
 #include "packet/SetPlayerStationTypesPacket.h"
 #include "packet/SetTileEntityEnergyPacket.h"
+#include "packet/SquareParticlesPacket.h"
 #include "packet/StatusEffectsPacket.h"
 #include "packet/SubmitScorePacket.h"
 #include "packet/SubscribeToVillageUpdatesPacket.h"
@@ -66,6 +67,7 @@
 #include "packet/TileEntityPacket.h"
 #include "packet/TileEntityRequestPacket.h"
 #include "packet/TileUpdatePacket.h"
+#include "packet/TileUpdatesPacket.h"
 #include "packet/TilesetRequestPacket.h"
 #include "packet/TilesetResponsePacket.h"
 #include "packet/TimePacket.h"
@@ -156,5 +158,7 @@ namespace Game3 {
 		add(PacketFactory::create<ExplosionPacket>());
 		add(PacketFactory::create<BuyFromRhosumPacket>());
 		add(PacketFactory::create<PurchaseResultPacket>());
+		add(PacketFactory::create<TileUpdatesPacket>());
+		add(PacketFactory::create<SquareParticlesPacket>());
 	}
 }
@@ -1,9 +1,12 @@
-#include "game/ClientInventory.h"
 #include "game/Game.h"
 #include "game/HasInventory.h"
 #include "game/ServerInventory.h"
 #include "net/Buffer.h"
 
+#ifndef GAME3_HEADLESS
+#include "game/ClientInventory.h"
+#endif
+
 namespace Game3 {
 	const std::shared_ptr<Inventory> &HasInventory::getInventory(InventoryID inventory_id) const {
 		if (inventory_id != 0) {
@@ -34,7 +37,11 @@ namespace Game3 {
 
 	void HasInventory::decode(BasicBuffer &buffer, InventoryID index) {
 		if (getSharedAgent()->getSide() == Side::Client) {
+#ifdef GAME3_HEADLESS
+			throw std::invalid_argument("Can't decode a client inventory in a headless build");
+#else
 			decodeSpecific<ClientInventory>(buffer, index);
+#endif
 		} else {
 			decodeSpecific<ServerInventory>(buffer, index);
 		}
@@ -5,8 +5,6 @@
 #include "entity/Player.h"
 #include "entity/ServerPlayer.h"
 #include "game/Agent.h"
-#include "game/ClientGame.h"
-#include "game/ClientInventory.h"
 #include "game/Inventory.h"
 #include "game/InventoryGetter.h"
 #include "game/ServerInventory.h"
@@ -18,6 +16,11 @@
 #include "util/Log.h"
 #include "util/Util.h"
 
+#ifndef GAME3_HEADLESS
+#include "game/ClientGame.h"
+#include "game/ClientInventory.h"
+#endif
+
 namespace Game3 {
 	Inventory::Inventory() = default;
 
@@ -132,6 +135,89 @@ namespace Game3 {
 		return out;
 	}
 
+	bool Inventory::canExchange(const std::vector<CraftingRequirement> &to_remove, const std::vector<ItemStackPtr> &to_add) const {
+		struct Simulated {
+			ItemStackPtr stack;
+			ItemCount count;
+		};
+
+		std::vector<Simulated> slots;
+		slots.reserve(getSlotCount());
+
+		iterate([&](const ItemStackPtr &stack, Slot) {
+			if (stack) {
+				slots.emplace_back(stack, stack->count);
+			}
+			return false;
+		});
+
+		// Removal goes in slot order, like ServerInventory::remove.
+		for (const CraftingRequirement &requirement: to_remove) {
+			ItemCount remaining = requirement.count();
+
+			for (Simulated &simulated: slots) {
+				if (remaining == 0) {
+					break;
+				}
+
+				if (simulated.count == 0) {
+					continue;
+				}
+
+				bool matches{};
+
+				if (requirement.is<ItemStackPtr>()) {
+					matches = simulated.stack->canMerge(*requirement.get<ItemStackPtr>());
+				} else {
+					matches = simulated.stack->hasAttribute(requirement.get<AttributeRequirement>().attribute);
+				}
+
+				if (matches) {
+					const ItemCount removed = std::min(remaining, simulated.count);
+					simulated.count -= removed;
+					remaining -= removed;
+				}
+			}
+		}
+
+		std::erase_if(slots, [](const Simulated &simulated) {
+			return simulated.count == 0;
+		});
+
+		Slot empty_slots = getSlotCount() - static_cast<Slot>(slots.size());
+
+		// Insertion tops up mergeable stacks first and then fills empty slots, like ServerInventory::add.
+		for (const ItemStackPtr &stack: to_add) {
+			ItemCount remaining = stack->count;
+			const ItemCount max_count = stack->item->maxCount;
+
+			for (Simulated &simulated: slots) {
+				if (remaining == 0) {
+					break;
+				}
+
+				if (simulated.count < max_count && simulated.stack->canMerge(*stack)) {
+					const ItemCount added = std::min(remaining, max_count - simulated.count);
+					simulated.count += added;
+					remaining -= added;
+				}
+			}
+
+			while (0 < remaining) {
+				if (empty_slots <= 0) {
+					return false;
+				}
+
+				const ItemCount added = std::min(remaining, max_count);
+				slots.emplace_back(stack, added);
+				remaining -= added;
+				--empty_slots;
+			}
+		}
+
+		return true;
+	}
+
 	std::unique_ptr<InventoryGetter> Inventory::getGetter() const {
 		return std::make_unique<InventoryGetter>(*this);
 	}
@@ -159,7 +245,11 @@ namespace Game3 {
 		}
 
 		if (side == Side::Client) {
+#ifdef GAME3_HEADLESS
+			throw std::invalid_argument("Can't create a client inventory in a headless build");
+#else
 			return std::make_shared<ClientInventory>(owner, slot_count, active_slot, index, std::move(storage));
+#endif
 		}
 
 		throw std::invalid_argument("Can't create inventory for side " + std::to_string(static_cast<int>(side)));
@@ -0,0 +1,99 @@
+#include "game/InventorySummary.h"
+#include "item/Item.h"
+
+namespace Game3 {
+	void InventorySummary::rebuild(const std::map<Slot, ItemStackPtr> &storage) {
+		clear();
+
+		for (const auto &[slot, stack]: storage) {
+			if (!stack || !stack->item) {
+				continue;
+			}
+
+			ItemEntry &entry = items[stack->item->identifier];
+			entry.total += stack->count;
+
+			// The storage map is ordered, so the first slot we see for an item is the lowest.
+			if (entry.firstSlot == -1) {
+				entry.firstSlot = slot;
+			}
+
+			const size_t hash = stack->getDataHash();
+			bool merged = false;
+
+			for (Variant &variant: entry.variants) {
+				if (variant.dataHash == hash && variant.sample->canMerge(*stack)) {
+					variant.count += stack->count;
+					merged = true;
+					break;
+				}
+			}
+
+			if (!merged) {
+				entry.variants.emplace_back(stack, hash, stack->count);
+			}
+
+			for (const Identifier &attribute: stack->item->attributes) {
+				AttributeEntry &attribute_entry = attributes[attribute];
+				attribute_entry.total += stack->count;
+				if (attribute_entry.firstSlot == -1) {
+					attribute_entry.firstSlot = slot;
+				}
+			}
+		}
+	}
+
+	void InventorySummary::clear() {
+		items.clear();
+		attributes.clear();
+	}
+
+	ItemCount InventorySummary::count(const ItemID &id) const {
+		if (auto iter = items.find(id); iter != items.end()) {
+			return iter->second.total;
+		}
+		return 0;
+	}
+
+	ItemCount InventorySummary::count(const ItemStack &stack) const {
+		if (!stack.item) {
+			return 0;
+		}
+
+		auto iter = items.find(stack.item->identifier);
+		if (iter == items.end()) {
+			return 0;
+		}
+
+		const size_t hash = stack.getDataHash();
+
+		for (const Variant &variant: iter->second.variants) {
+			if (variant.dataHash == hash && variant.sample->canMerge(stack)) {
+				return variant.count;
+			}
+		}
+
+		return 0;
+	}
+
+	ItemCount InventorySummary::countAttribute(const Identifier &attribute) const {
+		if (auto iter = attributes.find(attribute); iter != attributes.end()) {
+			return iter->second.total;
+		}
+		return 0;
+	}
+
+	std::optional<Slot> InventorySummary::find(const ItemID &id) const {
+		if (auto iter = items.find(id); iter != items.end()) {
+			return iter->second.firstSlot;
+		}
+		return std::nullopt;
+	}
+
+	std::optional<Slot> InventorySummary::findAttribute(const Identifier &attribute) const {
+		if (auto iter = attributes.find(attribute); iter != attributes.end()) {
+			return iter->second.firstSlot;
+		}
+		return std::nullopt;
+	}
+}
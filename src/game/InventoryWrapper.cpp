@@ -274,6 +274,10 @@ namespace Game3 {
 		return inventory->empty();
 	}
 
+	uint64_t InventoryWrapper::getRevision() const {
+		return inventory->getRevision();
+	}
+
 	Slot InventoryWrapper::slotsOccupied() const {
 		Slot out = 0;
 
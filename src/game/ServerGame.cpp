@@ -3,8 +3,10 @@
 #include "entity/ItemEntity.h"
 #include "entity/ServerPlayer.h"
 #include "error/IncompatibleError.h"
+#include "game/Inventory.h"
 #include "game/ServerGame.h"
 #include "graphics/Tileset.h"
+#include "net/NetStats.h"
 #include "net/RemoteClient.h"
 #include "net/Server.h"
 #include "packet/ChatMessageSentPacket.h"
@@ -17,20 +19,25 @@
 #include "packet/InventoryPacket.h"
 #include "packet/TileEntityPacket.h"
 #include "packet/TileUpdatePacket.h"
+#include "packet/TileUpdatesPacket.h"
 #include "packet/TimePacket.h"
 #include "realm/Overworld.h"
 #include "realm/ShadowRealm.h"
 #include "statuseffect/StatusEffectFactory.h"
+#include "threading/LockProfiler.h"
 #include "threading/ThreadContext.h"
 #include "util/Cast.h"
 #include "util/Demangle.h"
 #include "util/Explosion.h"
 #include "util/Log.h"
+#include "util/MemoryStats.h"
 #include "util/Timer.h"
 #include "util/Util.h"
 #include "worldgen/Overworld.h"
 #include "worldgen/ShadowRealm.h"
 
+#include <algorithm>
+#include <chrono>
 #include <iomanip>
 #include <random>
 
@@ -102,6 +109,10 @@ namespace Game3 {
 			// });
 		}
 
+		for (auto &tick_function: wakeQueue.steal()) {
+			enqueue(std::move(tick_function));
+		}
+
 		std::shared_ptr<TimePacket> time_packet;
 		timeSinceTimeUpdate += delta;
 		if (10. <= timeSinceTimeUpdate) {
@@ -139,6 +150,15 @@ namespace Game3 {
 			}
 		}
 
+		if (const ssize_t dump_seconds = getRule("netStatsDumpSeconds").value_or(0); 0 < dump_seconds) {
+			lastNetStatsDump += delta;
+			if (dump_seconds <= lastNetStatsDump) {
+				INFO("Network stats:\n{}", NetStats::global().summarize(NET_STATS_ROWS));
+				INFO("Memory usage:\n{}", MemoryStats::global().summarize());
+				lastNetStatsDump = 0.f;
+			}
+		}
+
 		lastGarbageCollection += delta;
 		if (GARBAGE_COLLECTION_TIME <= lastGarbageCollection) {
 			garbageCollect();
@@ -149,6 +169,9 @@ namespace Game3 {
 	}
 
 	void ServerGame::garbageCollect() {
+		pageOutChunks();
+		measureMemory();
+
 		auto lock = players.sharedLock();
 
 		for (const auto &player: players) {
@@ -172,10 +195,165 @@ namespace Game3 {
 		}
 	}
 
+	void ServerGame::pageOutChunks() {
+		const ssize_t idle_minutes = getRule("chunkIdleMinutes").value_or(10);
+		if (idle_minutes < 0 || !database || !database->isOpen()) {
+			return;
+		}
+
+		const ssize_t budget_megabytes = getRule("chunkMemoryBudgetMB").value_or(0);
+		const auto now = std::chrono::steady_clock::now();
+		const auto idle_limit = std::chrono::minutes(idle_minutes);
+
+		size_t resident = 0;
+		size_t paged_out = 0;
+		std::vector<std::tuple<std::chrono::steady_clock::time_point, RealmPtr, ChunkPosition>> remaining;
+
+		iterateRealms([&](const RealmPtr &realm) {
+			for (const auto &[last_seen, chunk_position]: realm->getPageableChunks()) {
+				if (idle_limit <= now - last_seen) {
+					paged_out += realm->pageOut(chunk_position);
+				} else if (0 < budget_megabytes) {
+					remaining.emplace_back(last_seen, realm, chunk_position);
+				}
+			}
+
+			resident += realm->tileProvider.getResidentChunkCount();
+		});
+
+		if (0 < budget_megabytes) {
+			const size_t budget_chunks = size_t(budget_megabytes) * 1024 * 1024 / TileProvider::CHUNK_BYTE_COUNT;
+			if (budget_chunks < resident) {
+				std::ranges::sort(remaining, [](const auto &left, const auto &right) {
+					return std::get<0>(left) < std::get<0>(right);
+				});
+
+				for (const auto &[last_seen, realm, chunk_position]: remaining) {
+					if (resident <= budget_chunks) {
+						break;
+					}
+
+					if (realm->pageOut(chunk_position)) {
+						++paged_out;
+						--resident;
+					}
+				}
+
+				if (budget_chunks < resident) {
+					WARN("{} chunks are resident, but the memory budget only allows {}", resident, budget_chunks);
+				}
+			}
+		}
+
+		if (paged_out != 0) {
+			INFO("Paged out {} chunk{}; {} resident", paged_out, paged_out == 1? "" : "s", resident);
+		}
+	}
+
+	void ServerGame::measureMemory() {
+		size_t chunk_bytes = 0;
+		size_t entity_bytes = 0;
+		size_t tile_entity_bytes = 0;
+		size_t inventory_bytes = 0;
+		size_t item_data_bytes = 0;
+
+		auto measure_inventories = [&](const HasInventory &has_inventory) {
+			for (InventoryID index = 0; index < has_inventory.getInventoryCount(); ++index) {
+				const InventoryPtr &inventory = has_inventory.getInventory(index);
+				if (!inventory) {
+					continue;
+				}
+
+				inventory_bytes += sizeof(Inventory);
+				inventory->iterate([&](const ItemStackPtr &stack, Slot) {
+					inventory_bytes += sizeof(ItemStack) + sizeof(std::pair<Slot, ItemStackPtr>) + MemoryStats::NODE_OVERHEAD;
+					auto data_lock = stack->data.sharedLock();
+					item_data_bytes += MemoryStats::estimate(*stack->data);
+					return false;
+				});
+			}
+		};
+
+		iterateRealms([&](const RealmPtr &realm) {
+			chunk_bytes += realm->tileProvider.getResidentChunkCount() * TileProvider::CHUNK_BYTE_COUNT;
+
+			{
+				auto lock = realm->entities.sharedLock();
+				for (const EntityPtr &entity: realm->entities) {
+					entity_bytes += sizeof(Entity) + MemoryStats::NODE_OVERHEAD;
+
+					{
+						auto players_lock = entity->visiblePlayers.sharedLock();
+						entity_bytes += entity->visiblePlayers.size() * (sizeof(std::weak_ptr<Player>) + MemoryStats::NODE_OVERHEAD);
+					}
+
+					{
+						auto entities_lock = entity->visibleEntities.sharedLock();
+						if (entity->visibleEntities.has_value()) {
+							auto inner_lock = entity->visibleEntities->sharedLock();
+							entity_bytes += entity->visibleEntities->size() * (sizeof(std::weak_ptr<Entity>) + MemoryStats::NODE_OVERHEAD);
+						}
+					}
+
+					{
+						auto path_lock = entity->path.sharedLock();
+						entity_bytes += entity->path.size() * sizeof(Direction);
+					}
+
+					measure_inventories(*entity);
+				}
+			}
+
+			auto lock = realm->tileEntities.sharedLock();
+			for (const auto &[position, tile_entity]: realm->tileEntities) {
+				tile_entity_bytes += sizeof(TileEntity) + sizeof(std::pair<Position, TileEntityPtr>) + MemoryStats::NODE_OVERHEAD;
+				if (const auto *has_inventory = dynamic_cast<const HasInventory *>(tile_entity.get())) {
+					measure_inventories(*has_inventory);
+				}
+			}
+		});
+
+		MemoryStats &stats = MemoryStats::global();
+		stats.set(MemorySubsystem::Chunks, chunk_bytes);
+		stats.set(MemorySubsystem::Entities, entity_bytes);
+		stats.set(MemorySubsystem::TileEntities, tile_entity_bytes);
+		stats.set(MemorySubsystem::Inventories, inventory_bytes);
+		stats.set(MemorySubsystem::ItemData, item_data_bytes);
+
+		for (const auto &[subsystem, rule]: MEMORY_BUDGET_RULES) {
+			stats.setBudget(subsystem, size_t(std::max<ssize_t>(0, getRule(rule).value_or(0))) * 1024 * 1024);
+		}
+
+		for (const std::string &warning: stats.checkBudgets()) {
+			WARN("{}", warning);
+		}
+	}
+
 	void ServerGame::broadcastTileUpdate(RealmID realm_id, Layer layer, const Position &position, TileID tile_id) {
 		broadcast({position, realms.at(realm_id), nullptr}, make<TileUpdatePacket>(realm_id, layer, position, tile_id));
 	}
 
+	void ServerGame::broadcastTileUpdates(RealmID realm_id, const std::map<std::pair<Layer, Position>, TileID> &updates) {
+		auto lock = players.sharedLock();
+		for (const ServerPlayerPtr &player: players) {
+			auto client = player->toServer()->weakClient.lock();
+			if (!client) {
+				continue;
+			}
+
+			auto packet = make<TileUpdatesPacket>(realm_id);
+			for (const auto &[key, tile_id]: updates) {
+				if (player->canSee(realm_id, key.second)) {
+					packet->add(key.first, key.second, tile_id);
+				}
+			}
+
+			if (!packet->empty()) {
+				client->send(packet);
+			}
+		}
+	}
+
 	void ServerGame::broadcastFluidUpdate(RealmID realm_id, const Position &position, FluidTile tile) {
 		broadcast({position, realms.at(realm_id), nullptr}, make<FluidUpdatePacket>(realm_id, position, tile));
 	}
@@ -184,6 +362,10 @@ namespace Game3 {
 		packetQueue.emplace(std::move(client), std::move(packet));
 	}
 
+	void ServerGame::queueWake(std::function<void(const TickArgs &)> tick_function) {
+		wakeQueue.push(std::move(tick_function));
+	}
+
 	void ServerGame::runCommand(GenericClient &client, const std::string &command, GlobalID command_id) {
 		auto [success, message] = commandHelper(client, command);
 		client.send(make<CommandResultPacket>(command_id, success, std::move(message)));
@@ -210,6 +392,9 @@ namespace Game3 {
 			return;
 		}
 
+		entity.replicatedPosition = entity.getPosition();
+		entity.replicatedOffset = entity.getOffset();
+
 		const auto packet = make<EntityMovedPacket>(entity);
 		packet->arguments.isTeleport = context.isTeleport;
 
@@ -243,6 +428,15 @@ namespace Game3 {
 		}
 	}
 
+	void ServerGame::entityMotionSettled(Entity &entity, MovementContext context, bool compare_offsets) {
+		// Clients have been replaying the same path or integrating the same fall, so as long as they ended up
+		// where the server did there's nothing to tell them.
+		const double threshold = getRule("movementCorrectionPercent").value_or(0) / 100.0;
+		if (entity.needsMovementCorrection(threshold, compare_offsets)) {
+			entityTeleported(entity, context);
+		}
+	}
+
 	void ServerGame::entityDestroyed(const Entity &entity) {
 		if (!entity.shouldBroadcastDestruction()) {
 			return;
@@ -307,6 +501,15 @@ namespace Game3 {
 		playerMap.emplace(player->username, player);
 	}
 
+	void ServerGame::reportLogin() {
+		if (loginReported.exchange(true)) {
+			return;
+		}
+
+		const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime);
+		INFO("First login {:.3f} s after startup", elapsed.count() / 1000.);
+	}
+
 	bool ServerGame::hasPlayer(const std::string &username) const {
 		auto lock = playerMap.sharedLock();
 		return playerMap.contains(username);
@@ -615,13 +818,64 @@ namespace Game3 {
 			if (first == "saveall") {
 				INFO("Writing...");
 				assert(database);
-				tickingPaused = true;
 				database->writeAll();
-				tickingPaused = false;
 				INFO("Writing done.");
 				return {true, "Wrote all data."};
 			}
 
+			if (first == "backup") {
+				if (words.size() != 2 && words.size() != 3) {
+					return {false, "Usage: backup <archive> [base archive]"};
+				}
+
+				assert(database);
+				std::optional<std::filesystem::path> base;
+				if (words.size() == 3) {
+					base = std::filesystem::path(words[2]);
+				}
+
+				const uint64_t bytes_per_second = uint64_t(std::max<ssize_t>(0, getRule("backupMegabytesPerSecond").value_or(32))) * 1024 * 1024;
+				if (!database->startBackup(std::filesystem::path(words[1]), std::move(base), bytes_per_second)) {
+					return {false, "A backup is already running."};
+				}
+
+				return {true, "Backup started."};
+			}
+
+			if (first == "locks") {
+#ifdef GAME3_LOCK_PROFILING
+				if (words.size() == 2 && words.at(1) == "reset") {
+					LockProfiler::reset();
+					return {true, "Reset lock statistics."};
+				}
+
+				if (words.size() == 3 && words.at(1) == "sample") {
+					uint32_t interval = 1;
+					try {
+						interval = parseNumber<uint32_t>(words.at(2));
+					} catch (const std::invalid_argument &) {
+						return {false, "Invalid sample interval."};
+					}
+					LockProfiler::setSampleInterval(interval);
+					return {true, "Sampling 1 in " + std::to_string(LockProfiler::getSampleInterval()) + " lock acquisitions."};
+				}
+
+				size_t limit = 20;
+				if (words.size() == 2) {
+					try {
+						limit = parseNumber<size_t>(words.at(1));
+					} catch (const std::invalid_argument &) {
+						return {false, "Invalid limit."};
+					}
+				}
+
+				INFO("Lock contention report:\n{}", LockProfiler::report(limit));
+				return {true, "Wrote lock contention report to the server log."};
+#else
+				return {false, "This server wasn't built with lock profiling."};
+#endif
+			}
+
 			if (first == "pos") {
 				INFO("Player {} position: {}", player->getGID(), player->getPosition());
 				INFO("Player {} chunk position: {}", player->getGID(), player->getChunk());
@@ -636,16 +890,13 @@ namespace Game3 {
 				TileProvider &provider = player->getRealm()->tileProvider;
 				auto &path_chunk = provider.getPathChunk(player->getChunk());
 				auto lock = path_chunk.sharedLock();
-				size_t walkables = 0;
-				for (size_t y = 0; y < CHUNK_SIZE; ++y) {
-					for (size_t x = 0; x < CHUNK_SIZE; ++x) {
-						const auto walkable = path_chunk[y * CHUNK_SIZE + x];
-						std::cerr << (walkable? "\u2588" : "\u2591");
-						walkables += walkable;
+				for (int64_t y = 0; y < CHUNK_SIZE; ++y) {
+					for (int64_t x = 0; x < CHUNK_SIZE; ++x) {
+						std::cerr << (getPathBit(path_chunk, y, x)? "\u2588" : "\u2591");
 					}
 					std::cerr << '\n';
 				}
-				return {true, "Walkable: " + std::to_string(walkables) + " / " + std::to_string(CHUNK_SIZE * CHUNK_SIZE)};
+				return {true, "Walkable: " + std::to_string(countPathBits(path_chunk)) + " / " + std::to_string(CHUNK_SIZE * CHUNK_SIZE)};
 			}
 
 			if (first == "stop") {
@@ -762,6 +1013,88 @@ namespace Game3 {
 				return {true, "Online players: " + join(display_names, ", ")};
 			}
 
+			if (first == "chunks") {
+				std::string out;
+				iterateRealms([&](const RealmPtr &realm) {
+					const Realm::PagingStats &stats = realm->pagingStats;
+					const size_t paged_in = stats.pagedIn;
+					const double average_ms = paged_in == 0? 0. : stats.totalPageInMicroseconds / 1000. / paged_in;
+					out += std::format("Realm {}: {} resident, {} paged out. Page-ins: {} (avg {:.2f} ms, max {:.2f} ms). Page-outs: {}\n",
+						realm->getID(), realm->tileProvider.getResidentChunkCount(), realm->getPagedOutChunkCount(),
+						paged_in, average_ms, stats.maxPageInMicroseconds / 1000., stats.pagedOut.load());
+				});
+				if (!out.empty()) {
+					out.pop_back();
+				}
+				return {true, out};
+			}
+
+			if (first == "memory") {
+				if (words.size() == 2 && words[1] == "reset") {
+					MemoryStats::global().resetPeaks();
+					return {true, "Memory peaks reset."};
+				}
+
+				if (words.size() != 1) {
+					return {false, "Incorrect parameter count."};
+				}
+
+				measureMemory();
+				return {true, MemoryStats::global().summarize()};
+			}
+
+			if (first == "netstats") {
+				if (words.size() == 1) {
+					return {true, NetStats::global().summarize(NET_STATS_ROWS)};
+				}
+
+				if (words.size() != 2) {
+					return {false, "Incorrect parameter count."};
+				}
+
+				if (words[1] == "reset") {
+					NetStats::global().reset();
+					if (std::shared_ptr<Server> server = getServer()) {
+						for (const GenericClientPtr &generic_client: server->getClients().copyBase()) {
+							generic_client->netStats.reset();
+						}
+					}
+					return {true, "Network stats reset."};
+				}
+
+				ServerPlayerPtr target;
+				playerMap.withShared([&](const auto &map) {
+					if (auto iter = map.find(std::string(words[1])); iter != map.end()) {
+						target = iter->second;
+					}
+				});
+
+				if (!target) {
+					return {false, "Player not online."};
+				}
+
+				if (auto target_client = target->weakClient.lock()) {
+					return {true, target_client->netStats.summarize(NET_STATS_ROWS)};
+				}
+
+				return {false, "Player has no client."};
+			}
+
+			if (first == "sleeping") {
+				size_t sleeping = 0;
+				size_t total = 0;
+				iterateRealms([&](const RealmPtr &realm) {
+					auto lock = realm->tileEntities.sharedLock();
+					for (const auto &[position, tile_entity]: realm->tileEntities) {
+						++total;
+						if (tile_entity->isSleeping()) {
+							++sleeping;
+						}
+					}
+				});
+				return {true, std::format("Sleeping tile entities: {} / {}. Ticks skipped: {}", sleeping, total, skippedTileEntityTicks.load())};
+			}
+
 			if (first == "entities" || first == "ents") {
 				auto lock = allAgents.sharedLock();
 				std::vector<EntityPtr> entities;
@@ -3,7 +3,6 @@
 #include "entity/Player.h"
 #include "entity/ServerPlayer.h"
 #include "game/Agent.h"
-#include "game/ClientGame.h"
 #include "game/ServerInventory.h"
 #include "item/Item.h"
 #include "net/Buffer.h"
@@ -17,6 +16,10 @@
 #include "util/Log.h"
 #include "util/Util.h"
 
+#ifndef GAME3_HEADLESS
+#include "game/ClientGame.h"
+#endif
+
 #include <cassert>
 
 namespace Game3 {
@@ -172,6 +175,7 @@ namespace Game3 {
 			after = onRemove(slot);
 		}
 		storage.erase(slot);
+		invalidateSummary();
 		if (after) {
 			after();
 		}
@@ -180,6 +184,7 @@ namespace Game3 {
 	void ServerInventory::clear() {
 		// TODO: some kind of callback?
 		storage.clear();
+		invalidateSummary();
 	}
 
 	ItemCount ServerInventory::remove(const ItemStackPtr &stack_to_remove) {
@@ -315,6 +320,8 @@ namespace Game3 {
 	}
 
 	void ServerInventory::notifyOwner(std::optional<std::variant<ItemStackPtr, Slot>> variant) {
+		invalidateSummary();
+
 		AgentPtr owner = weakOwner.lock();
 
 		if (owner) {
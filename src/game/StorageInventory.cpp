@@ -28,6 +28,7 @@ namespace Game3 {
 		onSwap = std::move(other.onSwap);
 		onMove = std::move(other.onMove);
 		storage = std::move(other.storage);
+		other.invalidateSummary();
 	}
 
 	StorageInventory & StorageInventory::operator=(const StorageInventory &other) {
@@ -39,6 +40,7 @@ namespace Game3 {
 		auto other_lock = other.sharedLock();
 		Inventory::operator=(other);
 		storage = other.storage;
+		invalidateSummary();
 		return *this;
 	}
 
@@ -51,6 +53,8 @@ namespace Game3 {
 		auto other_lock = other.uniqueLock();
 		Inventory::operator=(std::move(other));
 		storage = std::move(other.storage);
+		invalidateSummary();
+		other.invalidateSummary();
 		return *this;
 	}
 
@@ -66,6 +70,7 @@ namespace Game3 {
 			throw std::out_of_range("Slot out of range: " + std::to_string(slot));
 		}
 		storage[slot] = std::move(stack);
+		invalidateSummary();
 	}
 
 	Slot StorageInventory::getSlotCount() const {
@@ -207,39 +212,21 @@ namespace Game3 {
 			return countAttribute(id);
 		}
 
-		ItemCount out = 0;
-
-		for (const auto &[slot, stack]: storage) {
-			if (stack->item->identifier == id) {
-				out += stack->count;
-			}
-		}
-
-		return out;
+		return withSummary([&](const InventorySummary &summary) {
+			return summary.count(id);
+		});
 	}
 
 	ItemCount StorageInventory::count(const Item &item) const {
-		ItemCount out = 0;
-
-		for (const auto &[slot, stack]: storage) {
-			if (stack->item->identifier == item.identifier) {
-				out += stack->count;
-			}
-		}
-
-		return out;
+		return withSummary([&](const InventorySummary &summary) {
+			return summary.count(item.identifier);
+		});
 	}
 
 	ItemCount StorageInventory::count(const ItemStackPtr &stack) const {
-		ItemCount out = 0;
-
-		for (const auto &[slot, stored_stack]: storage) {
-			if (stack->canMerge(*stored_stack)) {
-				out += stored_stack->count;
-			}
-		}
-
-		return out;
+		return withSummary([&](const InventorySummary &summary) {
+			return summary.count(*stack);
+		});
 	}
 
 	ItemCount StorageInventory::count(const ItemStackPtr &stack, const std::function<bool(Slot)> &predicate) const {
@@ -255,15 +242,9 @@ namespace Game3 {
 	}
 
 	ItemCount StorageInventory::countAttribute(const Identifier &attribute) const {
-		ItemCount out = 0;
-
-		for (const auto &[slot, stack]: storage) {
-			if (stack->hasAttribute(attribute)) {
-				out += stack->count;
-			}
-		}
-
-		return out;
+		return withSummary([&](const InventorySummary &summary) {
+			return summary.countAttribute(attribute);
+		});
 	}
 
 	bool StorageInventory::hasSlot(Slot slot) const {
@@ -285,6 +266,12 @@ namespace Game3 {
 		return storage.contains(slot);
 	}
 
+	std::optional<Slot> StorageInventory::find(const ItemID &id) const {
+		return withSummary([&](const InventorySummary &summary) {
+			return summary.find(id);
+		});
+	}
+
 	std::optional<Slot> StorageInventory::find(const ItemID &id, const Predicate &predicate) const {
 		for (const auto &[slot, stack]: storage) {
 			if (predicate(stack, slot) && stack->item->identifier == id) {
@@ -294,6 +281,12 @@ namespace Game3 {
 		return std::nullopt;
 	}
 
+	std::optional<Slot> StorageInventory::findAttribute(const Identifier &attribute) const {
+		return withSummary([&](const InventorySummary &summary) {
+			return summary.findAttribute(attribute);
+		});
+	}
+
 	std::optional<Slot> StorageInventory::findAttribute(const Identifier &attribute, const Predicate &predicate) const {
 		for (const auto &[slot, stack]: storage) {
 			if (predicate(stack, slot) && stack->item->attributes.contains(attribute)) {
@@ -310,6 +303,11 @@ namespace Game3 {
 		return nullptr;
 	}
 
+	bool StorageInventory::contains(const ItemStackPtr &needle) const {
+		const ItemCount available = count(needle);
+		return 0 < available && needle->count <= available;
+	}
+
 	bool StorageInventory::contains(const ItemStackPtr &needle, const Predicate &predicate) const {
 		ItemCount remaining = needle->count;
 		for (const auto &[slot, stack]: storage) {
@@ -341,6 +339,10 @@ namespace Game3 {
 		return safeCast<Slot>(storage.size());
 	}
 
+	uint64_t StorageInventory::getRevision() const {
+		return revision.load();
+	}
+
 	void StorageInventory::replace(const Inventory &other) {
 		if (this == &other) {
 			return;
@@ -375,5 +377,7 @@ namespace Game3 {
 				++iter;
 			}
 		}
+
+		invalidateSummary();
 	}
 }
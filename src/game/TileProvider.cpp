@@ -6,6 +6,9 @@
 #include "util/Util.h"
 #include "util/Zstd.h"
 
+#include <algorithm>
+#include <cassert>
+
 namespace Game3 {
 	TileProvider::TileProvider(Identifier tileset_id):
 		tilesetID(std::move(tileset_id)) {
@@ -101,6 +104,44 @@ namespace Game3 {
 		return cachedTileset = game.registry<TilesetRegistry>().at(tilesetID);
 	}
 
+	void TileProvider::copyPaddedChunk(Layer layer, ChunkPosition chunk_position, std::span<TileID> out) const {
+		validateLayer(layer);
+		assert(out.size() == static_cast<size_t>(PADDED_CHUNK_SIZE * PADDED_CHUNK_SIZE));
+
+		std::ranges::fill(out, 0);
+
+		std::shared_lock lock(chunkMutexes[getIndex(layer)]);
+		const ChunkMap &map = chunkMaps[getIndex(layer)];
+
+		for (int32_t y_offset = -1; y_offset <= 1; ++y_offset) {
+			for (int32_t x_offset = -1; x_offset <= 1; ++x_offset) {
+				auto iter = map.find(ChunkPosition{chunk_position.x + x_offset, chunk_position.y + y_offset});
+				if (iter == map.end()) {
+					continue;
+				}
+
+				const TileChunk &chunk = iter->second;
+				auto chunk_lock = chunk.sharedLock();
+				if (chunk.empty()) {
+					continue;
+				}
+
+				// Only the row or column facing the center chunk is needed from each neighbor.
+				const int64_t row_begin    = y_offset < 0? CHUNK_SIZE - 1 : 0;
+				const int64_t row_end      = y_offset > 0? 1 : CHUNK_SIZE;
+				const int64_t column_begin = x_offset < 0? CHUNK_SIZE - 1 : 0;
+				const int64_t column_end   = x_offset > 0? 1 : CHUNK_SIZE;
+
+				for (int64_t row = row_begin; row < row_end; ++row) {
+					const int64_t padded_row = row + y_offset * CHUNK_SIZE + 1;
+					for (int64_t column = column_begin; column < column_end; ++column) {
+						out[padded_row * PADDED_CHUNK_SIZE + column + x_offset * CHUNK_SIZE + 1] = chunk[row * CHUNK_SIZE + column];
+					}
+				}
+			}
+		}
+	}
+
 	std::vector<Position> TileProvider::getLand(const Game &game, const ChunkRange &range, Index right_pad, Index bottom_pad) const {
 		TilesetPtr tileset = getTileset(game);
 		std::vector<Position> land_tiles;
@@ -200,7 +241,21 @@ namespace Game3 {
 		std::shared_lock lock(pathMutex);
 
 		if (auto iter = pathMap.find(chunk_position); iter != pathMap.end()) {
-			return access(iter->second, remainder(position.row), remainder(position.column));
+			auto chunk_lock = iter->second.sharedLock();
+			return getPathBit(iter->second, remainder(position.row), remainder(position.column));
+		}
+
+		return std::nullopt;
+	}
+
+	std::optional<uint64_t> TileProvider::copyPathRow(Position position) const {
+		const ChunkPosition chunk_position{divide(position.column), divide(position.row)};
+
+		std::shared_lock lock(pathMutex);
+
+		if (auto iter = pathMap.find(chunk_position); iter != pathMap.end()) {
+			auto chunk_lock = iter->second.sharedLock();
+			return iter->second[remainder(position.row)];
 		}
 
 		return std::nullopt;
@@ -260,6 +315,53 @@ namespace Game3 {
 		return {std::move(terrain), std::move(biomes), std::move(fluids), std::move(pathmap)};
 	}
 
+	std::vector<std::pair<ChunkPosition, ChunkSet>> TileProvider::copyChunkSets(std::span<const ChunkPosition> chunk_positions) const {
+		std::vector<std::pair<ChunkPosition, ChunkSet>> out;
+		out.reserve(chunk_positions.size());
+		for (ChunkPosition chunk_position: chunk_positions) {
+			out.emplace_back(chunk_position, ChunkSet{});
+		}
+
+		std::vector<bool> present(out.size(), true);
+
+		// Assigning rather than copy-constructing takes each chunk's own lock too.
+		auto copy = [&](std::shared_mutex &mutex, const auto &map, const auto &get_target) {
+			std::shared_lock lock(mutex);
+			for (size_t i = 0; i < out.size(); ++i) {
+				if (!present[i]) {
+					continue;
+				}
+
+				if (auto iter = map.find(out[i].first); iter != map.end()) {
+					get_target(out[i].second) = iter->second;
+				} else {
+					present[i] = false;
+				}
+			}
+		};
+
+		for (size_t layer = 0; layer < LAYER_COUNT; ++layer) {
+			copy(chunkMutexes[layer], chunkMaps[layer], [layer](ChunkSet &set) -> TileChunk & { return set.terrain[layer]; });
+		}
+
+		copy(biomeMutex, biomeMap, [](ChunkSet &set) -> BiomeChunk & { return set.biomes; });
+		copy(fluidMutex, fluidMap, [](ChunkSet &set) -> FluidChunk & { return set.fluids; });
+		copy(pathMutex, pathMap, [](ChunkSet &set) -> PathChunk & { return set.pathmap; });
+
+		size_t kept = 0;
+		for (size_t i = 0; i < out.size(); ++i) {
+			if (present[i]) {
+				if (kept != i) {
+					out[kept] = std::move(out[i]);
+				}
+				++kept;
+			}
+		}
+
+		out.resize(kept);
+		return out;
+	}
+
 	std::string TileProvider::getRawChunks(ChunkPosition chunk_position) const {
 		std::string raw;
 		raw.reserve(LAYER_COUNT * CHUNK_SIZE * CHUNK_SIZE * sizeof(TileID));
@@ -322,7 +424,8 @@ namespace Game3 {
 			std::shared_lock lock(pathMutex);
 			const PathChunk &pathmap_data = pathMap.at(chunk_position);
 			auto pathmap_lock = pathmap_data.sharedLock();
-			appendSpan(raw, std::span(pathmap_data));
+			const std::vector<uint8_t> unpacked = unpackPathChunk(pathmap_data);
+			appendSpan(raw, std::span(unpacked));
 		}
 		return raw;
 	}
@@ -429,16 +532,26 @@ namespace Game3 {
 		});
 	}
 
-	uint8_t & TileProvider::findPathState(Position position, bool &created, std::shared_lock<std::shared_mutex> *lock_out, PathMode mode) {
-		return findItem(position, created, lock_out, mode, pathMutex, pathMap, [this](auto &chunk, ChunkPosition chunk_position) {
-			initPathChunk(chunk, chunk_position);
-		});
-	}
+	bool TileProvider::setPathState(Position position, bool walkable, PathMode mode) {
+		const ChunkPosition chunk_position = position.getChunk();
+		PathChunk *chunk = nullptr;
+
+		if (mode == PathMode::Create) {
+			chunk = &getPathChunk(chunk_position);
+		} else {
+			chunk = tryPathChunk(chunk_position);
+			if (chunk == nullptr) {
+				throw std::out_of_range("Couldn't find path chunk at position " + static_cast<std::string>(chunk_position));
+			}
+		}
 
-	uint8_t & TileProvider::findPathState(Position position, bool &created, std::unique_lock<std::shared_mutex> *lock_out, PathMode mode) {
-		return findItem(position, created, lock_out, mode, pathMutex, pathMap, [this](auto &chunk, ChunkPosition chunk_position) {
-			initPathChunk(chunk, chunk_position);
-		});
+		auto lock = chunk->uniqueLock();
+		if (setPathBit(*chunk, remainder(position.row), remainder(position.column), walkable)) {
+			++chunk->updateCounter;
+			return true;
+		}
+
+		return false;
 	}
 
 	FluidTile & TileProvider::findFluid(Position position, std::shared_lock<std::shared_mutex> *lock_out, FluidMode mode) {
@@ -509,7 +622,7 @@ namespace Game3 {
 		return biomeMap[chunk_position];
 	}
 
-	const Chunk<uint8_t> & TileProvider::getPathChunk(ChunkPosition chunk_position) const {
+	const PathChunk & TileProvider::getPathChunk(ChunkPosition chunk_position) const {
 		std::shared_lock lock(pathMutex);
 
 		if (auto iter = pathMap.find(chunk_position); iter != pathMap.end()) {
@@ -519,7 +632,7 @@ namespace Game3 {
 		throw std::out_of_range("Couldn't find path chunk at position " + static_cast<std::string>(chunk_position));
 	}
 
-	Chunk<uint8_t> & TileProvider::getPathChunk(ChunkPosition chunk_position) {
+	PathChunk & TileProvider::getPathChunk(ChunkPosition chunk_position) {
 		ensurePathChunk(chunk_position);
 		std::unique_lock lock(pathMutex);
 		return pathMap[chunk_position];
@@ -538,7 +651,7 @@ namespace Game3 {
 		pathMap.emplace(chunk_position, std::move(chunk));
 	}
 
-	const Chunk<uint8_t> * TileProvider::tryPathChunk(ChunkPosition chunk_position) const {
+	const PathChunk * TileProvider::tryPathChunk(ChunkPosition chunk_position) const {
 		std::shared_lock lock(pathMutex);
 
 		if (auto iter = pathMap.find(chunk_position); iter != pathMap.end()) {
@@ -548,7 +661,7 @@ namespace Game3 {
 		return nullptr;
 	}
 
-	Chunk<uint8_t> * TileProvider::tryPathChunk(ChunkPosition chunk_position) {
+	PathChunk * TileProvider::tryPathChunk(ChunkPosition chunk_position) {
 		std::shared_lock lock(pathMutex);
 
 		if (auto iter = pathMap.find(chunk_position); iter != pathMap.end()) {
@@ -623,6 +736,33 @@ namespace Game3 {
 		ensureAllChunks(position.getChunk());
 	}
 
+	void TileProvider::evict(ChunkPosition chunk_position) {
+		for (size_t i = 0; i < LAYER_COUNT; ++i) {
+			std::unique_lock lock(chunkMutexes[i]);
+			chunkMaps[i].erase(chunk_position);
+		}
+
+		{
+			std::unique_lock lock(biomeMutex);
+			biomeMap.erase(chunk_position);
+		}
+
+		{
+			std::unique_lock lock(fluidMutex);
+			fluidMap.erase(chunk_position);
+		}
+
+		{
+			std::unique_lock lock(pathMutex);
+			pathMap.erase(chunk_position);
+		}
+	}
+
+	size_t TileProvider::getResidentChunkCount() const {
+		std::shared_lock lock(chunkMutexes[0]);
+		return chunkMaps[0].size();
+	}
+
 	void TileProvider::validateLayer(Layer layer) const {
 		if (static_cast<uint8_t>(layer) < static_cast<uint8_t>(Layer::Bedrock) || LAYER_COUNT < static_cast<uint8_t>(layer)) {
 			throw std::out_of_range("Invalid layer: " + std::to_string(static_cast<uint8_t>(layer)));
@@ -638,8 +778,8 @@ namespace Game3 {
 		chunk.resize(CHUNK_SIZE * CHUNK_SIZE, 0);
 	}
 
-	void TileProvider::initPathChunk(Chunk<uint8_t> &chunk, ChunkPosition) {
-		chunk.resize(CHUNK_SIZE * CHUNK_SIZE, 0);
+	void TileProvider::initPathChunk(PathChunk &chunk, ChunkPosition) {
+		chunk.resize(CHUNK_SIZE, 0);
 	}
 
 	void TileProvider::initFluidChunk(Chunk<FluidTile> &chunk, ChunkPosition) {
@@ -726,9 +866,15 @@ namespace Game3 {
 
 			for (const auto &item: data.at(2).as_array()) {
 				const auto [x, y] = boost::json::value_to<std::pair<int32_t, int32_t>>(item.at(0));
-				static_assert(sizeof(PathChunk::value_type) == 1);
+				static_assert(sizeof(PathChunk::value_type) == 8);
 				const auto compressed = boost::json::value_to<std::vector<uint8_t>>(item.at(1));
-				pathMap[ChunkPosition{x, y}] = decompress8(std::span(compressed.data(), compressed.size()));
+				const std::span compressed_span(compressed.data(), compressed.size());
+				// Pathmaps saved before they became bitmaps have one byte per tile.
+				if (const std::vector<uint8_t> bytes = decompress8(compressed_span); bytes.size() == CHUNK_SIZE * CHUNK_SIZE) {
+					pathMap[ChunkPosition{x, y}] = packPathChunk(std::span<const uint8_t>(bytes));
+				} else {
+					pathMap[ChunkPosition{x, y}] = decompress64(compressed_span);
+				}
 			}
 
 			for (const auto &item: data.at(3).as_array()) {
@@ -1,3 +1,4 @@
+#include "algorithm/Stonks.h"
 #include "biome/Biome.h"
 #include "data/ConsumptionRule.h"
 #include "data/ProductionRule.h"
@@ -17,6 +18,8 @@
 namespace Game3 {
 	namespace {
 		constexpr std::chrono::seconds PERIOD{1};
+		/** Dragging a trade slider quotes every amount along the way, so this is generous. */
+		constexpr size_t MAX_CACHED_QUOTES = 1024;
 
 		constexpr auto getMultiplier() {
 			return std::chrono::duration_cast<std::chrono::milliseconds>(PERIOD).count() / 60e3;
@@ -75,10 +78,59 @@ namespace Game3 {
 			} else {
 				resources[resource] = amount;
 			}
+			++resourcesRevision;
 		}
 		sendUpdates();
 	}
 
+	std::optional<MoneyCount> Village::quoteSell(const Identifier &resource, double base_price, ItemCount amount) const {
+		return quote(resource, base_price, amount, true);
+	}
+
+	std::optional<MoneyCount> Village::quoteBuy(const Identifier &resource, double base_price, ItemCount amount) const {
+		return quote(resource, base_price, amount, false);
+	}
+
+	std::optional<MoneyCount> Village::quote(const Identifier &resource, double base_price, ItemCount amount, bool is_sell) const {
+		// Read the revision before the resources. Writers bump it after changing them, so a quote computed from newer
+		// resources than its revision suggests is merely discarded early rather than served stale.
+		const uint64_t revision = resourcesRevision;
+		QuoteKey key{resource, amount, is_sell};
+
+		{
+			auto lock = quotes.sharedLock();
+			if (quotes.revision == revision) {
+				if (auto iter = quotes.find(key); iter != quotes.end()) {
+					return iter->second;
+				}
+			}
+		}
+
+		const ItemCount resource_count = getResourceAmount(resource).value_or(0.0);
+		std::optional<MoneyCount> price;
+
+		if (is_sell) {
+			price = totalSellPrice(resource_count, -1, base_price, amount, greed);
+		} else {
+			price = totalBuyPrice(resource_count, -1, base_price, amount);
+		}
+
+		auto lock = quotes.uniqueLock();
+
+		if (revision < quotes.revision) {
+			// The resources have changed since this quote was computed and someone has already cached newer quotes.
+			return price;
+		}
+
+		if (quotes.revision != revision || MAX_CACHED_QUOTES <= quotes.size()) {
+			quotes.clear();
+			quotes.revision = revision;
+		}
+
+		quotes.emplace(std::move(key), price);
+		return price;
+	}
+
 	Tick Village::enqueueTick() {
 		return getGame()->enqueue(sigc::mem_fun(*this, &Village::tick));
 	}
@@ -139,6 +191,7 @@ namespace Game3 {
 
 		output_count += add_count;
 		labor = labor - labor_needed;
+		++resourcesRevision;
 	}
 
 	void Village::produce(BiomeType biome, const ProductionRuleRegistry &rules) {
@@ -182,6 +235,7 @@ namespace Game3 {
 			resources.erase(iter);
 		}
 
+		++resourcesRevision;
 		return true;
 	}
 
@@ -259,6 +313,7 @@ namespace Game3 {
 		buffer >> labor;
 		buffer >> randomValue;
 		buffer >> greed;
+		++resourcesRevision;
 	}
 
 	void Village::addSubscriber(PlayerPtr player) {
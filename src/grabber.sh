@@ -1,2 +1,2 @@
 #!/bin/sh
-find . -name '*.cpp'
\ No newline at end of file
+find . -name '*.cpp' ! -path './bench/*'
\ No newline at end of file
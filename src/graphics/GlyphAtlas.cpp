@@ -0,0 +1,87 @@
+#include "graphics/GlyphAtlas.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace Game3 {
+	GlyphAtlas::GlyphAtlas(uint32_t width, uint32_t height, uint32_t max_height):
+		width(width),
+		height(height),
+		initialHeight(height),
+		maxHeight(std::max(height, max_height)),
+		pixels(size_t(width) * height) {}
+
+	std::optional<GlyphAtlas::Region> GlyphAtlas::insert(uint32_t glyph_width, uint32_t glyph_height, const uint8_t *source, int pitch) {
+		// Spaces and the like have nothing to draw.
+		if (glyph_width == 0 || glyph_height == 0) {
+			return Region{};
+		}
+
+		std::optional<Region> region = allocate(glyph_width, glyph_height);
+
+		while (!region) {
+			if (!grow()) {
+				return std::nullopt;
+			}
+
+			region = allocate(glyph_width, glyph_height);
+		}
+
+		// FreeType gives a negative pitch for bitmaps stored bottom row first.
+		for (uint32_t row = 0; row < glyph_height; ++row) {
+			const uint8_t *source_row = pitch < 0? source + (glyph_height - 1 - row) * size_t(-pitch) : source + row * size_t(pitch);
+			std::memcpy(&pixels[(size_t(region->y) + row) * width + region->x], source_row, glyph_width);
+		}
+
+		++revision;
+		return region;
+	}
+
+	void GlyphAtlas::clear() {
+		height = initialHeight;
+		pixels.assign(size_t(width) * height, 0);
+		shelves.clear();
+		++revision;
+	}
+
+	std::optional<GlyphAtlas::Region> GlyphAtlas::allocate(uint32_t glyph_width, uint32_t glyph_height) {
+		const uint32_t padded_width = glyph_width + PADDING;
+		const uint32_t padded_height = glyph_height + PADDING;
+
+		if (width < padded_width) {
+			return std::nullopt;
+		}
+
+		// Take the shortest shelf that's tall enough and has room left, so that short glyphs don't waste tall shelves.
+		Shelf *best = nullptr;
+		for (Shelf &shelf: shelves) {
+			if (padded_height <= shelf.height && padded_width <= width - shelf.used && (!best || shelf.height < best->height)) {
+				best = &shelf;
+			}
+		}
+
+		if (!best) {
+			const uint32_t top = shelves.empty()? 0 : shelves.back().y + shelves.back().height;
+			if (height < top + padded_height) {
+				return std::nullopt;
+			}
+			best = &shelves.emplace_back(Shelf{.y = top, .height = padded_height});
+		}
+
+		Region region{best->used, best->y, glyph_width, glyph_height};
+		best->used += padded_width;
+		return region;
+	}
+
+	bool GlyphAtlas::grow() {
+		if (maxHeight <= height) {
+			return false;
+		}
+
+		// Rows are stored top to bottom, so growing downward leaves every existing glyph where it was.
+		height = std::min(height * 2, maxHeight);
+		pixels.resize(size_t(width) * height);
+		++revision;
+		return true;
+	}
+}
@@ -74,7 +74,7 @@ namespace Game3 {
 	TexturePtr PathmapTextureCache::generateTexture(ChunkPosition chunk_position) {
 		assert(realm != nullptr);
 
-		Chunk<uint8_t> *chunk = realm->tileProvider.tryPathChunk(chunk_position);
+		PathChunk *chunk = realm->tileProvider.tryPathChunk(chunk_position);
 		if (chunk == nullptr) {
 			return nullptr;
 		}
@@ -82,8 +82,12 @@ namespace Game3 {
 		TexturePtr texture = std::make_shared<Texture>(Identifier{}, false, -1);
 		texture->format = GL_RED;
 
-		auto lock = chunk->sharedLock();
-		texture->init(*chunk, CHUNK_SIZE, CHUNK_SIZE);
+		std::vector<uint8_t> unpacked;
+		{
+			auto lock = chunk->sharedLock();
+			unpacked = unpackPathChunk(*chunk);
+		}
+		texture->init(unpacked, CHUNK_SIZE, CHUNK_SIZE);
 		return texture;
 	}
 }
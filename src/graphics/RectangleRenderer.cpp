@@ -4,6 +4,8 @@
 
 #include <glm/gtc/matrix_transform.hpp>
 
+#include <cstddef>
+
 #include "game/ClientGame.h"
 #include "game/TileProvider.h"
 #include "graphics/GL.h"
@@ -19,12 +21,18 @@ namespace Game3 {
 	namespace {
 		const std::string & rectangleFrag() { static auto out = readFile("resources/rectangle.frag"); return out; }
 		const std::string & rectangleVert() { static auto out = readFile("resources/rectangle.vert"); return out; }
+		const std::string & rectangleInstancedFrag() { static auto out = readFile("resources/rectangle_instanced.frag"); return out; }
+		const std::string & rectangleInstancedVert() { static auto out = readFile("resources/rectangle_instanced.vert"); return out; }
+
+		static_assert(sizeof(RectangleInstance) == 8 * sizeof(float));
 	}
 
 	RectangleRenderer::RectangleRenderer(Window &window):
 		shader("RectangleRenderer"),
+		instancedShader("RectangleRenderer (instanced)"),
 		window(window) {
 			shader.init(rectangleVert(), rectangleFrag()); CHECKGL
+			instancedShader.init(rectangleInstancedVert(), rectangleInstancedFrag()); CHECKGL
 			initRenderData(); CHECKGL
 		}
 
@@ -35,7 +43,13 @@ namespace Game3 {
 	void RectangleRenderer::reset() {
 		if (initialized) {
 			glDeleteVertexArrays(1, &quadVAO); CHECKGL
+			glDeleteVertexArrays(1, &instanceVAO); CHECKGL
+			glDeleteBuffers(1, &quadVBO); CHECKGL
+			glDeleteBuffers(1, &instanceVBO); CHECKGL
 			quadVAO = 0;
+			instanceVAO = 0;
+			quadVBO = 0;
+			instanceVBO = 0;
 			initialized = false;
 		}
 	}
@@ -46,6 +60,8 @@ namespace Game3 {
 			projection = glm::ortho(0.f, float(width), float(height), 0.f, -1.f, 1.f);
 			shader.bind(); CHECKGL
 			shader.set("projection", projection); CHECKGL
+			instancedShader.bind(); CHECKGL
+			instancedShader.set("projection", projection); CHECKGL
 		}
 	}
 
@@ -99,6 +115,39 @@ namespace Game3 {
 		glBindVertexArray(0); CHECKGL
 	}
 
+	void RectangleRenderer::drawBatchOnMap(std::span<const RectangleInstance> instances) {
+		if (!initialized || instances.empty())
+			return;
+
+		const auto [center_x, center_y] = window.center;
+		ClientGamePtr game = window.getGame();
+		RealmPtr realm = game->getActiveRealm();
+		TileProvider &provider = realm->tileProvider;
+		TilesetPtr tileset     = provider.getTileset(*game);
+		const auto tile_size   = tileset->getTileSize();
+		const auto map_length  = CHUNK_SIZE * REALM_DIAMETER;
+
+		// The same transformation as drawOnMap, worked out once for the whole batch and applied in the vertex shader.
+		const double position_scale = tile_size * window.scale / 2.;
+		const double origin_x = backbufferWidth  / 2. - map_length * tile_size * window.scale / window.magic * 2. + center_x * window.scale * tile_size / 2.;
+		const double origin_y = backbufferHeight / 2. - map_length * tile_size * window.scale / window.magic * 2. + center_y * window.scale * tile_size / 2.;
+
+		instancedShader.bind(); CHECKGL
+		instancedShader.set("positionScale", float(position_scale)); CHECKGL
+		instancedShader.set("mapOrigin", float(origin_x), float(origin_y)); CHECKGL
+		instancedShader.set("sizeScale", float(16 * window.scale / 2.)); CHECKGL
+
+		GLint old_abb = 0;
+		glGetIntegerv(GL_ARRAY_BUFFER_BINDING, &old_abb); CHECKGL
+		glBindBuffer(GL_ARRAY_BUFFER, instanceVBO); CHECKGL
+		glBufferData(GL_ARRAY_BUFFER, instances.size_bytes(), instances.data(), GL_STREAM_DRAW); CHECKGL
+		glBindBuffer(GL_ARRAY_BUFFER, old_abb); CHECKGL
+
+		glBindVertexArray(instanceVAO); CHECKGL
+		glDrawArraysInstanced(GL_TRIANGLES, 0, 6, static_cast<GLsizei>(instances.size())); CHECKGL
+		glBindVertexArray(0); CHECKGL
+	}
+
 	void RectangleRenderer::drawOnScreen(const Color &color, float x, float y, float width, float height, float angle) {
 		if (!initialized)
 			return;
@@ -136,8 +185,6 @@ namespace Game3 {
 	}
 
 	void RectangleRenderer::initRenderData() {
-		GLuint vbo{};
-
 		static const float vertices[] {
 			0, 1, 0, 1,
 			1, 0, 1, 0,
@@ -149,19 +196,35 @@ namespace Game3 {
 		};
 
 		glGenVertexArrays(1, &quadVAO); CHECKGL
-		glGenBuffers(1, &vbo); CHECKGL
+		glGenBuffers(1, &quadVBO); CHECKGL
 
 		GLint old_abb = 0;
 		glGetIntegerv(GL_ARRAY_BUFFER_BINDING, &old_abb); CHECKGL
 
-		glBindBuffer(GL_ARRAY_BUFFER, vbo); CHECKGL
+		glBindBuffer(GL_ARRAY_BUFFER, quadVBO); CHECKGL
 		glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW); CHECKGL
 
 		glBindVertexArray(quadVAO); CHECKGL
 		glEnableVertexAttribArray(0); CHECKGL
 		glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 4 * sizeof(float), nullptr); CHECKGL
-		glBindBuffer(GL_ARRAY_BUFFER, old_abb); CHECKGL
 		glBindVertexArray(0); CHECKGL
+
+		// The instanced VAO shares the quad's vertices and takes a rectangle and a color per instance.
+		glGenVertexArrays(1, &instanceVAO); CHECKGL
+		glGenBuffers(1, &instanceVBO); CHECKGL
+		glBindVertexArray(instanceVAO); CHECKGL
+		glEnableVertexAttribArray(0); CHECKGL
+		glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 4 * sizeof(float), nullptr); CHECKGL
+		glBindBuffer(GL_ARRAY_BUFFER, instanceVBO); CHECKGL
+		glEnableVertexAttribArray(1); CHECKGL
+		glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, sizeof(RectangleInstance), reinterpret_cast<void *>(offsetof(RectangleInstance, x))); CHECKGL
+		glVertexAttribDivisor(1, 1); CHECKGL
+		glEnableVertexAttribArray(2); CHECKGL
+		glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, sizeof(RectangleInstance), reinterpret_cast<void *>(offsetof(RectangleInstance, color))); CHECKGL
+		glVertexAttribDivisor(2, 1); CHECKGL
+		glBindVertexArray(0); CHECKGL
+
+		glBindBuffer(GL_ARRAY_BUFFER, old_abb); CHECKGL
 		initialized = true;
 	}
 }
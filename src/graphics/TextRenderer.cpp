@@ -54,8 +54,15 @@ namespace Game3 {
 		if (initialized && !fake) {
 			glDeleteVertexArrays(1, &vao); CHECKGL
 			glDeleteBuffers(1, &vbo); CHECKGL
+			if (atlasTexture != 0) {
+				glDeleteTextures(1, &atlasTexture); CHECKGL
+			}
 			vao = 0;
 			vbo = 0;
+			atlasTexture = 0;
+			uploadedRevision = 0;
+			uploadedHeight = 0;
+			vboCapacity = 0;
 			initialized = false;
 		}
 	}
@@ -65,70 +72,39 @@ namespace Game3 {
 			return;
 		}
 
-		auto freetypeLibrary = std::unique_ptr<FT_Library, FreeLibrary>(new FT_Library);
+		freetypeLibrary = std::unique_ptr<FT_Library, FreeLibrary>(new FT_Library);
 		if (FT_Init_FreeType(freetypeLibrary.get())) {
 			throw std::runtime_error("Couldn't initialize FreeType");
 		}
 
-		auto freetypeFace = std::unique_ptr<FT_Face, FreeFace>(new FT_Face);
+		freetypeFace = std::unique_ptr<FT_Face, FreeFace>(new FT_Face);
 		if (FT_New_Face(*freetypeLibrary, "resources/CozetteVector.ttf", 0, freetypeFace.get())) {
 			throw std::runtime_error("Couldn't initialize font");
 		}
 
-		auto &face = *freetypeFace;
-		FT_Set_Pixel_Sizes(face, 0, fontScale);
+		FT_Set_Pixel_Sizes(*freetypeFace, 0, fontScale);
 		characters.clear();
-
-		if (!fake) {
-			glPixelStorei(GL_UNPACK_ALIGNMENT, 1); CHECKGL
-		}
-
-		GLuint texture = 0;
-
-		auto register_glyph = [&](uint32_t ch) {
-			// Load character glyph
-			if (FT_Load_Char(face, ch, FT_LOAD_RENDER)) {
-				throw std::runtime_error("Failed to load glyph " + std::to_string(static_cast<uint32_t>(ch)));
+		layouts.clear();
+		atlas.clear();
+		cachedIHeight.reset();
+
+		// Printable ASCII is needed right away (the fallback glyph and the I used for line heights among it).
+		// Everything else is rasterized into the atlas when it's first drawn or measured.
+		for (uint32_t ch = 32; ch < 127; ++ch) {
+			if (!loadCharacter(ch)) {
+				throw std::runtime_error("Failed to load glyph " + std::to_string(ch));
 			}
-
-			if (!fake) {
-				glGenTextures(1, &texture); CHECKGL
-				glBindTexture(GL_TEXTURE_2D, texture); CHECKGL
-				glTexImage2D(GL_TEXTURE_2D, 0, GL_RED, face->glyph->bitmap.width, face->glyph->bitmap.rows, 0, GL_RED, GL_UNSIGNED_BYTE, face->glyph->bitmap.buffer); CHECKGL
-
-				// Set texture options
-				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE); CHECKGL
-				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE); CHECKGL
-				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR); CHECKGL
-				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR); CHECKGL
-			} else {
-				++texture;
-			}
-
-			// Store character for later use
-			characters.try_emplace(ch,
-				texture,
-				glm::ivec2(face->glyph->bitmap.width, face->glyph->bitmap.rows),
-				glm::ivec2(face->glyph->bitmap_left, face->glyph->bitmap_top),
-				face->glyph->advance.x);
-		};
-
-		for (uint32_t ch = 32; ch < 0x400; ++ch) {
-			register_glyph(ch);
 		}
 
-		register_glyph(U'ǒ');
-		register_glyph(U'ī');
-		register_glyph(U'ó');
-
 		if (!fake) {
 			glGenVertexArrays(1, &vao); CHECKGL
 			glGenBuffers(1, &vbo); CHECKGL
 			glBindVertexArray(vao); CHECKGL
 			glBindBuffer(GL_ARRAY_BUFFER, vbo); CHECKGL
-			glBufferData(GL_ARRAY_BUFFER, 4 * 6 * sizeof(float), nullptr, GL_DYNAMIC_DRAW); CHECKGL
 			glEnableVertexAttribArray(0); CHECKGL
-			glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 4 * sizeof(float), 0); CHECKGL
+			glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 8 * sizeof(float), nullptr); CHECKGL
+			glEnableVertexAttribArray(1); CHECKGL
+			glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, 8 * sizeof(float), reinterpret_cast<void *>(4 * sizeof(float))); CHECKGL
 			glBindBuffer(GL_ARRAY_BUFFER, 0); CHECKGL
 			glBindVertexArray(0); CHECKGL
 		}
@@ -136,6 +112,28 @@ namespace Game3 {
 		initialized = true;
 	}
 
+	const TextRenderer::Character * TextRenderer::loadCharacter(uint32_t ch) const {
+		FT_Face face = *freetypeFace;
+
+		if (FT_Get_Char_Index(face, ch) == 0 || FT_Load_Char(face, ch, FT_LOAD_RENDER)) {
+			return nullptr;
+		}
+
+		const FT_Bitmap &bitmap = face->glyph->bitmap;
+		std::optional<GlyphAtlas::Region> region = atlas.insert(bitmap.width, bitmap.rows, bitmap.buffer, bitmap.pitch);
+
+		if (!region) {
+			WARN("Glyph atlas is full; can't add glyph {}", ch);
+			return nullptr;
+		}
+
+		return &characters.try_emplace(ch,
+			glm::ivec2(bitmap.width, bitmap.rows),
+			glm::ivec2(face->glyph->bitmap_left, face->glyph->bitmap_top),
+			face->glyph->advance.x,
+			glm::ivec2(region->x, region->y)).first->second;
+	}
+
 	void TextRenderer::update(const Window &window) {
 		centerX = window.center.first;
 		centerY = window.center.second;
@@ -169,21 +167,18 @@ namespace Game3 {
 		}
 
 		if (0 < options.shadow.alpha) {
-			Color color = options.shadow;
-			Color shadow{0, 0, 0, 0};
-			double x = options.x + options.shadowOffset.x * options.scaleX;
-			double y = options.y + options.shadowOffset.y * options.scaleY;
-			std::swap(options.color, color);
-			std::swap(options.shadow, shadow);
-			std::swap(options.x, x);
-			std::swap(options.y, y);
-			drawOnMap(text, options);
-			std::swap(options.color, color);
-			std::swap(options.shadow, shadow);
-			std::swap(options.x, x);
-			std::swap(options.y, y);
+			TextRenderOptions shadow_options = options;
+			shadow_options.color = options.shadow;
+			shadow_options.x += options.shadowOffset.x * options.scaleX;
+			shadow_options.y += options.shadowOffset.y * options.scaleY;
+			queueOnMap(text, shadow_options);
 		}
 
+		queueOnMap(text, options);
+		flush();
+	}
+
+	void TextRenderer::queueOnMap(const UStringSpan &text, TextRenderOptions options) {
 		ClientGamePtr game = window->getGame();
 		RealmPtr realm = game->getActiveRealm();
 		TileProvider &provider = realm->tileProvider;
@@ -220,45 +215,7 @@ namespace Game3 {
 			x -= textWidth(text, scale_x);
 		}
 
-		shader.bind();
-		shader.set("textColor", options.color.red, options.color.green, options.color.blue, options.color.alpha); CHECKGL
-
-		glActiveTexture(GL_TEXTURE0); CHECKGL
-		glBindVertexArray(vao); CHECKGL
-
-		for (const auto ch: text) {
-			const auto &character = getCharacter(ch);
-
-			const float xpos = x + character.bearing.x * scale_x;
-			const float ypos = y - (character.size.y - character.bearing.y) * scale_y;
-			const float w = character.size.x * scale_x;
-			const float h = character.size.y * scale_y;
-
-			// Update VBO for each character
-			const float vertices[6][4] = {
-				{xpos,     ypos + h, 0, 0},
-				{xpos,     ypos,     0, 1},
-				{xpos + w, ypos,     1, 1},
-
-				{xpos,     ypos + h, 0, 0},
-				{xpos + w, ypos,     1, 1},
-				{xpos + w, ypos + h, 1, 0}
-			};
-
-			// Render glyph texture over quad
-			glBindTexture(GL_TEXTURE_2D, character.textureID); CHECKGL
-			// Update content of VBO memory
-			glBindBuffer(GL_ARRAY_BUFFER, vbo); CHECKGL
-			glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(vertices), vertices); CHECKGL
-			glBindBuffer(GL_ARRAY_BUFFER, 0); CHECKGL
-			// Render quad
-			glDrawArrays(GL_TRIANGLES, 0, 6); CHECKGL
-			// Advance cursors for next glyph (note that advance is number of 1/64 pixels)
-			x += (character.advance >> 6) * scale_x; // Bitshift by 6 to get value in pixels (2^6 = 64)
-		}
-
-		glBindVertexArray(0); CHECKGL
-		glBindTexture(GL_TEXTURE_2D, 0); CHECKGL
+		enqueue(layOut(text, scale_x, scale_y, 0, true), x, y, options.color);
 	}
 
 	void TextRenderer::drawOnScreen(const UString &text, TextRenderOptions options) {
@@ -266,21 +223,19 @@ namespace Game3 {
 			initRenderData();
 
 		if (0 < options.shadow.alpha) {
-			Color color = options.shadow;
-			Color shadow{0, 0, 0, 0};
-			double x = options.x + options.shadowOffset.x * options.scaleX;
-			double y = options.y + options.shadowOffset.y * options.scaleY;
-			std::swap(options.color, color);
-			std::swap(options.shadow, shadow);
-			std::swap(options.x, x);
-			std::swap(options.y, y);
-			drawOnScreen(text, options);
-			std::swap(options.color, color);
-			std::swap(options.shadow, shadow);
-			std::swap(options.x, x);
-			std::swap(options.y, y);
+			TextRenderOptions shadow_options = options;
+			shadow_options.color = options.shadow;
+			shadow_options.x += options.shadowOffset.x * options.scaleX;
+			shadow_options.y += options.shadowOffset.y * options.scaleY;
+			shadow_options.heightOut = nullptr;
+			queueOnScreen(text, shadow_options);
 		}
 
+		queueOnScreen(text, options);
+		flush();
+	}
+
+	void TextRenderer::queueOnScreen(const UString &text, TextRenderOptions options) {
 		auto &x = options.x;
 		auto &y = options.y;
 		auto &scale_x = options.scaleX;
@@ -300,25 +255,37 @@ namespace Game3 {
 			x -= textWidth(text, scale_x);
 		}
 
-		shader.bind();
-		shader.set("textColor", options.color.red, options.color.green, options.color.blue, options.color.alpha); CHECKGL
+		const Layout &layout = layOut(UStringSpan(text), scale_x, scale_y, options.wrapWidth, options.ignoreNewline);
+		enqueue(layout, x, y, options.color);
 
-		glActiveTexture(GL_TEXTURE0); CHECKGL
-		glBindVertexArray(vao); CHECKGL
+		if (options.heightOut) {
+			*options.heightOut = -layout.lastLineY + layout.highestOnFirstLine + (options.alignTop? i_height : 0);
+		}
+	}
+
+	auto TextRenderer::layOut(UStringSpan text, float scale_x, float scale_y, float wrap_width, bool ignore_newline) const -> const Layout & {
+		LayoutKey key{std::string(text), scale_x, scale_y, wrap_width, ignore_newline};
+
+		if (auto iter = layouts.find(key); iter != layouts.end()) {
+			return iter->second;
+		}
+
+		if (MAX_CACHED_LAYOUTS <= layouts.size()) {
+			layouts.clear();
+		}
 
-		const auto wrap_width = options.wrapWidth;
-		const auto x_start = x;
-		const auto y_start = y;
+		Layout layout;
+		const auto i_height = getIHeight() * scale_y;
+		float x = 0;
+		float y = 0;
 
 		auto next_line = [&] {
-			x = x_start;
+			x = 0;
 			y -= i_height * LINE_HEIGHT;
 		};
 
-		float highest_on_first_line = 0;
-
 		for (const uint32_t ch: text) {
-			if (!options.ignoreNewline && ch == '\n') {
+			if (!ignore_newline && ch == '\n') {
 				next_line();
 				continue;
 			}
@@ -330,45 +297,113 @@ namespace Game3 {
 			float xpos = x + character.bearing.x * scale_x;
 			float ypos = y - h + character.bearing.y * scale_y;
 
-			if (y == y_start && h > highest_on_first_line) {
-				highest_on_first_line = h;
+			if (y == 0 && h > layout.highestOnFirstLine) {
+				layout.highestOnFirstLine = h;
 			}
 
-			if (wrap_width > 0 && wrap_width < xpos - x_start + w) {
+			if (wrap_width > 0 && wrap_width < xpos + w) {
 				next_line();
 				xpos = x + character.bearing.x * scale_x;
 				ypos = y - h + character.bearing.y * scale_y;
 			}
 
-			// Update VBO for each character
+			if (0 < character.size.x && 0 < character.size.y) {
+				layout.quads.push_back({xpos, ypos, w, h, character.atlasPosition, character.size});
+			}
+
+			// Advance cursor for next glyph (note that advance is number of 1/64 pixels)
+			x += (character.advance >> 6) * scale_x; // Bitshift by 6 to get value in pixels (2^6 = 64)
+		}
+
+		layout.lastLineY = y;
+		return layouts.emplace(std::move(key), std::move(layout)).first->second;
+	}
+
+	void TextRenderer::enqueue(const Layout &layout, float x, float y, const Color &color) {
+		batch.reserve(batch.size() + layout.quads.size() * 6 * 8);
+
+		for (const Layout::Quad &quad: layout.quads) {
+			const float xpos = x + quad.x;
+			const float ypos = y + quad.y;
+			// Texture coordinates are in texels; the shader divides by the atlas size at draw time.
+			const float u0 = quad.atlasPosition.x;
+			const float v0 = quad.atlasPosition.y;
+			const float u1 = u0 + quad.size.x;
+			const float v1 = v0 + quad.size.y;
+
 			const float vertices[6][4] = {
-				{xpos,     ypos + h, 0, 0},
-				{xpos,     ypos,     0, 1},
-				{xpos + w, ypos,     1, 1},
+				{xpos,              ypos + quad.height, u0, v0},
+				{xpos,              ypos,               u0, v1},
+				{xpos + quad.width, ypos,               u1, v1},
 
-				{xpos,     ypos + h, 0, 0},
-				{xpos + w, ypos,     1, 1},
-				{xpos + w, ypos + h, 1, 0}
+				{xpos,              ypos + quad.height, u0, v0},
+				{xpos + quad.width, ypos,               u1, v1},
+				{xpos + quad.width, ypos + quad.height, u1, v0}
 			};
 
-			// Render glyph texture over quad
-			glBindTexture(GL_TEXTURE_2D, character.textureID); CHECKGL
-			// Update content of VBO memory
-			glBindBuffer(GL_ARRAY_BUFFER, vbo); CHECKGL
-			glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(vertices), vertices); CHECKGL
-			glBindBuffer(GL_ARRAY_BUFFER, 0); CHECKGL
-			// Render quad
-			glDrawArrays(GL_TRIANGLES, 0, 6); CHECKGL
-			// Advance cursor for next glyph (note that advance is number of 1/64 pixels)
-			x += (character.advance >> 6) * scale_x; // Bitshift by 6 to get value in pixels (2^6 = 64)
+			for (const auto &vertex: vertices) {
+				batch.insert(batch.end(), std::begin(vertex), std::end(vertex));
+				batch.insert(batch.end(), {color.red, color.green, color.blue, color.alpha});
+			}
 		}
+	}
 
-		glBindVertexArray(0); CHECKGL
-		glBindTexture(GL_TEXTURE_2D, 0); CHECKGL
+	void TextRenderer::flush() {
+		if (batch.empty()) {
+			return;
+		}
 
-		if (options.heightOut) {
-			*options.heightOut = y_start - y + highest_on_first_line + (options.alignTop? i_height : 0);
+		if (fake) {
+			batch.clear();
+			return;
+		}
+
+		glActiveTexture(GL_TEXTURE0); CHECKGL
+
+		if (atlasTexture == 0) {
+			glGenTextures(1, &atlasTexture); CHECKGL
+			glBindTexture(GL_TEXTURE_2D, atlasTexture); CHECKGL
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE); CHECKGL
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE); CHECKGL
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR); CHECKGL
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR); CHECKGL
+			uploadedHeight = 0;
+		} else {
+			glBindTexture(GL_TEXTURE_2D, atlasTexture); CHECKGL
+		}
+
+		if (uploadedHeight == 0 || uploadedRevision != atlas.getRevision()) {
+			glPixelStorei(GL_UNPACK_ALIGNMENT, 1); CHECKGL
+			if (uploadedHeight != atlas.getHeight()) {
+				glTexImage2D(GL_TEXTURE_2D, 0, GL_RED, atlas.getWidth(), atlas.getHeight(), 0, GL_RED, GL_UNSIGNED_BYTE, atlas.getPixels().data()); CHECKGL
+				uploadedHeight = atlas.getHeight();
+			} else {
+				glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, atlas.getWidth(), atlas.getHeight(), GL_RED, GL_UNSIGNED_BYTE, atlas.getPixels().data()); CHECKGL
+			}
+			uploadedRevision = atlas.getRevision();
+		}
+
+		shader.bind();
+		shader.set("atlasSize", float(atlas.getWidth()), float(atlas.getHeight())); CHECKGL
+
+		glBindVertexArray(vao); CHECKGL
+		glBindBuffer(GL_ARRAY_BUFFER, vbo); CHECKGL
+
+		const size_t bytes = batch.size() * sizeof(float);
+		if (vboCapacity < bytes) {
+			glBufferData(GL_ARRAY_BUFFER, bytes, batch.data(), GL_DYNAMIC_DRAW); CHECKGL
+			vboCapacity = bytes;
+		} else {
+			glBufferSubData(GL_ARRAY_BUFFER, 0, bytes, batch.data()); CHECKGL
 		}
+
+		glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(batch.size() / 8)); CHECKGL
+		++drawCalls;
+
+		glBindBuffer(GL_ARRAY_BUFFER, 0); CHECKGL
+		glBindVertexArray(0); CHECKGL
+		glBindTexture(GL_TEXTURE_2D, 0); CHECKGL
+		batch.clear();
 	}
 
 	void TextRenderer::operator()(const UString &text, const TextRenderOptions &options) {
@@ -462,6 +497,11 @@ namespace Game3 {
 		}
 
 		assert(initialized);
+
+		if (const Character *character = loadCharacter(ch)) {
+			return *character;
+		}
+
 		return characters.at('?');
 	}
 
@@ -470,10 +510,14 @@ namespace Game3 {
 			initRenderData();
 		}
 
-		if (auto iter = characters.find(ch); iter != characters.end()) {
-			return iter->second;
-		}
+		return std::as_const(*this).getCharacter(ch);
+	}
 
-		return characters.at('?');
+	size_t TextRenderer::LayoutKeyHash::operator()(const LayoutKey &key) const noexcept {
+		size_t hash = std::hash<std::string>{}(key.text);
+		for (const float value: {key.scaleX, key.scaleY, key.wrapWidth}) {
+			hash = (hash * 0x1f1f1f1f1f1f1f1fuz) ^ std::hash<float>{}(value);
+		}
+		return (hash << 1) | key.ignoreNewline;
 	}
 }
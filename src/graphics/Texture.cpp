@@ -1,16 +1,25 @@
 // Credit: https://github.com/JoeyDeVries/LearnOpenGL/blob/master/src/7.in_practice/3.2d_game/0.full_source/texture.cpp
 #include "config.h"
 #include "util/Log.h"
-#include "graphics/GL.h"
 #include "graphics/Texture.h"
 #include "lib/JSON.h"
 #include "lib/PNG.h"
 #include "util/Util.h"
 
+#ifndef GAME3_HEADLESS
+#include "graphics/GL.h"
+#endif
+
 #include <unordered_map>
 
 namespace Game3 {
-	static constexpr GLint DEFAULT_FILTER = GL_NEAREST;
+	static constexpr int DEFAULT_FILTER = Texture::NEAREST;
+
+#ifndef GAME3_HEADLESS
+	static_assert(Texture::NEAREST == GL_NEAREST);
+	static_assert(Texture::LINEAR  == GL_LINEAR);
+	static_assert(Texture::RGB     == GL_RGB);
+	static_assert(Texture::RGBA    == GL_RGBA);
 
 	static void setParameters(GLint filter) {
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE); CHECKGL
@@ -18,17 +27,19 @@ namespace Game3 {
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, filter); CHECKGL
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, filter); CHECKGL
 	}
+#endif
 
 	Texture::Texture(Identifier identifier, bool alpha, int filter):
 		Texture(std::move(identifier), std::filesystem::path{}, alpha, filter) {}
 
 	Texture::Texture(Identifier identifier, std::filesystem::path path, bool alpha, int filter):
 		NamedRegisterable(std::move(identifier)),
-		format(alpha? GL_RGBA : GL_RGB),
+		format(alpha? RGBA : RGB),
 		filter(filter == -1? DEFAULT_FILTER : filter),
 		alpha(alpha),
 		path(std::move(path)) {}
 
+#ifndef GAME3_HEADLESS
 	void Texture::init() {
 		if (valid) {
 			return;
@@ -136,6 +147,7 @@ namespace Game3 {
 		}
 		glBindTexture(GL_TEXTURE_2D, id); CHECKGL
 	}
+#endif
 
 	void Texture::dump(const std::filesystem::path &dump_path) {
 		assert(valid);
@@ -143,6 +155,7 @@ namespace Game3 {
 		stbi_write_png(dump_path.string().c_str(), width, height, channels, data.get(), width * channels);
 	}
 
+#ifndef GAME3_HEADLESS
 	void Texture::destroy() {
 		if (!valid) {
 			return;
@@ -152,6 +165,7 @@ namespace Game3 {
 		id = 0;
 		valid = false;
 	}
+#endif
 
 	using TextureCache = std::unordered_map<std::string, std::shared_ptr<Texture>>;
 
@@ -185,8 +199,8 @@ namespace Game3 {
 	std::string Texture::filterToString(int filter) {
 		filter = filter == -1? DEFAULT_FILTER : filter;
 		switch (filter) {
-			case GL_NEAREST: return "nearest";
-			case GL_LINEAR:  return "linear";
+			case NEAREST: return "nearest";
+			case LINEAR:  return "linear";
 			default:
 				throw std::runtime_error(std::format("Unrecognized filter: {}", filter));
 		}
@@ -194,11 +208,11 @@ namespace Game3 {
 
 	int Texture::stringToFilter(std::string_view string) {
 		if (string == "nearest") {
-			return GL_NEAREST;
+			return NEAREST;
 		}
 
 		if (string == "linear") {
-			return GL_LINEAR;
+			return LINEAR;
 		}
 
 		throw std::runtime_error(std::format("Unrecognized filter: {}", string));
@@ -214,7 +228,7 @@ namespace Game3 {
 	TexturePtr tag_invoke(boost::json::value_to_tag<TexturePtr>, const boost::json::value &json) {
 		const auto &array = json.as_array();
 		bool alpha = 1 < array.size()? array.at(1).as_bool() : true;
-		int filter = 2 < array.size()? Texture::stringToFilter(std::string_view(array.at(2).as_string())) : GL_NEAREST;
+		int filter = 2 < array.size()? Texture::stringToFilter(std::string_view(array.at(2).as_string())) : Texture::NEAREST;
 		return cacheTexture(std::filesystem::path(std::string_view(json.at(0).as_string())), alpha, filter);
 	}
 }
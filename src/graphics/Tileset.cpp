@@ -4,6 +4,8 @@
 #include "realm/Realm.h"
 #include "util/Crypto.h"
 
+#include <algorithm>
+
 namespace Game3 {
 	Tileset::Tileset(Identifier identifier_):
 		NamedRegisterable(std::move(identifier_)) {}
@@ -128,6 +130,34 @@ namespace Game3 {
 		return nullptr;
 	}
 
+	void Tileset::compileAutotiles() {
+		size_t id_count = 0;
+		for (const auto &[id, tilename]: names) {
+			id_count = std::max<size_t>(id_count, id + 1);
+		}
+
+		for (const auto &[identifier, autotile_set]: autotileSets) {
+			autotile_set->memberIDs.assign(id_count, false);
+		}
+
+		compiledMarchables.assign(id_count, {});
+		noOmniIDs.assign(id_count, false);
+
+		for (const auto &[id, tilename]: names) {
+			for (const auto &[identifier, autotile_set]: autotileSets) {
+				if (autotile_set->members.contains(tilename)) {
+					autotile_set->memberIDs[id] = true;
+				}
+			}
+
+			if (const MarchableInfo *info = getMarchableInfo(tilename)) {
+				compiledMarchables[id] = CompiledMarchable{info->autotileSet.get(), ids.at(info->start), info->tall, info->eight};
+			}
+
+			noOmniIDs[id] = isInCategory(tilename, "base:category/no_omni");
+		}
+	}
+
 	void Tileset::clearCache() {
 		marchableCache.clear();
 		unmarchableCache.clear();
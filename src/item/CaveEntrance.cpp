@@ -3,7 +3,6 @@
 #include "algorithm/Spiral.h"
 #include "biome/Biome.h"
 #include "entity/Player.h"
-#include "game/ClientGame.h"
 #include "game/Inventory.h"
 #include "game/ServerGame.h"
 #include "graphics/Tileset.h"
@@ -12,9 +11,13 @@
 #include "threading/ThreadContext.h"
 #include "tileentity/Building.h"
 #include "types/Position.h"
-#include "ui/Window.h"
 #include "worldgen/CaveGen.h"
 
+#ifndef GAME3_HEADLESS
+#include "game/ClientGame.h"
+#include "ui/Window.h"
+#endif
+
 namespace {
 	constexpr size_t LADDER_ATTEMPTS = 49;
 }
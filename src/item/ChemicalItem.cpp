@@ -2,7 +2,6 @@
 #include "chemistry/MoleculeColors.h"
 #include "chemistry/MoleculeNames.h"
 #include "graphics/HSL.h"
-#include "graphics/OpenGL.h"
 #include "graphics/Texture.h"
 #include "item/ChemicalItem.h"
 
@@ -11,6 +10,7 @@
 namespace Game3 {
 	Lockable<std::unordered_map<std::string, TexturePtr>> ChemicalItem::textureCache{};
 
+#ifndef GAME3_HEADLESS
 	TexturePtr ChemicalItem::getTexture(const Game &game, const ConstItemStackPtr &stack) const {
 		const std::string formula = getFormula(*stack);
 
@@ -51,12 +51,13 @@ namespace Game3 {
 
 		TexturePtr new_texture = std::make_shared<Texture>();
 		new_texture->alpha = true;
-		new_texture->filter = GL_NEAREST;
-		new_texture->format = GL_RGBA;
+		new_texture->filter = Texture::NEAREST;
+		new_texture->format = Texture::RGBA;
 		new_texture->init(rawImage, width, height);
 
 		return new_texture;
 	}
+#endif
 
 	std::string ChemicalItem::getTooltip(const ConstItemStackPtr &stack) {
 		std::string formula = getFormula(*stack);
@@ -70,7 +71,7 @@ namespace Game3 {
 	}
 
 	std::string ChemicalItem::getFormula(const ItemStack &stack) {
-		if (const auto *data = stack.data.if_object()) {
+		if (const auto *data = stack.data->if_object()) {
 			if (auto *value = data->if_contains("formula"); value && value->is_string()) {
 				return std::string(value->as_string());
 			}
@@ -21,17 +21,21 @@ namespace Game3 {
 			return true;
 		}
 
-		auto &data = stack->data;
-		auto data_lock = data.uniqueLock();
-		boost::json::object &object = ensureObject(data);
+		const bool changed = stack->data.mutate([&](boost::json::value &data) {
+			boost::json::object &object = ensureObject(data);
 
-		bool &dense = boolifyKey(object, "dense", false);
+			bool &dense = boolifyKey(object, "dense", false);
 
-		// Shift-ctrl click to toggle density
-		if (modifiers == Modifiers(true, true, false, false)) {
-			dense = !dense;
-			place.player->getInventory(0)->notifyOwner(stack);
-		} else if (dense? denseClick(place, object, modifiers.onlyShift()) : regularClick(place, object)) {
+			// Shift-ctrl click to toggle density
+			if (modifiers == Modifiers(true, true, false, false)) {
+				dense = !dense;
+				return true;
+			}
+
+			return dense? denseClick(place, object, modifiers.onlyShift()) : regularClick(place, object);
+		});
+
+		if (changed) {
 			place.player->getInventory(0)->notifyOwner(stack);
 		}
 
@@ -45,7 +49,7 @@ namespace Game3 {
 	std::string ContainmentOrb::getTooltip(const ConstItemStackPtr &stack) {
 		auto lock = stack->data.sharedLock();
 
-		if (const boost::json::object *object = stack->data.if_object()) {
+		if (const boost::json::object *object = stack->data->if_object()) {
 			if (getBoolKey(*object, "dense", false)) {
 				if (const boost::json::value *entities_value = object->if_contains("entities")) {
 					if (const boost::json::array *entities = entities_value->if_array()) {
@@ -74,7 +78,7 @@ namespace Game3 {
 		auto lock = stack->data.sharedLock();
 		bool empty = true;
 
-		if (const boost::json::object *object = stack->data.if_object()) {
+		if (const boost::json::object *object = stack->data->if_object()) {
 			if (getBoolKey(*object, "dense", false)) {
 				if (const boost::json::value *entities_value = object->if_contains("entities")) {
 					if (const boost::json::array *entities = entities_value->if_array()) {
@@ -91,9 +95,9 @@ namespace Game3 {
 
 	EntityPtr ContainmentOrb::makeEntity(const ItemStackPtr &stack) {
 		GamePtr game = stack->getGame();
-		Identifier type = boost::json::value_to<Identifier>(stack->data.at("type"));
+		Identifier type = boost::json::value_to<Identifier>(stack->data->at("type"));
 		const std::shared_ptr<EntityFactory> &factory = game->registry<EntityFactoryRegistry>()[type];
-		EntityPtr entity = (*factory)(game, stack->data);
+		EntityPtr entity = (*factory)(game, *stack->data);
 		entity->spawning = true;
 		return entity;
 	}
@@ -111,7 +115,7 @@ namespace Game3 {
 			throw std::invalid_argument("Can't evaluate whether non-containment orb stack is an empty containment orb");
 		}
 
-		if (const auto *object = stack->data.if_object()) {
+		if (const auto *object = stack->data->if_object()) {
 			return object->empty();
 		}
 
@@ -1,12 +1,7 @@
 #include "types/Layer.h"
-#include "entity/ClientPlayer.h"
 #include "entity/Player.h"
-#include "game/ClientGame.h"
 #include "game/Game.h"
 #include "game/Inventory.h"
-#include "graphics/RectangleRenderer.h"
-#include "graphics/RendererContext.h"
-#include "graphics/RenderOptions.h"
 #include "graphics/Tileset.h"
 #include "item/Copier.h"
 #include "packet/SetCopierConfigurationPacket.h"
@@ -16,6 +11,14 @@
 #include "tools/Paster.h"
 #include "util/Util.h"
 
+#ifndef GAME3_HEADLESS
+#include "entity/ClientPlayer.h"
+#include "game/ClientGame.h"
+#include "graphics/RectangleRenderer.h"
+#include "graphics/RendererContext.h"
+#include "graphics/RenderOptions.h"
+#endif
+
 #include <sstream>
 
 namespace Game3 {
@@ -23,7 +26,7 @@ namespace Game3 {
 		template <template <typename...> typename C = std::unordered_set>
 		C<Position> getPositions(const ItemStack &stack) {
 			auto lock = stack.data.sharedLock();
-			const auto &object = stack.data.as_object();
+			const auto &object = stack.data->as_object();
 			if (const auto *value = object.if_contains("positions")) {
 				return boost::json::value_to<C<Position>>(*value);
 			}
@@ -141,7 +144,7 @@ namespace Game3 {
 			combined.pop_back();
 		}
 
-		if (const auto *value = stack->data.as_object().if_contains("includeTileEntities"); !value || !value->as_bool()) {
+		if (const auto *value = stack->data->as_object().if_contains("includeTileEntities"); !value || !value->as_bool()) {
 			return combined;
 		}
 
@@ -181,15 +184,13 @@ namespace Game3 {
 			return true;
 		}
 
-		{
-			auto lock = stack->data.uniqueLock();
-
+		stack->data.mutate([&](boost::json::value &json) {
 			if (modifiers.onlyCtrl()) {
-				if (auto *object = stack->data.if_object()) {
+				if (auto *object = json.if_object()) {
 					object->erase("positions");
 					object->erase("min");
 				}
-			} else if (auto *object = stack->data.if_object()) {
+			} else if (auto *object = json.if_object()) {
 				const Position &position = place.position;
 				std::unordered_set<Position> positions;
 
@@ -227,12 +228,13 @@ namespace Game3 {
 					(*object)["positions"] = boost::json::value_from(positions);
 				}
 			}
-		}
+		});
 
 		place.player->getInventory(0)->notifyOwner({});
 		return true;
 	}
 
+#ifndef GAME3_HEADLESS
 	void Copier::renderEffects(Window &, const RendererContext &context, const Position &mouse_position, Modifiers modifiers, const ItemStackPtr &stack) const {
 		RectangleRenderer &rectangle = context.rectangle;
 
@@ -249,7 +251,7 @@ namespace Game3 {
 		}
 
 		if (modifiers == Modifiers(true, true, false, false)) {
-			if (auto *value = stack->data.as_object().if_contains("min")) {
+			if (auto *value = stack->data->as_object().if_contains("min")) {
 				Position anchor = boost::json::value_to<Position>(*value);
 
 				for (const Position &position: positions) {
@@ -265,6 +267,7 @@ namespace Game3 {
 			}
 		}
 	}
+#endif
 
 	/*
 	bool Copier::populateMenu(const InventoryPtr &inventory, Slot slot, const ItemStackPtr &stack, Glib::RefPtr<Gio::Menu> menu, Glib::RefPtr<Gio::SimpleActionGroup> group) const {
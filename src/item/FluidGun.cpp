@@ -1,9 +1,7 @@
 #include "util/Log.h"
 #include "entity/Player.h"
 #include "entity/FluidParticle.h"
-#include "game/ClientGame.h"
 #include "game/Inventory.h"
-#include "graphics/RendererContext.h"
 #include "graphics/Tileset.h"
 #include "item/FluidGun.h"
 #include "lib/JSON.h"
@@ -15,13 +13,18 @@
 #include "tileentity/FluidHoldingTileEntity.h"
 #include "types/PackedTime.h"
 #include "types/Position.h"
+#include "util/Explosion.h"
+
+#ifndef GAME3_HEADLESS
+#include "game/ClientGame.h"
+#include "graphics/RendererContext.h"
 #include "ui/dialog/BottomDialog.h"
 #include "ui/widget/Hotbar.h"
 #include "ui/widget/ProgressBar.h"
 #include "ui/Constants.h"
 #include "ui/GameUI.h"
 #include "ui/Window.h"
-#include "util/Explosion.h"
+#endif
 
 #include <tuple>
 
@@ -65,7 +68,7 @@ namespace Game3 {
 	}
 
 	static void setFluidGunData(const PlayerPtr &player, Slot slot, const ItemStackPtr &stack, const FluidPtr &fluid, double amount, std::optional<PackedTime> last_slurp) {
-		stack->data.withUnique([&](boost::json::value &json) {
+		stack->data.mutate([&](boost::json::value &json) {
 			boost::json::object *object = json.if_object();
 			if (!object) {
 				object = &json.emplace_object();
@@ -193,6 +196,7 @@ namespace Game3 {
 		return use(slot, stack, place, modifiers, offsets);
 	}
 
+#ifndef GAME3_HEADLESS
 	bool FluidGun::fire(Slot, const ItemStackPtr &stack, const Place &place, Modifiers modifiers, std::pair<float, float> offsets) {
 		if (modifiers.shift) {
 			return false;
@@ -243,6 +247,7 @@ namespace Game3 {
 			ProgressBar(ui, 1, color, amount / capacity).render(renderers, rectangle);
 		}
 	}
+#endif
 
 	bool FluidGun::fireGun(Slot slot, const ItemStackPtr &stack, const Place &place, Modifiers modifiers, std::pair<float, float> offsets, uint16_t tick_frequency) {
 		if (modifiers.shift) {
@@ -41,6 +41,7 @@ namespace Game3 {
 
 	Item::~Item() = default;
 
+#ifndef GAME3_HEADLESS
 	TexturePtr Item::getTexture(const Game &game, const ConstItemStackPtr &stack) const {
 		if (!isTextureCacheable() || !cachedTexture)
 			cachedTexture = makeTexture(game, stack);
@@ -53,7 +54,7 @@ namespace Game3 {
 		texture->init();
 		const int width  = item_texture->width;
 		const int height = item_texture->height;
-		const ptrdiff_t channels = texture->format == GL_RGBA? 4 : 3;
+		const ptrdiff_t channels = texture->format == Texture::RGBA? 4 : 3;
 		const size_t row_size = channels * width;
 
 		auto lock = rawImage.uniqueLock();
@@ -76,11 +77,13 @@ namespace Game3 {
 
 		return new_texture;
 	}
+#endif
 
 	Identifier Item::getTextureIdentifier(const ConstItemStackPtr &) const {
 		return identifier;
 	}
 
+#ifndef GAME3_HEADLESS
 	void Item::getOffsets(const Game &game, std::shared_ptr<Texture> &texture, float &x_offset, float &y_offset) {
 		const auto &registry = game.registry<ItemTextureRegistry>();
 		if (registry.contains(identifier)) {
@@ -93,6 +96,7 @@ namespace Game3 {
 			y_offset = 0.f;
 		}
 	}
+#endif
 
 	Item & Item::addAttribute(Identifier attribute) & {
 		attributes.insert(std::move(attribute));
@@ -153,7 +157,7 @@ namespace Game3 {
 		item->initStack(*game, *this);
 	}
 
-	ItemStack::ItemStack(const GamePtr &game, std::shared_ptr<Item> item_, ItemCount count_, boost::json::value data_):
+	ItemStack::ItemStack(const GamePtr &game, std::shared_ptr<Item> item_, ItemCount count_, ItemStackData data_):
 	item(std::move(item_)), count(count_), data(std::move(data_)), weakGame(game) {
 		assert(item != nullptr);
 		assert(game != nullptr);
@@ -167,12 +171,13 @@ namespace Game3 {
 		item->initStack(*game, *this);
 	}
 
-	ItemStack::ItemStack(const GamePtr &game, const ItemID &id, ItemCount count, boost::json::value data):
+	ItemStack::ItemStack(const GamePtr &game, const ItemID &id, ItemCount count, ItemStackData data):
 		item(game->itemRegistry->at(id)), count(count), data(std::move(data)), weakGame(game) {
 			assert(item != nullptr);
 			item->initStack(*game, *this);
 		}
 
+#ifndef GAME3_HEADLESS
 	TexturePtr ItemStack::getTexture() const {
 		GamePtr game = getGame();
 		return getTexture(*game);
@@ -189,13 +194,26 @@ namespace Game3 {
 
 		return {};
 	}
+#endif
 
 	bool ItemStack::canMerge(const ItemStack &other) const {
 		if (!item || !other.item) {
 			return false;
 		}
 
-		return *item == *other.item && data == other.data;
+		if (this == &other) {
+			return true;
+		}
+
+		if (item != other.item && !(*item == *other.item)) {
+			return false;
+		}
+
+		return data == other.data;
+	}
+
+	size_t ItemStack::getDataHash() const {
+		return data.getHash();
 	}
 
 	ItemStackPtr ItemStack::withCount(ItemCount new_count) const {
@@ -204,10 +222,11 @@ namespace Game3 {
 
 	ItemStackPtr ItemStack::withDurability(const GamePtr &game, const ItemID &id, Durability durability) {
 		ItemStackPtr out = ItemStack::create(game, id, 1);
-		auto &object = out->data.emplace_object();
-		auto &array = object["durability"].emplace_array();
-		array.emplace_back(durability);
-		array.emplace_back(durability);
+		out->data.mutate([&](boost::json::value &json) {
+			auto &array = json.emplace_object()["durability"].emplace_array();
+			array.emplace_back(durability);
+			array.emplace_back(durability);
+		});
 		return out;
 	}
 
@@ -220,11 +239,12 @@ namespace Game3 {
 			return false;
 		}
 
-		auto &object = data.as_object();
-		auto &durability = object["durability"].at(0);
-		auto new_durability = std::max(0, boost::json::value_to<Durability>(durability) - amount);
-		durability = new_durability;
-		return new_durability == 0;
+		return data.mutate([&](boost::json::value &json) {
+			auto &durability = json.as_object()["durability"].at(0);
+			auto new_durability = std::max(0, boost::json::value_to<Durability>(durability) - amount);
+			durability = new_durability;
+			return new_durability == 0;
+		});
 	}
 
 	bool ItemStack::hasAttribute(const Identifier &attribute) const {
@@ -232,7 +252,7 @@ namespace Game3 {
 	}
 
 	bool ItemStack::hasDurability() const {
-		if (const auto *object = data.if_object()) {
+		if (const auto *object = data->if_object()) {
 			if (auto iter = object->find("durability"); iter != object->end()) {
 				return 0 <= getDouble(iter->value().as_array().at(1));
 			}
@@ -246,7 +266,7 @@ namespace Game3 {
 			return 1;
 		}
 
-		const boost::json::object &object = data.as_object();
+		const boost::json::object &object = data->as_object();
 		const boost::json::array &array = object.at("durability").as_array();
 		return getDouble(array[0]) / getDouble(array.at(1));
 	}
@@ -275,17 +295,19 @@ namespace Game3 {
 			const auto &extra = array[2];
 			if (extra.is_string() && extra == "with_durability") {
 				const Durability durability = dynamic_cast<HasMaxDurability &>(*stack->item).maxDurability;
-				boost::json::object *object = nullptr;
-				if (stack->data.is_null()) {
-					object = &stack->data.emplace_object();
-				} else {
-					object = stack->data.if_object();
-				}
-				if (object) {
-					auto &durability_array = (*object)["durability"].emplace_array();
-					durability_array.emplace_back(durability);
-					durability_array.emplace_back(durability);
-				}
+				stack->data.mutate([&](boost::json::value &json) {
+					boost::json::object *object = nullptr;
+					if (json.is_null()) {
+						object = &json.emplace_object();
+					} else {
+						object = json.if_object();
+					}
+					if (object) {
+						auto &durability_array = (*object)["durability"].emplace_array();
+						durability_array.emplace_back(durability);
+						durability_array.emplace_back(durability);
+					}
+				});
 			} else {
 				stack->data = extra;
 			}
@@ -311,9 +333,11 @@ namespace Game3 {
 		item->onDestroy(game, shared_from_this());
 	}
 
+#ifndef GAME3_HEADLESS
 	void ItemStack::renderEffects(Window &window, const RendererContext &renderers, const Position &position, Modifiers modifiers) {
 		item->renderEffects(window, renderers, position, modifiers, shared_from_this());
 	}
+#endif
 
 	void ItemStack::encode(Game &game, Buffer &buffer) {
 		assert(item != nullptr);
@@ -370,7 +394,9 @@ namespace Game3 {
 		buffer.appendType(stack, false);
 		buffer << stack->item->identifier;
 		buffer << stack->count;
-		buffer << stack->data;
+		stack->data.withShared([&](const boost::json::value &json) {
+			buffer << json;
+		});
 		return buffer;
 	}
 
@@ -399,8 +425,8 @@ namespace Game3 {
 		auto &array = json.emplace_array();
 		array.emplace_back(boost::json::value_from(stack.item->identifier));
 		array.emplace_back(stack.count);
-		if (!stack.data.is_null()) {
-			array.emplace_back(stack.data);
+		if (!stack.data.isNull()) {
+			array.emplace_back(boost::json::value_from(stack.data));
 		}
 	}
 
@@ -0,0 +1,101 @@
+#include "item/ItemStackData.h"
+
+#include <utility>
+
+namespace Game3 {
+	ItemStackData::ItemStackData(boost::json::value json) {
+		if (!json.is_null()) {
+			value = std::make_shared<boost::json::value>(std::move(json));
+			rehash();
+		}
+	}
+
+	ItemStackData::ItemStackData(const ItemStackData &other) {
+		auto lock = other.sharedLock();
+		value = other.value;
+		hash = other.hash;
+	}
+
+	ItemStackData::ItemStackData(ItemStackData &&other) noexcept {
+		auto lock = other.uniqueLock();
+		value = std::move(other.value);
+		hash = std::exchange(other.hash, 0);
+	}
+
+	ItemStackData & ItemStackData::operator=(const ItemStackData &other) {
+		if (this == &other) {
+			return *this;
+		}
+
+		auto this_lock = uniqueLock();
+		auto other_lock = other.sharedLock();
+		value = other.value;
+		hash = other.hash;
+		return *this;
+	}
+
+	ItemStackData & ItemStackData::operator=(ItemStackData &&other) noexcept {
+		if (this == &other) {
+			return *this;
+		}
+
+		auto this_lock = uniqueLock();
+		auto other_lock = other.uniqueLock();
+		value = std::move(other.value);
+		hash = std::exchange(other.hash, 0);
+		return *this;
+	}
+
+	ItemStackData & ItemStackData::operator=(boost::json::value json) {
+		auto lock = uniqueLock();
+		if (json.is_null()) {
+			value.reset();
+		} else {
+			value = std::make_shared<boost::json::value>(std::move(json));
+		}
+		rehash();
+		return *this;
+	}
+
+	const boost::json::value & ItemStackData::get() const {
+		static const boost::json::value null;
+		return value? *value : null;
+	}
+
+	bool ItemStackData::operator==(const ItemStackData &other) const {
+		if (this == &other) {
+			return true;
+		}
+
+		auto this_lock = sharedLock();
+		auto other_lock = other.sharedLock();
+
+		if (value == other.value) {
+			return true;
+		}
+
+		return hash == other.hash && get() == other.get();
+	}
+
+	bool ItemStackData::operator==(const boost::json::value &json) const {
+		auto lock = sharedLock();
+		return get() == json;
+	}
+
+	void ItemStackData::detach() {
+		if (!value) {
+			value = std::make_shared<boost::json::value>();
+		} else if (1 < value.use_count()) {
+			value = std::make_shared<boost::json::value>(*value);
+		}
+	}
+
+	void ItemStackData::rehash() {
+		hash = isNull()? 0 : std::hash<boost::json::value>{}(*value);
+	}
+
+	void tag_invoke(boost::json::value_from_tag, boost::json::value &json, const ItemStackData &data) {
+		auto lock = data.sharedLock();
+		json = data.get();
+	}
+}
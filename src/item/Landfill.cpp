@@ -4,7 +4,10 @@
 #include "game/Inventory.h"
 #include "item/Landfill.h"
 #include "realm/Realm.h"
+
+#ifndef GAME3_HEADLESS
 #include "ui/Window.h"
+#endif
 
 namespace Game3 {
 	Landfill::Landfill(ItemID id, std::string name, MoneyCount basePrice, ItemCount maxCount, Layer terrainLayer, Identifier terrainName, Identifier objectsName, ItemCount requiredCount):
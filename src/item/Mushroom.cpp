@@ -2,15 +2,20 @@
 #include "entity/Player.h"
 #include "game/Game.h"
 #include "game/Inventory.h"
+#include "graphics/Texture.h"
 #include "item/Mushroom.h"
 #include "realm/Realm.h"
+
+#ifndef GAME3_HEADLESS
 #include "ui/Window.h"
+#endif
 
 namespace Game3 {
 	Mushroom::Mushroom(ItemID id_, std::string name_, MoneyCount base_price, Mushroom::ID sub_id):
 		Item(std::move(id_), std::move(name_), base_price, 64),
 		subID(sub_id) {}
 
+#ifndef GAME3_HEADLESS
 	void Mushroom::getOffsets(const Game &game, std::shared_ptr<Texture> &texture, float &x_offset, float &y_offset) {
 		texture = game.registry<TextureRegistry>().at("base:texture/mushrooms");
 		texture->init();
@@ -23,7 +28,7 @@ namespace Game3 {
 		texture->init();
 		constexpr int width  = 16;
 		constexpr int height = 16;
-		const int channels = texture->format == GL_RGBA? 4 : 3;
+		const int channels = texture->format == Texture::RGBA? 4 : 3;
 		const size_t row_size = size_t(channels) * width;
 
 		const auto x = (subID % 6) * 16;
@@ -47,4 +52,5 @@ namespace Game3 {
 
 		return new_texture;
 	}
+#endif
 }
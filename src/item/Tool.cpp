@@ -2,14 +2,17 @@
 
 namespace Game3 {
 	void Tool::initStack(const Game &, ItemStack &stack) {
-		if (stack.data.is_null()) {
-			stack.data.emplace_object();
+		// Copies of a tool stack already have durability, and mutating their data would unshare it for nothing.
+		if (const auto *object = stack.data->if_object(); object && object->contains("durability")) {
+			return;
 		}
 
-		auto &object = stack.data.is_null()? stack.data.emplace_object() : stack.data.as_object();
+		stack.data.mutate([&](boost::json::value &json) {
+			auto &object = json.is_null()? json.emplace_object() : json.as_object();
 
-		if (!object.contains("durability")) {
-			object["durability"] = boost::json::array{maxDurability, maxDurability};
-		}
+			if (!object.contains("durability")) {
+				object["durability"] = boost::json::array{maxDurability, maxDurability};
+			}
+		});
 	}
 }
@@ -3,6 +3,7 @@
 #include "Options.h"
 #include "client/RichPresence.h"
 #include "client/ServerWrapper.h"
+#include "data/DBBackup.h"
 #include "game/ClientGame.h"
 #include "graphics/Texture.h"
 #include "lib/JSON.h"
@@ -13,6 +14,7 @@
 #include "threading/ThreadContext.h"
 #include "tools/Flasker.h"
 #include "tools/ItemStitcher.h"
+#include "tools/LoadTest.h"
 #include "tools/Mazer.h"
 #include "tools/Migrator.h"
 #include "tools/Reshape.h"
@@ -52,6 +54,8 @@ namespace Game3 {
 	void testBuffer2();
 	void omniOptOut();
 	void filterTest();
+	void craftingBenchmark();
+	void kinematicsBenchmark();
 	bool chemskrTest(int, char **);
 	void skewTest(double location, double scale, double shape);
 	void damageTest(HitPoints weapon_damage, int defense, int variability, double attacker_luck, double defender_luck);
@@ -196,6 +200,26 @@ int main(int argc, char **argv) {
 			return migrate(args);
 		}
 
+		if (arg1 == "--restore") {
+			if (argc < 4) {
+				std::println("Usage: {} --restore <new world path> <full backup> [incremental backups...]", argv[0]);
+				return 1;
+			}
+
+			const std::vector<std::filesystem::path> archives(argv + 3, argv + argc);
+			const DBBackup::Stats stats = DBBackup::restore(argv[2], archives);
+			SUCCESS("Restored {} records and {} erasures into {}.", stats.written, stats.erased, argv[2]);
+			return 0;
+		}
+
+		if (arg1 == "--loadtest") {
+			std::vector<std::string> args;
+			for (int i = 2; i < argc; ++i) {
+				args.emplace_back(argv[i]);
+			}
+			return loadTest(args);
+		}
+
 		if (arg1 == "--maze") {
 			for (const auto &row: Mazer({32, 32}, 666, {2, 0}).getRows(false)) {
 				for (const auto column: row) {
@@ -217,6 +241,16 @@ int main(int argc, char **argv) {
 			return 0;
 		}
 
+		if (arg1 == "--crafting-benchmark") {
+			craftingBenchmark();
+			return 0;
+		}
+
+		if (arg1 == "--kinematics-benchmark") {
+			kinematicsBenchmark();
+			return 0;
+		}
+
 		if (arg1 == "--shell-test") {
 			if (argc == 3 && strcmp(argv[2], "print") == 0) {
 				std::cout << "Hello, ";
@@ -1,12 +1,16 @@
 #include "util/Log.h"
-#include "graphics/GL.h"
 #include "math/Rectangle.h"
 
+#ifndef GAME3_HEADLESS
+#include "graphics/GL.h"
+#endif
+
 namespace Game3 {
 	int Rectangle::area() const {
 		return width * height;
 	}
 
+#ifndef GAME3_HEADLESS
 	void Rectangle::scissor(int outer_height) const {
 		// `outer_height - y - height` to transform upper left corner to lower left corner
 		glScissor(x, outer_height - y - height, static_cast<GLsizei>(width), static_cast<GLsizei>(height)); CHECKGL
@@ -16,6 +20,7 @@ namespace Game3 {
 		// `outer_height - y - height` to transform upper left corner to lower left corner
 		glViewport(x, outer_height - y - height, static_cast<GLsizei>(std::max(0, width)), static_cast<GLsizei>(std::max(0, height))); CHECKGL
 	}
+#endif
 
 	bool Rectangle::contains(int x, int y) const {
 		return this->x <= x && x < this->x + width && this->y <= y && y < this->y + height;
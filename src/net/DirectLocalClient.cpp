@@ -1,7 +1,10 @@
-#include "game/ClientGame.h"
 #include "net/DirectLocalClient.h"
 #include "net/DirectRemoteClient.h"
 
+#ifndef GAME3_HEADLESS
+#include "game/ClientGame.h"
+#endif
+
 namespace Game3 {
 	DirectLocalClient::DirectLocalClient() = default;
 
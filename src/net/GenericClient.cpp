@@ -22,6 +22,8 @@ namespace Game3 {
 		assert(server != nullptr);
 		assert(server->getGame() != nullptr);
 
+		realm.ensureResident(chunk_position);
+
 		if (counter_threshold != 0 && realm.tileProvider.contains(chunk_position) && realm.tileProvider.getUpdateCounter(chunk_position) < counter_threshold) {
 			return;
 		}
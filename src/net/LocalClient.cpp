@@ -1,5 +1,4 @@
 #include "util/Log.h"
-#include "game/ClientGame.h"
 #include "lib/JSON.h"
 #include "net/Buffer.h"
 #include "net/LocalClient.h"
@@ -10,6 +9,10 @@
 #include "util/FS.h"
 #include "util/Util.h"
 
+#ifndef GAME3_HEADLESS
+#include "game/ClientGame.h"
+#endif
+
 #include <cassert>
 #include <fstream>
 
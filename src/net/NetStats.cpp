@@ -0,0 +1,104 @@
+#include "net/NetStats.h"
+
+#include <algorithm>
+#include <format>
+#include <utility>
+
+namespace Game3 {
+	namespace {
+		thread_local size_t compressionSavings = 0;
+	}
+
+	void NetStats::record(PacketID packet_id, std::chrono::nanoseconds encode_time, size_t raw_bytes, size_t wire_bytes) {
+		Counters &row = counters[std::min<size_t>(packet_id, TRACKED_IDS - 1)];
+		row.packets.fetch_add(1, std::memory_order_relaxed);
+		row.encodeNanoseconds.fetch_add(encode_time.count(), std::memory_order_relaxed);
+		row.rawBytes.fetch_add(raw_bytes, std::memory_order_relaxed);
+		row.wireBytes.fetch_add(wire_bytes, std::memory_order_relaxed);
+	}
+
+	void NetStats::recordQueueDepth(size_t depth) {
+		queueDepth.store(depth, std::memory_order_relaxed);
+		size_t max = maxQueueDepth.load(std::memory_order_relaxed);
+		while (max < depth && !maxQueueDepth.compare_exchange_weak(max, depth, std::memory_order_relaxed));
+	}
+
+	std::vector<NetStats::Row> NetStats::snapshot() const {
+		std::vector<Row> out;
+
+		for (size_t packet_id = 0; packet_id < TRACKED_IDS; ++packet_id) {
+			const Counters &row = counters[packet_id];
+			const uint64_t packets = row.packets.load(std::memory_order_relaxed);
+			if (packets == 0) {
+				continue;
+			}
+
+			out.push_back(Row{
+				.packetID = static_cast<PacketID>(packet_id),
+				.packets = packets,
+				.encodeNanoseconds = row.encodeNanoseconds.load(std::memory_order_relaxed),
+				.rawBytes = row.rawBytes.load(std::memory_order_relaxed),
+				.wireBytes = row.wireBytes.load(std::memory_order_relaxed),
+			});
+		}
+
+		std::ranges::sort(out, [](const Row &left, const Row &right) {
+			return left.wireBytes > right.wireBytes;
+		});
+
+		return out;
+	}
+
+	std::string NetStats::summarize(size_t max_rows) const {
+		const std::vector<Row> rows = snapshot();
+		Row total;
+		std::string out;
+
+		for (size_t i = 0; i < rows.size(); ++i) {
+			const Row &row = rows[i];
+			total.packets += row.packets;
+			total.encodeNanoseconds += row.encodeNanoseconds;
+			total.rawBytes += row.rawBytes;
+			total.wireBytes += row.wireBytes;
+
+			if (i < max_rows) {
+				out += std::format("Packet {}: {} sent, {} B raw, {} B wire, {:.2f} us avg encode\n", row.packetID, row.packets,
+					row.rawBytes, row.wireBytes, row.encodeNanoseconds / 1000. / row.packets);
+			}
+		}
+
+		out += std::format("Total: {} packets, {} B raw, {} B wire", total.packets, total.rawBytes, total.wireBytes);
+
+		if (const size_t max_depth = getMaxQueueDepth(); 0 < max_depth) {
+			out += std::format(". Outbox depth: {} (max {})", getQueueDepth(), max_depth);
+		}
+
+		return out;
+	}
+
+	void NetStats::reset() {
+		for (Counters &row: counters) {
+			row.packets = 0;
+			row.encodeNanoseconds = 0;
+			row.rawBytes = 0;
+			row.wireBytes = 0;
+		}
+
+		maxQueueDepth = queueDepth.load();
+	}
+
+	NetStats & NetStats::global() {
+		static NetStats stats;
+		return stats;
+	}
+
+	void NetStats::noteCompression(size_t uncompressed, size_t compressed) {
+		if (compressed < uncompressed) {
+			compressionSavings += uncompressed - compressed;
+		}
+	}
+
+	size_t NetStats::takeCompressionSavings() {
+		return std::exchange(compressionSavings, 0);
+	}
+}
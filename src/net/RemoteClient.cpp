@@ -9,9 +9,11 @@
 #include "packet/PacketFactory.h"
 #include "util/Demangle.h"
 #include "util/Math.h"
+#include "util/MemoryStats.h"
 #include "util/Util.h"
 
 #include <cassert>
+#include <chrono>
 #include <csignal>
 
 namespace Game3 {
@@ -24,13 +26,20 @@ namespace Game3 {
 
 	RemoteClient::~RemoteClient() {
 		auto lock = outbox.uniqueLock();
+		size_t bytes = sendBuffer.bytes.size();
+		for (const std::string &message: outbox) {
+			bytes += message.size();
+		}
+		MemoryStats::global().subtract(MemorySubsystem::Network, bytes);
 		outbox.clear();
 	}
 
 	void RemoteClient::queue(std::string message) {
 		{
 			auto lock = outbox.uniqueLock();
+			MemoryStats::global().add(MemorySubsystem::Network, message.size());
 			outbox.push_back(std::move(message));
+			netStats.recordQueueDepth(outbox.size());
 			if (1 < outbox.size()) {
 				return;
 			}
@@ -163,7 +172,10 @@ namespace Game3 {
 		}
 
 		Buffer send_buffer{Side::Client};
+		NetStats::takeCompressionSavings();
+		const auto encode_start = std::chrono::steady_clock::now();
 		packet->encode(*game, send_buffer);
+		const auto encode_time = std::chrono::steady_clock::now() - encode_start;
 		assert(send_buffer.size() < UINT32_MAX);
 		const auto size = toLittle(static_cast<uint32_t>(send_buffer.size()));
 		const auto packet_id = toLittle(packet->getID());
@@ -174,6 +186,11 @@ namespace Game3 {
 		to_send.append(reinterpret_cast<const char *>(&packet_id), sizeof(packet_id));
 		to_send.append(reinterpret_cast<const char *>(&size), sizeof(size));
 		to_send.append(span.begin(), span.end());
+
+		const size_t raw_bytes = to_send.size() + NetStats::takeCompressionSavings();
+		netStats.record(packet->getID(), encode_time, raw_bytes, to_send.size());
+		NetStats::global().record(packet->getID(), encode_time, raw_bytes, to_send.size());
+
 		send(std::move(to_send), false);
 		return true;
 	}
@@ -187,6 +204,7 @@ namespace Game3 {
 			SendBuffer &buffer = sendBuffer;
 			auto lock = buffer.uniqueLock();
 			buffer.bytes.insert(buffer.bytes.end(), message.begin(), message.end());
+			MemoryStats::global().add(MemorySubsystem::Network, message.size());
 			return;
 		}
 
@@ -214,6 +232,8 @@ namespace Game3 {
 			}
 			moved_buffer = std::move(sendBuffer.bytes);
 		}
+		// It's counted again once it reaches the outbox.
+		MemoryStats::global().subtract(MemorySubsystem::Network, moved_buffer.size());
 		send(std::move(moved_buffer), true);
 	}
 
@@ -297,7 +317,9 @@ namespace Game3 {
 	void RemoteClient::writeHandler(const asio::error_code &errc, size_t) {
 		bool empty = [&] {
 			auto lock = outbox.uniqueLock();
+			MemoryStats::global().subtract(MemorySubsystem::Network, outbox.front().size());
 			outbox.pop_front();
+			netStats.recordQueueDepth(outbox.size());
 			return outbox.empty();
 		}();
 
@@ -193,6 +193,7 @@ namespace Game3 {
 		client.send(make<TimePacket>(game->time));
 		client.send(make<RecipeListPacket>(CraftingRecipeRegistry::ID(), game->registry<CraftingRecipeRegistry>(), game));
 		client.send(make<KnownItemsPacket>(*player));
+		game->reportLogin();
 		auto lock = game->players.sharedLock();
 		const auto packet = make<EntityPacket>(player);
 		for (const auto &other_player: game->players) {
@@ -330,9 +331,7 @@ namespace Game3 {
 				});
 
 				if (running && save_period <= std::chrono::system_clock::now() - last_save) {
-					game->tickingPaused = true;
 					game->getDatabase().writeAll();
-					game->tickingPaused = false;
 					last_save = std::chrono::system_clock::now();
 				}
 			}
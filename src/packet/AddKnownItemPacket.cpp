@@ -1,18 +1,22 @@
 #include "util/Log.h"
-#include "entity/ClientPlayer.h"
 #include "entity/Player.h"
-#include "game/ClientGame.h"
 #include "packet/AddKnownItemPacket.h"
+#include "util/Util.h"
+
+#ifndef GAME3_HEADLESS
+#include "entity/ClientPlayer.h"
+#include "game/ClientGame.h"
 #include "ui/dialog/OmniDialog.h"
 #include "ui/tab/CraftingTab.h"
 #include "ui/GameUI.h"
 #include "ui/Window.h"
-#include "util/Util.h"
+#endif
 
 namespace Game3 {
 	AddKnownItemPacket::AddKnownItemPacket(Identifier item_id):
 		itemID(std::move(item_id)) {}
 
+#ifndef GAME3_HEADLESS
 	void AddKnownItemPacket::handle(const ClientGamePtr &game) {
 		if (game->getPlayer()->addKnownItem(itemID)) {
 			game->getWindow()->queue([](Window &window) {
@@ -22,4 +26,5 @@ namespace Game3 {
 			});
 		}
 	}
+#endif
 }
@@ -1,12 +1,15 @@
 #include "util/Log.h"
-#include "entity/ClientPlayer.h"
 #include "entity/ServerPlayer.h"
-#include "game/ClientGame.h"
 #include "game/ServerGame.h"
 #include "net/RemoteClient.h"
 #include "packet/ErrorPacket.h"
 #include "packet/AgentMessagePacket.h"
 
+#ifndef GAME3_HEADLESS
+#include "entity/ClientPlayer.h"
+#include "game/ClientGame.h"
+#endif
+
 namespace Game3 {
 	void AgentMessagePacket::handle(const std::shared_ptr<ServerGame> &game, GenericClient &client) {
 		if (!Agent::validateGID(globalID)) {
@@ -24,6 +27,7 @@ namespace Game3 {
 		destination->handleMessage(client.getPlayer(), messageName, data);
 	}
 
+#ifndef GAME3_HEADLESS
 	void AgentMessagePacket::handle(const ClientGamePtr &game) {
 		if (!Agent::validateGID(globalID)) {
 			ERR("Can't send message to player: invalid GID");
@@ -39,4 +43,5 @@ namespace Game3 {
 		std::any data{std::move(messageData)};
 		game->getPlayer()->handleMessage(source, messageName, data);
 	}
+#endif
 }
@@ -1,9 +1,13 @@
 #include "util/Log.h"
+#include "packet/ChatMessageSentPacket.h"
+
+#ifndef GAME3_HEADLESS
 #include "entity/ClientPlayer.h"
 #include "game/ClientGame.h"
-#include "packet/ChatMessageSentPacket.h"
+#endif
 
 namespace Game3 {
+#ifndef GAME3_HEADLESS
 	void ChatMessageSentPacket::handle(const ClientGamePtr &game) {
 		auto player = game->getAgent<ClientPlayer>(globalID);
 		if (!player) {
@@ -15,4 +19,5 @@ namespace Game3 {
 		game->handleChat(player, message);
 		player->setLastMessage(std::move(message));
 	}
+#endif
 }
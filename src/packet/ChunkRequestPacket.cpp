@@ -4,13 +4,17 @@
 #include "net/RemoteClient.h"
 #include "packet/ChunkRequestPacket.h"
 #include "packet/PacketError.h"
+#include "realm/Realm.h"
+#include "threading/ThreadPool.h"
 
 namespace Game3 {
 	ChunkRequestPacket::ChunkRequestPacket(Realm &realm, const std::set<ChunkPosition> &positions, bool no_threshold, bool generate_missing):
 	realmID(realm.id),
 	generateMissing(generate_missing) {
+		// If we still hold the chunk, the server only needs to send it if it changed since our copy.
+		// Evicted chunks keep their update counters, but they have to be sent again in full.
 		for (const auto chunk_position: positions)
-			requests.emplace(chunk_position, no_threshold? 0 : (realm.tileProvider.getUpdateCounter(chunk_position) + 1));
+			requests.emplace(chunk_position, no_threshold || !realm.tileProvider.contains(chunk_position)? 0 : (realm.tileProvider.getUpdateCounter(chunk_position) + 1));
 	}
 
 	void ChunkRequestPacket::encode(Game &, Buffer &buffer) const {
@@ -51,16 +55,42 @@ namespace Game3 {
 	}
 
 	void ChunkRequestPacket::handle(const std::shared_ptr<ServerGame> &game, GenericClient &client) {
-		if (generateMissing) {
-			for (const ChunkRequest &request: requests)
-				client.sendChunk(*game->getRealm(realmID), request.position, true, request.counterThreshold);
-			return;
-		}
+		RealmPtr realm = game->getRealm(realmID);
+
+		auto send = [realm, weak_client = std::weak_ptr(client.shared_from_this()), requests = requests, generate_missing = generateMissing] {
+			GenericClientPtr client = weak_client.lock();
+			if (!client) {
+				return;
+			}
+
+			if (generate_missing) {
+				for (const ChunkRequest &request: requests)
+					client->sendChunk(*realm, request.position, true, request.counterThreshold);
+				return;
+			}
+
+			for (const ChunkRequest &request: requests) {
+				try {
+					client->sendChunk(*realm, request.position, false, request.counterThreshold);
+				} catch (const std::out_of_range &) {}
+			}
+		};
+
+		// Copying and compressing the chunks is the slow part, so it happens on the pool and fills the realm's chunk
+		// packet cache. The packets themselves are sent from the realm's tick so that they can't overtake tile updates
+		// broadcast after they were built; if a chunk changed in the meantime, sendChunk just rebuilds it.
+		const bool added = game->getPool().add([realm, requests = requests, send](ThreadPool &, size_t) mutable {
+			for (const ChunkRequest &request: requests) {
+				if (realm->tileProvider.contains(request.position) && realm->isChunkGenerated(request.position)) {
+					realm->getChunkTilesPacket(request.position);
+				}
+			}
+
+			realm->queue(std::move(send));
+		});
 
-		for (const ChunkRequest &request: requests) {
-			try {
-				client.sendChunk(*game->getRealm(realmID), request.position, false, request.counterThreshold);
-			} catch (const std::out_of_range &) {}
+		if (!added) {
+			send();
 		}
 	}
 }
@@ -1,6 +1,7 @@
 #include "util/Log.h"
-#include "game/ClientGame.h"
+#include "game/Game.h"
 #include "game/TileProvider.h"
+#include "net/NetStats.h"
 #include "packet/ChunkTilesPacket.h"
 #include "packet/PacketError.h"
 #include "realm/Realm.h"
@@ -8,6 +9,10 @@
 #include "util/Timer.h"
 #include "util/Util.h"
 
+#ifndef GAME3_HEADLESS
+#include "game/ClientGame.h"
+#endif
+
 // #define DEBUG_COMPRESSION
 
 namespace Game3 {
@@ -25,20 +30,32 @@ namespace Game3 {
 			auto lock = fluid_chunk.sharedLock();
 			fluids = fluid_chunk;
 		}
-
-		const PathChunk &path_chunk = realm.tileProvider.getPathChunk(chunk_position);
-		auto lock = path_chunk.sharedLock();
-		pathmap = path_chunk;
 	}
 
 	ChunkTilesPacket::ChunkTilesPacket(Realm &realm, ChunkPosition chunk_position): ChunkTilesPacket(realm, chunk_position, 0) {
 		updateCounter = realm.tileProvider.getUpdateCounter(chunk_position);
 	}
 
+	void ChunkTilesPacket::precompress() {
+		Buffer secondary{Side::Client};
+		secondary << realmID << chunkPosition << updateCounter << tiles << fluids;
+		uncompressedSize = secondary.size();
+		compressed = std::make_shared<const std::vector<uint8_t>>(LZ4::compress(secondary.getSpan()));
+		tiles = {};
+		fluids = {};
+	}
+
 	void ChunkTilesPacket::encode(Game &, Buffer &buffer) const {
+		if (compressed) {
+			NetStats::noteCompression(uncompressedSize, compressed->size());
+			buffer << *compressed;
+			return;
+		}
+
 		Buffer secondary{buffer.target};
-		secondary << realmID << chunkPosition << updateCounter << tiles << fluids << pathmap;
+		secondary << realmID << chunkPosition << updateCounter << tiles << fluids;
 		auto compressed = LZ4::compress(secondary.getSpan());
+		NetStats::noteCompression(secondary.size(), compressed.size());
 #ifdef DEBUG_COMPRESSION
 		INFO("Compression: {} → {} ({})", secondary.getSpan().size_bytes(), compressed.size(), double(secondary.getSpan().size_bytes()) / compressed.size());
 #endif
@@ -48,16 +65,35 @@ namespace Game3 {
 	void ChunkTilesPacket::decode(Game &, BasicBuffer &buffer) {
 		auto decompressed = LZ4::decompress(buffer.take<std::span<const uint8_t>>());
 		ViewBuffer view{decompressed, buffer.target};
-		view >> realmID >> chunkPosition >> updateCounter >> tiles >> fluids >> pathmap;
+		view >> realmID >> chunkPosition >> updateCounter >> tiles >> fluids;
 	}
 
+#ifndef GAME3_HEADLESS
 	void ChunkTilesPacket::handle(const ClientGamePtr &game) {
-		if (tiles.size() != CHUNK_SIZE * CHUNK_SIZE * LAYER_COUNT) {
-			throw PacketError("Invalid tile count in ChunkTilesPacket: " + std::to_string(tiles.size()));
+		// Local clients are handed the server's cached packet object without an encode/decode round trip, so the payload
+		// may still be compressed. It's shared with every other recipient, so it has to be left untouched.
+		std::vector<TileID> unpacked_tiles;
+		std::vector<FluidTile> unpacked_fluids;
+		const std::vector<TileID> *tiles_in = &tiles;
+		const std::vector<FluidTile> *fluids_in = &fluids;
+
+		if (compressed && tiles.empty()) {
+			auto decompressed = LZ4::decompress(*compressed);
+			ViewBuffer view{decompressed, Side::Client};
+			RealmID unpacked_realm_id{};
+			ChunkPosition unpacked_chunk_position;
+			uint64_t unpacked_update_counter{};
+			view >> unpacked_realm_id >> unpacked_chunk_position >> unpacked_update_counter >> unpacked_tiles >> unpacked_fluids;
+			tiles_in = &unpacked_tiles;
+			fluids_in = &unpacked_fluids;
 		}
 
-		if (fluids.size() != CHUNK_SIZE * CHUNK_SIZE) {
-			throw PacketError("Invalid fluid count in ChunkTilesPacket: " + std::to_string(fluids.size()));
+		if (tiles_in->size() != CHUNK_SIZE * CHUNK_SIZE * LAYER_COUNT) {
+			throw PacketError("Invalid tile count in ChunkTilesPacket: " + std::to_string(tiles_in->size()));
+		}
+
+		if (fluids_in->size() != CHUNK_SIZE * CHUNK_SIZE) {
+			throw PacketError("Invalid fluid count in ChunkTilesPacket: " + std::to_string(fluids_in->size()));
 		}
 
 		RealmPtr realm = game->getRealm(realmID);
@@ -67,14 +103,16 @@ namespace Game3 {
 			TileChunk &chunk = provider.getTileChunk(layer, chunkPosition);
 			const size_t offset = getIndex(layer) * CHUNK_SIZE * CHUNK_SIZE;
 			auto lock = chunk.uniqueLock();
-			chunk.assign(tiles.begin() + offset, tiles.begin() + offset + CHUNK_SIZE * CHUNK_SIZE);
+			chunk.assign(tiles_in->begin() + offset, tiles_in->begin() + offset + CHUNK_SIZE * CHUNK_SIZE);
 		}
 
-		provider.getFluidChunk(chunkPosition) = std::move(fluids);
-		provider.setPathChunk(chunkPosition, std::move(pathmap));
+		provider.getFluidChunk(chunkPosition) = *fluids_in;
 		provider.setUpdateCounter(chunkPosition, updateCounter);
+		// The pathmap isn't sent; it's cheap to derive from the tiles we just received.
+		realm->remakePathMap(chunkPosition);
 		game->chunkReceived(chunkPosition);
 		realm->queueReupload();
 		realm->queueStaticLightingTexture();
 	}
+#endif
 }
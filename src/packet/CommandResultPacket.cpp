@@ -1,8 +1,12 @@
-#include "game/ClientGame.h"
 #include "packet/CommandResultPacket.h"
+
+#ifndef GAME3_HEADLESS
+#include "game/ClientGame.h"
 #include "ui/Window.h"
+#endif
 
 namespace Game3 {
+#ifndef GAME3_HEADLESS
 	void CommandResultPacket::handle(const ClientGamePtr &game) {
 		WindowPtr window = game->getWindow();
 
@@ -16,4 +20,5 @@ namespace Game3 {
 			game->handleChat(nullptr, std::format("Command {} was unsuccessful: {}", commandID, message));
 		}
 	}
+#endif
 }
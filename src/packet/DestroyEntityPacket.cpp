@@ -1,13 +1,17 @@
 #include "util/Log.h"
 #include "entity/Entity.h"
-#include "game/ClientGame.h"
 #include "packet/DestroyEntityPacket.h"
 
+#ifndef GAME3_HEADLESS
+#include "game/ClientGame.h"
+#endif
+
 namespace Game3 {
 	DestroyEntityPacket::DestroyEntityPacket(const Entity &entity, bool require_realm):
 		globalID(entity.getGID()),
 		realmRequirement(require_realm? std::make_optional(entity.getRealm()->id) : std::nullopt) {}
 
+#ifndef GAME3_HEADLESS
 	void DestroyEntityPacket::handle(const ClientGamePtr &game) {
 		if (auto entity = game->getAgent<Entity>(globalID)) {
 			if (realmRequirement && entity->getRealm()->id != *realmRequirement)
@@ -18,4 +22,5 @@ namespace Game3 {
 		}
 		// else WARN("DestroyEntityPacket: couldn't find entity {}.", globalID);
 	}
+#endif
 }
@@ -1,12 +1,16 @@
 #include "util/Log.h"
+#include "packet/DisplayTextPacket.h"
+
+#ifndef GAME3_HEADLESS
 #include "entity/ClientPlayer.h"
 #include "game/ClientGame.h"
-#include "packet/DisplayTextPacket.h"
 #include "ui/module/TextModule.h"
 #include "ui/GameUI.h"
 #include "ui/Window.h"
+#endif
 
 namespace Game3 {
+#ifndef GAME3_HEADLESS
 	void DisplayTextPacket::handle(const ClientGamePtr &game) {
 		auto window = game->getWindow();
 
@@ -28,4 +32,5 @@ namespace Game3 {
 			}
 		});
 	}
+#endif
 }
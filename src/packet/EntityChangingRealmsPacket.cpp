@@ -1,9 +1,13 @@
 #include "util/Log.h"
+#include "packet/EntityChangingRealmsPacket.h"
+
+#ifndef GAME3_HEADLESS
 #include "entity/ClientPlayer.h"
 #include "game/ClientGame.h"
-#include "packet/EntityChangingRealmsPacket.h"
+#endif
 
 namespace Game3 {
+#ifndef GAME3_HEADLESS
 	void EntityChangingRealmsPacket::handle(const ClientGamePtr &game) {
 		if (globalID == game->getPlayer()->getGID())
 			return;
@@ -20,4 +24,5 @@ namespace Game3 {
 
 		game->putInLimbo(entity, newRealmID, newPosition);
 	}
+#endif
 }
@@ -1,12 +1,17 @@
 #include "util/Log.h"
+#include "entity/Entity.h"
+#include "packet/EntityMoneyChangedPacket.h"
+
+#ifndef GAME3_HEADLESS
 #include "entity/ClientPlayer.h"
 #include "game/ClientGame.h"
-#include "packet/EntityMoneyChangedPacket.h"
+#endif
 
 namespace Game3 {
 	EntityMoneyChangedPacket::EntityMoneyChangedPacket(const Entity &entity):
 		EntityMoneyChangedPacket(entity.getGID(), entity.getMoney()) {}
 
+#ifndef GAME3_HEADLESS
 	void EntityMoneyChangedPacket::handle(const ClientGamePtr &game) {
 		EntityPtr entity = game->getAgent<Entity>(globalID);
 		if (!entity) {
@@ -16,4 +21,5 @@ namespace Game3 {
 
 		entity->setMoney(moneyCount);
 	}
+#endif
 }
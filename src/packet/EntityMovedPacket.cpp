@@ -1,7 +1,11 @@
 #include "util/Log.h"
+#include "entity/Entity.h"
+#include "packet/EntityMovedPacket.h"
+
+#ifndef GAME3_HEADLESS
 #include "entity/ClientPlayer.h"
 #include "game/ClientGame.h"
-#include "packet/EntityMovedPacket.h"
+#endif
 
 namespace Game3 {
 	EntityMovedPacket::EntityMovedPacket(const Entity &entity):
@@ -15,6 +19,7 @@ namespace Game3 {
 		buffer >> arguments.globalID >> arguments.realmID >> arguments.position >> arguments.facing >> arguments.offset >> arguments.velocity >> arguments.adjustOffset >> arguments.isTeleport;
 	}
 
+#ifndef GAME3_HEADLESS
 	void EntityMovedPacket::handle(const ClientGamePtr &game) {
 		RealmPtr realm = game->tryRealm(arguments.realmID);
 		if (!realm) {
@@ -55,4 +60,5 @@ namespace Game3 {
 		if (arguments.velocity)
 			entity->velocity = *arguments.velocity;
 	}
+#endif
 }
@@ -1,5 +1,4 @@
 #include "util/Log.h"
-#include "game/ClientGame.h"
 #include "game/Game.h"
 #include "net/Buffer.h"
 #include "packet/EntityPacket.h"
@@ -7,6 +6,10 @@
 #include "entity/Entity.h"
 #include "entity/EntityFactory.h"
 
+#ifndef GAME3_HEADLESS
+#include "game/ClientGame.h"
+#endif
+
 namespace Game3 {
 	Lockable<std::unordered_map<std::string, size_t>> entityUpdates;
 
@@ -39,6 +42,7 @@ namespace Game3 {
 		buffer << globalID << identifier << realmID << storedBuffer;
 	}
 
+#ifndef GAME3_HEADLESS
 	void EntityPacket::handle(const ClientGamePtr &game) {
 		RealmPtr realm = game->tryRealm(realmID);
 
@@ -69,4 +73,5 @@ namespace Game3 {
 
 		realm->add(entity, entity->getPosition());
 	}
+#endif
 }
@@ -1,12 +1,16 @@
 #include "util/Log.h"
 #include "entity/Entity.h"
-#include "game/ClientGame.h"
 #include "packet/EntityRiddenPacket.h"
 
+#ifndef GAME3_HEADLESS
+#include "game/ClientGame.h"
+#endif
+
 namespace Game3 {
 	EntityRiddenPacket::EntityRiddenPacket(const EntityPtr &rider, const Entity &ridden):
 		EntityRiddenPacket(rider? std::make_optional(rider->getGID()) : std::nullopt, ridden.getGID()) {}
 
+#ifndef GAME3_HEADLESS
 	void EntityRiddenPacket::handle(const ClientGamePtr &game) {
 		EntityPtr ridden = game->getAgent<Entity>(riddenID);
 		if (!ridden) {
@@ -27,4 +31,5 @@ namespace Game3 {
 
 		ridden->setRider(rider);
 	}
+#endif
 }
@@ -1,12 +1,55 @@
 #include "util/Log.h"
 #include "entity/Entity.h"
-#include "game/ClientGame.h"
 #include "packet/EntitySetPathPacket.h"
+#include "packet/PacketError.h"
+
+#ifndef GAME3_HEADLESS
+#include "game/ClientGame.h"
+#endif
+
+#include <string>
+#include <vector>
 
 namespace Game3 {
+	namespace {
+		constexpr uint16_t DIRECTION_BITS = 3;
+		constexpr uint16_t MAX_RUN = UINT16_MAX >> DIRECTION_BITS;
+	}
+
 	EntitySetPathPacket::EntitySetPathPacket(Entity &entity):
 		EntitySetPathPacket(entity.globalID, entity.realmID, entity.position.copyBase(), entity.copyPath<std::vector>(), entity.getUpdateCounter()) {}
 
+	void EntitySetPathPacket::encode(Game &, Buffer &buffer) const {
+		std::vector<uint16_t> runs;
+
+		for (size_t i = 0; i < path.size();) {
+			const Direction direction = path[i];
+			uint16_t length = 0;
+			while (i < path.size() && path[i] == direction && length < MAX_RUN) {
+				++length;
+				++i;
+			}
+			runs.push_back(static_cast<uint16_t>((length << DIRECTION_BITS) | static_cast<uint16_t>(direction)));
+		}
+
+		buffer << globalID << realmID << position << runs << newCounter;
+	}
+
+	void EntitySetPathPacket::decode(Game &, BasicBuffer &buffer) {
+		std::vector<uint16_t> runs;
+		buffer >> globalID >> realmID >> position >> runs >> newCounter;
+
+		path.clear();
+		for (const uint16_t run: runs) {
+			const auto direction = static_cast<Direction>(run & ((1 << DIRECTION_BITS) - 1));
+			if (direction == Direction::Invalid || direction > Direction::Left) {
+				throw PacketError("Invalid direction in EntitySetPathPacket: " + std::to_string(static_cast<int>(direction)));
+			}
+			path.insert(path.end(), run >> DIRECTION_BITS, direction);
+		}
+	}
+
+#ifndef GAME3_HEADLESS
 	void EntitySetPathPacket::handle(const ClientGamePtr &game) {
 		RealmPtr realm = game->tryRealm(realmID);
 		if (!realm) {
@@ -36,4 +79,5 @@ namespace Game3 {
 		entity->path = std::deque<Direction>{path.begin(), path.end()};
 		entity->setUpdateCounter(newCounter);
 	}
+#endif
 }
@@ -1,9 +1,14 @@
-#include "game/ClientGame.h"
 #include "packet/ErrorPacket.h"
+
+#ifndef GAME3_HEADLESS
+#include "game/ClientGame.h"
 #include "ui/Window.h"
+#endif
 
 namespace Game3 {
+#ifndef GAME3_HEADLESS
 	void ErrorPacket::handle(const ClientGamePtr &game) {
 		game->getWindow()->error(error);
 	}
+#endif
 }
@@ -1,7 +1,7 @@
 #include "entity/EntityFactory.h"
 #include "entity/ExplosionParticle.h"
+#include "entity/SquareParticle.h"
 #include "game/Agent.h"
-#include "game/ClientGame.h"
 #include "game/ServerGame.h"
 #include "math/FilledCircle.h"
 #include "math/Random.h"
@@ -10,6 +10,10 @@
 #include "threading/ThreadContext.h"
 #include "util/Explosion.h"
 
+#ifndef GAME3_HEADLESS
+#include "game/ClientGame.h"
+#endif
+
 namespace Game3 {
 	ExplosionPacket::ExplosionPacket(RealmID realmID, Position origin, ExplosionOptions options):
 		origin(origin),
@@ -30,6 +34,7 @@ namespace Game3 {
 		buffer >> realmID >> origin >> radius >> particleType >> soundEffect >> pitchVariance >> randomizationParameters;
 	}
 
+#ifndef GAME3_HEADLESS
 	void ExplosionPacket::handle(const std::shared_ptr<ClientGame> &game) {
 		RealmPtr realm = game->tryRealm(realmID);
 		if (!realm) {
@@ -45,6 +50,11 @@ namespace Game3 {
 			realm->playSound(origin, *soundEffect, threadContext.getPitch(pitchVariance.value_or(1.f)), std::max<uint16_t>(radius * 2, 64));
 		}
 
+		if (particleType == SquareParticle::ID()) {
+			spawnSquareParticles(*realm);
+			return;
+		}
+
 		std::optional<float> lifetime;
 		if (particleType == ExplosionParticle::ID()) {
 			lifetime = ExplosionParticle::getLifetime();
@@ -63,4 +73,39 @@ namespace Game3 {
 			realm->spawn(entity, position);
 		});
 	}
+#endif
+
+	void ExplosionPacket::spawnSquareParticles(Realm &realm) {
+		// Mirrors what SquareParticle::onSpawn does with randomization parameters, without making an entity per square.
+		std::optional<SquareParticle::RandomizationOptions> options;
+		if (!randomizationParameters.empty()) {
+			Buffer parameters = randomizationParameters;
+			options.emplace().decode(parameters);
+		}
+
+		std::uniform_real_distribution speed_distribution(2.f, 4.f);
+		std::uniform_real_distribution rise_distribution(8.f, 12.f);
+		std::bernoulli_distribution left_distribution;
+
+		iterateFilledCircle<Position::IntType>(origin.column, origin.row, radius, [&](auto x, auto y) {
+			ParticleSystem::Square square{
+				.x = double(x),
+				.y = double(y),
+				.velocityX = speed_distribution(threadContext.rng) * (left_distribution(threadContext.rng)? -1 : 1),
+				.velocityZ = rise_distribution(threadContext.rng),
+			};
+
+			if (options) {
+				square.size = threadContext.random(options->sizeMin, options->sizeMax);
+				square.color = OKHsv{
+					threadContext.random(options->hueMin, options->hueMax),
+					threadContext.random(options->saturationMin, options->saturationMax),
+					threadContext.random(options->valueMin, options->valueMax),
+					threadContext.random(options->alphaMin, options->alphaMax),
+				}.convert<Color>();
+			}
+
+			realm.particles.spawn(square);
+		});
+	}
 }
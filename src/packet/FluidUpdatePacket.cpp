@@ -1,12 +1,17 @@
 #include "util/Log.h"
 #include "error/PlayerMissingError.h"
-#include "game/ClientGame.h"
 #include "packet/FluidUpdatePacket.h"
 
+#ifndef GAME3_HEADLESS
+#include "game/ClientGame.h"
+#endif
+
 namespace Game3 {
+#ifndef GAME3_HEADLESS
 	void FluidUpdatePacket::handle(const ClientGamePtr &game) {
 		auto realm = game->getRealm(realmID);
 		realm->setFluid(position, fluidTile);
 		realm->queueReupload();
 	}
+#endif
 }
@@ -1,10 +1,14 @@
 #include "util/Log.h"
 #include "entity/Entity.h"
 #include "error/PlayerMissingError.h"
-#include "game/ClientGame.h"
 #include "packet/HeldItemSetPacket.h"
 
+#ifndef GAME3_HEADLESS
+#include "game/ClientGame.h"
+#endif
+
 namespace Game3 {
+#ifndef GAME3_HEADLESS
 	void HeldItemSetPacket::handle(const ClientGamePtr &game) {
 		RealmPtr realm = game->tryRealm(realmID);
 		if (!realm) {
@@ -25,4 +29,5 @@ namespace Game3 {
 
 		entity->setUpdateCounter(newCounter);
 	}
+#endif
 }
@@ -1,12 +1,15 @@
-#include "entity/ClientPlayer.h"
 #include "entity/ServerPlayer.h"
-#include "game/ClientGame.h"
 #include "game/ServerGame.h"
 #include "net/RemoteClient.h"
 #include "packet/ErrorPacket.h"
 #include "packet/InteractPacket.h"
 #include "util/Log.h"
 
+#ifndef GAME3_HEADLESS
+#include "entity/ClientPlayer.h"
+#include "game/ClientGame.h"
+#endif
+
 namespace Game3 {
 	void InteractPacket::handle(const std::shared_ptr<ServerGame> &game, GenericClient &client) {
 		if (ServerPlayerPtr player = client.getPlayer()) {
@@ -39,6 +42,7 @@ namespace Game3 {
 		}
 	}
 
+#ifndef GAME3_HEADLESS
 	void InteractPacket::handle(const std::shared_ptr<ClientGame> &game) {
 		if (ClientPlayerPtr player = game->getPlayer()) {
 			const ItemStackPtr &held_item = player->getHeld(hand);
@@ -60,4 +64,5 @@ namespace Game3 {
 			WARN("Can't interact: client game has no player");
 		}
 	}
+#endif
 }
@@ -1,20 +1,30 @@
 #include "util/Log.h"
-#include "entity/ClientPlayer.h"
-#include "game/ClientGame.h"
-#include "game/ClientInventory.h"
+#include "game/Game.h"
 #include "game/Inventory.h"
 #include "game/ServerInventory.h"
 #include "packet/InventoryPacket.h"
 
+#ifndef GAME3_HEADLESS
+#include "entity/ClientPlayer.h"
+#include "game/ClientGame.h"
+#include "game/ClientInventory.h"
+#endif
+
 namespace Game3 {
 	void InventoryPacket::encode(Game &, Buffer &buffer) const {
 		buffer << *std::dynamic_pointer_cast<ServerInventory>(inventory);
 	}
 
 	void InventoryPacket::decode(Game &, BasicBuffer &buffer) {
+#ifdef GAME3_HEADLESS
+		(void) buffer;
+		throw std::invalid_argument("Can't decode a client inventory in a headless build");
+#else
 		inventory = std::make_shared<ClientInventory>(buffer.take<ClientInventory>());
+#endif
 	}
 
+#ifndef GAME3_HEADLESS
 	void InventoryPacket::handle(const ClientGamePtr &game) {
 		if (game->isConnectedLocally()) {
 			// TODO: transmogrify ServerInventory into ClientInventory without going through a Buffer.
@@ -32,4 +42,5 @@ namespace Game3 {
 			assert(player);
 		}
 	}
+#endif
 }
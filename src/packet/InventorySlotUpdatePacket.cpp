@@ -1,11 +1,15 @@
 #include "util/Log.h"
-#include "entity/ClientPlayer.h"
-#include "game/ClientGame.h"
 #include "game/Inventory.h"
 #include "net/RemoteClient.h"
 #include "packet/InventorySlotUpdatePacket.h"
 
+#ifndef GAME3_HEADLESS
+#include "entity/ClientPlayer.h"
+#include "game/ClientGame.h"
+#endif
+
 namespace Game3 {
+#ifndef GAME3_HEADLESS
 	void InventorySlotUpdatePacket::handle(const ClientGamePtr &game) {
 		if (ClientPlayerPtr player = game->getPlayer()) {
 			if (InventoryPtr inventory = player->getInventory(0)) {
@@ -18,4 +22,5 @@ namespace Game3 {
 			}
 		}
 	}
+#endif
 }
@@ -1,18 +1,22 @@
 #include "util/Log.h"
-#include "entity/ClientPlayer.h"
 #include "entity/Player.h"
-#include "game/ClientGame.h"
 #include "packet/KnownItemsPacket.h"
+#include "util/Util.h"
+
+#ifndef GAME3_HEADLESS
+#include "entity/ClientPlayer.h"
+#include "game/ClientGame.h"
 #include "ui/dialog/OmniDialog.h"
 #include "ui/tab/CraftingTab.h"
 #include "ui/GameUI.h"
 #include "ui/Window.h"
-#include "util/Util.h"
+#endif
 
 namespace Game3 {
 	KnownItemsPacket::KnownItemsPacket(const Player &player):
 		KnownItemsPacket(player.getKnownItems().copyBase()) {}
 
+#ifndef GAME3_HEADLESS
 	void KnownItemsPacket::handle(const ClientGamePtr &game) {
 		game->getPlayer()->setKnownItems(itemIDs);
 		game->getWindow()->queue([](Window &window) {
@@ -21,4 +25,5 @@ namespace Game3 {
 			}
 		});
 	}
+#endif
 }
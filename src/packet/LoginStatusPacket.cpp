@@ -1,13 +1,17 @@
 #include "util/Log.h"
-#include "entity/ClientPlayer.h"
+#include "entity/Player.h"
 #include "error/AuthenticationError.h"
-#include "game/ClientGame.h"
 #include "game/Inventory.h"
 #include "packet/LoginStatusPacket.h"
 #include "packet/PacketError.h"
+
+#ifndef GAME3_HEADLESS
+#include "entity/ClientPlayer.h"
+#include "game/ClientGame.h"
 #include "ui/dialog/ConnectionDialog.h"
 #include "ui/GameUI.h"
 #include "ui/Window.h"
+#endif
 
 namespace Game3 {
 	LoginStatusPacket::LoginStatusPacket(bool success, GlobalID global_id, std::string username, std::string display_name, std::shared_ptr<Player> player):
@@ -32,6 +36,7 @@ namespace Game3 {
 		buffer >> success >> globalID >> username >> displayName >> message >> playerDataBuffer;
 	}
 
+#ifndef GAME3_HEADLESS
 	void LoginStatusPacket::handle(const ClientGamePtr &game) {
 		auto window = game->getWindow();
 
@@ -64,4 +69,5 @@ namespace Game3 {
 			window.uiContext.setUI<GameUI>();
 		});
 	}
+#endif
 }
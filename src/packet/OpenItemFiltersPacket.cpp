@@ -1,14 +1,18 @@
 #include "util/Log.h"
+#include "packet/OpenItemFiltersPacket.h"
+#include "types/DirectedPlace.h"
+#include "ui/module/ModuleIDs.h"
+
+#ifndef GAME3_HEADLESS
 #include "entity/ClientPlayer.h"
 #include "game/ClientGame.h"
 #include "game/ClientInventory.h"
-#include "packet/OpenItemFiltersPacket.h"
-#include "types/DirectedPlace.h"
 #include "ui/GameUI.h"
 #include "ui/Window.h"
-#include "ui/module/ItemFiltersModule.h"
+#endif
 
 namespace Game3 {
+#ifndef GAME3_HEADLESS
 	void OpenItemFiltersPacket::handle(const ClientGamePtr &game) {
 		RealmPtr realm = game->getRealm(realmID);
 		if (!realm) {
@@ -39,8 +43,9 @@ namespace Game3 {
 
 		window->queue([place = std::move(place)](Window &window) {
 			if (auto game_ui = window.uiContext.getUI<GameUI>()) {
-				game_ui->openModule(ItemFiltersModule::ID(), std::any(place));
+				game_ui->openModule(ModuleID::itemFilters(), std::any(place));
 			}
 		});
 	}
+#endif
 }
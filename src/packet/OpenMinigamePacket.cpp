@@ -1,8 +1,11 @@
+#include "packet/OpenMinigamePacket.h"
+
+#ifndef GAME3_HEADLESS
 #include "game/ClientGame.h"
 #include "minigame/MinigameFactory.h"
-#include "packet/OpenMinigamePacket.h"
 #include "ui/dialog/MinigameDialog.h"
 #include "ui/Window.h"
+#endif
 
 namespace Game3 {
 	OpenMinigamePacket::OpenMinigamePacket(Identifier minigame_id, int game_width, int game_height):
@@ -10,6 +13,7 @@ namespace Game3 {
 		gameWidth(game_width),
 		gameHeight(game_height) {}
 
+#ifndef GAME3_HEADLESS
 	void OpenMinigamePacket::handle(const std::shared_ptr<ClientGame> &game) {
 		game->getWindow()->queue([game, id = minigameID, width = gameWidth, height = gameHeight](Window &window) {
 			auto &registry = game->registry<MinigameFactoryRegistry>();
@@ -20,4 +24,5 @@ namespace Game3 {
 			}
 		});
 	}
+#endif
 }
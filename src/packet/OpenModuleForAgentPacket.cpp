@@ -1,12 +1,16 @@
 #include "util/Log.h"
+#include "packet/OpenModuleForAgentPacket.h"
+
+#ifndef GAME3_HEADLESS
 #include "entity/ClientPlayer.h"
 #include "game/ClientGame.h"
 #include "game/ClientInventory.h"
-#include "packet/OpenModuleForAgentPacket.h"
 #include "ui/GameUI.h"
 #include "ui/Window.h"
+#endif
 
 namespace Game3 {
+#ifndef GAME3_HEADLESS
 	void OpenModuleForAgentPacket::handle(const ClientGamePtr &game) {
 		AgentPtr agent = game->getAgent(agentGID);
 		if (!agent) {
@@ -34,4 +38,5 @@ namespace Game3 {
 			}
 		});
 	}
+#endif
 }
@@ -1,14 +1,18 @@
 #include "util/Log.h"
+#include "packet/OpenVillageTradePacket.h"
+#include "types/DirectedPlace.h"
+#include "ui/module/ModuleIDs.h"
+
+#ifndef GAME3_HEADLESS
 #include "entity/ClientPlayer.h"
 #include "game/ClientGame.h"
 #include "game/ClientInventory.h"
-#include "packet/OpenVillageTradePacket.h"
-#include "types/DirectedPlace.h"
 #include "ui/GameUI.h"
 #include "ui/Window.h"
-#include "ui/module/VillageTradeModule.h"
+#endif
 
 namespace Game3 {
+#ifndef GAME3_HEADLESS
 	void OpenVillageTradePacket::handle(const ClientGamePtr &game) {
 		auto window = game->getWindow();
 
@@ -39,9 +43,10 @@ namespace Game3 {
 
 			window->queue([village = std::move(village)](Window &window) {
 				if (auto game_ui = window.uiContext.getUI<GameUI>()) {
-					game_ui->openModule(VillageTradeModule::ID(), std::any(village));
+					game_ui->openModule(ModuleID::villageTrade(), std::any(village));
 				}
 			});
 		}
 	}
+#endif
 }
@@ -1,9 +1,13 @@
 #include "util/Log.h"
+#include "packet/PlaySoundPacket.h"
+
+#ifndef GAME3_HEADLESS
 #include "entity/ClientPlayer.h"
 #include "game/ClientGame.h"
-#include "packet/PlaySoundPacket.h"
+#endif
 
 namespace Game3 {
+#ifndef GAME3_HEADLESS
 	void PlaySoundPacket::handle(const ClientGamePtr &game) {
 		float volume = 1;
 
@@ -17,4 +21,5 @@ namespace Game3 {
 			WARN("Can't play unknown sound: {}", soundID);
 		}
 	}
+#endif
 }
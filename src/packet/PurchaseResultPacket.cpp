@@ -1,9 +1,13 @@
+#include "packet/PurchaseResultPacket.h"
+
+#ifndef GAME3_HEADLESS
 #include "dialogue/Dialogue.h"
 #include "entity/ClientPlayer.h"
 #include "game/ClientGame.h"
-#include "packet/PurchaseResultPacket.h"
+#endif
 
 namespace Game3 {
+#ifndef GAME3_HEADLESS
 	void PurchaseResultPacket::handle(const std::shared_ptr<ClientGame> &game) {
 		ClientPlayerPtr player = game->getPlayer();
 
@@ -15,4 +19,5 @@ namespace Game3 {
 			graph->selectNode(success? "purchase_successful" : "purchase_failed");
 		});
 	}
+#endif
 }
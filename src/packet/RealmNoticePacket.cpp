@@ -1,14 +1,18 @@
 #include "util/Log.h"
 #include "graphics/Tileset.h"
-#include "game/ClientGame.h"
 #include "packet/RealmNoticePacket.h"
 #include "realm/Realm.h"
 #include "realm/RealmFactory.h"
 
+#ifndef GAME3_HEADLESS
+#include "game/ClientGame.h"
+#endif
+
 namespace Game3 {
 	RealmNoticePacket::RealmNoticePacket(Realm &realm):
 		RealmNoticePacket(realm.id, realm.type, realm.getTileset().identifier, realm.seed, realm.outdoors) {}
 
+#ifndef GAME3_HEADLESS
 	void RealmNoticePacket::handle(const ClientGamePtr &game) {
 		if (!game->hasRealm(realmID)) {
 			auto factory = game->registry<RealmFactoryRegistry>().at(type);
@@ -22,4 +26,5 @@ namespace Game3 {
 			game->addRealm(realmID, realm);
 		}
 	}
+#endif
 }
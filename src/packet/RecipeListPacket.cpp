@@ -1,10 +1,14 @@
 #include "util/Log.h"
 #include "graphics/Tileset.h"
-#include "game/ClientGame.h"
 #include "packet/RecipeListPacket.h"
 #include "recipe/CraftingRecipe.h"
 
+#ifndef GAME3_HEADLESS
+#include "game/ClientGame.h"
+#endif
+
 namespace Game3 {
+#ifndef GAME3_HEADLESS
 	void RecipeListPacket::handle(const ClientGamePtr &game) {
 		auto &registry = game->registry<CraftingRecipeRegistry>();
 		auto lock = registry.uniqueLock();
@@ -13,6 +17,7 @@ namespace Game3 {
 			registry.add(game, json);
 		}
 	}
+#endif
 
 	std::vector<boost::json::value> RecipeListPacket::getRecipes(const CraftingRecipeRegistry &registry, const GamePtr &game) {
 		std::vector<boost::json::value> out;
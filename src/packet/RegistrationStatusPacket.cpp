@@ -1,12 +1,16 @@
 #include "util/Log.h"
 #include "error/AuthenticationError.h"
-#include "game/ClientGame.h"
 #include "net/LocalClient.h"
 #include "packet/RegistrationStatusPacket.h"
 #include "packet/PacketError.h"
+
+#ifndef GAME3_HEADLESS
+#include "game/ClientGame.h"
 #include "ui/Window.h"
+#endif
 
 namespace Game3 {
+#ifndef GAME3_HEADLESS
 	void RegistrationStatusPacket::handle(const ClientGamePtr &game) {
 		if (token == 0) {
 			game->getWindow()->error("Registration failed.");
@@ -19,4 +23,5 @@ namespace Game3 {
 		client->setToken(client->getHostname(), username, token);
 		client->saveTokens();
 	}
+#endif
 }
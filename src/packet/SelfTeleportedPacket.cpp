@@ -1,10 +1,14 @@
 #include "util/Log.h"
-#include "entity/ClientPlayer.h"
 #include "error/PlayerMissingError.h"
-#include "game/ClientGame.h"
 #include "packet/SelfTeleportedPacket.h"
 
+#ifndef GAME3_HEADLESS
+#include "entity/ClientPlayer.h"
+#include "game/ClientGame.h"
+#endif
+
 namespace Game3 {
+#ifndef GAME3_HEADLESS
 	void SelfTeleportedPacket::handle(const ClientGamePtr &game) {
 		auto player = game->getPlayer();
 
@@ -15,4 +19,5 @@ namespace Game3 {
 		player->teleport(position, realm);
 		player->focus(*game->getWindow(), true); // TODO: probably replace `true` with `false`
 	}
+#endif
 }
@@ -1,15 +1,18 @@
 #include "util/Log.h"
-#include "entity/ClientPlayer.h"
 #include "entity/ServerPlayer.h"
-#include "game/ClientGame.h"
 #include "game/Inventory.h"
 #include "game/ServerGame.h"
 #include "net/RemoteClient.h"
 #include "packet/SetActiveSlotPacket.h"
+
+#ifndef GAME3_HEADLESS
+#include "entity/ClientPlayer.h"
+#include "game/ClientGame.h"
 #include "ui/Window.h"
 #include "ui/tab/InventoryTab.h"
 #include "ui/Constants.h"
 #include "ui/dialog/OmniDialog.h"
+#endif
 
 namespace Game3 {
 	void SetActiveSlotPacket::handle(const std::shared_ptr<ServerGame> &, GenericClient &client) {
@@ -24,7 +27,9 @@ namespace Game3 {
 		}
 	}
 
+#ifndef GAME3_HEADLESS
 	void SetActiveSlotPacket::handle(const ClientGamePtr &game) {
 		game->getPlayer()->getInventory(0)->setActive(slot, true);
 	}
+#endif
 }
@@ -33,7 +33,9 @@ namespace Game3 {
 			return;
 		}
 
-		ensureObject(stack->data)["includeTileEntities"] = includeTileEntities;
+		stack->data.mutate([&](boost::json::value &data) {
+			ensureObject(data)["includeTileEntities"] = includeTileEntities;
+		});
 		inventory->notifyOwner({});
 	}
 }
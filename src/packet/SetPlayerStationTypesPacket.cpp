@@ -1,14 +1,18 @@
 #include "util/Log.h"
+#include "packet/SetPlayerStationTypesPacket.h"
+
+#ifndef GAME3_HEADLESS
 #include "game/ClientGame.h"
 #include "entity/ClientPlayer.h"
-#include "packet/SetPlayerStationTypesPacket.h"
 #include "ui/dialog/OmniDialog.h"
 #include "ui/tab/CraftingTab.h"
 #include "ui/tab/InventoryTab.h"
 #include "ui/GameUI.h"
 #include "ui/Window.h"
+#endif
 
 namespace Game3 {
+#ifndef GAME3_HEADLESS
 	void SetPlayerStationTypesPacket::handle(const ClientGamePtr &game) {
 		game->getPlayer()->stationTypes = std::move(stationTypes);
 		auto window = game->getWindow();
@@ -26,4 +30,5 @@ namespace Game3 {
 			}
 		});
 	}
+#endif
 }
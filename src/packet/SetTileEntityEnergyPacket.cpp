@@ -1,10 +1,14 @@
 #include "util/Log.h"
-#include "game/ClientGame.h"
 #include "game/EnergyContainer.h"
 #include "packet/SetTileEntityEnergyPacket.h"
 #include "tileentity/EnergeticTileEntity.h"
 
+#ifndef GAME3_HEADLESS
+#include "game/ClientGame.h"
+#endif
+
 namespace Game3 {
+#ifndef GAME3_HEADLESS
 	void SetTileEntityEnergyPacket::handle(const ClientGamePtr &game) {
 		AgentPtr agent = game->getAgent(agentGID);
 		if (!agent) {
@@ -21,4 +25,5 @@ namespace Game3 {
 		auto lock = energetic->energyContainer->uniqueLock();
 		energetic->setEnergy(newEnergy);
 	}
+#endif
 }
@@ -0,0 +1,16 @@
+#include "packet/SquareParticlesPacket.h"
+#include "realm/Realm.h"
+
+#ifndef GAME3_HEADLESS
+#include "game/ClientGame.h"
+#endif
+
+namespace Game3 {
+#ifndef GAME3_HEADLESS
+	void SquareParticlesPacket::handle(const ClientGamePtr &game) {
+		if (RealmPtr realm = game->tryRealm(realmID)) {
+			realm->particles.spawnBurst(origin, offset, colors, lingerTime, size);
+		}
+	}
+#endif
+}
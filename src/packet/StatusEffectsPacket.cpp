@@ -1,7 +1,10 @@
 #include "entity/LivingEntity.h"
-#include "game/ClientGame.h"
 #include "packet/StatusEffectsPacket.h"
 
+#ifndef GAME3_HEADLESS
+#include "game/ClientGame.h"
+#endif
+
 namespace Game3 {
 	StatusEffectsPacket::StatusEffectsPacket(LivingEntity &entity):
 		StatusEffectsPacket(entity.getGID(), entity.copyStatusEffects()) {}
@@ -10,6 +13,7 @@ namespace Game3 {
 		globalID(globalID),
 		map(std::move(map)) {}
 
+#ifndef GAME3_HEADLESS
 	void StatusEffectsPacket::handle(const std::shared_ptr<ClientGame> &game) {
 		LivingEntityPtr entity = game->getAgent<LivingEntity>(globalID);
 		if (!entity) {
@@ -19,4 +23,5 @@ namespace Game3 {
 
 		entity->setStatusEffects(std::move(map));
 	}
+#endif
 }
@@ -1,6 +1,5 @@
 #include "util/Log.h"
 #include "entity/Entity.h"
-#include "game/ClientGame.h"
 #include "game/Game.h"
 #include "game/Inventory.h"
 #include "lib/JSON.h"
@@ -11,6 +10,10 @@
 #include "tileentity/TileEntityFactory.h"
 #include "util/Demangle.h"
 
+#ifndef GAME3_HEADLESS
+#include "game/ClientGame.h"
+#endif
+
 namespace Game3 {
 	TileEntityPacket::TileEntityPacket(TileEntityPtr tile_entity):
 		tileEntity(std::move(tile_entity)),
@@ -41,6 +44,7 @@ namespace Game3 {
 		buffer << globalID << identifier << realmID << storedBuffer;
 	}
 
+#ifndef GAME3_HEADLESS
 	void TileEntityPacket::handle(const ClientGamePtr &game) {
 		RealmPtr realm = game->tryRealm(realmID);
 		if (!realm)
@@ -102,4 +106,5 @@ namespace Game3 {
 			}
 		}
 	}
+#endif
 }
@@ -1,12 +1,17 @@
 #include "util/Log.h"
 #include "error/PlayerMissingError.h"
-#include "game/ClientGame.h"
 #include "packet/TileUpdatePacket.h"
 
+#ifndef GAME3_HEADLESS
+#include "game/ClientGame.h"
+#endif
+
 namespace Game3 {
+#ifndef GAME3_HEADLESS
 	void TileUpdatePacket::handle(const ClientGamePtr &game) {
 		auto realm = game->getRealm(realmID);
 		realm->setTile(layer, position, tileID, true);
 		realm->queueReupload();
 	}
+#endif
 }
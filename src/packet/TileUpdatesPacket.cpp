@@ -0,0 +1,22 @@
+#include "packet/PacketError.h"
+#include "packet/TileUpdatesPacket.h"
+
+#ifndef GAME3_HEADLESS
+#include "game/ClientGame.h"
+#endif
+
+namespace Game3 {
+#ifndef GAME3_HEADLESS
+	void TileUpdatesPacket::handle(const ClientGamePtr &game) {
+		if (layers.size() != positions.size() || positions.size() != tileIDs.size()) {
+			throw PacketError("Mismatched vector sizes in TileUpdatesPacket");
+		}
+
+		RealmPtr realm = game->getRealm(realmID);
+		for (size_t i = 0; i < positions.size(); ++i) {
+			realm->setTile(layers[i], positions[i], tileIDs[i], true);
+		}
+		realm->queueReupload();
+	}
+#endif
+}
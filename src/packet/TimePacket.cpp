@@ -1,8 +1,13 @@
-#include "game/ClientGame.h"
 #include "packet/TimePacket.h"
 
+#ifndef GAME3_HEADLESS
+#include "game/ClientGame.h"
+#endif
+
 namespace Game3 {
+#ifndef GAME3_HEADLESS
 	void TimePacket::handle(const ClientGamePtr &game) {
 		game->time = time;
 	}
+#endif
 }
@@ -1,9 +1,12 @@
 #include "game/Agent.h"
-#include "game/ClientGame.h"
 #include "game/ServerGame.h"
 #include "net/GenericClient.h"
 #include "packet/UpdateAgentFieldPacket.h"
 
+#ifndef GAME3_HEADLESS
+#include "game/ClientGame.h"
+#endif
+
 namespace Game3 {
 	void UpdateAgentFieldPacket::encode(Game &, Buffer &buffer) const {
 		buffer << globalID << fieldNameHash << fieldValue;
@@ -24,6 +27,7 @@ namespace Game3 {
 		agent->setField(fieldNameHash, fieldValue, client.getPlayer());
 	}
 
+#ifndef GAME3_HEADLESS
 	void UpdateAgentFieldPacket::handle(const std::shared_ptr<ClientGame> &game) {
 		AgentPtr agent = game->getAgent(globalID);
 		if (!agent) {
@@ -33,4 +37,5 @@ namespace Game3 {
 
 		agent->setField(fieldNameHash, fieldValue, nullptr);
 	}
+#endif
 }
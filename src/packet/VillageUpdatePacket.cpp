@@ -1,13 +1,17 @@
 #include "util/Log.h"
-#include "game/ClientGame.h"
 #include "game/Village.h"
 #include "packet/VillageUpdatePacket.h"
+
+#ifndef GAME3_HEADLESS
+#include "game/ClientGame.h"
 #include "ui/Window.h"
+#endif
 
 namespace Game3 {
 	VillageUpdatePacket::VillageUpdatePacket(const Village &village):
 		VillageUpdatePacket(village.getID(), village.getRealmID(), village.getChunkPosition(), village.getPosition(), village.getName(), village.getLabor(), village.getGreed(), village.getResources()) {}
 
+#ifndef GAME3_HEADLESS
 	void VillageUpdatePacket::handle(const ClientGamePtr &game) {
 		VillagePtr village;
 
@@ -34,4 +38,5 @@ namespace Game3 {
 		village->setGreed(greed);
 		game->signalVillageUpdate(village);
 	}
+#endif
 }
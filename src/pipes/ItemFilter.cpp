@@ -34,7 +34,7 @@ namespace Game3 {
 		auto items_lock = items.uniqueLock();
 		auto configs_lock = configsByItem.uniqueLock();
 		items.insert(stack->item->identifier);
-		configsByItem[stack->item->identifier].emplace(stack->data);
+		configsByItem[stack->item->identifier].emplace(*stack->data);
 	}
 
 	void ItemFilter::removeItem(const ItemStackPtr &stack) {
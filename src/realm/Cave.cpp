@@ -15,9 +15,11 @@ namespace Game3 {
 	Cave::Cave(const GamePtr &game_, RealmID id_, RealmID parent_realm, int seed_):
 		Realm(game_, id_, ID(), "base:tileset/monomap", seed_), parentRealm(parent_realm) {}
 
+#ifndef GAME3_HEADLESS
 	void Cave::clearLighting(float) {
 		GL::clear(0.117, 0.117, 0.235, 1, GL_COLOR_BUFFER_BIT);
 	}
+#endif
 
 	void Cave::onRemove() {
 		// Assumptions:
@@ -1,16 +1,10 @@
 #include "algorithm/MarchingSquares.h"
 #include "biome/Biome.h"
-#include "entity/ClientPlayer.h"
 #include "entity/Entity.h"
 #include "entity/ServerPlayer.h"
-#include "game/ClientGame.h"
 #include "game/Game.h"
 #include "game/InteractionSet.h"
 #include "game/ServerGame.h"
-#include "graphics/RealmRenderer.h"
-#include "graphics/RendererContext.h"
-#include "graphics/SpriteRenderer.h"
-#include "graphics/TextRenderer.h"
 #include "graphics/Tileset.h"
 #include "lib/JSON.h"
 #include "net/GenericClient.h"
@@ -21,14 +15,24 @@
 #include "realm/RealmFactory.h"
 #include "threading/ThreadContext.h"
 #include "tile/Tile.h"
-#include "ui/GameUI.h"
-#include "ui/Window.h"
 #include "util/Cast.h"
 #include "util/Log.h"
 #include "util/Reverse.h"
 #include "util/Timer.h"
 #include "util/Util.h"
 
+#ifndef GAME3_HEADLESS
+#include "entity/ClientPlayer.h"
+#include "game/ClientGame.h"
+#include "graphics/RealmRenderer.h"
+#include "graphics/RendererContext.h"
+#include "graphics/SpriteRenderer.h"
+#include "graphics/TextRenderer.h"
+#include "ui/GameUI.h"
+#include "ui/Window.h"
+#endif
+
+#include <algorithm>
 #include <thread>
 #include <unordered_set>
 
@@ -43,6 +47,7 @@ namespace Game3 {
 
 	Realm::Realm(const GamePtr &game):
 		weakGame(game) {
+#ifndef GAME3_HEADLESS
 			if (game->getSide() == Side::Client) {
 				game->toClient().getWindow()->queue([this](Window &) {
 					createRenderers();
@@ -52,6 +57,7 @@ namespace Game3 {
 					queueStaticLightingTexture();
 				});
 			}
+#endif
 		}
 
 	Realm::Realm(const GamePtr &game, RealmID id, RealmType type, Identifier tileset_id, int64_t seed):
@@ -60,6 +66,7 @@ namespace Game3 {
 		tileProvider(std::move(tileset_id)),
 		seed(seed),
 		weakGame(game) {
+#ifndef GAME3_HEADLESS
 			if (game->getSide() == Side::Client) {
 				game->toClient().getWindow()->queue([this](Window &) {
 					createRenderers();
@@ -70,8 +77,10 @@ namespace Game3 {
 					queueStaticLightingTexture();
 				});
 			}
+#endif
 		}
 
+#ifndef GAME3_HEADLESS
 	void Realm::initRendererRealms() {
 		assert(isClient());
 		assert(baseRenderers.has_value());
@@ -110,6 +119,7 @@ namespace Game3 {
 			}
 		}
 	}
+#endif
 
 	void Realm::initTexture() {}
 
@@ -145,7 +155,9 @@ namespace Game3 {
 			extraData = *extra;
 		}
 
+#ifndef GAME3_HEADLESS
 		initRendererTileProviders();
+#endif
 		initTexture();
 
 		tileProvider.absorbJSON(json.at("provider"), full_data);
@@ -186,7 +198,9 @@ namespace Game3 {
 
 	void Realm::onFocus() {
 		if (isClient() && !focused.exchange(true)) {
+#ifndef GAME3_HEADLESS
 			queueStaticLightingTexture();
+#endif
 			wakeupPending = true;
 		}
 	}
@@ -199,6 +213,7 @@ namespace Game3 {
 
 	void Realm::onRemove() {}
 
+#ifndef GAME3_HEADLESS
 	void Realm::createRenderers() {
 		assert(isClient());
 
@@ -297,6 +312,8 @@ namespace Game3 {
 		});
 
 		player->render(renderers);
+		// Drawn before the entities' sprites are flushed, like the particle entities this replaced.
+		particles.render(rectangle_renderer);
 
 		batch_sprite.renderNow();
 
@@ -414,6 +431,7 @@ namespace Game3 {
 			}
 		}
 	}
+#endif
 
 	EntityPtr Realm::add(const EntityPtr &entity, const Position &position) {
 		if (EntityPtr found = getEntity(entity->getGID())) {
@@ -449,6 +467,7 @@ namespace Game3 {
 	}
 
 	TileEntityPtr Realm::add(const TileEntityPtr &tile_entity) {
+		ensureResident(tile_entity->getChunk());
 		{
 			auto lock = tileEntities.sharedLock();
 			if (tileEntities.contains(tile_entity->position)) {
@@ -470,8 +489,7 @@ namespace Game3 {
 		}
 		attach(tile_entity);
 		if (tile_entity->solid) {
-			std::unique_lock<std::shared_mutex> path_lock;
-			tileProvider.findPathState(tile_entity->position.copyBase(), &path_lock) = 0;
+			tileProvider.setPathState(tile_entity->position.copyBase(), false);
 		}
 		tile_entity->onSpawn();
 		return tile_entity;
@@ -575,7 +593,8 @@ namespace Game3 {
 								Timer timer{"TickTileEntity"};
 #endif
 								if (tile_entity->tryInitialTick()) {
-									tile_entity->tick(args);
+									// Wakes signaled before the first tick are cleared like any other tick's.
+									tile_entity->getTickFunction()(args);
 								}
 							}
 						}
@@ -600,6 +619,13 @@ namespace Game3 {
 				}
 			}
 
+			{
+#ifdef PROFILE_TICKS
+				Timer timer{"Kinematics"};
+#endif
+				kinematics.step(*this, delta);
+			}
+
 			for (const WeakEntityPtr &stolen: entityRemovalQueue.steal()) {
 				if (EntityPtr locked = stolen.lock()) {
 					remove(locked);
@@ -653,6 +679,9 @@ namespace Game3 {
 						sendToMany(strong, chunk_position);
 						chunkRequests.erase(iter);
 					}
+				} else {
+					// Something touched a paged-out chunk and created an empty one in its place.
+					ensureResident(chunk_position);
 				}
 			} else {
 				auto lock = chunkRequests.uniqueLock();
@@ -665,6 +694,8 @@ namespace Game3 {
 						generateChunk(chunk_position);
 						generatedChunks.insert(chunk_position);
 						remakePathMap(chunk_position);
+					} else {
+						ensureResident(chunk_position);
 					}
 
 					sendToMany(filterWeak(client_set), chunk_position);
@@ -672,7 +703,9 @@ namespace Game3 {
 				}
 			}
 
-		} else {
+		}
+#ifndef GAME3_HEADLESS
+		else {
 
 			ClientPlayerPtr player = getGame()->toClient().getPlayer();
 			if (!player) {
@@ -699,6 +732,9 @@ namespace Game3 {
 				}
 			}
 
+			kinematics.step(*this, delta);
+			particles.step(delta);
+
 			ticking = false;
 
 			for (const WeakEntityPtr &stolen: entityRemovalQueue.steal()) {
@@ -758,6 +794,7 @@ namespace Game3 {
 				}
 			}
 		}
+#endif
 
 		ticking = false;
 	}
@@ -1171,6 +1208,7 @@ namespace Game3 {
 				setLayerHelper(position.row, position.column, Layer::Objects);
 			} else {
 				queueStaticLightingTexture();
+				remakePathMap(position);
 			}
 		}
 
@@ -1263,6 +1301,8 @@ namespace Game3 {
 		bool affected_lighting = false;
 		GamePtr game = getGame();
 
+		ensureResident(position.getChunk());
+
 		{
 			std::unique_lock<std::shared_mutex> tile_lock;
 			TileID &tile = tileProvider.findTile(layer, position, &tile_lock, TileProvider::TileMode::Create);
@@ -1280,6 +1320,18 @@ namespace Game3 {
 		}
 
 		if (isServer()) {
+			if (isBatchingTiles()) {
+				if (!isGenerating()) {
+					tileBatch.pendingBroadcasts[{layer, position}] = tile_id;
+				}
+				if (run_helper) {
+					auto [iter, inserted] = tileBatch.pendingUpdates.try_emplace({layer, position}, context);
+					if (!inserted) {
+						iter->second.limit = std::max(iter->second.limit, context.limit);
+					}
+				}
+				return;
+			}
 			if (!isGenerating()) {
 				tileProvider.updateChunk(position.getChunk());
 				game->toServer().broadcastTileUpdate(id, layer, position, tile_id);
@@ -1294,11 +1346,7 @@ namespace Game3 {
 				queueStaticLightingTexture();
 			}
 
-			{
-				bool walkable = isWalkable(position.row, position.column, getTileset());
-				std::unique_lock<std::shared_mutex> path_lock;
-				tileProvider.findPathState(position, &path_lock) = walkable;
-			}
+			remakePathMap(position);
 			{
 				auto lock = pathmapUpdateSet.uniqueLock();
 				pathmapUpdateSet.insert(position.getChunk());
@@ -1414,13 +1462,7 @@ namespace Game3 {
 	}
 
 	void Realm::setPathable(const Position &position, bool pathable) {
-		PathChunk &chunk = tileProvider.getPathChunk(position.getChunk());
-		auto lock = chunk.uniqueLock();
-		uint8_t &stored = TileProvider::access(chunk, TileProvider::remainder(position.row), TileProvider::remainder(position.column));
-		if (stored != pathable) {
-			stored = pathable;
-			++chunk.updateCounter;
-		}
+		tileProvider.setPathState(position, pathable);
 	}
 
 	uint64_t Realm::getPathmapUpdateCounter(ChunkPosition chunk_position) {
@@ -1463,7 +1505,9 @@ namespace Game3 {
 		}
 
 		if (--threadContext.updateNeighborsDepth == 0 && isClient()) {
+#ifndef GAME3_HEADLESS
 			queueReupload();
+#endif
 		}
 	}
 
@@ -1543,16 +1587,200 @@ namespace Game3 {
 		const Tileset &tileset = getTileset();
 		const Position position(row, column);
 
+		tileProvider.setPathState(position, isWalkable(row, column, tileset));
+
+		updateNeighbors(position, layer, context);
+	}
+
+	bool Realm::beginTileBatch() {
+		if (!isServer()) {
+			return false;
+		}
+
+		std::thread::id expected{};
+		const std::thread::id self = std::this_thread::get_id();
+		if (!tileBatch.owner.compare_exchange_strong(expected, self) && expected != self) {
+			return false;
+		}
+
+		++tileBatch.depth;
+		return true;
+	}
+
+	void Realm::endTileBatch() {
+		assert(isBatchingTiles());
+		if (--tileBatch.depth == 0) {
+			// Still owned while flushing so that tiles changed by autotiling are collected into the batch too.
+			flushTileBatch();
+			tileBatch.owner = std::thread::id{};
+		}
+	}
+
+	bool Realm::isBatchingTiles() const {
+		return tileBatch.owner.load() == std::this_thread::get_id();
+	}
+
+	void Realm::flushTileBatch() {
+		GamePtr game = getGame();
+		TilesetPtr tileset = tileProvider.getTileset(*game);
+		RealmPtr self = shared_from_this();
+		Place place{{}, self, nullptr};
+
+		while (!tileBatch.pendingUpdates.empty()) {
+			const auto updates = std::exchange(tileBatch.pendingUpdates, {});
+
+			// Positions whose tile changed on several layers only need their walkability recomputed once.
+			std::unordered_set<Position> changed_positions;
+			for (const auto &[key, context]: updates) {
+				changed_positions.insert(key.second);
+			}
+
+			for (const Position &position: changed_positions) {
+				tileProvider.setPathState(position, isWalkable(position.row, position.column, *tileset));
+			}
+
+			if (updatesPaused) {
+				continue;
+			}
+
+			// Overlapping neighborhoods are merged so that each neighbor is autotiled once per layer
+			// and each neighboring tile entity hears about each changed offset once.
+			std::map<std::pair<Layer, Position>, TileUpdateContext> neighbors;
+			std::map<Position, std::set<Position>> neighbor_offsets;
+
+			for (const auto &[key, context]: updates) {
+				const auto &[layer, position] = key;
+				if (context.limit == 0) {
+					continue;
+				}
+
+				const TileUpdateContext neighbor_context(context.limit - 1);
+
+				for (Index row_offset = -1; row_offset <= 1; ++row_offset) {
+					for (Index column_offset = -1; column_offset <= 1; ++column_offset) {
+						if (row_offset == 0 && column_offset == 0) {
+							continue;
+						}
+
+						const Position offset_position = position + Position(row_offset, column_offset);
+						neighbor_offsets[offset_position].emplace(-row_offset, -column_offset);
+
+						auto [iter, inserted] = neighbors.try_emplace({layer, offset_position}, neighbor_context);
+						if (!inserted) {
+							iter->second.limit = std::max(iter->second.limit, neighbor_context.limit);
+						}
+					}
+				}
+			}
+
+			++threadContext.updateNeighborsDepth;
+
+			for (const auto &[position, offsets]: neighbor_offsets) {
+				if (TileEntityPtr neighbor = tileEntityAt(position)) {
+					for (const Position &offset: offsets) {
+						neighbor->onNeighborUpdated(offset);
+					}
+				}
+			}
+
+			// Chunks with many neighbors to autotile are marched from one snapshot instead of tile by tile.
+			constexpr static size_t BULK_AUTOTILE_THRESHOLD = 2 * CHUNK_SIZE;
+			std::map<std::pair<Layer, ChunkPosition>, size_t> neighbor_counts;
+			std::map<std::pair<Layer, ChunkPosition>, std::vector<TileID>> marched_chunks;
+
+			for (const auto &[key, context]: neighbors) {
+				++neighbor_counts[{key.first, key.second.getChunk()}];
+			}
+
+			for (const auto &[key, count]: neighbor_counts) {
+				if (BULK_AUTOTILE_THRESHOLD <= count) {
+					std::vector<TileID> &marched = marched_chunks[key];
+					marched.resize(CHUNK_SIZE * CHUNK_SIZE);
+					computeAutotiles(key.second, key.first, marched);
+				}
+			}
+
+			for (const auto &[key, context]: neighbors) {
+				const auto &[layer, position] = key;
+				if (std::optional<TileID> tile_id = tryTile(layer, position)) {
+					place.position = position;
+					if (game->getTile((*tileset)[*tile_id])->update(place, layer)) {
+						continue;
+					}
+				}
+
+				// Any tiles changed here are added to pendingUpdates for the next iteration.
+				const ChunkPosition chunk_position = position.getChunk();
+				if (auto iter = marched_chunks.find({layer, chunk_position}); iter != marched_chunks.end()) {
+					const auto [top, left] = chunk_position.topLeft();
+					const TileID marched = iter->second[(position.row - top) * CHUNK_SIZE + position.column - left];
+					const TileID current = tileProvider.copyTile(layer, position, TileProvider::TileMode::ReturnEmpty);
+					const CompiledMarchable *current_info = tileset->getCompiledMarchable(current);
+					const CompiledMarchable *marched_info = tileset->getCompiledMarchable(marched);
+
+					// The snapshot is only trusted while the tile is still a variant of what was marched.
+					if (current_info != nullptr && marched_info != nullptr && current_info->start == marched_info->start) {
+						if (current != marched) {
+							setTile(layer, position, marched, true, context);
+						}
+						continue;
+					}
+				}
+
+				autotile(position, layer, context);
+			}
+
+			--threadContext.updateNeighborsDepth;
+		}
+
+		const auto broadcasts = std::exchange(tileBatch.pendingBroadcasts, {});
+		if (broadcasts.empty()) {
+			return;
+		}
+
+		std::set<ChunkPosition> chunks;
+		for (const auto &[key, tile_id]: broadcasts) {
+			chunks.insert(key.second.getChunk());
+		}
+
+		for (ChunkPosition chunk: chunks) {
+			tileProvider.updateChunk(chunk);
+		}
+
+		game->toServer().broadcastTileUpdates(id, broadcasts);
+	}
+
+	std::shared_ptr<ChunkTilesPacket> Realm::getChunkTilesPacket(ChunkPosition chunk_position) {
+		assert(isServer());
+
+		// Read these before copying the tiles. If the chunk changes while it's being copied, the cached packet is
+		// simply rebuilt next time instead of being mistaken for the newer version.
+		const uint64_t epoch = generationEpoch;
+		const uint64_t update_counter = tileProvider.getUpdateCounter(chunk_position);
+
 		{
-			std::unique_lock<std::shared_mutex> path_lock;
-			tileProvider.findPathState(position, &path_lock) = isWalkable(row, column, tileset);
+			auto lock = chunkPacketCache.sharedLock();
+			if (auto iter = chunkPacketCache.find(chunk_position); iter != chunkPacketCache.end()) {
+				const CachedChunkPacket &cached = iter->second;
+				if (cached.updateCounter == update_counter && cached.generationEpoch == epoch && !isGenerating()) {
+					return cached.packet;
+				}
+			}
 		}
 
-		updateNeighbors(position, layer, context);
+		auto packet = make<ChunkTilesPacket>(*this, chunk_position, update_counter);
+		packet->precompress();
+
+		if (!isGenerating()) {
+			auto lock = chunkPacketCache.uniqueLock();
+			chunkPacketCache[chunk_position] = CachedChunkPacket{update_counter, epoch, packet};
+		}
+
+		return packet;
 	}
 
 	Realm::ChunkPackets Realm::getChunkPackets(ChunkPosition chunk_position) {
-		auto chunk_tiles = make<ChunkTilesPacket>(*this, chunk_position);
+		auto chunk_tiles = getChunkTilesPacket(chunk_position);
 		std::vector<std::shared_ptr<EntityPacket>> entity_packets;
 		std::vector<std::shared_ptr<TileEntityPacket>> tile_entity_packets;
 
@@ -1576,14 +1804,18 @@ namespace Game3 {
 	}
 
 	void Realm::remakePathMap() {
-		const Tileset &tileset = getTileset();
-		for (auto &[chunk_position, path_chunk]: tileProvider.pathMap) {
-			for (int64_t row = 0; row < CHUNK_SIZE; ++row) {
-				for (int64_t column = 0; column < CHUNK_SIZE; ++column) {
-					path_chunk[row * CHUNK_SIZE + column] = isWalkable(row, column, tileset);
-				}
+		std::vector<ChunkPosition> chunk_positions;
+		{
+			std::shared_lock lock(tileProvider.pathMutex);
+			chunk_positions.reserve(tileProvider.pathMap.size());
+			for (const auto &[chunk_position, path_chunk]: tileProvider.pathMap) {
+				chunk_positions.push_back(chunk_position);
 			}
 		}
+
+		for (ChunkPosition chunk_position: chunk_positions) {
+			remakePathMap(chunk_position);
+		}
 	}
 
 	void Realm::remakePathMap(const ChunkRange &range) {
@@ -1592,23 +1824,65 @@ namespace Game3 {
 		});
 	}
 
-	void Realm::remakePathMap(ChunkPosition position) {
+	void Realm::remakePathMap(ChunkPosition chunk_position) {
 		Timer timer{"RemakePathMap"};
 		const Tileset &tileset = getTileset();
-		auto &path_chunk = tileProvider.getPathChunk(position);
-		auto lock = path_chunk.uniqueLock();
-		for (int64_t row = 0; row < CHUNK_SIZE; ++row) {
-			for (int64_t column = 0; column < CHUNK_SIZE; ++column) {
-				path_chunk[row * CHUNK_SIZE + column] = isWalkable(position.y * CHUNK_SIZE + row, position.x * CHUNK_SIZE + column, tileset);
+
+		// Start with every tile walkable and clear bits layer by layer, one row word at a time,
+		// instead of looking up every layer and the tile entity map for each tile separately.
+		std::array<uint64_t, CHUNK_SIZE> rows;
+		rows.fill(~uint64_t(0));
+
+		std::unordered_map<TileID, bool> blocking_cache;
+		auto is_blocking = [&](TileID tile_id) {
+			auto [iter, inserted] = blocking_cache.try_emplace(tile_id);
+			if (inserted) {
+				iter->second = !tileset.isWalkable(tile_id) || tileset.isSolid(tile_id);
+			}
+			return iter->second;
+		};
+
+		for (Layer layer: collidingLayers) {
+			const TileChunk *tile_chunk = tileProvider.tryTileChunk(layer, chunk_position);
+			if (tile_chunk == nullptr) {
+				rows.fill(0);
+				break;
+			}
+
+			auto lock = tile_chunk->sharedLock();
+			for (int64_t row = 0; row < CHUNK_SIZE; ++row) {
+				if (rows[row] == 0) {
+					continue;
+				}
+
+				for (int64_t column = 0; column < CHUNK_SIZE; ++column) {
+					if (is_blocking((*tile_chunk)[row * CHUNK_SIZE + column])) {
+						rows[row] &= ~(uint64_t(1) << column);
+					}
+				}
+			}
+		}
+
+		if (auto tile_entities = getTileEntities(chunk_position)) {
+			auto lock = tile_entities->sharedLock();
+			for (const TileEntityPtr &tile_entity: *tile_entities) {
+				if (tile_entity->solid) {
+					const Position position = tile_entity->getPosition();
+					rows[TileProvider::remainder(position.row)] &= ~(uint64_t(1) << TileProvider::remainder(position.column));
+				}
 			}
 		}
+
+		PathChunk &path_chunk = tileProvider.getPathChunk(chunk_position);
+		auto lock = path_chunk.uniqueLock();
+		if (!std::equal(rows.begin(), rows.end(), path_chunk.begin())) {
+			std::copy(rows.begin(), rows.end(), path_chunk.begin());
+			++path_chunk.updateCounter;
+		}
 	}
 
 	void Realm::remakePathMap(Position position) {
-		const Tileset &tileset = getTileset();
-		PathChunk &path_chunk = tileProvider.getPathChunk(position.getChunk());
-		auto lock = path_chunk.uniqueLock();
-		path_chunk[position.row * CHUNK_SIZE + position.column] = isWalkable(position.row, position.column, tileset);
+		tileProvider.setPathState(position, isWalkable(position.row, position.column, getTileset()));
 	}
 
 	void Realm::markGenerated(const ChunkRange &range) {
@@ -1670,6 +1944,7 @@ namespace Game3 {
 		return getGame()->getSide();
 	}
 
+#ifndef GAME3_HEADLESS
 	std::set<ChunkPosition> Realm::getMissingChunks() const {
 		assert(isClient());
 
@@ -1702,6 +1977,7 @@ namespace Game3 {
 
 		return out;
 	}
+#endif
 
 	void Realm::addPlayer(const PlayerPtr &player) {
 		auto players_lock = players.uniqueLock();
@@ -1758,6 +2034,209 @@ namespace Game3 {
 		chunkRequests[chunk_position].insert(client);
 	}
 
+	bool Realm::ensureResident(ChunkPosition chunk_position) {
+		// Movement and pathfinding call this for every tile they read, so the common case only takes a shared lock.
+		if (!isServer() || !isPagedOut(chunk_position)) {
+			return false;
+		}
+
+		auto lock = pagedOutChunks.uniqueLock();
+		if (!pagedOutChunks.contains(chunk_position)) {
+			return false;
+		}
+
+		const auto start = std::chrono::steady_clock::now();
+		pagedOutChunks.erase(chunk_position);
+		--pagedOutCount;
+
+		std::optional<ChunkSet> chunk_set = getGame()->toServer().getDatabase().getChunk(id, chunk_position);
+		if (!chunk_set) {
+			ERR("Chunk {} in realm {} was paged out but isn't in the database; it will be regenerated", chunk_position, id);
+			auto generated_lock = generatedChunks.uniqueLock();
+			generatedChunks.erase(chunk_position);
+			tileProvider.generationQueue.push(chunk_position);
+			return false;
+		}
+
+		tileProvider.absorb(chunk_position, std::move(*chunk_set));
+
+		const auto now = std::chrono::steady_clock::now();
+		{
+			auto seen_lock = chunkLastSeen.uniqueLock();
+			chunkLastSeen[chunk_position] = now;
+		}
+
+		const uint64_t microseconds = std::chrono::duration_cast<std::chrono::microseconds>(now - start).count();
+		++pagingStats.pagedIn;
+		pagingStats.totalPageInMicroseconds += microseconds;
+		uint64_t max = pagingStats.maxPageInMicroseconds;
+		while (max < microseconds && !pagingStats.maxPageInMicroseconds.compare_exchange_weak(max, microseconds));
+		return true;
+	}
+
+	bool Realm::pageOut(ChunkPosition chunk_position) {
+		assert(isServer());
+
+		auto lock = pagedOutChunks.uniqueLock();
+		if (!tileProvider.contains(chunk_position)) {
+			return false;
+		}
+
+		getGame()->toServer().getDatabase().writeChunk(shared_from_this(), chunk_position);
+		tileProvider.evict(chunk_position);
+		{
+			auto cache_lock = chunkPacketCache.uniqueLock();
+			chunkPacketCache.erase(chunk_position);
+		}
+		pagedOutChunks.insert(chunk_position);
+		pageOutEpochs[chunk_position] = ++pageOutEpoch;
+		++pagedOutCount;
+		++pagingStats.pagedOut;
+
+		auto seen_lock = chunkLastSeen.uniqueLock();
+		chunkLastSeen.erase(chunk_position);
+		return true;
+	}
+
+	std::vector<std::pair<std::chrono::steady_clock::time_point, ChunkPosition>> Realm::getPageableChunks() {
+		assert(isServer());
+
+		const auto now = std::chrono::steady_clock::now();
+		std::vector<ChunkPosition> resident;
+
+		{
+			std::shared_lock lock(tileProvider.chunkMutexes[0]);
+			resident.reserve(tileProvider.chunkMaps[0].size());
+			for (const auto &[chunk_position, chunk]: tileProvider.chunkMaps[0]) {
+				resident.push_back(chunk_position);
+			}
+		}
+
+		std::vector<std::pair<std::chrono::steady_clock::time_point, ChunkPosition>> out;
+		auto visible_lock = visibleChunks.sharedLock();
+
+		// Agents read the terrain around them and players see past the edge of their chunk, so the chunks next to
+		// visible and agent-holding chunks stay resident too.
+		std::unordered_set<ChunkPosition> kept;
+		auto keep_around = [&](ChunkPosition chunk_position) {
+			ChunkRange(chunk_position).iterate([&](ChunkPosition neighbor) {
+				kept.insert(neighbor);
+			});
+		};
+
+		for (ChunkPosition chunk_position: visibleChunks) {
+			keep_around(chunk_position);
+		}
+
+		for (ChunkPosition chunk_position: resident) {
+			if (holdsAgents(chunk_position)) {
+				keep_around(chunk_position);
+			}
+		}
+
+		auto seen_lock = chunkLastSeen.uniqueLock();
+
+		for (ChunkPosition chunk_position: resident) {
+			if (visibleChunks.contains(chunk_position)) {
+				chunkLastSeen[chunk_position] = now;
+				continue;
+			}
+
+			// Chunks loaded from the database or generated without being seen get a full grace period.
+			auto [iter, inserted] = chunkLastSeen.try_emplace(chunk_position, now);
+
+			if (kept.contains(chunk_position)) {
+				continue;
+			}
+
+			out.emplace_back(iter->second, chunk_position);
+		}
+
+		return out;
+	}
+
+	void Realm::markPagedOut(ChunkPosition chunk_position) {
+		assert(isServer());
+		auto lock = pagedOutChunks.uniqueLock();
+		if (pagedOutChunks.insert(chunk_position).second) {
+			++pagedOutCount;
+		}
+	}
+
+	bool Realm::unlessPagedOutSince(ChunkPosition chunk_position, uint64_t epoch, const std::function<void()> &function) {
+		assert(isServer());
+
+		auto lock = pagedOutChunks.sharedLock();
+		if (auto iter = pageOutEpochs.find(chunk_position); iter != pageOutEpochs.end() && epoch < iter->second) {
+			return false;
+		}
+
+		function();
+		return true;
+	}
+
+	bool Realm::isPagedOut(ChunkPosition chunk_position) const {
+		if (pagedOutCount == 0) {
+			return false;
+		}
+
+		auto lock = pagedOutChunks.sharedLock();
+		return pagedOutChunks.contains(chunk_position);
+	}
+
+	bool Realm::holdsAgents(ChunkPosition chunk_position) {
+		if (auto tile_entities = getTileEntities(chunk_position); tile_entities && !tile_entities->empty()) {
+			return true;
+		}
+
+		if (auto entities = getEntities(chunk_position)) {
+			auto entities_lock = entities->sharedLock();
+			return std::ranges::any_of(*entities, [](const WeakEntityPtr &weak_entity) { return !weak_entity.expired(); });
+		}
+
+		return false;
+	}
+
+	size_t Realm::getPagedOutChunkCount() const {
+		return pagedOutCount;
+	}
+
+	std::vector<std::pair<std::chrono::steady_clock::time_point, ChunkPosition>> Realm::getEvictableChunks() {
+		assert(isClient());
+
+		const auto now = std::chrono::steady_clock::now();
+		std::optional<ChunkRange> view;
+
+#ifndef GAME3_HEADLESS
+		if (ClientPlayerPtr player = getGame()->toClient().getPlayer(); player && player->getRealm().get() == this) {
+			view.emplace(player->getChunk());
+		}
+#endif
+
+		std::vector<std::pair<std::chrono::steady_clock::time_point, ChunkPosition>> out;
+		std::shared_lock lock(tileProvider.chunkMutexes[0]);
+		auto seen_lock = chunkLastSeen.uniqueLock();
+
+		for (const auto &[chunk_position, chunk]: tileProvider.chunkMaps[0]) {
+			if (view && view->contains(chunk_position)) {
+				chunkLastSeen[chunk_position] = now;
+				continue;
+			}
+
+			auto [iter, inserted] = chunkLastSeen.try_emplace(chunk_position, now);
+			out.emplace_back(iter->second, chunk_position);
+		}
+
+		return out;
+	}
+
+	void Realm::evictChunk(ChunkPosition chunk_position) {
+		assert(isClient());
+		tileProvider.evict(chunk_position);
+		auto seen_lock = chunkLastSeen.uniqueLock();
+		chunkLastSeen.erase(chunk_position);
+	}
+
 	void Realm::detach(const EntityPtr &entity, ChunkPosition chunk_position) {
 		auto lock = entitiesByChunk.uniqueLock();
 
@@ -1779,8 +2258,9 @@ namespace Game3 {
 	}
 
 	void Realm::attach(const EntityPtr &entity) {
-		auto lock = entitiesByChunk.uniqueLock();
 		ChunkPosition chunk_position = entity->getChunk();
+		ensureResident(chunk_position);
+		auto lock = entitiesByChunk.uniqueLock();
 
 		if (auto iter = entitiesByChunk.find(chunk_position); iter != entitiesByChunk.end()) {
 			assert(iter->second);
@@ -1899,6 +2379,7 @@ namespace Game3 {
 		visibleChunks = std::move(new_visible_chunks);
 	}
 
+#ifndef GAME3_HEADLESS
 	void Realm::queueReupload() {
 		assert(isClient());
 
@@ -1913,6 +2394,7 @@ namespace Game3 {
 			});
 		}
 	}
+#endif
 
 	void Realm::autotile(const Position &position, Layer layer, TileUpdateContext context) {
 		const Tileset &tileset = getTileset();
@@ -1922,9 +2404,7 @@ namespace Game3 {
 			return;
 		}
 
-		const Identifier &tilename = tileset[tile];
-
-		if (const MarchableInfo *info = tileset.getMarchableInfo(tilename)) {
+		if (const CompiledMarchable *info = tileset.getCompiledMarchable(tile)) {
 			TileID march_result{};
 
 			if (info->autotileSet->omni) {
@@ -1933,23 +2413,22 @@ namespace Game3 {
 					Position march_position = position + Position(march_row_offset, march_column_offset);
 					for (Layer omni_layer: {Layer::Submerged, Layer::Objects}) {
 						TileID march_tile = tileProvider.copyTile(omni_layer, march_position, TileProvider::TileMode::ReturnEmpty);
-						if (march_tile != 0 && !tileset.isInCategory(march_tile, "base:category/no_omni")) {
+						if (march_tile != 0 && !tileset.isNoOmni(march_tile)) {
 							return true;
 						}
 					}
 					return false;
 				});
 			} else {
-				const std::unordered_set<Identifier> &members = info->autotileSet->members;
+				const AutotileSet &autotile_set = *info->autotileSet;
 				const auto &march = info->eight? march8 : march4;
 				march_result = march([&](int8_t march_row_offset, int8_t march_column_offset) -> bool {
 					Position march_position = position + Position(march_row_offset, march_column_offset);
-					TileID march_tile = tileProvider.copyTile(layer, march_position, TileProvider::TileMode::ReturnEmpty);
-					return members.contains(tileset[march_tile]);
+					return autotile_set.hasMember(tileProvider.copyTile(layer, march_position, TileProvider::TileMode::ReturnEmpty));
 				});
 			}
 
-			TileID marched = tileset[info->start] + (info->tall? 2 * march_result : march_result);
+			TileID marched = info->start + (info->tall? 2 * march_result : march_result);
 
 			if (marched != tile) {
 				setTile(layer, position, marched, true, context);
@@ -1957,6 +2436,105 @@ namespace Game3 {
 		}
 	}
 
+	void Realm::autotileChunk(ChunkPosition chunk_position, Layer layer, TileUpdateContext context) {
+		std::vector<TileID> padded(PADDED_CHUNK_SIZE * PADDED_CHUNK_SIZE);
+		std::vector<TileID> marched(CHUNK_SIZE * CHUNK_SIZE);
+		tileProvider.copyPaddedChunk(layer, chunk_position, padded);
+		computeAutotiles(padded, marched);
+
+		const auto [top, left] = chunk_position.topLeft();
+
+		for (int64_t row = 0; row < CHUNK_SIZE; ++row) {
+			for (int64_t column = 0; column < CHUNK_SIZE; ++column) {
+				const TileID marched_tile = marched[row * CHUNK_SIZE + column];
+				if (padded[(row + 1) * PADDED_CHUNK_SIZE + column + 1] != marched_tile) {
+					setTile(layer, Position(top + row, left + column), marched_tile, false, context);
+				}
+			}
+		}
+	}
+
+	void Realm::computeAutotiles(ChunkPosition chunk_position, Layer layer, std::span<TileID> out) const {
+		std::vector<TileID> padded(PADDED_CHUNK_SIZE * PADDED_CHUNK_SIZE);
+		tileProvider.copyPaddedChunk(layer, chunk_position, padded);
+		computeAutotiles(padded, out);
+	}
+
+	void Realm::computeAutotiles(std::span<const TileID> tiles, std::span<TileID> out) const {
+		assert(tiles.size() == static_cast<size_t>(PADDED_CHUNK_SIZE * PADDED_CHUNK_SIZE));
+		assert(out.size() == static_cast<size_t>(CHUNK_SIZE * CHUNK_SIZE));
+
+		const Tileset &tileset = getTileset();
+		constexpr size_t padded_area = PADDED_CHUNK_SIZE * PADDED_CHUNK_SIZE;
+
+		auto center = [&](int64_t row, int64_t column) -> TileID {
+			return tiles[(row + 1) * PADDED_CHUNK_SIZE + column + 1];
+		};
+
+		// Autotile sets that occur in this chunk, with whether they march eight ways. There are only ever a few.
+		std::vector<std::pair<const AutotileSet *, bool>> groups;
+
+		for (int64_t row = 0; row < CHUNK_SIZE; ++row) {
+			for (int64_t column = 0; column < CHUNK_SIZE; ++column) {
+				const TileID tile = center(row, column);
+				out[row * CHUNK_SIZE + column] = tile;
+				if (const CompiledMarchable *info = tileset.getCompiledMarchable(tile)) {
+					const std::pair group{info->autotileSet, info->eight};
+					if (std::ranges::find(groups, group) == groups.end()) {
+						groups.push_back(group);
+					}
+				}
+			}
+		}
+
+		if (groups.empty()) {
+			return;
+		}
+
+		std::vector<uint8_t> neighbors(padded_area);
+		std::vector<uint8_t> marches(CHUNK_SIZE * CHUNK_SIZE);
+		std::vector<TileID> submerged;
+		std::vector<TileID> objects;
+
+		for (const auto &[autotile_set, eight]: groups) {
+			if (autotile_set->omni) {
+				assert(!eight);
+				if (submerged.empty()) {
+					submerged.resize(padded_area);
+					objects.resize(padded_area);
+					tileProvider.copyPaddedChunk(Layer::Submerged, chunk_position, submerged);
+					tileProvider.copyPaddedChunk(Layer::Objects, chunk_position, objects);
+				}
+
+				for (size_t i = 0; i < padded_area; ++i) {
+					neighbors[i] = (submerged[i] != 0 && !tileset.isNoOmni(submerged[i])) || (objects[i] != 0 && !tileset.isNoOmni(objects[i]));
+				}
+			} else {
+				for (size_t i = 0; i < padded_area; ++i) {
+					neighbors[i] = autotile_set->hasMember(tiles[i]);
+				}
+			}
+
+			if (eight) {
+				march8Chunk(neighbors, marches);
+			} else {
+				march4Chunk(neighbors, marches);
+			}
+
+			for (int64_t row = 0; row < CHUNK_SIZE; ++row) {
+				for (int64_t column = 0; column < CHUNK_SIZE; ++column) {
+					const CompiledMarchable *info = tileset.getCompiledMarchable(center(row, column));
+					if (info != nullptr && info->autotileSet == autotile_set && info->eight == eight) {
+						const size_t index = row * CHUNK_SIZE + column;
+						const TileID march_result = marches[index];
+						out[index] = info->start + (info->tall? 2 * march_result : march_result);
+					}
+				}
+			}
+		}
+	}
+
+#ifndef GAME3_HEADLESS
 	void Realm::remakeStaticLightingTexture(GameUI &ui) {
 		assert(isClient());
 
@@ -2003,6 +2581,7 @@ namespace Game3 {
 		assert(isClient());
 		staticLightingQueued = true;
 	}
+#endif
 
 	void Realm::playSound(const Position &position, const Identifier &id, float pitch, uint16_t maximum_distance) const {
 		if (isServer()) {
@@ -2015,9 +2594,12 @@ namespace Game3 {
 					}
 				}
 			});
-		} else {
+		}
+#ifndef GAME3_HEADLESS
+		else {
 			getGame()->toClient().playSound(id, pitch);
 		}
+#endif
 	}
 
 	bool Realm::isChunkGenerated(ChunkPosition chunk_position) const {
@@ -2026,6 +2608,10 @@ namespace Game3 {
 	}
 
 	bool Realm::rightClick(const Position &position, double, double) {
+#ifdef GAME3_HEADLESS
+		(void) position;
+		return false;
+#else
 		if (!isClient()) {
 			return false;
 		}
@@ -2083,6 +2669,7 @@ namespace Game3 {
 		*/
 
 		return false;
+#endif
 	}
 
 	bool Realm::canSpawnMonsters() const {
@@ -2094,9 +2681,11 @@ namespace Game3 {
 		return !(5. <= hour && hour < 21.);
 	}
 
+#ifndef GAME3_HEADLESS
 	std::unique_ptr<RealmRenderer> Realm::getRenderer() {
 		return std::make_unique<RealmRenderer>();
 	}
+#endif
 
 	void Realm::initEntity(const EntityPtr &entity, const Position &position) {
 		GamePtr game = getGame();
@@ -2124,9 +2713,13 @@ namespace Game3 {
 	}
 
 	bool Realm::isActive() const {
+#ifdef GAME3_HEADLESS
+		return false;
+#else
 		assert(isClient());
 		GamePtr game = getGame();
 		return game->toClient().getActiveRealm().get() == this;
+#endif
 	}
 
 	BiomeType Realm::getBiome(int64_t seed) {
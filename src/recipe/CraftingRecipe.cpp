@@ -3,6 +3,16 @@
 #include "recipe/CraftingRecipe.h"
 
 namespace Game3 {
+	namespace {
+		const std::vector<CraftingRecipePtr> & findRecipes(const std::unordered_map<Identifier, std::vector<CraftingRecipePtr>> &map, const Identifier &identifier) {
+			static const std::vector<CraftingRecipePtr> empty;
+			if (auto iter = map.find(identifier); iter != map.end()) {
+				return iter->second;
+			}
+			return empty;
+		}
+	}
+
 	CraftingRecipe::CraftingRecipe(Input input_, Output output_, Identifier station_type):
 		input(std::move(input_)), output(std::move(output_)), stationType(std::move(station_type)) {}
 
@@ -54,81 +64,82 @@ namespace Game3 {
 			return false;
 		}
 
-		PlayerPtr out_player = std::dynamic_pointer_cast<Player>(inventory_out->getOwner());
+		PlayerPtr out_player = inventory_out->hasOwner()? std::dynamic_pointer_cast<Player>(inventory_out->getOwner()) : nullptr;
 
 		// We need to check whether the output inventory has enough space to hold the outputs.
-		// How we do this depends on the number of outputs as well as whether the input and output inventory are the same.
+		// If the input and output inventories are the same, the space freed by the ingredients counts too.
+		// Either way, the check is a simulation on slot counts, so nothing has to be copied.
 
 		if (inventory_in == inventory_out) {
-			// If they're the same, we need to copy the inventory early to check for
-			// removability and insertability, regardless of the number of outputs.
-			std::unique_ptr<Inventory> copy = inventory_in->copy();
-			for (const CraftingRequirement &requirement: input) {
-				copy->remove(requirement);
-				}
-
-			for (const ItemStackPtr &stack: output) {
-				if (copy->add(stack)) {
-					return false;
-				}
-			}
-
-			inventory_in->replace(std::move(*copy));
-
-			if (out_player) {
-				for (const ItemStackPtr &stack: output) {
-					out_player->addKnownItem(stack);
-				}
+			if (!inventory_in->canExchange(input, output)) {
+				return false;
 			}
-
-			return true;
-		}
-
-		if (output.size() == 1) {
-			// If there's just one output, we can check whether it's insertable without having to copy the output inventory.
+		} else if (output.size() == 1) {
 			if (!inventory_out->canInsert(output[0])) {
 				return false;
 			}
+		} else if (!inventory_out->canExchange({}, output)) {
+			return false;
+		}
 
-			for (const CraftingRequirement &requirement: input) {
-				inventory_in->remove(requirement);
-			}
+		for (const CraftingRequirement &requirement: input) {
+			inventory_in->remove(requirement);
+		}
 
+		for (const ItemStackPtr &stack: output) {
 			if (out_player) {
-				out_player->addKnownItem(output[0]);
+				out_player->addKnownItem(stack);
 			}
 
-			inventory_out->add(output[0]);
-			return true;
+			inventory_out->add(stack);
 		}
 
-		// At this point the input and output inventories are different and there are multiple outputs.
-		// Make a copy of the output inventory and try to insert all the outputs in it.
-		// If that succeeds, proceed to remove the ingredients from the input inventory and replace
-		// the output inventory with the copy.
-		std::unique_ptr<Inventory> out_copy = inventory_out->copy();
-		for (const ItemStackPtr &stack: output) {
-			if (out_copy->add(stack)) {
-				return false;
+		return true;
+	}
+
+	void CraftingRecipe::toJSON(boost::json::value &json, const GamePtr &) const {
+		boost::json::value_from(*this, json);
+	}
+
+	void CraftingRecipeRegistry::onAdd(const CraftingRecipe &) {
+		// UnnamedRegistry::add appends the new recipe to byCounter before calling onAdd.
+		const CraftingRecipePtr &recipe = byCounter.back();
+
+		for (const ItemStackPtr &stack: recipe->output) {
+			auto &recipes = byOutput[stack->getID()];
+			if (recipes.empty() || recipes.back() != recipe) {
+				recipes.push_back(recipe);
 			}
 		}
 
-		for (const CraftingRequirement &requirement: input) {
-			inventory_in->remove(requirement);
-		}
+		for (const CraftingRequirement &requirement: recipe->input) {
+			auto &recipes = requirement.is<ItemStackPtr>()?
+				byIngredient[requirement.get<ItemStackPtr>()->getID()] :
+				byAttribute[requirement.get<AttributeRequirement>().attribute];
 
-		if (out_player) {
-			for (const ItemStackPtr &stack: output) {
-				out_player->addKnownItem(stack);
+			if (recipes.empty() || recipes.back() != recipe) {
+				recipes.push_back(recipe);
 			}
 		}
+	}
 
-		inventory_out->replace(std::move(*out_copy));
-		return true;
+	void CraftingRecipeRegistry::clear() {
+		UnnamedJSONRegistry<CraftingRecipe>::clear();
+		byOutput.clear();
+		byIngredient.clear();
+		byAttribute.clear();
 	}
 
-	void CraftingRecipe::toJSON(boost::json::value &json, const GamePtr &) const {
-		boost::json::value_from(*this, json);
+	const std::vector<CraftingRecipePtr> & CraftingRecipeRegistry::getByOutput(const ItemID &id) const {
+		return findRecipes(byOutput, id);
+	}
+
+	const std::vector<CraftingRecipePtr> & CraftingRecipeRegistry::getByIngredient(const ItemID &id) const {
+		return findRecipes(byIngredient, id);
+	}
+
+	const std::vector<CraftingRecipePtr> & CraftingRecipeRegistry::getByAttribute(const Identifier &attribute) const {
+		return findRecipes(byAttribute, attribute);
 	}
 
 	void tag_invoke(boost::json::value_from_tag, boost::json::value &json, const CraftingRecipe &recipe) {
@@ -15,7 +15,7 @@ namespace Game3 {
 				return 4; // Count non-chemicals as four atoms.
 			}
 
-			const auto counts = Chemskr::count(std::string(chemical->data.at("formula").as_string()));
+			const auto counts = Chemskr::count(std::string(chemical->data->at("formula").as_string()));
 
 			return std::accumulate(counts.begin(), counts.end(), 0, [](size_t total, const auto &pair) {
 				return total + pair.second;
@@ -0,0 +1,158 @@
+#include "config.h"
+
+#ifdef GAME3_ENABLE_SCRIPTING
+#include "scripting/IsolatePool.h"
+#include "scripting/ScriptEngine.h"
+
+namespace Game3 {
+	ScriptIsolate::ScriptIsolate(v8::Isolate *isolate_):
+		isolate(isolate_) {
+			isolate->AddGCEpilogueCallback(&ScriptIsolate::gcEpilogue, this);
+			isolate->AddNearHeapLimitCallback(&ScriptIsolate::nearHeapLimit, this);
+		}
+
+	ScriptIsolate::~ScriptIsolate() {
+		{
+			v8::Locker locker(isolate);
+			templates.clear();
+		}
+
+		isolate->Dispose();
+	}
+
+	std::shared_ptr<ScriptIsolate> ScriptIsolate::create(size_t heap_limit) {
+		return std::shared_ptr<ScriptIsolate>(new ScriptIsolate(ScriptEngine::makeIsolate(heap_limit)));
+	}
+
+	v8::Local<v8::FunctionTemplate> ScriptIsolate::getTemplate(const std::string &name, const TemplateBuilder &builder) {
+		if (auto iter = templates.find(name); iter != templates.end())
+			return iter->second.Get(isolate);
+
+		v8::Local<v8::FunctionTemplate> templ = builder(isolate);
+		templates.emplace(name, v8::Global<v8::FunctionTemplate>(isolate, templ));
+		return templ;
+	}
+
+	void ScriptIsolate::gcEpilogue(v8::Isolate *isolate, v8::GCType, v8::GCCallbackFlags, void *data) {
+		auto &host = *static_cast<ScriptIsolate *>(data);
+		Guard *guard = host.activeGuard;
+
+		if (guard == nullptr || guard->reason != nullptr)
+			return;
+
+		// Runaway allocation shows up as a steady stream of scavenges, so checking here catches it early.
+		v8::HeapStatistics stats;
+		isolate->GetHeapStatistics(&stats);
+
+		if (stats.used_heap_size() > guard->heapBaseline + guard->budget.heapBytes) {
+			const char *expected = nullptr;
+			if (guard->reason.compare_exchange_strong(expected, "Script exceeded its heap budget"))
+				isolate->TerminateExecution();
+		}
+	}
+
+	size_t ScriptIsolate::nearHeapLimit(void *data, size_t current_limit, size_t) {
+		auto &host = *static_cast<ScriptIsolate *>(data);
+
+		if (Guard *guard = host.activeGuard) {
+			const char *expected = nullptr;
+			guard->reason.compare_exchange_strong(expected, "Script exceeded its heap budget");
+		}
+
+		host.isolate->TerminateExecution();
+		// Give the terminating script room to unwind instead of letting V8 abort the whole process.
+		// The original limit is restored once the heap shrinks again.
+		host.isolate->AutomaticallyRestoreInitialHeapLimit();
+		return current_limit + current_limit / 4;
+	}
+
+	ScriptIsolate::Guard::Guard(ScriptIsolate &host_, Budget budget_):
+		host(host_),
+		budget(budget_),
+		outer(host_.activeGuard) {
+			if (outer)
+				return;
+
+			v8::HeapStatistics stats;
+			host.isolate->GetHeapStatistics(&stats);
+			heapBaseline = stats.used_heap_size();
+			deadline = std::chrono::steady_clock::now() + budget.cpu;
+			host.activeGuard = this;
+
+			IsolatePool &pool = IsolatePool::get();
+			auto lock = pool.guards.uniqueLock();
+			pool.guards.insert(this);
+		}
+
+	ScriptIsolate::Guard::~Guard() {
+		if (outer)
+			return;
+
+		{
+			IsolatePool &pool = IsolatePool::get();
+			auto lock = pool.guards.uniqueLock();
+			pool.guards.erase(this);
+		}
+
+		host.activeGuard = nullptr;
+		// The watchdog may have fired just as the script returned. Don't let that termination leak into the next run.
+		host.isolate->CancelTerminateExecution();
+	}
+
+	const char * ScriptIsolate::Guard::exceeded() const {
+		if (outer)
+			return outer->exceeded();
+		return reason;
+	}
+
+	IsolatePool::IsolatePool():
+		watchdog([this](std::stop_token stop_token) { watch(std::move(stop_token)); }) {}
+
+	IsolatePool & IsolatePool::get() {
+		static IsolatePool pool;
+		return pool;
+	}
+
+	std::shared_ptr<ScriptIsolate> IsolatePool::acquire() {
+		auto lock = isolates.uniqueLock();
+
+		std::erase_if(isolates, [](const std::weak_ptr<ScriptIsolate> &weak) {
+			return weak.expired();
+		});
+
+		std::shared_ptr<ScriptIsolate> least_loaded;
+
+		for (const std::weak_ptr<ScriptIsolate> &weak: isolates) {
+			if (std::shared_ptr<ScriptIsolate> isolate = weak.lock()) {
+				if (!least_loaded || isolate->getContextCount() < least_loaded->getContextCount())
+					least_loaded = std::move(isolate);
+			}
+		}
+
+		if (least_loaded && (least_loaded->getContextCount() < CONTEXTS_PER_ISOLATE || MAX_ISOLATES <= isolates.size()))
+			return least_loaded;
+
+		std::shared_ptr<ScriptIsolate> isolate = ScriptIsolate::create(ISOLATE_HEAP_LIMIT);
+		isolates.push_back(isolate);
+		return isolate;
+	}
+
+	void IsolatePool::watch(std::stop_token stop_token) {
+		while (!stop_token.stop_requested()) {
+			std::this_thread::sleep_for(WATCHDOG_PERIOD);
+
+			const auto now = std::chrono::steady_clock::now();
+			auto lock = guards.sharedLock();
+
+			for (ScriptIsolate::Guard *guard: guards) {
+				if (guard->deadline <= now) {
+					const char *expected = nullptr;
+					// TerminateExecution is the one isolate method that's safe to call from another thread.
+					if (guard->reason.compare_exchange_strong(expected, "Script exceeded its CPU budget"))
+						guard->host.isolate->TerminateExecution();
+				}
+			}
+		}
+	}
+}
+#endif
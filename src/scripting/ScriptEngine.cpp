@@ -8,7 +8,6 @@
 #include "scripting/ObjectWrap.h"
 #include "scripting/ScriptEngine.h"
 #include "scripting/ScriptError.h"
-#include "scripting/ScriptUtil.h"
 #include "util/JSON.h"
 #include "util/Util.h"
 
@@ -23,27 +22,38 @@ namespace Game3 {
 	v8::Isolate::CreateParams ScriptEngine::createParams;
 
 	ScriptEngine::ScriptEngine(std::shared_ptr<Game> game):
-		game(game),
-		isolate(makeIsolate()),
-		bufferTemplate(makeBufferTemplate()),
-		globalContext(makeContext()) {}
+		ScriptEngine(std::move(game), ScriptIsolate::create(), GlobalMutator{}) {}
 
 	ScriptEngine::ScriptEngine(std::shared_ptr<Game> game, FunctionAdder function_adder):
 		game(game),
-		isolate(makeIsolate()),
-		bufferTemplate(makeBufferTemplate()),
-		globalContext(makeContext(std::move(function_adder))) {}
+		host(ScriptIsolate::create()),
+		isolate(host->get()),
+		bufferTemplate(shareBufferTemplate()),
+		globalContext(makeContext(std::move(function_adder))) {
+			++host->contextCount;
+		}
 
 	ScriptEngine::ScriptEngine(std::shared_ptr<Game> game, GlobalMutator global_mutator):
+		ScriptEngine(std::move(game), ScriptIsolate::create(), std::move(global_mutator)) {}
+
+	ScriptEngine::ScriptEngine(std::shared_ptr<Game> game, std::shared_ptr<ScriptIsolate> host_, GlobalMutator global_mutator):
 		game(game),
-		isolate(makeIsolate()),
-		bufferTemplate(makeBufferTemplate()),
-		globalContext(makeContext(std::move(global_mutator))) {}
+		host(std::move(host_)),
+		isolate(host->get()),
+		bufferTemplate(shareBufferTemplate()),
+		globalContext(makeContext(std::move(global_mutator))) {
+			++host->contextCount;
+		}
 
 	ScriptEngine::~ScriptEngine() {
-		globalContext.Reset();
-		bufferTemplate.Reset();
-		isolate->Dispose();
+		{
+			// Other engines may be using the isolate right now.
+			v8::Locker locker(isolate);
+			globalContext.Reset();
+			bufferTemplate.Reset();
+		}
+
+		--host->contextCount;
 	}
 
 	std::optional<v8::Local<v8::Value>> ScriptEngine::execute(const std::string &javascript, bool can_throw, const std::function<void(v8::Local<v8::Context>)> &context_mutator) {
@@ -62,6 +72,10 @@ namespace Game3 {
 		if (context_mutator)
 			context_mutator(context);
 
+		std::optional<ScriptIsolate::Guard> guard;
+		if (budget)
+			guard.emplace(*host, *budget);
+
 		v8::Local<v8::Script> script;
 		if (!v8::Script::Compile(context, source, &origin).ToLocal(&script)) {
 			if (can_throw)
@@ -72,6 +86,11 @@ namespace Game3 {
 		v8::Local<v8::Value> result;
 		if (!script->Run(context).ToLocal(&result)) {
 			assert(try_catch.HasCaught());
+			if (try_catch.HasTerminated()) {
+				if (can_throw)
+					throw ScriptError(guard && guard->exceeded()? guard->exceeded() : "Script terminated");
+				return std::nullopt;
+			}
 			if (can_throw)
 				throwException(isolate, &try_catch);
 			return std::nullopt;
@@ -219,6 +238,19 @@ namespace Game3 {
 		throw std::runtime_error("Couldn't JSONify value");
 	}
 
+	void ScriptEngine::setOwner(void *new_owner) {
+		owner = new_owner;
+
+		v8::Locker locker(isolate);
+		v8::Isolate::Scope isolate_scope(isolate);
+		v8::HandleScope handle_scope(isolate);
+		getContext()->SetAlignedPointerInEmbedderData(OWNER_INDEX, owner);
+	}
+
+	ScriptEngine & ScriptEngine::fromContext(v8::Local<v8::Context> context) {
+		return *static_cast<ScriptEngine *>(context->GetAlignedPointerFromEmbedderData(ENGINE_INDEX));
+	}
+
 	void ScriptEngine::clearContext() {
 		globalContext = makeContext(std::move(savedMutator));
 	}
@@ -269,9 +301,15 @@ namespace Game3 {
 		throw ScriptError(exception_string, line, column);
 	}
 
-	v8::Isolate * ScriptEngine::makeIsolate() {
+	v8::Isolate * ScriptEngine::makeIsolate(size_t heap_limit) {
 		assert(initialized);
-		return v8::Isolate::New(createParams);
+
+		if (heap_limit == 0)
+			return v8::Isolate::New(createParams);
+
+		v8::Isolate::CreateParams params = createParams;
+		params.constraints.ConfigureDefaultsFromHeapSize(0, heap_limit);
+		return v8::Isolate::New(params);
 	}
 
 	v8::Global<v8::Context> ScriptEngine::makeContext(GlobalMutator global_mutator) {
@@ -281,30 +319,34 @@ namespace Game3 {
 
 		v8::Local<v8::ObjectTemplate> global = v8::ObjectTemplate::New(isolate);
 
-		global->Set(isolate, "print", v8::FunctionTemplate::New(isolate, [](const v8::FunctionCallbackInfo<v8::Value> &info) {
-			bool first = true;
-			std::stringstream ss;
-			for (int i = 0; i < info.Length(); ++i) {
-				v8::HandleScope handle_scope(info.GetIsolate());
-				if (first)
-					first = false;
-				else
-					ss << ' ';
-				ss << toCString(v8::String::Utf8Value(info.GetIsolate(), info[i]));
-			}
-			auto &engine = *reinterpret_cast<ScriptEngine *>(info.Data().As<v8::External>()->Value());
-			engine.print(ss.str());
-		}, v8::External::New(isolate, this)));
-
-		global->Set(isolate, "gc", v8::FunctionTemplate::New(isolate, [](const v8::FunctionCallbackInfo<v8::Value> &info) {
-			auto &engine = *reinterpret_cast<ScriptEngine *>(info.Data().As<v8::External>()->Value());
-			auto *isolate = engine.getIsolate();
-			int64_t bytes = 100'000'000;
-			if (info.Length() == 1 && info[0]->IsNumber())
-				bytes = int64_t(info[0].As<v8::Number>()->Value());
-			isolate->AdjustAmountOfExternalAllocatedMemory(bytes);
-			info.GetReturnValue().Set(v8::BigInt::New(isolate, bytes));
-		}, v8::External::New(isolate, this)));
+		// The function templates live as long as the isolate and are shared by every context in it.
+		// Callbacks find their engine through the context they're called in.
+		global->Set(isolate, "print", host->getTemplate("print", [](v8::Isolate *isolate) {
+			return v8::FunctionTemplate::New(isolate, [](const v8::FunctionCallbackInfo<v8::Value> &info) {
+				bool first = true;
+				std::stringstream ss;
+				for (int i = 0; i < info.Length(); ++i) {
+					v8::HandleScope handle_scope(info.GetIsolate());
+					if (first)
+						first = false;
+					else
+						ss << ' ';
+					ss << toCString(v8::String::Utf8Value(info.GetIsolate(), info[i]));
+				}
+				fromContext(info.GetIsolate()->GetCurrentContext()).print(ss.str());
+			});
+		}));
+
+		global->Set(isolate, "gc", host->getTemplate("gc", [](v8::Isolate *isolate) {
+			return v8::FunctionTemplate::New(isolate, [](const v8::FunctionCallbackInfo<v8::Value> &info) {
+				auto *isolate = info.GetIsolate();
+				int64_t bytes = 100'000'000;
+				if (info.Length() == 1 && info[0]->IsNumber())
+					bytes = int64_t(info[0].As<v8::Number>()->Value());
+				isolate->AdjustAmountOfExternalAllocatedMemory(bytes);
+				info.GetReturnValue().Set(v8::BigInt::New(isolate, bytes));
+			});
+		}));
 
 		global->Set(isolate, "Buffer", getBufferTemplate());
 
@@ -314,6 +356,8 @@ namespace Game3 {
 		savedMutator = std::move(global_mutator);
 
 		v8::Local<v8::Context> context = v8::Context::New(isolate, nullptr, global);
+		context->SetAlignedPointerInEmbedderData(ENGINE_INDEX, this);
+		context->SetAlignedPointerInEmbedderData(OWNER_INDEX, owner);
 		return v8::Global<v8::Context>(isolate, context);
 	}
 
@@ -338,7 +382,7 @@ namespace Game3 {
 					json = buffer.popJSON();
 				}
 
-				auto &engine = getExternal<ScriptEngine>(info);
+				auto &engine = fromContext(info.GetIsolate()->GetCurrentContext());
 
 				try {
 					if (auto result = engine.execute(stringifyWithBigInt(json)))
@@ -355,18 +399,21 @@ namespace Game3 {
 		}
 	}
 
-	v8::Global<v8::FunctionTemplate> ScriptEngine::makeBufferTemplate() {
+	v8::Global<v8::FunctionTemplate> ScriptEngine::shareBufferTemplate() {
 		v8::Locker locker(isolate);
 		v8::Isolate::Scope isolate_scope(isolate);
 		v8::HandleScope handle_scope(isolate);
+		return v8::Global<v8::FunctionTemplate>(isolate, host->getTemplate("Buffer", &ScriptEngine::makeBufferTemplate));
+	}
 
+	v8::Local<v8::FunctionTemplate> ScriptEngine::makeBufferTemplate(v8::Isolate *isolate) {
 		v8::Local<v8::FunctionTemplate> templ = v8::FunctionTemplate::New(isolate, [](const v8::FunctionCallbackInfo<v8::Value> &info) {
-			auto &engine = getExternal<ScriptEngine>(info);
+			auto &engine = fromContext(info.GetIsolate()->GetCurrentContext());
 			v8::Local<v8::Object> this_obj = info.This();
 			auto *wrapper = ObjectWrap<Buffer>::make(Side::Client);
 			wrapper->wrap(engine.getIsolate(), "Buffer", this_obj);
 			wrapper->object->context = engine.game;
-		}, wrap(this));
+		});
 
 		v8::Local<v8::ObjectTemplate> instance = templ->InstanceTemplate();
 
@@ -386,10 +433,10 @@ namespace Game3 {
 			for (int i = 1; i < info.Length(); ++i)
 				values.push_back(info[i]);
 
-			auto &engine = getExternal<ScriptEngine>(info);
+			auto &engine = fromContext(info.GetIsolate()->GetCurrentContext());
 			engine.addToBuffer(*wrapper.object, info[0], values);
 			info.GetReturnValue().Set(info.This());
-		}, wrap(this)));
+		}));
 
 		instance->Set(isolate, "debug", v8::FunctionTemplate::New(isolate, [](const v8::FunctionCallbackInfo<v8::Value> &info) {
 			auto &wrapper = ObjectWrap<Buffer>::unwrap("Buffer", info.This());
@@ -409,7 +456,7 @@ namespace Game3 {
 			auto &wrapper = ObjectWrap<Buffer>::unwrap("Buffer", info.This());
 			assert(wrapper.object);
 
-			auto &engine = getExternal<ScriptEngine>(info);
+			auto &engine = fromContext(info.GetIsolate()->GetCurrentContext());
 			v8::Local<v8::Context> context = engine.getContext();
 			v8::Local<v8::Object> new_buffer = engine.getBufferTemplate()->GetFunction(context).ToLocalChecked()->CallAsConstructor(context, 0, nullptr).ToLocalChecked().As<v8::Object>();
 
@@ -417,13 +464,13 @@ namespace Game3 {
 			*new_wrapper.object = *wrapper.object;
 
 			info.GetReturnValue().Set(new_buffer);
-		}, wrap(this)));
+		}));
 
 		instance->Set(isolate, "takeObject", v8::FunctionTemplate::New(isolate, [](const v8::FunctionCallbackInfo<v8::Value> &info) {
 			auto &wrapper = ObjectWrap<Buffer>::unwrap("Buffer", info.This());
 			assert(wrapper.object);
 			toObject(*wrapper.object, info);
-		}, wrap(this)));
+		}));
 
 		instance->Set(isolate, "toObject", v8::FunctionTemplate::New(isolate, [](const v8::FunctionCallbackInfo<v8::Value> &info) {
 			auto &wrapper = ObjectWrap<Buffer>::unwrap("Buffer", info.This());
@@ -431,9 +478,9 @@ namespace Game3 {
 			const auto old_skip = wrapper.object->skip;
 			toObject(*wrapper.object, info);
 			wrapper.object->skip = old_skip;
-		}, wrap(this)));
+		}));
 
-		instance->SetNativeDataProperty(string("length"), [](v8::Local<v8::Name>, const v8::PropertyCallbackInfo<v8::Value> &info) {
+		instance->SetNativeDataProperty(v8::String::NewFromUtf8Literal(isolate, "length"), [](v8::Local<v8::Name>, const v8::PropertyCallbackInfo<v8::Value> &info) {
 			auto &wrapper = ObjectWrap<Buffer>::unwrap("Buffer", info.This());
 			size_t size = wrapper->size();
 			if (size <= UINT32_MAX)
@@ -442,7 +489,7 @@ namespace Game3 {
 				info.GetReturnValue().Set(double(size));
 		});
 
-		return v8::Global<v8::FunctionTemplate>(isolate, templ);
+		return templ;
 	}
 
 	void ScriptEngine::addToBuffer(Buffer &buffer, v8::Local<v8::Value> type_value, std::span<v8::Local<v8::Value>> values, bool in_container) {
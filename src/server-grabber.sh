@@ -0,0 +1,27 @@
+#!/bin/sh
+
+# Lists the sources for game3-server: everything grabber.sh lists except the windowing, UI, audio and OpenGL code.
+# Tilesets, colors, item sets and textures live in graphics/ but the server needs them too (textures only as image
+# data, never uploaded). Modifiers are part of the interaction packets. Minigames, local commands, dialogue and the
+# local clients only run on a client.
+# This is used during `meson setup`.
+
+find . -name '*.cpp' \
+	! -path './ui/*' \
+	! -path './client/*' \
+	! -path './test/*' \
+	! -path './bench/*' \
+	! -path './graphics/*' \
+	! -path './minigame/*' \
+	! -path './command/local/*' \
+	! -path './dialogue/*' \
+	! -path './game/ClientGame.cpp' \
+	! -path './game/ClientInventory.cpp' \
+	! -path './entity/ClientPlayer.cpp' \
+	! -path './net/LocalClient.cpp' \
+	! -path './net/DirectLocalClient.cpp' \
+	! -path './net/DirectRemoteClient.cpp' \
+	! -path './main.cpp'
+
+find ./graphics -name 'Tileset.cpp' -o -name 'Color.cpp' -o -name 'ItemSet.cpp' -o -name 'Texture.cpp'
+find ./ui -name 'Modifiers.cpp'
@@ -14,7 +14,9 @@ namespace Game3 {
 
 	void StatusEffect::modifyColors(Color &, Color &) {}
 
+#ifndef GAME3_HEADLESS
 	std::shared_ptr<Texture> StatusEffect::getTexture(const std::shared_ptr<ClientGame> &) {
 		return {};
 	}
+#endif
 }
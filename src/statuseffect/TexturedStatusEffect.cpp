@@ -1,12 +1,16 @@
-#include "game/ClientGame.h"
 #include "item/Item.h"
 #include "statuseffect/TexturedStatusEffect.h"
 
+#ifndef GAME3_HEADLESS
+#include "game/ClientGame.h"
+#endif
+
 namespace Game3 {
 	TexturedStatusEffect::TexturedStatusEffect(Identifier identifier, Identifier itemID):
 		StatusEffect(std::move(identifier)),
 		itemID(std::move(itemID)) {}
 
+#ifndef GAME3_HEADLESS
 	std::shared_ptr<Texture> TexturedStatusEffect::getTexture(const std::shared_ptr<ClientGame> &game) {
 		if (!cachedTexture) {
 			cachedTexture = game->itemRegistry->at(itemID)->getTexture(*game, {});
@@ -14,4 +18,5 @@ namespace Game3 {
 
 		return cachedTexture;
 	}
+#endif
 }
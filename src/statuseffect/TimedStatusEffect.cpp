@@ -1,6 +1,10 @@
-#include "game/ClientGame.h"
+#include "net/Buffer.h"
 #include "statuseffect/TimedStatusEffect.h"
 
+#ifndef GAME3_HEADLESS
+#include "game/ClientGame.h"
+#endif
+
 namespace Game3 {
 	TimedStatusEffect::TimedStatusEffect(Identifier identifier, Identifier itemID, float duration):
 		TexturedStatusEffect(std::move(identifier), std::move(itemID)),
@@ -0,0 +1,45 @@
+#include "game/TileProvider.h"
+#include "test/Testing.h"
+
+#include <array>
+
+namespace Game3 {
+	class ChunkSnapshotTest: public Test {
+		public:
+			static Identifier ID() { return "base:test/game/chunk_snapshot"; }
+
+			ChunkSnapshotTest() = default;
+
+			void operator()(TestContext &context) {
+				TileProvider provider("base:tileset/monomap");
+				const ChunkPosition resident{0, 0};
+				const ChunkPosition missing{5, 5};
+				provider.ensureAllChunks(resident);
+
+				{
+					std::unique_lock<std::shared_mutex> lock;
+					provider.findTile(Layer::Soil, Position{1, 2}, &lock) = 42;
+				}
+
+				const std::array positions{resident, missing};
+				std::vector<std::pair<ChunkPosition, ChunkSet>> snapshot = provider.copyChunkSets(positions);
+
+				context.expectEqual("missing chunks are skipped", snapshot.size(), 1uz);
+				const ChunkSet &chunk_set = snapshot.at(0).second;
+				context.expectEqual("terrain encodes like the provider", chunk_set.getRawTerrain() == provider.getRawTerrain(resident), true);
+				context.expectEqual("biomes encode like the provider", chunk_set.getRawBiomes() == provider.getRawBiomes(resident), true);
+				context.expectEqual("fluids encode like the provider", chunk_set.getRawFluids() == provider.getRawFluids(resident), true);
+				context.expectEqual("pathmaps encode like the provider", chunk_set.getRawPathmap() == provider.getRawPathmap(resident), true);
+
+				{
+					std::unique_lock<std::shared_mutex> lock;
+					provider.findTile(Layer::Soil, Position{1, 2}, &lock) = 43;
+				}
+
+				const TileChunk &soil = chunk_set.terrain.at(getIndex(Layer::Soil));
+				context.expectEqual("later writes don't reach the snapshot", TileProvider::access(soil, 1, 2), TileID(42));
+			}
+	};
+
+	static auto added = addTest<ChunkSnapshotTest>();
+}
@@ -0,0 +1,109 @@
+#include "game/ClientGame.h"
+#include "game/InventorySpan.h"
+#include "game/ServerInventory.h"
+#include "recipe/CraftingRecipe.h"
+#include "util/Timer.h"
+
+#include <iostream>
+
+namespace Game3 {
+	namespace {
+		constexpr size_t AUTOCRAFTER_COUNT = 500;
+		constexpr size_t TICK_COUNT = 1'000;
+		constexpr Slot INPUT_CAPACITY = 10;
+		constexpr Slot OUTPUT_CAPACITY = 10;
+
+		struct SimulatedAutocrafter {
+			InventoryPtr inventory;
+			std::shared_ptr<InventorySpan> inputSpan;
+			std::shared_ptr<InventorySpan> outputSpan;
+			CraftingRecipePtr recipe;
+			uint64_t idleRevision = -1;
+		};
+	}
+
+	/** Simulates a factory of autocrafters that mostly sit idle, the way Autocrafter::autocraft drives recipes. */
+	void craftingBenchmark() {
+		auto game = Game::create(Side::Client, nullptr);
+		auto &registry = game->registry<CraftingRecipeRegistry>();
+
+		std::vector<CraftingRecipePtr> recipes;
+		for (const CraftingRecipePtr &recipe: registry) {
+			if (recipe->stationType || recipe->input.empty()) {
+				continue;
+			}
+
+			if (std::ranges::all_of(recipe->input, [](const CraftingRequirement &requirement) { return requirement.is<ItemStackPtr>(); })) {
+				recipes.push_back(recipe);
+			}
+		}
+
+		if (recipes.empty()) {
+			std::cerr << "No suitable recipes found.\n";
+			return;
+		}
+
+		auto make_factory = [&] {
+			std::vector<SimulatedAutocrafter> factory;
+			factory.reserve(AUTOCRAFTER_COUNT);
+
+			for (size_t i = 0; i < AUTOCRAFTER_COUNT; ++i) {
+				InventoryPtr inventory = std::make_shared<ServerInventory>(nullptr, INPUT_CAPACITY + OUTPUT_CAPACITY);
+				CraftingRecipePtr recipe = recipes[i % recipes.size()];
+
+				// Give every tenth autocrafter enough for a few crafts and leave the rest short of ingredients.
+				const ItemCount multiplier = i % 10 == 0? 4 : 0;
+				for (const CraftingRequirement &requirement: recipe->input) {
+					const ItemStackPtr &stack = requirement.get<ItemStackPtr>();
+					const ItemCount count = std::max<ItemCount>(1, stack->count * multiplier);
+					inventory->add(stack->withCount(std::min(count, stack->item->maxCount)), [](Slot slot) { return slot < INPUT_CAPACITY; });
+				}
+
+				factory.emplace_back(inventory,
+					std::make_shared<InventorySpan>(inventory, 0, INPUT_CAPACITY - 1),
+					std::make_shared<InventorySpan>(inventory, INPUT_CAPACITY, INPUT_CAPACITY + OUTPUT_CAPACITY - 1),
+					std::move(recipe));
+			}
+
+			return factory;
+		};
+
+		size_t crafted = 0;
+
+		{
+			std::vector<SimulatedAutocrafter> factory = make_factory();
+			Timer timer{"CraftEveryPeriod"};
+			for (size_t tick = 0; tick < TICK_COUNT; ++tick) {
+				for (SimulatedAutocrafter &autocrafter: factory) {
+					crafted += autocrafter.recipe->craft(game, autocrafter.inputSpan, autocrafter.outputSpan);
+				}
+			}
+		}
+
+		std::cout << "Crafted without revision checks: " << crafted << '\n';
+		crafted = 0;
+
+		{
+			std::vector<SimulatedAutocrafter> factory = make_factory();
+			Timer timer{"CraftOnRevisionChange"};
+			for (size_t tick = 0; tick < TICK_COUNT; ++tick) {
+				for (SimulatedAutocrafter &autocrafter: factory) {
+					const uint64_t revision = autocrafter.inventory->getRevision();
+					if (revision == autocrafter.idleRevision) {
+						continue;
+					}
+
+					if (autocrafter.recipe->craft(game, autocrafter.inputSpan, autocrafter.outputSpan)) {
+						++crafted;
+					} else {
+						autocrafter.idleRevision = revision;
+					}
+				}
+			}
+		}
+
+		std::cout << "Crafted with revision checks: " << crafted << '\n';
+
+		Timer::summary();
+	}
+}
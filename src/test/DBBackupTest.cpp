@@ -0,0 +1,119 @@
+#include "data/DBBackup.h"
+#include "test/Testing.h"
+#include "util/Defer.h"
+
+#include <array>
+#include <filesystem>
+#include <format>
+#include <memory>
+#include <random>
+#include <stop_token>
+
+namespace Game3 {
+	class DBBackupTest: public Test {
+		public:
+			static Identifier ID() { return "base:test/data/backup"; }
+
+			DBBackupTest() = default;
+
+			void operator()(TestContext &context) {
+				const std::filesystem::path root = std::filesystem::temp_directory_path() / std::format("game3-backup-test-{}", std::random_device{}());
+				std::filesystem::create_directories(root);
+				Defer cleanup([&] { std::filesystem::remove_all(root); });
+
+				std::unique_ptr<leveldb::DB> database = open(root / "live", true);
+				database->Put({}, "kept", "same");
+				database->Put({}, "changed", "before");
+				database->Put({}, "erased", "doomed");
+
+				const leveldb::Snapshot *snapshot = database->GetSnapshot();
+				// Writes after the snapshot mustn't show up in the full backup.
+				database->Put({}, "late", "too late");
+				const DBBackup::Stats full = DBBackup::backup(*database, snapshot, root / "full.g3b", std::nullopt, 0);
+				database->ReleaseSnapshot(snapshot);
+
+				context.expectEqual("full backup writes every key in the snapshot", full.written, 3uz);
+
+				database->Put({}, "changed", "after");
+				database->Delete({}, "erased");
+
+				const DBBackup::Stats incremental = DBBackup::backup(*database, nullptr, root / "incremental.g3b", root / "full.g3b", 0);
+				context.expectEqual("incremental backup writes new and changed keys", incremental.written, 2uz);
+				context.expectEqual("incremental backup skips unchanged keys", incremental.unchanged, 1uz);
+				context.expectEqual("incremental backup erases missing keys", incremental.erased, 1uz);
+
+				database.reset();
+
+				DBBackup::restore(root / "restored-full", std::array{root / "full.g3b"});
+				{
+					std::unique_ptr<leveldb::DB> restored = open(root / "restored-full", false);
+					context.expectEqual("full restore has old values", get(*restored, "changed"), std::string("before"));
+					context.expectEqual("full restore leaves out later writes", get(*restored, "late"), std::string());
+				}
+
+				DBBackup::restore(root / "restored-incremental", std::array{root / "full.g3b", root / "incremental.g3b"});
+				{
+					std::unique_ptr<leveldb::DB> restored = open(root / "restored-incremental", false);
+					context.expectEqual("incremental restore keeps unchanged values", get(*restored, "kept"), std::string("same"));
+					context.expectEqual("incremental restore applies changes", get(*restored, "changed"), std::string("after"));
+					context.expectEqual("incremental restore applies erasures", get(*restored, "erased"), std::string());
+					context.expectEqual("incremental restore adds new keys", get(*restored, "late"), std::string("too late"));
+				}
+
+				testLargeArchive(context, root);
+			}
+
+		private:
+			/** Covers archives with several blocks, which restore streams through its queue, and cancelling a backup
+			 *  that reads plenty but writes nothing. */
+			static void testLargeArchive(TestContext &context, const std::filesystem::path &root) {
+				constexpr size_t KEY_COUNT = 12;
+				const std::string value(1 << 20, 'x');
+
+				std::unique_ptr<leveldb::DB> database = open(root / "large", true);
+				for (size_t i = 0; i < KEY_COUNT; ++i) {
+					database->Put({}, std::format("key{}", i), value);
+				}
+
+				const DBBackup::Stats full = DBBackup::backup(*database, nullptr, root / "large.g3b", std::nullopt, 0);
+				context.expectEqual("large backup spans several blocks", DBBackup::BLOCK_SIZE < full.rawBytes, true);
+
+				std::stop_source stop_source;
+				stop_source.request_stop();
+				bool cancelled = false;
+				try {
+					DBBackup::backup(*database, nullptr, root / "unchanged.g3b", root / "large.g3b", 0, stop_source.get_token());
+				} catch (const std::runtime_error &) {
+					cancelled = true;
+				}
+				context.expectEqual("backup that writes nothing can still be cancelled", cancelled, true);
+				context.expectEqual("cancelled backup leaves no archive", std::filesystem::exists(root / "unchanged.g3b"), false);
+
+				database.reset();
+
+				const DBBackup::Stats restored = DBBackup::restore(root / "restored-large", std::array{root / "large.g3b"});
+				context.expectEqual("large restore writes every key", restored.written, KEY_COUNT);
+
+				std::unique_ptr<leveldb::DB> restored_database = open(root / "restored-large", false);
+				context.expectEqual("large restore keeps the last value", get(*restored_database, std::format("key{}", KEY_COUNT - 1)) == value, true);
+			}
+
+			static std::unique_ptr<leveldb::DB> open(const std::filesystem::path &path, bool create) {
+				leveldb::Options options;
+				options.create_if_missing = create;
+				leveldb::DB *database = nullptr;
+				if (!leveldb::DB::Open(options, path.string(), &database).ok()) {
+					throw std::runtime_error("Couldn't open " + path.string());
+				}
+				return std::unique_ptr<leveldb::DB>(database);
+			}
+
+			static std::string get(leveldb::DB &database, const std::string &key) {
+				std::string out;
+				database.Get({}, key, &out);
+				return out;
+			}
+	};
+
+	static auto added = addTest<DBBackupTest>();
+}
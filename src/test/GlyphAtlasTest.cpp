@@ -0,0 +1,80 @@
+#include "graphics/GlyphAtlas.h"
+#include "graphics/TextRenderer.h"
+#include "test/Testing.h"
+#include "types/UString.h"
+
+#include <algorithm>
+
+namespace Game3 {
+	class GlyphAtlasTest: public Test {
+		public:
+			static Identifier ID() { return "base:test/graphics/glyph_atlas"; }
+
+			GlyphAtlasTest() = default;
+
+			void operator()(TestContext &context) {
+				{
+					GlyphAtlas atlas(64, 16, 64);
+					std::vector<GlyphAtlas::Region> regions;
+					bool all_inserted = true;
+
+					for (uint8_t i = 1; i <= 40; ++i) {
+						const uint32_t width = 3 + i % 7;
+						const uint32_t height = 4 + i % 5;
+						std::vector<uint8_t> bitmap(width * height, i);
+						if (auto region = atlas.insert(width, height, bitmap.data(), width)) {
+							regions.push_back(*region);
+						} else {
+							all_inserted = false;
+						}
+					}
+
+					context.expectEqual("every glyph fits", all_inserted, true);
+					context.expectEqual("the atlas grew", atlas.getHeight(), 64u);
+
+					bool overlap = false;
+					for (size_t i = 0; i < regions.size(); ++i) {
+						for (size_t j = i + 1; j < regions.size(); ++j) {
+							const GlyphAtlas::Region &a = regions[i];
+							const GlyphAtlas::Region &b = regions[j];
+							overlap |= a.x < b.x + b.width && b.x < a.x + a.width && a.y < b.y + b.height && b.y < a.y + a.height;
+						}
+					}
+					context.expectEqual("no regions overlap", overlap, false);
+
+					// Growing must leave the glyphs inserted before it where they were.
+					bool intact = true;
+					for (size_t i = 0; i < regions.size(); ++i) {
+						const GlyphAtlas::Region &region = regions[i];
+						for (uint32_t row = 0; row < region.height; ++row) {
+							const auto begin = atlas.getPixels().begin() + (region.y + row) * atlas.getWidth() + region.x;
+							intact &= std::all_of(begin, begin + region.width, [&](uint8_t pixel) { return pixel == i + 1; });
+						}
+					}
+					context.expectEqual("pixels survive growth", intact, true);
+
+					std::vector<uint8_t> huge(65 * 4);
+					context.expectEqual("too wide", atlas.insert(65, 4, huge.data(), 65).has_value(), false);
+				}
+
+				TextRenderer renderer = TextRenderer::forTesting();
+				renderer.initRenderData();
+
+				{
+					const UString text = "Gangblanc, Gangblanc, give me your answer, do";
+					const TextRenderer::Layout &first = renderer.layOut(UStringSpan(text), 0.5, 0.5);
+					const TextRenderer::Layout &second = renderer.layOut(UStringSpan(text), 0.5, 0.5);
+					context.expectEqual("layouts are cached", &first, &second);
+					context.expectEqual("single line", first.lastLineY, 0.f);
+					// Spaces have no quads.
+					context.expectEqual("quad count", first.quads.size(), 39uz);
+
+					const TextRenderer::Layout &wrapped = renderer.layOut(UStringSpan(text), 0.5, 0.5, 200);
+					context.expectEqual("wrapping adds lines", wrapped.lastLineY < 0, true);
+					context.expectEqual("wrapping keeps every glyph", wrapped.quads.size(), 39uz);
+				}
+			}
+	};
+
+	static auto added = addTest<GlyphAtlasTest>();
+}
@@ -0,0 +1,91 @@
+#include "entity/ItemEntity.h"
+#include "entity/KinematicsStore.h"
+#include "entity/Pig.h"
+#include "game/ClientGame.h"
+#include "realm/Overworld.h"
+#include "util/Timer.h"
+
+#include <chrono>
+#include <iostream>
+
+namespace Game3 {
+	namespace {
+		constexpr size_t ITEM_COUNT = 10'000;
+		constexpr size_t ANIMAL_COUNT = 10'000;
+		constexpr size_t TICK_COUNT = 1'000;
+		constexpr float DELTA = 1.f / 60.f;
+	}
+
+	/** Integrates the motion of a crowd of bouncing item entities and wandering animals through a realm's KinematicsStore. */
+	void kinematicsBenchmark() {
+		auto game = Game::create(Side::Client, nullptr);
+		RealmPtr realm = Realm::create<Overworld>(game, 1, Overworld::ID(), "base:tileset/monomap", 0);
+		game->addRealm(realm->id, realm);
+
+		std::vector<EntityPtr> items;
+		std::vector<EntityPtr> animals;
+		items.reserve(ITEM_COUNT);
+		animals.reserve(ANIMAL_COUNT);
+
+		for (size_t i = 0; i < ITEM_COUNT; ++i) {
+			EntityPtr item = ItemEntity::create(game);
+			item->setRealm(realm);
+			item->position = Position(i / 100, i % 100);
+			items.push_back(std::move(item));
+		}
+
+		for (size_t i = 0; i < ANIMAL_COUNT; ++i) {
+			EntityPtr animal = Pig::create(game);
+			animal->setRealm(realm);
+			animal->position = Position(i / 100, i % 100 + 200);
+			animals.push_back(std::move(animal));
+		}
+
+		size_t integrated = 0;
+
+		{
+			Timer timer{"KinematicsStore"};
+			for (size_t tick = 0; tick < TICK_COUNT; ++tick) {
+				// Throw the items back up once they land and start another step for animals that finished walking.
+				for (const EntityPtr &item: items) {
+					if (!item->kinematicsTracked) {
+						item->velocity.withUnique([](Vector3 &velocity) { velocity.z = 6; });
+					}
+					item->applyMotion(DELTA);
+				}
+
+				for (size_t i = 0; i < animals.size(); ++i) {
+					const EntityPtr &animal = animals[i];
+					if (!animal->kinematicsTracked) {
+						animal->offset.withUnique([&](Vector3 &offset) { offset.x = (i + tick) % 2 == 0? 1 : -1; });
+					}
+					animal->applyMotion(DELTA);
+				}
+
+				integrated += realm->kinematics.size();
+				realm->kinematics.step(*realm, DELTA);
+			}
+		}
+
+		std::cout << "Bodies integrated through the store: " << integrated << '\n';
+
+		KinematicsStore::Arrays arrays;
+		arrays.resize(ITEM_COUNT + ANIMAL_COUNT);
+		for (size_t i = 0; i < arrays.size(); ++i) {
+			arrays.speed[i] = 5.f;
+			arrays.velocityZ[i] = i < ITEM_COUNT? 6 : 0;
+			arrays.offsetX[i] = i < ITEM_COUNT? 0 : 1;
+		}
+
+		{
+			Timer timer{"IntegrateOnly"};
+			for (size_t tick = 0; tick < TICK_COUNT; ++tick) {
+				KinematicsStore::integrate(arrays, DELTA);
+			}
+		}
+
+		std::cout << "Bodies integrated by the kernel alone: " << arrays.size() * TICK_COUNT << '\n';
+
+		Timer::summary();
+	}
+}
@@ -0,0 +1,64 @@
+#include "test/Testing.h"
+#include "threading/LockProfiler.h"
+
+#include <algorithm>
+
+namespace Game3 {
+	class LockProfilerTest: public Test {
+		public:
+			static Identifier ID() { return "base:test/threading/lock_profiler"; }
+
+			LockProfilerTest() = default;
+
+			void operator()(TestContext &context) {
+				const uint32_t old_interval = LockProfiler::getSampleInterval();
+
+				LockProfiler::Site &quiet = LockProfiler::getSite("test/quiet");
+				LockProfiler::Site &busy = LockProfiler::getSite("test/busy");
+				context.expectEqual("sites are interned", &LockProfiler::getSite("test/busy"), &busy);
+
+				LockProfiler::setSampleInterval(1);
+				quiet.recordAcquisition(false, 0);
+				quiet.recordAcquisition(false, 0);
+				busy.recordAcquisition(true, 5'000);
+				busy.recordAcquisition(true, 1'000);
+				busy.recordHold(2'000);
+
+				// Sampled acquisitions stand in for the ones that weren't measured.
+				LockProfiler::setSampleInterval(4);
+				busy.recordAcquisition(false, 0);
+
+				const std::vector<LockProfiler::Entry> entries = LockProfiler::snapshot();
+				auto find = [&](std::string_view name) {
+					return std::find_if(entries.begin(), entries.end(), [&](const LockProfiler::Entry &entry) { return entry.name == name; });
+				};
+
+				auto quiet_entry = find("test/quiet");
+				auto busy_entry = find("test/busy");
+				if (context.expectEqual("both sites reported", quiet_entry != entries.end() && busy_entry != entries.end(), true)) {
+					context.expectEqual("ranked by wait", busy_entry < quiet_entry, true);
+					context.expectEqual("quiet acquisitions", quiet_entry->acquisitions, uint64_t(2));
+					context.expectEqual("busy acquisitions", busy_entry->acquisitions, uint64_t(6));
+					context.expectEqual("busy contended", busy_entry->contended, uint64_t(2));
+					context.expectEqual("busy wait", busy_entry->waitNanos, uint64_t(6'000));
+					context.expectEqual("busy max wait", busy_entry->maxWaitNanos, uint64_t(5'000));
+					context.expectEqual("busy hold", busy_entry->holdNanos, uint64_t(2'000));
+				}
+
+				// With an interval of 3, exactly one in three acquisitions on a thread is sampled.
+				LockProfiler::setSampleInterval(3);
+				while (!LockProfiler::shouldSample());
+				size_t sampled = 0;
+				for (int i = 0; i < 30; ++i) {
+					sampled += LockProfiler::shouldSample();
+				}
+				context.expectEqual("sampling rate", sampled, 10uz);
+
+				LockProfiler::reset();
+				context.expectEqual("reset", busy.acquisitions.load(), uint64_t(0));
+				LockProfiler::setSampleInterval(old_interval);
+			}
+	};
+
+	static auto added = addTest<LockProfilerTest>();
+}
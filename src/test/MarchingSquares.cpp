@@ -0,0 +1,49 @@
+#include "algorithm/MarchingSquares.h"
+#include "test/Testing.h"
+
+#include <random>
+#include <vector>
+
+namespace Game3 {
+	class MarchChunkTest: public Test {
+		public:
+			static Identifier ID() { return "base:test/algorithm/march_chunk"; }
+
+			MarchChunkTest() = default;
+
+			void operator()(TestContext &context) {
+				std::default_random_engine rng(1621);
+				std::bernoulli_distribution coin(0.6);
+
+				std::vector<uint8_t> padded(PADDED_CHUNK_SIZE * PADDED_CHUNK_SIZE);
+				for (uint8_t &flag: padded) {
+					flag = coin(rng);
+				}
+
+				auto get = [&](int64_t row, int64_t column) {
+					return [&, row, column](int8_t row_offset, int8_t column_offset) -> bool {
+						return padded[(row + 1 + row_offset) * PADDED_CHUNK_SIZE + column + 1 + column_offset] != 0;
+					};
+				};
+
+				std::vector<uint8_t> marched4(CHUNK_SIZE * CHUNK_SIZE);
+				std::vector<uint8_t> marched8(CHUNK_SIZE * CHUNK_SIZE);
+				march4Chunk(padded, marched4);
+				march8Chunk(padded, marched8);
+
+				size_t mismatches = 0;
+
+				for (int64_t row = 0; row < CHUNK_SIZE; ++row) {
+					for (int64_t column = 0; column < CHUNK_SIZE; ++column) {
+						const size_t index = row * CHUNK_SIZE + column;
+						mismatches += march4(get(row, column)) != marched4[index];
+						mismatches += march8(get(row, column)) != marched8[index];
+					}
+				}
+
+				context.expectEqual(mismatches, 0uz);
+			}
+	};
+
+	static auto added = addTest<MarchChunkTest>();
+}
@@ -0,0 +1,39 @@
+#include "test/Testing.h"
+#include "util/MemoryStats.h"
+
+namespace Game3 {
+	class MemoryStatsTest: public Test {
+		public:
+			static Identifier ID() { return "base:test/util/memory_stats"; }
+
+			MemoryStatsTest() = default;
+
+			void operator()(TestContext &context) {
+				MemoryStats stats;
+
+				stats.add(MemorySubsystem::Network, 300);
+				stats.add(MemorySubsystem::Network, 200);
+				stats.subtract(MemorySubsystem::Network, 400);
+				context.expectEqual("counted bytes", stats.get(MemorySubsystem::Network), uint64_t(100));
+				context.expectEqual("peak bytes", stats.snapshot().at(size_t(MemorySubsystem::Network)).peakBytes, uint64_t(500));
+
+				stats.set(MemorySubsystem::Chunks, 2048);
+				stats.setBudget(MemorySubsystem::Chunks, 1024);
+				context.expectEqual("first crossing warns", stats.checkBudgets().size(), 1uz);
+				context.expectEqual("staying over doesn't warn again", stats.checkBudgets().size(), 0uz);
+				stats.set(MemorySubsystem::Chunks, 512);
+				context.expectEqual("under budget", stats.checkBudgets().size(), 0uz);
+				stats.set(MemorySubsystem::Chunks, 4096);
+				context.expectEqual("crossing again warns", stats.checkBudgets().size(), 1uz);
+
+				context.expectEqual("subsystem names", MemoryStats::parseSubsystem(MemoryStats::getName(MemorySubsystem::ItemData)), std::optional(MemorySubsystem::ItemData));
+
+				const std::string long_string(100, 'x');
+				boost::json::value json{{"name", long_string}, {"list", boost::json::array{1, 2, 3}}};
+				context.expectEqual("JSON estimate covers its strings", long_string.size() < MemoryStats::estimate(json), true);
+				context.expectEqual("scalars own nothing", MemoryStats::estimate(boost::json::value(42)), 0uz);
+			}
+	};
+
+	static auto added = addTest<MemoryStatsTest>();
+}
@@ -0,0 +1,83 @@
+#include "entity/Chicken.h"
+#include "game/ServerGame.h"
+#include "graphics/Tileset.h"
+#include "net/CertGen.h"
+#include "net/Server.h"
+#include "realm/Realm.h"
+#include "test/Testing.h"
+#include "tileentity/TileEntity.h"
+#include "util/Crypto.h"
+#include "util/Defer.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <format>
+#include <random>
+
+namespace Game3 {
+	class PagingTest: public Test {
+		public:
+			static Identifier ID() { return "base:test/realm/paging"; }
+
+			PagingTest() = default;
+
+			void operator()(TestContext &context) {
+				const std::filesystem::path root = std::filesystem::temp_directory_path() / std::format("game3-paging-test-{}", std::random_device{}());
+				std::filesystem::create_directories(root);
+				// Declared first so that it runs after the game has closed its database.
+				Defer cleanup([&] { std::filesystem::remove_all(root); });
+
+				generateCertPair(root / "test.crt", root / "test.key");
+				ServerPtr server = Server::create("::1", 0, root / "test.crt", root / "test.key", generateSecret(8), 1);
+				auto game = std::dynamic_pointer_cast<ServerGame>(Game::create(Side::Server, std::make_pair(server, 1uz)));
+				game->openDatabase(root / "world.game3");
+				server->weakGame = game;
+				game->initialWorldgen(1621);
+				game->initEntities();
+
+				Defer release([&] {
+					server->weakGame.reset();
+					game.reset();
+					server.reset();
+				});
+
+				RealmPtr realm = game->getRealm(1);
+				const Tileset &tileset = realm->getTileset();
+				const ChunkPosition far_chunk{1, 0};
+				const Index row = 10;
+				const Index first_column = CHUNK_SIZE - 2;
+				const Index last_column = CHUNK_SIZE + 1;
+
+				// Clear a corridor that crosses from chunk (0, 0) into chunk (1, 0).
+				for (Index column = first_column; column <= last_column; ++column) {
+					const Position position{row, column};
+					for (const Layer layer: {Layer::Submerged, Layer::Objects, Layer::Highest}) {
+						realm->setTile(layer, position, tileset.getEmptyID(), false);
+					}
+					if (TileEntityPtr tile_entity = realm->tileEntityAt(position)) {
+						realm->remove(tile_entity, false);
+					}
+				}
+
+				auto chicken = Chicken::create(game);
+				chicken->init(game);
+				realm->add(chicken, Position{row, first_column});
+
+				const auto pageable = realm->getPageableChunks();
+				context.expectEqual("chunks next to agents aren't pageable", std::ranges::none_of(pageable, [&](const auto &pair) { return pair.second == far_chunk; }), true);
+
+				realm->pageOut(far_chunk);
+				context.expectEqual("chunk is paged out", realm->isPagedOut(far_chunk), true);
+
+				for (Index column = first_column; column < last_column; ++column) {
+					chicken->offset = Vector3{};
+					chicken->move(Direction::Right);
+				}
+
+				context.expectEqual("entity crosses into a paged-out chunk", chicken->getPosition(), Position{row, last_column});
+				context.expectEqual("moving pages the chunk back in", realm->isPagedOut(far_chunk), false);
+			}
+	};
+
+	static auto added = addTest<PagingTest>();
+}
@@ -0,0 +1,61 @@
+#include "entity/ParticleSystem.h"
+#include "test/Testing.h"
+
+namespace Game3 {
+	class ParticleSystemTest: public Test {
+		public:
+			static Identifier ID() { return "base:test/entity/particle_system"; }
+
+			ParticleSystemTest() = default;
+
+			void operator()(TestContext &context) {
+				constexpr float DELTA = 1.f / 64.f;
+
+				ParticleSystem particles;
+				// Rises and falls for about half a second before landing, then lingers for a second.
+				particles.spawn({.x = 10, .y = 20, .velocityX = 4, .velocityZ = 8, .lingerTime = 1});
+				// Starts on the ground and is gone as soon as it's had a tenth of a second there.
+				particles.spawn({.lingerTime = 0.1});
+				context.expectEqual("pending squares aren't simulated", particles.size(), 0uz);
+
+				particles.step(DELTA);
+				context.expectEqual("both squares joined", particles.size(), 2uz);
+
+				for (int i = 1; i < 8; ++i) {
+					particles.step(DELTA);
+				}
+				context.expectEqual("the grounded square retired", particles.size(), 1uz);
+
+				for (int i = 8; i < 64; ++i) {
+					particles.step(DELTA);
+				}
+				context.expectEqual("the thrown square is still lingering", particles.size(), 1uz);
+
+				for (int i = 64; i < 96; ++i) {
+					particles.step(DELTA);
+				}
+				context.expectEqual("the thrown square retired", particles.size(), 0uz);
+
+				// Check the kernel directly: a landed square stops moving and doesn't sink below its depth.
+				ParticleSystem::Arrays arrays;
+				arrays.push({.x = 1, .y = 2, .velocityX = 4, .velocityZ = 8, .depth = -0.25f});
+				for (int i = 0; i < 64; ++i) {
+					ParticleSystem::simulate(arrays, DELTA);
+				}
+				context.expectEqual("landed at its depth", arrays.z[0], -0.25f);
+				context.expectEqual("stopped moving", arrays.velocityX[0], 0.f);
+				context.report("travelled while airborne", 1 < arrays.x[0] - 1 && arrays.x[0] - 1 < 4);
+				context.report("aged only on the ground", 0 < arrays.age[0] && arrays.age[0] < 64 * DELTA);
+
+				arrays.resize(0);
+				arrays.push({.x = 7, .lingerTime = 100});
+				arrays.push({.lingerTime = 0});
+				arrays.push({.x = 9, .lingerTime = 100});
+				arrays.push({.lingerTime = 0});
+				context.expectEqual("retired the expired squares", ParticleSystem::retire(arrays), 2uz);
+				context.report("kept the others", arrays.size() == 2 && arrays.x[0] == 7 && arrays.x[1] == 9);
+			}
+	};
+
+	static auto added = addTest<ParticleSystemTest>();
+}
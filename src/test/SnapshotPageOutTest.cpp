@@ -0,0 +1,86 @@
+#include "data/ChunkSet.h"
+#include "data/GameDB.h"
+#include "game/ServerGame.h"
+#include "game/TileProvider.h"
+#include "graphics/Tileset.h"
+#include "net/CertGen.h"
+#include "net/Server.h"
+#include "realm/Realm.h"
+#include "test/Testing.h"
+#include "util/Crypto.h"
+#include "util/Defer.h"
+
+#include <filesystem>
+#include <format>
+#include <random>
+
+namespace Game3 {
+	class SnapshotPageOutTest: public Test {
+		public:
+			static Identifier ID() { return "base:test/data/snapshot_page_out"; }
+
+			SnapshotPageOutTest() = default;
+
+			void operator()(TestContext &context) {
+				const std::filesystem::path root = std::filesystem::temp_directory_path() / std::format("game3-snapshot-test-{}", std::random_device{}());
+				std::filesystem::create_directories(root);
+				// Declared first so that it runs after the game has closed its database.
+				Defer cleanup([&] { std::filesystem::remove_all(root); });
+
+				generateCertPair(root / "test.crt", root / "test.key");
+				ServerPtr server = Server::create("::1", 0, root / "test.crt", root / "test.key", generateSecret(8), 1);
+				auto game = std::dynamic_pointer_cast<ServerGame>(Game::create(Side::Server, std::make_pair(server, 1uz)));
+				game->openDatabase(root / "world.game3");
+				server->weakGame = game;
+				game->initialWorldgen(1621);
+				game->initEntities();
+
+				Defer release([&] {
+					server->weakGame.reset();
+					game.reset();
+					server.reset();
+				});
+
+				GameDB &database = game->getDatabase();
+				RealmPtr realm = game->getRealm(1);
+				const Tileset &tileset = realm->getTileset();
+				const TileID before = tileset.getEmptyID();
+				const TileID after = tileset["base:tile/grimstone"];
+
+				// One tile in a chunk that stays resident and one in a chunk that gets paged out.
+				const ChunkPosition resident_chunk{0, 0};
+				const ChunkPosition paged_chunk{1, 0};
+				const Position resident_position{5, 5};
+				const Position paged_position{5, CHUNK_SIZE + 5};
+
+				realm->setTile(Layer::Objects, resident_position, before, false);
+				realm->setTile(Layer::Objects, paged_position, before, false);
+
+				const RealmSnapshot snapshot = database.snapshotRealm(realm);
+
+				// Ticking would have resumed here. The page-out writes the newer tile before the snapshot is written.
+				realm->setTile(Layer::Objects, resident_position, after, false);
+				realm->setTile(Layer::Objects, paged_position, after, false);
+				realm->pageOut(paged_chunk);
+
+				database.writeSnapshot(snapshot);
+
+				auto stored_tile = [&](ChunkPosition chunk_position, const Position &position) -> TileID {
+					std::optional<ChunkSet> chunk_set = database.getChunk(realm->getID(), chunk_position);
+					if (!chunk_set) {
+						return TileID(-1);
+					}
+					const TileChunk &objects = chunk_set->terrain.at(getIndex(Layer::Objects));
+					return TileProvider::access(objects, position.row % CHUNK_SIZE, position.column % CHUNK_SIZE);
+				};
+
+				context.expectEqual("resident chunks are written as snapshotted", stored_tile(resident_chunk, resident_position), before);
+				context.expectEqual("a page-out after the snapshot isn't overwritten", stored_tile(paged_chunk, paged_position), after);
+
+				realm->ensureResident(paged_chunk);
+				context.expectEqual("the chunk pages back in with the newer tile", realm->getTile(Layer::Objects, paged_position), after);
+			}
+	};
+
+	static auto added = addTest<SnapshotPageOutTest>();
+}
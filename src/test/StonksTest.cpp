@@ -0,0 +1,85 @@
+#include "algorithm/Stonks.h"
+#include "test/Testing.h"
+
+#include <cmath>
+
+namespace Game3 {
+	namespace {
+		constexpr double E = 2.71828182845904523536;
+
+		/** The per-unit price as Stonks computed it before its exponentials were tabulated. */
+		double referenceBuyPrice(double base_price, ItemCount item_count, MoneyCount merchant_money) {
+			if (merchant_money != MoneyCount(-1)) {
+				base_price /= pow(E, merchant_money / 50.);
+			}
+			return base_price / pow(E, item_count / 100.);
+		}
+
+		std::optional<MoneyCount> referenceSellPrice(ItemCount merchant_count, MoneyCount merchant_money, double base_price, ItemCount count, double greed) {
+			double price = 0.;
+			double money = merchant_money == MoneyCount(-1)? -1 : double(merchant_money);
+
+			while (1 <= count) {
+				const double unit_price = referenceBuyPrice(base_price, merchant_count++, money < 0? MoneyCount(-1) : MoneyCount(money)) / (1. + greed);
+				if (0 <= money) {
+					money -= unit_price;
+					if (money < 0) {
+						return std::nullopt;
+					}
+				}
+				price += unit_price;
+				--count;
+			}
+
+			return MoneyCount(std::floor(price));
+		}
+
+		std::optional<MoneyCount> referenceBuyPrice(ItemCount merchant_count, MoneyCount merchant_money, double base_price, ItemCount count) {
+			double price = 0.;
+			double money(merchant_money);
+
+			while (1 <= count) {
+				if (merchant_count == 0) {
+					return std::nullopt;
+				}
+				const double unit_price = referenceBuyPrice(base_price, merchant_count--, money < 0? MoneyCount(-1) : MoneyCount(money));
+				if (0 <= money) {
+					money += unit_price;
+				}
+				price += unit_price;
+				--count;
+			}
+
+			return std::ceil(price);
+		}
+	}
+
+	class StonksTest: public Test {
+		public:
+			static Identifier ID() { return "base:test/algorithm/stonks"; }
+
+			StonksTest() = default;
+
+			void operator()(TestContext &context) {
+				size_t mismatches = 0;
+
+				// Merchant counts on both sides of the lookup tables' bounds.
+				for (ItemCount merchant_count: {0, 1, 17, 250, 1000, 8100, 8191, 8192, 9000}) {
+					for (ItemCount count: {0, 1, 2, 64, 200}) {
+						for (double base_price: {1., 7.5, 120.}) {
+							for (MoneyCount money: {MoneyCount(-1), MoneyCount(0), MoneyCount(100), MoneyCount(5000), MoneyCount(10000)}) {
+								for (double greed: {0., 0.15}) {
+									mismatches += totalSellPrice(merchant_count, money, base_price, count, greed) != referenceSellPrice(merchant_count, money, base_price, count, greed);
+								}
+								mismatches += totalBuyPrice(merchant_count, money, base_price, count) != referenceBuyPrice(merchant_count, money, base_price, count);
+							}
+						}
+					}
+				}
+
+				context.expectEqual(mismatches, 0uz);
+			}
+	};
+
+	static auto added = addTest<StonksTest>();
+}
@@ -0,0 +1,206 @@
+#include "threading/LockProfiler.h"
+#include "util/PairHash.h"
+
+#include <algorithm>
+#include <chrono>
+#include <format>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include <utility>
+
+namespace Game3 {
+	namespace {
+		// These use plain standard mutexes so that the profiler never measures itself.
+		std::shared_mutex registryMutex;
+		std::unordered_map<std::string, std::unique_ptr<LockProfiler::Site>> sitesByName;
+		std::unordered_map<std::pair<const char *, uint32_t>, LockProfiler::Site *, PairHash<const char *, uint32_t>> sitesByLocation;
+
+		thread_local std::optional<LockProfiler::Site *> nextSite;
+		thread_local uint32_t sampleCountdown = 0;
+
+		void updateMax(std::atomic<uint64_t> &max, uint64_t value) {
+			uint64_t previous = max.load(std::memory_order_relaxed);
+			while (previous < value && !max.compare_exchange_weak(previous, value, std::memory_order_relaxed));
+		}
+
+		std::string formatLocation(const std::source_location &location) {
+			std::string_view file = location.file_name();
+			// Absolute paths from the build machine only get in the way.
+			for (std::string_view root: {"/src/", "/include/"}) {
+				if (size_t index = file.rfind(root); index != std::string_view::npos) {
+					file.remove_prefix(index + 1);
+					break;
+				}
+			}
+			return std::format("{}:{}", file, location.line());
+		}
+
+		std::string formatNanos(uint64_t nanos) {
+			if (nanos < 10'000) {
+				return std::format("{}ns", nanos);
+			}
+
+			if (nanos < 10'000'000) {
+				return std::format("{:.1f}us", nanos / 1e3);
+			}
+
+			return std::format("{:.1f}ms", nanos / 1e6);
+		}
+	}
+
+	std::atomic<uint32_t> LockProfiler::sampleInterval{1};
+
+	LockProfiler::Site::Site(std::string name):
+		name(std::move(name)) {}
+
+	void LockProfiler::Site::recordAcquisition(bool was_contended, uint64_t wait_nanos) {
+		const uint64_t weight = getSampleInterval();
+		acquisitions.fetch_add(weight, std::memory_order_relaxed);
+		if (was_contended) {
+			contended.fetch_add(weight, std::memory_order_relaxed);
+			waitNanos.fetch_add(weight * wait_nanos, std::memory_order_relaxed);
+			updateMax(maxWaitNanos, wait_nanos);
+		}
+	}
+
+	void LockProfiler::Site::recordHold(uint64_t hold_nanos) {
+		const uint64_t weight = getSampleInterval();
+		holds.fetch_add(weight, std::memory_order_relaxed);
+		holdNanos.fetch_add(weight * hold_nanos, std::memory_order_relaxed);
+		updateMax(maxHoldNanos, hold_nanos);
+	}
+
+	LockProfiler::Site & LockProfiler::getSite(const std::source_location &location) {
+		const std::pair<const char *, uint32_t> key{location.file_name(), location.line()};
+
+		{
+			std::shared_lock lock(registryMutex);
+			if (auto iter = sitesByLocation.find(key); iter != sitesByLocation.end()) {
+				return *iter->second;
+			}
+		}
+
+		Site &site = getSite(formatLocation(location));
+		std::unique_lock lock(registryMutex);
+		sitesByLocation.emplace(key, &site);
+		return site;
+	}
+
+	LockProfiler::Site & LockProfiler::getSite(std::string_view name) {
+		{
+			std::shared_lock lock(registryMutex);
+			if (auto iter = sitesByName.find(std::string(name)); iter != sitesByName.end()) {
+				return *iter->second;
+			}
+		}
+
+		std::unique_lock lock(registryMutex);
+		auto [iter, inserted] = sitesByName.try_emplace(std::string(name));
+		if (inserted) {
+			iter->second = std::make_unique<Site>(std::string(name));
+		}
+		return *iter->second;
+	}
+
+	void LockProfiler::setNextSite(Site *site) {
+		nextSite = site;
+	}
+
+	std::optional<LockProfiler::Site *> LockProfiler::takeNextSite() {
+		return std::exchange(nextSite, std::nullopt);
+	}
+
+	void LockProfiler::setSampleInterval(uint32_t interval) {
+		sampleInterval = std::max(interval, 1u);
+	}
+
+	uint32_t LockProfiler::getSampleInterval() {
+		return sampleInterval.load(std::memory_order_relaxed);
+	}
+
+	bool LockProfiler::shouldSample() {
+		if (sampleCountdown == 0) {
+			sampleCountdown = getSampleInterval() - 1;
+			return true;
+		}
+
+		--sampleCountdown;
+		return false;
+	}
+
+	std::vector<LockProfiler::Entry> LockProfiler::snapshot() {
+		std::vector<Entry> entries;
+
+		{
+			std::shared_lock lock(registryMutex);
+			entries.reserve(sitesByName.size());
+			for (const auto &[name, site]: sitesByName) {
+				entries.push_back(Entry{
+					.name = name,
+					.acquisitions = site->acquisitions.load(std::memory_order_relaxed),
+					.contended = site->contended.load(std::memory_order_relaxed),
+					.waitNanos = site->waitNanos.load(std::memory_order_relaxed),
+					.maxWaitNanos = site->maxWaitNanos.load(std::memory_order_relaxed),
+					.holds = site->holds.load(std::memory_order_relaxed),
+					.holdNanos = site->holdNanos.load(std::memory_order_relaxed),
+					.maxHoldNanos = site->maxHoldNanos.load(std::memory_order_relaxed),
+				});
+			}
+		}
+
+		std::sort(entries.begin(), entries.end(), [](const Entry &left, const Entry &right) {
+			if (left.waitNanos != right.waitNanos) {
+				return left.waitNanos > right.waitNanos;
+			}
+			return left.acquisitions > right.acquisitions;
+		});
+
+		return entries;
+	}
+
+	std::string LockProfiler::report(size_t limit) {
+		std::vector<Entry> entries = snapshot();
+		if (limit < entries.size()) {
+			entries.resize(limit);
+		}
+
+		size_t name_width = 4;
+		for (const Entry &entry: entries) {
+			name_width = std::max(name_width, entry.name.size());
+		}
+
+		std::string out = std::format("{:<{}}  {:>12}  {:>9}  {:>10}  {:>10}  {:>10}  {:>10}\n", "Site", name_width, "Acquisitions", "Contended", "Total wait", "Max wait", "Avg hold", "Max hold");
+
+		for (const Entry &entry: entries) {
+			const double contended_percent = entry.acquisitions == 0? 0. : 100. * entry.contended / entry.acquisitions;
+			const uint64_t average_hold = entry.holds == 0? 0 : entry.holdNanos / entry.holds;
+			out += std::format("{:<{}}  {:>12}  {:>8.2f}%  {:>10}  {:>10}  {:>10}  {:>10}\n", entry.name, name_width, entry.acquisitions, contended_percent,
+				formatNanos(entry.waitNanos), formatNanos(entry.maxWaitNanos), formatNanos(average_hold), formatNanos(entry.maxHoldNanos));
+		}
+
+		if (const uint32_t interval = getSampleInterval(); 1 < interval) {
+			out += std::format("(Sampling 1 in {} acquisitions; totals are estimates.)\n", interval);
+		}
+
+		return out;
+	}
+
+	void LockProfiler::reset() {
+		std::shared_lock lock(registryMutex);
+		for (const auto &[name, site]: sitesByName) {
+			site->acquisitions = 0;
+			site->contended = 0;
+			site->waitNanos = 0;
+			site->maxWaitNanos = 0;
+			site->holds = 0;
+			site->holdNanos = 0;
+			site->maxHoldNanos = 0;
+		}
+	}
+
+	uint64_t LockProfiler::now() {
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+}
@@ -4,6 +4,10 @@ namespace Game3 {
 	constexpr static bool uniqueOnly = false;
 
 	void SharedRecursiveMutex::lock() {
+#ifdef GAME3_LOCK_PROFILING
+		LockProfiler::Site *site = pickSite();
+#endif
+
 		if constexpr (uniqueOnly) {
 			std::recursive_mutex::lock();
 			return;
@@ -15,13 +19,32 @@ namespace Game3 {
 			++count;
 		} else {
 			// normal locking
+#ifdef GAME3_LOCK_PROFILING
+			if (site) {
+				const uint64_t start = LockProfiler::now();
+				const bool contended = !std::shared_mutex::try_lock();
+				if (contended) {
+					std::shared_mutex::lock();
+				}
+				acquiredAt = LockProfiler::now();
+				holdSite = site;
+				site->recordAcquisition(contended, acquiredAt - start);
+			} else {
+				std::shared_mutex::lock();
+			}
+#else
 			std::shared_mutex::lock();
+#endif
 			owner = this_id;
 			count = 1;
 		}
 	}
 
 	void SharedRecursiveMutex::lock_shared() {
+#ifdef GAME3_LOCK_PROFILING
+		LockProfiler::Site *site = pickSite();
+#endif
+
 		if constexpr (uniqueOnly) {
 			std::recursive_mutex::lock();
 			return;
@@ -29,6 +52,18 @@ namespace Game3 {
 
 		// This is not ideal!
 		if (owner != std::this_thread::get_id()) {
+#ifdef GAME3_LOCK_PROFILING
+			// Shared holds overlap, so only waits are measured for them.
+			if (site) {
+				const uint64_t start = LockProfiler::now();
+				const bool contended = !std::shared_mutex::try_lock_shared();
+				if (contended) {
+					std::shared_mutex::lock_shared();
+				}
+				site->recordAcquisition(contended, LockProfiler::now() - start);
+				return;
+			}
+#endif
 			std::shared_mutex::lock_shared();
 		}
 	}
@@ -53,6 +88,12 @@ namespace Game3 {
 
 		if (count.fetch_sub(1) == 1) {
 			// normal unlocking
+#ifdef GAME3_LOCK_PROFILING
+			if (holdSite) {
+				holdSite->recordHold(LockProfiler::now() - acquiredAt);
+				holdSite = nullptr;
+			}
+#endif
 			owner = std::thread::id();
 			count = 0;
 			std::shared_mutex::unlock();
@@ -94,4 +135,30 @@ namespace Game3 {
 
 		return false;
 	}
+
+	void SharedRecursiveMutex::setName([[maybe_unused]] std::string_view name) {
+#ifdef GAME3_LOCK_PROFILING
+		namedSite = &LockProfiler::getSite(name);
+#endif
+	}
+
+#ifdef GAME3_LOCK_PROFILING
+	LockProfiler::Site * SharedRecursiveMutex::pickSite() const {
+		// A call site chosen by Lockable takes precedence; it has already been through sampling.
+		if (std::optional<LockProfiler::Site *> site = LockProfiler::takeNextSite()) {
+			return *site;
+		}
+
+		if (!LockProfiler::shouldSample()) {
+			return nullptr;
+		}
+
+		if (namedSite) {
+			return namedSite;
+		}
+
+		static LockProfiler::Site &unnamed = LockProfiler::getSite("(unnamed SharedRecursiveMutex)");
+		return &unnamed;
+	}
+#endif
 }
@@ -65,7 +65,9 @@ namespace Game3 {
 		return 0.1;
 	}
 
+#ifndef GAME3_HEADLESS
 	void Tile::renderStaticLighting(const Place &, Layer, const RendererContext &) {}
+#endif
 
 	bool Tile::hasStaticLighting() const {
 		return false;
@@ -1,8 +1,5 @@
 #include "util/Log.h"
 #include "entity/Player.h"
-#include "graphics/CircleRenderer.h"
-#include "graphics/RendererContext.h"
-#include "graphics/RenderOptions.h"
 #include "graphics/Tileset.h"
 #include "realm/Realm.h"
 #include "threading/ThreadContext.h"
@@ -10,10 +7,17 @@
 #include "types/Position.h"
 #include "util/Util.h"
 
+#ifndef GAME3_HEADLESS
+#include "graphics/CircleRenderer.h"
+#include "graphics/RendererContext.h"
+#include "graphics/RenderOptions.h"
+#endif
+
 namespace Game3 {
 	TorchTile::TorchTile():
 		Tile(ID()) {}
 
+#ifndef GAME3_HEADLESS
 	void TorchTile::renderStaticLighting(const Place &place, Layer, const RendererContext &context) {
 		assert(place.realm->isClient());
 		const size_t tile_size = place.realm->getTileset().getTileSize();
@@ -31,4 +35,5 @@ namespace Game3 {
 
 		context.circle.drawOnScreen(Color{1, 1, 0.5, 1}, left, top, radius, radius, 0.2);
 	}
+#endif
 }
@@ -1,17 +1,21 @@
 #include <iostream>
 
+#include "game/Game.h"
 #include "graphics/Tileset.h"
 #include "entity/Player.h"
-#include "game/ClientGame.h"
-#include "graphics/SpriteRenderer.h"
-#include "minigame/MinigameFactory.h"
 #include "packet/OpenMinigamePacket.h"
 #include "realm/Realm.h"
 #include "tileentity/ArcadeMachine.h"
+
+#ifndef GAME3_HEADLESS
+#include "game/ClientGame.h"
+#include "graphics/SpriteRenderer.h"
+#include "minigame/MinigameFactory.h"
 #include "ui/dialog/MinigameDialog.h"
 #include "ui/widget/Tooltip.h"
 #include "ui/GameUI.h"
 #include "ui/Window.h"
+#endif
 
 namespace Game3 {
 	ArcadeMachine::ArcadeMachine(Identifier tilename, Position position, Identifier minigame_name, int game_width, int game_height):
@@ -25,6 +29,7 @@ namespace Game3 {
 		return true;
 	}
 
+#ifndef GAME3_HEADLESS
 	bool ArcadeMachine::mouseOver() {
 		WindowPtr window = getGame()->toClient().getWindow();
 		auto tooltip = window->uiContext.getTooltip();
@@ -48,6 +53,7 @@ namespace Game3 {
 			tooltip->hide();
 		}
 	}
+#endif
 
 	void ArcadeMachine::encode(Game &game, Buffer &buffer) {
 		TileEntity::encode(game, buffer);
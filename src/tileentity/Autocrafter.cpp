@@ -4,14 +4,17 @@
 #include "game/InventorySpan.h"
 #include "game/ServerInventory.h"
 #include "graphics/ItemTexture.h"
-#include "graphics/SpriteRenderer.h"
 #include "graphics/Tileset.h"
 #include "item/Furniture.h"
 #include "lib/JSON.h"
 #include "packet/OpenModuleForAgentPacket.h"
 #include "recipe/CraftingRecipe.h"
 #include "tileentity/Autocrafter.h"
-#include "ui/module/AutocrafterModule.h"
+#include "ui/module/ModuleIDs.h"
+
+#ifndef GAME3_HEADLESS
+#include "graphics/SpriteRenderer.h"
+#endif
 
 namespace Game3 {
 	namespace {
@@ -76,8 +79,15 @@ namespace Game3 {
 
 		Ticker ticker{*this, args};
 
-		autocraft();
-		enqueueTick(PERIOD);
+		if (energyContainer->copyEnergy() < ENERGY_PER_ACTION) {
+			sleepUntilEnergy(ENERGY_PER_ACTION, PERIOD);
+			return;
+		}
+
+		if (autocraft())
+			enqueueTick(PERIOD);
+		else
+			sleepUntil(WakeCondition::Inventory, PERIOD);
 	}
 
 	bool Autocrafter::onInteractNextTo(const PlayerPtr &player, Modifiers modifiers, const ItemStackPtr &, Hand) {
@@ -107,7 +117,7 @@ namespace Game3 {
 		if (modifiers.onlyShift()) {
 			EnergeticTileEntity::addObserver(player, false);
 		} else {
-			player->send(make<OpenModuleForAgentPacket>(AutocrafterModule::ID(), getGID()));
+			player->send(make<OpenModuleForAgentPacket>(ModuleID::autocrafter(), getGID()));
 			InventoriedTileEntity::addObserver(player, true);
 		}
 
@@ -115,6 +125,7 @@ namespace Game3 {
 		return true;
 	}
 
+#ifndef GAME3_HEADLESS
 	void Autocrafter::render(SpriteRenderer &sprite_renderer) {
 		if (!isVisible())
 			return;
@@ -217,6 +228,7 @@ namespace Game3 {
 			.sizeY = float(tilesize),
 		});
 	}
+#endif
 
 	void Autocrafter::toJSON(boost::json::value &json) const {
 		TileEntity::toJSON(json);
@@ -303,22 +315,26 @@ namespace Game3 {
 			} catch (const std::invalid_argument &) {}
 
 			if (source)
-				sendMessage(source, "ModuleMessage", AutocrafterModule::ID(), "TargetSet", success, new_target);
+				sendMessage(source, "ModuleMessage", ModuleID::autocrafter(), "TargetSet", success, new_target);
 
 		} else {
 			TileEntity::handleMessage(source, name, data);
 		}
 	}
 
-	void Autocrafter::autocraft() {
+	bool Autocrafter::autocraft() {
 		if (energyContainer->copyEnergy() < ENERGY_PER_ACTION)
-			return;
+			return false;
 
 		auto recipes_lock = cachedRecipes.sharedLock();
 		if (cachedRecipes.empty())
-			return;
+			return false;
 
 		InventoryPtr inventory = getInventory(0);
+		const uint64_t revision = inventory->getRevision();
+		if (revision == idleRevision)
+			return false;
+
 		const ItemCount input_capacity = INPUT_CAPACITY;
 		auto input_span = std::make_shared<InventorySpan>(inventory, 0, input_capacity - 1);
 		auto output_span = std::make_shared<InventorySpan>(inventory, input_capacity, input_capacity + OUTPUT_CAPACITY - 1);
@@ -329,21 +345,29 @@ namespace Game3 {
 			if (recipe->craft(game, input_span, output_span, leftovers)) {
 				auto energy_lock = energyContainer->sharedLock();
 				energyContainer->remove(ENERGY_PER_ACTION, true);
-				return;
+				return true;
 			}
 		}
+
+		// Failed crafts don't modify the inventory, so nothing will be craftable until something else changes it.
+		idleRevision = revision;
+		return false;
 	}
 
 	bool Autocrafter::setTarget(Identifier new_target) {
 		target = std::move(new_target);
 		cacheRecipes();
+		wake();
 		return true;
 	}
 
 	void Autocrafter::cacheRecipes() {
 		auto lock = cachedRecipes.uniqueLock();
 		cachedRecipes.clear();
-		for (const std::shared_ptr<CraftingRecipe> &recipe: getGame()->registry<CraftingRecipeRegistry>())
+		idleRevision = -1;
+
+		auto &registry = getGame()->registry<CraftingRecipeRegistry>();
+		for (const std::shared_ptr<CraftingRecipe> &recipe: registry.getByOutput(target.copyBase()))
 			if (validateRecipe(*recipe))
 				cachedRecipes.push_back(recipe);
 	}
@@ -368,10 +392,14 @@ namespace Game3 {
 		}
 
 		cacheRecipes();
+		wake();
 		return out;
 	}
 
 	void Autocrafter::setStationTexture(const ItemStackPtr &stack) {
+#ifdef GAME3_HEADLESS
+		(void) stack;
+#else
 		GamePtr game = getGame();
 		if (game->getSide() != Side::Client)
 			return;
@@ -382,6 +410,7 @@ namespace Game3 {
 		stationYOffset = item_texture->y / 2.f;
 		stationSizeX   = float(item_texture->width);
 		stationSizeY   = float(item_texture->height);
+#endif
 	}
 
 	void Autocrafter::resetStationTexture() {
@@ -1,18 +1,22 @@
 #include "util/Log.h"
 #include "entity/Player.h"
-#include "game/ClientGame.h"
 #include "game/Crop.h"
 #include "game/EnergyContainer.h"
+#include "game/Game.h"
 #include "game/InventorySpan.h"
 #include "game/ServerInventory.h"
-#include "graphics/SpriteRenderer.h"
 #include "graphics/Tileset.h"
 #include "item/Plantable.h"
 #include "packet/OpenModuleForAgentPacket.h"
 #include "realm/Realm.h"
 #include "tile/CropTile.h"
 #include "tileentity/Autofarmer.h"
-#include "ui/module/MultiModule.h"
+#include "ui/module/ModuleIDs.h"
+
+#ifndef GAME3_HEADLESS
+#include "game/ClientGame.h"
+#include "graphics/SpriteRenderer.h"
+#endif
 
 namespace Game3 {
 	namespace {
@@ -72,7 +76,7 @@ namespace Game3 {
 			return true;
 		}
 
-		player->send(make<OpenModuleForAgentPacket>(MultiModule<Substance::Item, Substance::Energy>::ID(), getGID()));
+		player->send(make<OpenModuleForAgentPacket>(ModuleID::multi<Substance::Item, Substance::Energy>(), getGID()));
 		EnergeticTileEntity::addObserver(player, true);
 		InventoriedTileEntity::addObserver(player, true);
 
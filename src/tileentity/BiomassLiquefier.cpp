@@ -1,14 +1,18 @@
 #include "entity/Player.h"
-#include "game/ClientGame.h"
 #include "game/EnergyContainer.h"
+#include "game/Game.h"
 #include "game/ServerInventory.h"
-#include "graphics/SpriteRenderer.h"
 #include "graphics/Tileset.h"
 #include "packet/OpenModuleForAgentPacket.h"
 #include "realm/Realm.h"
 #include "recipe/BiomassLiquefierRecipe.h"
 #include "tileentity/BiomassLiquefier.h"
-#include "ui/module/MultiModule.h"
+#include "ui/module/ModuleIDs.h"
+
+#ifndef GAME3_HEADLESS
+#include "game/ClientGame.h"
+#include "graphics/SpriteRenderer.h"
+#endif
 
 namespace Game3 {
 	namespace {
@@ -99,7 +103,7 @@ namespace Game3 {
 			return true;
 		}
 
-		player->send(make<OpenModuleForAgentPacket>(MultiModule<Substance::Item, Substance::Energy, Substance::Fluid>::ID(), getGID()));
+		player->send(make<OpenModuleForAgentPacket>(ModuleID::multi<Substance::Item, Substance::Energy, Substance::Fluid>(), getGID()));
 		EnergeticTileEntity::addObserver(player, true);
 		FluidHoldingTileEntity::addObserver(player, true);
 		InventoriedTileEntity::addObserver(player, true);
@@ -1,12 +1,15 @@
 #include "entity/Player.h"
 #include "game/Game.h"
-#include "graphics/SpriteRenderer.h"
 #include "graphics/Tileset.h"
 #include "lib/JSON.h"
 #include "realm/Realm.h"
 #include "threading/ThreadContext.h"
 #include "tileentity/Building.h"
 
+#ifndef GAME3_HEADLESS
+#include "graphics/SpriteRenderer.h"
+#endif
+
 namespace Game3 {
 	Building::Building(Identifier id, Position position, RealmID innerRealmID, Position entrance, Identifier soundSetID):
 		TileEntity(std::move(id), ID(), position, true),
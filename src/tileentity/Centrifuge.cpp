@@ -1,13 +1,17 @@
 #include "entity/Player.h"
-#include "game/ClientGame.h"
+#include "game/Game.h"
 #include "game/ServerInventory.h"
-#include "graphics/SpriteRenderer.h"
 #include "graphics/Tileset.h"
 #include "packet/OpenModuleForAgentPacket.h"
 #include "realm/Realm.h"
 #include "recipe/CentrifugeRecipe.h"
 #include "tileentity/Centrifuge.h"
-#include "ui/module/MultiModule.h"
+#include "ui/module/ModuleIDs.h"
+
+#ifndef GAME3_HEADLESS
+#include "game/ClientGame.h"
+#include "graphics/SpriteRenderer.h"
+#endif
 
 namespace Game3 {
 	namespace {
@@ -41,22 +45,28 @@ namespace Game3 {
 		Ticker ticker{*this, args};
 		GamePtr game = args.getGame();
 
-		enqueueTick(PERIOD);
-
 		auto &levels = fluidContainer->levels;
 		auto fluids_lock = levels.uniqueLock();
 
-		if (levels.empty())
+		if (levels.empty()) {
+			sleepUntil(WakeCondition::Fluids, PERIOD);
 			return;
+		}
 
 		auto &registry = game->registry<CentrifugeRecipeRegistry>();
 
 		std::optional<ItemStackPtr> leftovers;
 		const InventoryPtr inventory = getInventory(0);
 		auto inventory_lock = inventory->uniqueLock();
-		for (const std::shared_ptr<CentrifugeRecipe> &recipe: registry.items)
-			if (recipe->craft(game, fluidContainer, inventory, leftovers))
+		for (const std::shared_ptr<CentrifugeRecipe> &recipe: registry.items) {
+			if (recipe->craft(game, fluidContainer, inventory, leftovers)) {
+				enqueueTick(PERIOD);
 				return;
+			}
+		}
+
+		// Either there isn't enough fluid or there's no room for the output.
+		sleepUntil(WakeCondition::Fluids | WakeCondition::Inventory, PERIOD);
 	}
 
 	void Centrifuge::toJSON(boost::json::value &json) const {
@@ -74,7 +84,7 @@ namespace Game3 {
 			return true;
 		}
 
-		player->send(make<OpenModuleForAgentPacket>(MultiModule<Substance::Item, Substance::Fluid>::ID(), getGID()));
+		player->send(make<OpenModuleForAgentPacket>(ModuleID::multi<Substance::Item, Substance::Fluid>(), getGID()));
 		FluidHoldingTileEntity::addObserver(player, true);
 		InventoriedTileEntity::addObserver(player, true);
 
@@ -1,7 +1,7 @@
 #include "util/Log.h"
 #include "entity/Player.h"
-#include "game/ClientGame.h"
 #include "game/EnergyContainer.h"
+#include "game/Game.h"
 #include "game/ServerInventory.h"
 #include "item/ChemicalItem.h"
 #include "packet/OpenModuleForAgentPacket.h"
@@ -9,7 +9,11 @@
 #include "realm/Realm.h"
 #include "tileentity/ChemicalReactor.h"
 #include "types/SlotRange.h"
-#include "ui/module/ChemicalReactorModule.h"
+#include "ui/module/ModuleIDs.h"
+
+#ifndef GAME3_HEADLESS
+#include "game/ClientGame.h"
+#endif
 
 #include <cassert>
 
@@ -33,7 +37,7 @@ namespace Game3 {
 		}
 
 		if (std::dynamic_pointer_cast<ChemicalItem>(stack->item)) {
-			if (const auto *object = stack->data.if_object()) {
+			if (const auto *object = stack->data->if_object()) {
 				return object->contains("formula");
 			}
 		}
@@ -59,7 +63,7 @@ namespace Game3 {
 			const std::string new_equation = buffer->take<std::string>();
 			const bool success = setEquation(new_equation);
 			if (source) {
-				sendMessage(source, "ModuleMessage", ChemicalReactorModule::ID(), "EquationSet", success);
+				sendMessage(source, "ModuleMessage", ModuleID::chemicalReactor(), "EquationSet", success);
 			}
 
 		} else {
@@ -80,14 +84,19 @@ namespace Game3 {
 
 		Ticker ticker{*this, args};
 
-		enqueueTick(PERIOD);
-
 		InventoryPtr inventory = getInventory(0);
 		if (!inventory->hasOwner()) {
 			inventory->setOwner(weak_from_this());
 		}
 
-		react();
+		if (energyContainer->copyEnergy() < ENERGY_PER_ATOM) {
+			sleepUntilEnergy(ENERGY_PER_ATOM, PERIOD);
+		} else if (react()) {
+			enqueueTick(PERIOD);
+		} else {
+			// The reaction may also have failed for want of enough energy for every atom.
+			sleepUntil(WakeCondition::Inventory | WakeCondition::Energy, PERIOD);
+		}
 	}
 
 	void ChemicalReactor::toJSON(boost::json::value &json) const {
@@ -123,7 +132,7 @@ namespace Game3 {
 		if (modifiers.onlyShift()) {
 			EnergeticTileEntity::addObserver(player, false);
 		} else {
-			player->send(make<OpenModuleForAgentPacket>(ChemicalReactorModule::ID(), getGID()));
+			player->send(make<OpenModuleForAgentPacket>(ModuleID::chemicalReactor(), getGID()));
 			InventoriedTileEntity::addObserver(player, true);
 			// TODO: formula observation
 		}
@@ -219,6 +228,7 @@ namespace Game3 {
 				equation = std::move(new_equation);
 				reactants.clear();
 				products.clear();
+				wake();
 				return true;
 			}
 
@@ -1,12 +1,16 @@
 #include "graphics/Texture.h"
 #include "graphics/Tileset.h"
 #include "entity/Player.h"
-#include "game/ClientGame.h"
+#include "game/Game.h"
 #include "game/ServerInventory.h"
-#include "graphics/SpriteRenderer.h"
 #include "realm/Realm.h"
 #include "tileentity/Chest.h"
 
+#ifndef GAME3_HEADLESS
+#include "game/ClientGame.h"
+#include "graphics/SpriteRenderer.h"
+#endif
+
 namespace Game3 {
 	Chest::Chest(Identifier tile_id, const Position &position_, std::string name_, Identifier item_name):
 		TileEntity(std::move(tile_id), ID(), position_, true), name(std::move(name_)), itemName(std::move(item_name)) {}
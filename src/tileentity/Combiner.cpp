@@ -1,7 +1,7 @@
 #include "util/Log.h"
 #include "entity/Player.h"
-#include "game/ClientGame.h"
 #include "game/EnergyContainer.h"
+#include "game/Game.h"
 #include "game/InventorySpan.h"
 #include "game/ServerInventory.h"
 #include "item/ChemicalItem.h"
@@ -10,7 +10,11 @@
 #include "realm/Realm.h"
 #include "recipe/CombinerRecipe.h"
 #include "tileentity/Combiner.h"
-#include "ui/module/CombinerModule.h"
+#include "ui/module/ModuleIDs.h"
+
+#ifndef GAME3_HEADLESS
+#include "game/ClientGame.h"
+#endif
 
 #include <cassert>
 #include <numeric>
@@ -65,7 +69,7 @@ namespace Game3 {
 			} catch (const std::invalid_argument &) {}
 
 			if (source)
-				sendMessage(source, "ModuleMessage", CombinerModule::ID(), "TargetSet", success, new_target);
+				sendMessage(source, "ModuleMessage", ModuleID::combiner(), "TargetSet", success, new_target);
 
 		} else if (name == "GetInventory") {
 
@@ -89,8 +93,13 @@ namespace Game3 {
 			return;
 
 		Ticker ticker{*this, args};
-		combine();
-		enqueueTick(PERIOD);
+
+		if (energyContainer->copyEnergy() < ENERGY_PER_OPERATION)
+			sleepUntilEnergy(ENERGY_PER_OPERATION, PERIOD);
+		else if (combine())
+			enqueueTick(PERIOD);
+		else
+			sleepUntil(WakeCondition::Inventory, PERIOD);
 	}
 
 	void Combiner::toJSON(boost::json::value &json) const {
@@ -121,7 +130,7 @@ namespace Game3 {
 		if (modifiers.onlyShift()) {
 			EnergeticTileEntity::addObserver(player, false);
 		} else {
-			player->send(make<OpenModuleForAgentPacket>(CombinerModule::ID(), getGID()));
+			player->send(make<OpenModuleForAgentPacket>(ModuleID::combiner(), getGID()));
 			InventoriedTileEntity::addObserver(player, true);
 		}
 
@@ -246,6 +255,7 @@ namespace Game3 {
 		if (std::shared_ptr<CombinerRecipe> maybe = registry.maybe(new_target)) {
 			recipe = std::move(maybe);
 			target = std::move(new_target);
+			wake();
 			return true;
 		}
 
@@ -1,17 +1,22 @@
 #ifdef GAME3_ENABLE_SCRIPTING
 #include "entity/Player.h"
-#include "game/ClientGame.h"
+#include "game/ServerGame.h"
 #include "net/LocalClient.h"
 #include "packet/OpenModuleForAgentPacket.h"
 #include "pipes/DataNetwork.h"
 #include "realm/Realm.h"
+#include "scripting/IsolatePool.h"
 #include "scripting/ObjectWrap.h"
 #include "scripting/ScriptError.h"
 #include "scripting/ScriptUtil.h"
 #include "tileentity/Computer.h"
-#include "ui/module/ComputerModule.h"
 #include "util/Concepts.h"
 
+#ifndef GAME3_HEADLESS
+#include "game/ClientGame.h"
+#include "ui/module/ComputerModule.h"
+#endif
+
 namespace Game3 {
 	Computer::Computer(Identifier tile_id, Position position_):
 		TileEntity(std::move(tile_id), ID(), position_, true) {}
@@ -20,54 +25,30 @@ namespace Game3 {
 		Computer("base:tile/computer"_id, position_) {}
 
 	Computer::~Computer() {
-		listeners.clear();
+		if (engine) {
+			// The isolate is shared with other computers, so the listeners' handles can't be released without the lock.
+			v8::Locker locker(engine->getIsolate());
+			listeners.clear();
+		}
 	}
 
 	void Computer::init(Game &game) {
 		TileEntity::init(game);
 		context = std::make_shared<Context>(std::static_pointer_cast<Computer>(getSelf()));
-		engine = std::make_unique<ScriptEngine>(game.shared_from_this(), [&](v8::Isolate *isolate, v8::Local<v8::ObjectTemplate> global) {
-			tileEntityTemplate = makeTileEntityTemplate(isolate);
-			global->Set(isolate, "TileEntity", tileEntityTemplate.Get(isolate));
-		});
-
-		v8::Isolate *isolate = engine->getIsolate();
-		v8::Locker locker(isolate);
-		v8::Isolate::Scope isolate_scope(isolate);
-		v8::HandleScope handle_scope(isolate);
 
-		v8::Local<v8::ObjectTemplate> instance = tileEntityTemplate.Get(isolate)->InstanceTemplate();
-
-		instance->SetAccessor(engine->string("gid"), [](v8::Local<v8::Name>, const v8::PropertyCallbackInfo<v8::Value> &info) {
-			auto &wrapper = WeakObjectWrap<TileEntity>::unwrap("TileEntity", info.This());
-			auto locked = wrapper.object.lock();
-			if (!locked) {
-				info.GetReturnValue().SetNull();
-			} else {
-				info.GetReturnValue().Set(v8::BigInt::New(info.GetIsolate(), locked->getGID()));
-			}
+		std::shared_ptr<ScriptIsolate> host = IsolatePool::get().acquire();
+		engine = std::make_unique<ScriptEngine>(game.shared_from_this(), host, [host = host.get()](v8::Isolate *isolate, v8::Local<v8::ObjectTemplate> global) {
+			global->Set(isolate, "TileEntity", host->getTemplate("TileEntity", &Computer::makeTileEntityTemplate));
 		});
+		engine->setOwner(this);
 
-		instance->SetAccessor(engine->string("realm"), [](v8::Local<v8::Name>, const v8::PropertyCallbackInfo<v8::Value> &info) {
-			auto &wrapper = WeakObjectWrap<TileEntity>::unwrap("TileEntity", info.This());
-			auto locked = wrapper.object.lock();
-			if (!locked) {
-				info.GetReturnValue().SetNull();
-			} else {
-				info.GetReturnValue().Set(v8::BigInt::New(info.GetIsolate(), locked->getRealm()->getID()));
-			}
-		});
-
-		instance->SetAccessor(engine->string("name"), [](v8::Local<v8::Name>, const v8::PropertyCallbackInfo<v8::Value> &info) {
-			auto &wrapper = WeakObjectWrap<TileEntity>::unwrap("TileEntity", info.This());
-			auto locked = wrapper.object.lock();
-			if (!locked) {
-				info.GetReturnValue().SetNull();
-			} else {
-				std::string name = locked->getName();
-				info.GetReturnValue().Set(v8::String::NewFromUtf8(info.GetIsolate(), name.c_str(), v8::NewStringType::kNormal, name.size()).ToLocalChecked());
-			}
-		});
+		if (game.getSide() == Side::Server) {
+			ServerGame &server_game = game.toServer();
+			engine->budget = ScriptIsolate::Budget{
+				.cpu = std::chrono::milliseconds(server_game.getRule("scriptCPUMillis").value_or(50)),
+				.heapBytes = static_cast<size_t>(server_game.getRule("scriptHeapMB").value_or(16)) << 20,
+			};
+		}
 	}
 
 	void Computer::handleMessage(const std::shared_ptr<Agent> &source, const std::string &name, std::any &data) {
@@ -87,7 +68,7 @@ namespace Game3 {
 
 				if (auto tile_entity = std::dynamic_pointer_cast<TileEntity>(source)) {
 					v8::Local<v8::Value> tile_entity_args[] {v8::BigInt::New(isolate, int64_t(tile_entity->getGID()))};
-					agent_object = tileEntityTemplate.Get(isolate)->GetFunction(context).ToLocalChecked()->CallAsConstructor(context, 1, tile_entity_args).ToLocalChecked().As<v8::Object>();
+					agent_object = getTileEntityTemplate()->GetFunction(context).ToLocalChecked()->CallAsConstructor(context, 1, tile_entity_args).ToLocalChecked().As<v8::Object>();
 					auto *wrapper = new ObjectWrap<TileEntity>(tile_entity);
 					wrapper->wrap(isolate, "TileEntity", agent_object);
 					argument = agent_object;
@@ -95,6 +76,10 @@ namespace Game3 {
 					argument = v8::Null(isolate);
 				}
 
+				std::optional<ScriptIsolate::Guard> guard;
+				if (engine->budget)
+					guard.emplace(engine->getHost(), *engine->budget);
+
 				for (; iter != end; ++iter) {
 					v8::Local<v8::Object> new_buffer = engine->getBufferTemplate()->GetFunction(context).ToLocalChecked()->CallAsConstructor(context, 0, nullptr).ToLocalChecked().As<v8::Object>();
 					auto &new_wrapper = ObjectWrap<Buffer>::unwrap("Buffer", new_buffer);
@@ -141,7 +126,7 @@ namespace Game3 {
 
 							std::unordered_set<GlobalID> gids;
 
-							auto templ = computer->tileEntityTemplate.Get(info.GetIsolate());
+							auto templ = computer->getTileEntityTemplate();
 							v8::Local<v8::Context> engine_context = engine.getContext();
 							v8::Local<v8::Function> function = templ->GetFunction(engine_context).ToLocalChecked();
 
@@ -285,13 +270,13 @@ namespace Game3 {
 		return false;
 	}
 
-	v8::Global<v8::FunctionTemplate> Computer::makeTileEntityTemplate(v8::Isolate *isolate) {
-		v8::Locker locker(isolate);
-		v8::Isolate::Scope isolate_scope(isolate);
-		v8::HandleScope handle_scope(isolate);
-
-		v8::Local<v8::External> external = v8::External::New(isolate, this);
+	v8::Local<v8::FunctionTemplate> Computer::getTileEntityTemplate() {
+		return engine->getHost().getTemplate("TileEntity", &Computer::makeTileEntityTemplate);
+	}
 
+	v8::Local<v8::FunctionTemplate> Computer::makeTileEntityTemplate(v8::Isolate *isolate) {
+		// The template is shared by every computer whose context lives in the same isolate,
+		// so the callbacks look up their computer through the context they're called in.
 		v8::Local<v8::FunctionTemplate> templ = v8::FunctionTemplate::New(isolate, [](const v8::FunctionCallbackInfo<v8::Value> &info) {
 			v8::Isolate *isolate = info.GetIsolate();
 
@@ -301,7 +286,7 @@ namespace Game3 {
 			}
 
 			const GlobalID gid = info[0].As<v8::BigInt>()->Uint64Value();
-			Computer &computer = getExternal<Computer>(info);
+			Computer &computer = *ScriptEngine::getOwner<Computer>(isolate->GetCurrentContext());
 			ScriptEngine &engine = *computer.engine;
 			GamePtr game = engine.game.lock();
 
@@ -315,16 +300,47 @@ namespace Game3 {
 
 			auto *wrapper = new WeakObjectWrap<TileEntity>(tile_entity);
 			wrapper->wrap(engine.getIsolate(), "TileEntity", this_obj);
-		}, external);
+		});
 
 		v8::Local<v8::ObjectTemplate> instance = templ->InstanceTemplate();
 
 		instance->SetInternalFieldCount(2);
 
+		instance->SetAccessor(v8::String::NewFromUtf8Literal(isolate, "gid"), [](v8::Local<v8::Name>, const v8::PropertyCallbackInfo<v8::Value> &info) {
+			auto &wrapper = WeakObjectWrap<TileEntity>::unwrap("TileEntity", info.This());
+			auto locked = wrapper.object.lock();
+			if (!locked) {
+				info.GetReturnValue().SetNull();
+			} else {
+				info.GetReturnValue().Set(v8::BigInt::New(info.GetIsolate(), locked->getGID()));
+			}
+		});
+
+		instance->SetAccessor(v8::String::NewFromUtf8Literal(isolate, "realm"), [](v8::Local<v8::Name>, const v8::PropertyCallbackInfo<v8::Value> &info) {
+			auto &wrapper = WeakObjectWrap<TileEntity>::unwrap("TileEntity", info.This());
+			auto locked = wrapper.object.lock();
+			if (!locked) {
+				info.GetReturnValue().SetNull();
+			} else {
+				info.GetReturnValue().Set(v8::BigInt::New(info.GetIsolate(), locked->getRealm()->getID()));
+			}
+		});
+
+		instance->SetAccessor(v8::String::NewFromUtf8Literal(isolate, "name"), [](v8::Local<v8::Name>, const v8::PropertyCallbackInfo<v8::Value> &info) {
+			auto &wrapper = WeakObjectWrap<TileEntity>::unwrap("TileEntity", info.This());
+			auto locked = wrapper.object.lock();
+			if (!locked) {
+				info.GetReturnValue().SetNull();
+			} else {
+				std::string name = locked->getName();
+				info.GetReturnValue().Set(v8::String::NewFromUtf8(info.GetIsolate(), name.c_str(), v8::NewStringType::kNormal, name.size()).ToLocalChecked());
+			}
+		});
+
 		instance->Set(isolate, "tell", v8::FunctionTemplate::New(isolate, [](const v8::FunctionCallbackInfo<v8::Value> &info) {
 			auto &wrapper = WeakObjectWrap<TileEntity>::unwrap("TileEntity", info.This());
 
-			Computer &computer = getExternal<Computer>(info);
+			Computer &computer = *ScriptEngine::getOwner<Computer>(info.GetIsolate()->GetCurrentContext());
 			ScriptEngine &engine = *computer.engine;
 
 			TileEntityPtr tile_entity = wrapper.object.lock();
@@ -388,9 +404,9 @@ namespace Game3 {
 					info.GetReturnValue().SetNull();
 				}
 			}
-		}, external));
+		}));
 
-		return v8::Global<v8::FunctionTemplate>(isolate, templ);
+		return templ;
 	}
 
 	TileEntityPtr Computer::searchFor(GlobalID gid) {
@@ -1,12 +1,16 @@
 #include <iostream>
 
+#include "game/Game.h"
 #include "graphics/Tileset.h"
 #include "entity/Player.h"
-#include "game/ClientGame.h"
-#include "graphics/SpriteRenderer.h"
 #include "realm/Realm.h"
 #include "tileentity/CraftingStation.h"
+
+#ifndef GAME3_HEADLESS
+#include "game/ClientGame.h"
+#include "graphics/SpriteRenderer.h"
 #include "ui/Window.h"
+#endif
 // #include "ui/tab/GTKCraftingTab.h"
 // #include "ui/tab/GTKInventoryTab.h"
 #include "util/Cast.h"
@@ -1,15 +1,19 @@
 #include "graphics/Texture.h"
 #include "graphics/Tileset.h"
 #include "entity/Player.h"
-#include "game/ClientGame.h"
-#include "game/ClientInventory.h"
+#include "game/Game.h"
 #include "game/ExpandedServerInventory.h"
 #include "game/ServerInventory.h"
-#include "graphics/SpriteRenderer.h"
 #include "lib/JSON.h"
 #include "realm/Realm.h"
 #include "tileentity/Crate.h"
 
+#ifndef GAME3_HEADLESS
+#include "game/ClientGame.h"
+#include "game/ClientInventory.h"
+#include "graphics/SpriteRenderer.h"
+#endif
+
 namespace Game3 {
 	Crate::Crate(Identifier tile_id, const Position &position_, Identifier item_name, std::string name_):
 		TileEntity(std::move(tile_id), ID(), position_, true), itemName(std::move(item_name)), name(std::move(name_)) {}
@@ -69,10 +73,15 @@ namespace Game3 {
 	void Crate::decode(Game &game, BasicBuffer &buffer) {
 		TileEntity::decode(game, buffer);
 		setInventory(1);
-		if (getSharedAgent()->getSide() == Side::Client)
+		if (getSharedAgent()->getSide() == Side::Client) {
+#ifdef GAME3_HEADLESS
+			throw std::invalid_argument("Can't decode a client inventory in a headless build");
+#else
 			decodeSpecific<ClientInventory>(buffer, 0);
-		else
+#endif
+		} else {
 			decodeSpecific<ExpandedServerInventory>(buffer, 0);
+		}
 		buffer >> itemName;
 		buffer >> name;
 	}
@@ -88,10 +97,15 @@ namespace Game3 {
 	}
 
 	void Crate::setInventory(Slot slot_count) {
-		if (getSide() == Side::Client)
+		if (getSide() == Side::Client) {
+#ifdef GAME3_HEADLESS
+			throw std::invalid_argument("Can't create a client inventory in a headless build");
+#else
 			HasInventory::setInventory(std::make_shared<ClientInventory>(shared_from_this(), slot_count), 0);
-		else
+#endif
+		} else {
 			HasInventory::setInventory(std::make_shared<ExpandedServerInventory>(shared_from_this(), slot_count), 0);
+		}
 		inventoryUpdated(0);
 	}
 }
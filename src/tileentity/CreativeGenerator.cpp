@@ -1,11 +1,15 @@
 #include "util/Log.h"
 #include "entity/Player.h"
-#include "game/ClientGame.h"
 #include "game/EnergyContainer.h"
+#include "game/Game.h"
 #include "game/ServerInventory.h"
 #include "realm/Realm.h"
 #include "tileentity/CreativeGenerator.h"
 
+#ifndef GAME3_HEADLESS
+#include "game/ClientGame.h"
+#endif
+
 namespace Game3 {
 	namespace {
 		constexpr EnergyAmount ENERGY_CAPACITY = 1'000'000;
@@ -1,7 +1,7 @@
 #include "util/Log.h"
 #include "entity/Player.h"
-#include "game/ClientGame.h"
 #include "game/EnergyContainer.h"
+#include "game/Game.h"
 #include "game/InventorySpan.h"
 #include "game/ServerInventory.h"
 #include "item/ChemicalItem.h"
@@ -10,7 +10,11 @@
 #include "realm/Realm.h"
 #include "tileentity/Disruptor.h"
 #include "types/SlotRange.h"
-#include "ui/module/MultiModule.h"
+#include "ui/module/ModuleIDs.h"
+
+#ifndef GAME3_HEADLESS
+#include "game/ClientGame.h"
+#endif
 
 #include <cassert>
 
@@ -40,7 +44,7 @@ namespace Game3 {
 		}
 
 		if (std::dynamic_pointer_cast<ChemicalItem>(stack->item)) {
-			if (const auto *object = stack->data.if_object()) {
+			if (const auto *object = stack->data->if_object()) {
 				return object->contains("formula");
 			}
 		}
@@ -107,7 +111,7 @@ namespace Game3 {
 			return true;
 		}
 
-		player->send(make<OpenModuleForAgentPacket>(MultiModule<Substance::Item, Substance::Energy>::ID(), getGID()));
+		player->send(make<OpenModuleForAgentPacket>(ModuleID::multi<Substance::Item, Substance::Energy>(), getGID()));
 		InventoriedTileEntity::addObserver(player, true);
 		EnergeticTileEntity::addObserver(player, true);
 
@@ -205,7 +209,7 @@ namespace Game3 {
 			return false;
 		}
 
-		const auto *object = stack->data.if_object();
+		const auto *object = stack->data->if_object();
 		if (!object) {
 			return false;
 		}
@@ -1,7 +1,7 @@
 #include "util/Log.h"
 #include "entity/Player.h"
-#include "game/ClientGame.h"
 #include "game/EnergyContainer.h"
+#include "game/Game.h"
 #include "game/InventorySpan.h"
 #include "game/ServerInventory.h"
 #include "item/ChemicalItem.h"
@@ -10,7 +10,11 @@
 #include "realm/Realm.h"
 #include "recipe/DissolverRecipe.h"
 #include "tileentity/Dissolver.h"
-#include "ui/module/MultiModule.h"
+#include "ui/module/ModuleIDs.h"
+
+#ifndef GAME3_HEADLESS
+#include "game/ClientGame.h"
+#endif
 
 #include <cassert>
 #include <numeric>
@@ -61,8 +65,13 @@ namespace Game3 {
 			return;
 
 		Ticker ticker{*this, args};
-		dissolve();
-		enqueueTick(PERIOD);
+
+		if (energyContainer->copyEnergy() < ENERGY_PER_ATOM)
+			sleepUntilEnergy(ENERGY_PER_ATOM, PERIOD);
+		else if (dissolve())
+			enqueueTick(PERIOD);
+		else
+			sleepUntil(WakeCondition::Inventory | WakeCondition::Energy, PERIOD);
 	}
 
 	void Dissolver::toJSON(boost::json::value &json) const {
@@ -90,7 +99,7 @@ namespace Game3 {
 			return true;
 		}
 
-		player->send(make<OpenModuleForAgentPacket>(MultiModule<Substance::Item, Substance::Energy>::ID(), getGID()));
+		player->send(make<OpenModuleForAgentPacket>(ModuleID::multi<Substance::Item, Substance::Energy>(), getGID()));
 		EnergeticTileEntity::addObserver(player, true);
 		InventoriedTileEntity::addObserver(player, true);
 
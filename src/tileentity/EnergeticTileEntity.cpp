@@ -1,14 +1,18 @@
 #include "entity/Player.h"
-#include "game/ClientGame.h"
 #include "game/EnergyContainer.h"
+#include "game/Game.h"
 #include "lib/JSON.h"
 #include "packet/OpenModuleForAgentPacket.h"
 #include "packet/SetTileEntityEnergyPacket.h"
 #include "realm/Realm.h"
 #include "tileentity/EnergeticTileEntity.h"
-#include "ui/module/EnergyModule.h"
+#include "ui/module/ModuleIDs.h"
 #include "util/Cast.h"
 
+#ifndef GAME3_HEADLESS
+#include "game/ClientGame.h"
+#endif
+
 namespace Game3 {
 	EnergeticTileEntity::EnergeticTileEntity(EnergyAmount capacity, EnergyAmount energy):
 		HasEnergy(capacity, energy) {}
@@ -44,10 +48,15 @@ namespace Game3 {
 		if (realm->getSide() == Side::Server) {
 			increaseUpdateCounter();
 			queueBroadcast();
-		} else {
+			if (wakeEnergy <= getEnergy() && wake(WakeCondition::Energy))
+				wakeEnergy = 0;
+		}
+#ifndef GAME3_HEADLESS
+		else {
 			GamePtr game = realm->getGame();
 			game->toClient().signalEnergyUpdate(std::dynamic_pointer_cast<HasEnergy>(shared_from_this()));
 		}
+#endif
 	}
 
 	void EnergeticTileEntity::addObserver(const PlayerPtr &player, bool silent) {
@@ -56,7 +65,7 @@ namespace Game3 {
 		player->send(make<TileEntityPacket>(getSelf()));
 
 		if (!silent)
-			player->send(make<OpenModuleForAgentPacket>(EnergyModule::ID(), getGID(), true));
+			player->send(make<OpenModuleForAgentPacket>(ModuleID::energy(), getGID(), true));
 
 		player->queueForMove([weak_self = getWeakSelf()](const EntityPtr &entity, bool) {
 			if (auto self = weak_self.lock())
@@ -1,11 +1,14 @@
 #include "entity/Player.h"
 #include "game/Game.h"
-#include "graphics/SpriteRenderer.h"
 #include "graphics/Tileset.h"
 #include "lib/JSON.h"
 #include "realm/Realm.h"
 #include "tileentity/EntityBuilding.h"
 
+#ifndef GAME3_HEADLESS
+#include "graphics/SpriteRenderer.h"
+#endif
+
 namespace Game3 {
 	EntityBuilding::EntityBuilding(Identifier tilename, Position position_, GlobalID target_entity):
 		TileEntity(std::move(tilename), ID(), position_, false),
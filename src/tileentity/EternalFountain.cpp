@@ -1,12 +1,16 @@
 #include "entity/Player.h"
-#include "game/ClientGame.h"
-#include "graphics/SpriteRenderer.h"
+#include "game/Game.h"
 #include "graphics/Tileset.h"
 #include "interface/HasFluidType.h"
 #include "packet/OpenModuleForAgentPacket.h"
 #include "realm/Realm.h"
 #include "tileentity/EternalFountain.h"
-#include "ui/module/MultiModule.h"
+#include "ui/module/ModuleIDs.h"
+
+#ifndef GAME3_HEADLESS
+#include "game/ClientGame.h"
+#include "graphics/SpriteRenderer.h"
+#endif
 
 namespace Game3 {
 	namespace {
@@ -96,7 +100,7 @@ namespace Game3 {
 			return true;
 		}
 
-		player->send(make<OpenModuleForAgentPacket>(MultiModule<Substance::Item, Substance::Fluid>::ID(), getGID()));
+		player->send(make<OpenModuleForAgentPacket>(ModuleID::multi<Substance::Item, Substance::Fluid>(), getGID()));
 		FluidHoldingTileEntity::addObserver(player, true);
 		InventoriedTileEntity::addObserver(player, true);
 
@@ -1,13 +1,17 @@
 #include "entity/Player.h"
-#include "game/ClientGame.h"
+#include "game/Game.h"
 #include "lib/JSON.h"
 #include "packet/OpenModuleForAgentPacket.h"
 #include "packet/TileEntityPacket.h"
 #include "realm/Realm.h"
 #include "tileentity/FluidHoldingTileEntity.h"
-#include "ui/module/FluidsModule.h"
+#include "ui/module/ModuleIDs.h"
 #include "util/Cast.h"
 
+#ifndef GAME3_HEADLESS
+#include "game/ClientGame.h"
+#endif
+
 namespace Game3 {
 	FluidHoldingTileEntity::FluidHoldingTileEntity(FluidContainer::Map map):
 		HasFluids(std::make_shared<FluidContainer>(std::move(map))) {}
@@ -57,6 +61,9 @@ namespace Game3 {
 			if (iter->second == 0) {
 				levels.erase(iter);
 			}
+			if (0 < to_remove) {
+				wake(WakeCondition::Fluids);
+			}
 		}
 
 		return FluidStack(id, to_remove);
@@ -84,10 +91,14 @@ namespace Game3 {
 		if (realm->getSide() == Side::Server) {
 			increaseUpdateCounter();
 			queueBroadcast();
-		} else {
+			wake(WakeCondition::Fluids);
+		}
+#ifndef GAME3_HEADLESS
+		else {
 			GamePtr game = TileEntity::getGame();
 			game->toClient().signalFluidUpdate(safeDynamicCast<HasFluids>(shared_from_this()));
 		}
+#endif
 	}
 
 	void FluidHoldingTileEntity::addObserver(const PlayerPtr &player, bool silent) {
@@ -96,7 +107,7 @@ namespace Game3 {
 		player->send(make<TileEntityPacket>(getSelf()));
 
 		if (!silent) {
-			player->send(make<OpenModuleForAgentPacket>(FluidsModule::ID(), getGID(), true));
+			player->send(make<OpenModuleForAgentPacket>(ModuleID::fluids(), getGID(), true));
 		}
 
 		player->queueForMove([weak_self = getWeakSelf()](const EntityPtr &entity, bool) {
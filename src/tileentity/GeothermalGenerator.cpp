@@ -1,7 +1,7 @@
 #include "util/Log.h"
 #include "entity/Player.h"
-#include "game/ClientGame.h"
 #include "game/EnergyContainer.h"
+#include "game/Game.h"
 #include "game/ServerInventory.h"
 #include "item/FilledFlask.h"
 #include "packet/InteractPacket.h"
@@ -9,7 +9,11 @@
 #include "realm/Realm.h"
 #include "recipe/GeothermalRecipe.h"
 #include "tileentity/GeothermalGenerator.h"
-#include "ui/module/MultiModule.h"
+#include "ui/module/ModuleIDs.h"
+
+#ifndef GAME3_HEADLESS
+#include "game/ClientGame.h"
+#endif
 
 namespace Game3 {
 	namespace {
@@ -147,7 +151,7 @@ namespace Game3 {
 			return true;
 		}
 
-		player->send(make<OpenModuleForAgentPacket>(MultiModule<Substance::Item, Substance::Energy, Substance::Fluid>::ID(), getGID()));
+		player->send(make<OpenModuleForAgentPacket>(ModuleID::multi<Substance::Item, Substance::Energy, Substance::Fluid>(), getGID()));
 		EnergeticTileEntity::addObserver(player, true);
 		FluidHoldingTileEntity::addObserver(player, true);
 		InventoriedTileEntity::addObserver(player, true);
@@ -275,15 +279,13 @@ namespace Game3 {
 			return;
 		}
 
-		stack->count -= flasks_to_insert;
-		if (stack->count == 0) {
-			inventory->erase(0);
-		}
-
 		fluidContainer->levels[fluid_stack.id] += flasks_to_insert * fluid_stack.amount;
+		fluid_lock.unlock();
+
+		// Going through the inventory keeps its summary current, and it calls inventoryUpdated for us.
+		inventory->decrease(stack, 0, flasks_to_insert, true);
 
 		inventory_lock.unlock();
-		inventoryUpdated(0);
 		fluidsUpdated();
 	}
 }
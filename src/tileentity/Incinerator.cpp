@@ -1,13 +1,17 @@
 #include <iostream>
 
 #include "entity/Player.h"
-#include "game/ClientGame.h"
+#include "game/Game.h"
 #include "game/ServerInventory.h"
-#include "graphics/SpriteRenderer.h"
 #include "graphics/Tileset.h"
 #include "realm/Realm.h"
 #include "tileentity/Incinerator.h"
 
+#ifndef GAME3_HEADLESS
+#include "game/ClientGame.h"
+#include "graphics/SpriteRenderer.h"
+#endif
+
 namespace Game3 {
 	namespace {
 		constexpr std::chrono::milliseconds PERIOD{100};
@@ -39,8 +43,6 @@ namespace Game3 {
 
 		Ticker ticker{*this, args};
 
-		enqueueTick(PERIOD);
-
 		{
 			auto lock = fluidContainer->levels.uniqueLock();
 			fluidContainer->levels.clear();
@@ -51,6 +53,8 @@ namespace Game3 {
 			auto lock = inventory->uniqueLock();
 			inventory->clear();
 		}
+
+		sleepUntil(WakeCondition::Inventory | WakeCondition::Fluids, PERIOD);
 	}
 
 	void Incinerator::toJSON(boost::json::value &json) const {
@@ -1,15 +1,19 @@
 #include "entity/EntityFactory.h"
 #include "entity/Player.h"
-#include "game/ClientGame.h"
 #include "game/EnergyContainer.h"
+#include "game/Game.h"
 #include "game/ServerInventory.h"
-#include "graphics/SpriteRenderer.h"
 #include "graphics/Tileset.h"
 #include "item/ContainmentOrb.h"
 #include "packet/OpenModuleForAgentPacket.h"
 #include "realm/Realm.h"
 #include "tileentity/Incubator.h"
-#include "ui/module/MicroscopeModule.h"
+#include "ui/module/ModuleIDs.h"
+
+#ifndef GAME3_HEADLESS
+#include "game/ClientGame.h"
+#include "graphics/SpriteRenderer.h"
+#endif
 
 namespace Game3 {
 	namespace {
@@ -77,7 +81,7 @@ namespace Game3 {
 			return;
 		}
 
-		const auto *object = genetic_template->data.if_object();
+		const auto *object = genetic_template->data->if_object();
 		if (!object) {
 			ERR(3, "Template doesn't have an object as data.");
 			return;
@@ -108,7 +112,9 @@ namespace Game3 {
 			return;
 		}
 
-		ContainmentOrb::saveToJSON(entity, orb->data, false);
+		orb->data.mutate([&](boost::json::value &data) {
+			ContainmentOrb::saveToJSON(entity, data, false);
+		});
 		fluid_iter->second -= FLUID_PER_ACTION;
 		inventory->notifyOwner({});
 	}
@@ -133,7 +139,7 @@ namespace Game3 {
 			return true;
 		}
 
-		player->send(make<OpenModuleForAgentPacket>(MicroscopeModule<1, Substance::Energy, Substance::Fluid>::ID(), getGID()));
+		player->send(make<OpenModuleForAgentPacket>(ModuleID::microscope<1, Substance::Energy, Substance::Fluid>(), getGID()));
 		EnergeticTileEntity::addObserver(player, true);
 		FluidHoldingTileEntity::addObserver(player, true);
 		InventoriedTileEntity::addObserver(player, true);
@@ -6,7 +6,7 @@
 #include "packet/TileEntityPacket.h"
 #include "realm/Realm.h"
 #include "tileentity/InventoriedTileEntity.h"
-#include "ui/module/InventoryModule.h"
+#include "ui/module/ModuleIDs.h"
 #include "util/Cast.h"
 
 namespace Game3 {
@@ -146,6 +146,7 @@ namespace Game3 {
 		if (getSide() != Side::Server)
 			return;
 		increaseUpdateCounter();
+		wake(WakeCondition::Inventory);
 	}
 
 	std::shared_ptr<Agent> InventoriedTileEntity::getSharedAgent() {
@@ -158,7 +159,7 @@ namespace Game3 {
 		player->send(make<TileEntityPacket>(getSelf()));
 
 		if (!silent) {
-			player->send(make<OpenModuleForAgentPacket>(InventoryModule::ID(), getGID()));
+			player->send(make<OpenModuleForAgentPacket>(ModuleID::inventory(), getGID()));
 		}
 
 		player->queueForMove([weak_self = getWeakSelf()](const EntityPtr &entity, bool) {
@@ -3,15 +3,18 @@
 #include "entity/Player.h"
 #include "game/Game.h"
 #include "game/Inventory.h"
-#include "graphics/SpriteRenderer.h"
 #include "graphics/Tileset.h"
 #include "lib/JSON.h"
 #include "realm/Realm.h"
 #include "threading/ThreadContext.h"
 #include "tileentity/ItemSpawner.h"
-#include "ui/Window.h"
 #include "util/Util.h"
 
+#ifndef GAME3_HEADLESS
+#include "graphics/SpriteRenderer.h"
+#include "ui/Window.h"
+#endif
+
 namespace Game3 {
 	ItemSpawner::ItemSpawner(Position position_, float minimum_time, float maximum_time, std::vector<ItemStackPtr> spawnables_):
 		TileEntity("base:tile/empty", ID(), position_, false),
@@ -60,7 +63,9 @@ namespace Game3 {
 		enqueueTick(std::chrono::microseconds(int64_t(1e6 * distribution(threadContext.rng))));
 	}
 
+#ifndef GAME3_HEADLESS
 	void ItemSpawner::render(SpriteRenderer &) {}
+#endif
 
 	void ItemSpawner::encode(Game &game, Buffer &buffer) {
 		TileEntity::encode(game, buffer);
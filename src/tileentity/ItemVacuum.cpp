@@ -1,6 +1,5 @@
 #include "entity/ItemEntity.h"
 #include "entity/Player.h"
-#include "game/ClientGame.h"
 #include "game/EnergyContainer.h"
 #include "game/Inventory.h"
 #include "game/ServerGame.h"
@@ -8,10 +7,14 @@
 #include "packet/UpdateAgentFieldPacket.h"
 #include "realm/Realm.h"
 #include "tileentity/ItemVacuum.h"
-#include "ui/module/RadiusMachineModule.h"
+#include "ui/module/ModuleIDs.h"
 #include "util/ConstexprHash.h"
 #include "util/Log.h"
 
+#ifndef GAME3_HEADLESS
+#include "game/ClientGame.h"
+#endif
+
 #include <cassert>
 
 namespace Game3 {
@@ -90,7 +93,7 @@ namespace Game3 {
 			return true;
 		}
 
-		player->send(make<OpenModuleForAgentPacket>(RadiusMachineModule::ID(), getGID()));
+		player->send(make<OpenModuleForAgentPacket>(ModuleID::radiusMachine(), getGID()));
 		InventoriedTileEntity::addObserver(player, true);
 		EnergeticTileEntity::addObserver(player, true);
 
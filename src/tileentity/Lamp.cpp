@@ -1,12 +1,15 @@
 #include "entity/Player.h"
 #include "game/Game.h"
-#include "graphics/SpriteRenderer.h"
 #include "graphics/Tileset.h"
 #include "lib/JSON.h"
 #include "pipes/DataNetwork.h"
 #include "realm/Realm.h"
 #include "tileentity/Lamp.h"
 
+#ifndef GAME3_HEADLESS
+#include "graphics/SpriteRenderer.h"
+#endif
+
 namespace Game3 {
 	namespace {
 		const Identifier TILE_ID_ON = "base:tile/lamp_on";
@@ -1,16 +1,20 @@
 #include "entity/Player.h"
-#include "game/ClientGame.h"
 #include "game/EnergyContainer.h"
+#include "game/Game.h"
 #include "game/ServerInventory.h"
-#include "graphics/SpriteRenderer.h"
 #include "graphics/Tileset.h"
 #include "packet/OpenModuleForAgentPacket.h"
 #include "realm/Realm.h"
 #include "recipe/LiquefierRecipe.h"
 #include "tileentity/Liquefier.h"
-#include "ui/module/MultiModule.h"
+#include "ui/module/ModuleIDs.h"
 #include "util/Cast.h"
 
+#ifndef GAME3_HEADLESS
+#include "game/ClientGame.h"
+#include "graphics/SpriteRenderer.h"
+#endif
+
 namespace Game3 {
 	namespace {
 		constexpr std::chrono::milliseconds PERIOD{250};
@@ -45,11 +49,12 @@ namespace Game3 {
 		}
 
 		Ticker ticker{*this, args};
-		enqueueTick(PERIOD);
 
 		const EnergyAmount consumed_energy = ENERGY_PER_ACTION;
 		auto energy_lock = energyContainer->uniqueLock();
 		if (consumed_energy > energyContainer->energy) {
+			energy_lock.unlock();
+			sleepUntilEnergy(consumed_energy, PERIOD);
 			return;
 		}
 
@@ -62,9 +67,12 @@ namespace Game3 {
 		for (const std::shared_ptr<LiquefierRecipe> &recipe: game->registry<LiquefierRecipeRegistry>().items) {
 			if (recipe->craft(game, inventory, fluidContainer)) {
 				energyContainer->energy -= consumed_energy;
+				enqueueTick(PERIOD);
 				return;
 			}
 		}
+
+		sleepUntil(WakeCondition::Inventory | WakeCondition::Fluids, PERIOD);
 	}
 
 	void Liquefier::toJSON(boost::json::value &json) const {
@@ -87,7 +95,7 @@ namespace Game3 {
 			return true;
 		}
 
-		player->send(make<OpenModuleForAgentPacket>(MultiModule<Substance::Item, Substance::Energy, Substance::Fluid>::ID(), getGID()));
+		player->send(make<OpenModuleForAgentPacket>(ModuleID::multi<Substance::Item, Substance::Energy, Substance::Fluid>(), getGID()));
 		EnergeticTileEntity::addObserver(player, true);
 		FluidHoldingTileEntity::addObserver(player, true);
 		InventoriedTileEntity::addObserver(player, true);
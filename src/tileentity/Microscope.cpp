@@ -1,10 +1,14 @@
 #include "entity/Player.h"
-#include "game/ClientGame.h"
+#include "game/Game.h"
 #include "game/ServerInventory.h"
 #include "packet/OpenModuleForAgentPacket.h"
 #include "realm/Realm.h"
 #include "tileentity/Microscope.h"
-#include "ui/module/MicroscopeModule.h"
+#include "ui/module/ModuleIDs.h"
+
+#ifndef GAME3_HEADLESS
+#include "game/ClientGame.h"
+#endif
 
 namespace Game3 {
 	Microscope::Microscope(Identifier tile_id, Position position_):
@@ -35,7 +39,7 @@ namespace Game3 {
 			return true;
 		}
 
-		player->send(make<OpenModuleForAgentPacket>(MicroscopeModule<0>::ID(), getGID()));
+		player->send(make<OpenModuleForAgentPacket>(ModuleID::microscope<0>(), getGID()));
 		addObserver(player, true);
 
 		return false;
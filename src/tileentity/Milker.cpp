@@ -1,5 +1,4 @@
 #include "entity/Player.h"
-#include "game/ClientGame.h"
 #include "game/EnergyContainer.h"
 #include "game/ServerGame.h"
 #include "game/ServerInventory.h"
@@ -7,9 +6,13 @@
 #include "packet/UpdateAgentFieldPacket.h"
 #include "realm/Realm.h"
 #include "tileentity/Milker.h"
-#include "ui/module/RadiusMachineModule.h"
+#include "ui/module/ModuleIDs.h"
 #include "util/ConstexprHash.h"
 
+#ifndef GAME3_HEADLESS
+#include "game/ClientGame.h"
+#endif
+
 namespace Game3 {
 	namespace {
 		constexpr float PERIOD = 0.5;
@@ -102,7 +105,7 @@ namespace Game3 {
 			return true;
 		}
 
-		player->send(make<OpenModuleForAgentPacket>(RadiusMachineModule::ID(), getGID()));
+		player->send(make<OpenModuleForAgentPacket>(ModuleID::radiusMachine(), getGID()));
 		FluidHoldingTileEntity::addObserver(player, true);
 		EnergeticTileEntity::addObserver(player, true);
 
@@ -1,13 +1,17 @@
 #include "biology/Gene.h"
 #include "entity/Player.h"
-#include "game/ClientGame.h"
+#include "game/Game.h"
 #include "game/ServerInventory.h"
-#include "graphics/SpriteRenderer.h"
 #include "graphics/Tileset.h"
 #include "packet/OpenModuleForAgentPacket.h"
 #include "realm/Realm.h"
 #include "tileentity/Mutator.h"
-#include "ui/module/MutatorModule.h"
+#include "ui/module/ModuleIDs.h"
+
+#ifndef GAME3_HEADLESS
+#include "game/ClientGame.h"
+#include "graphics/SpriteRenderer.h"
+#endif
 
 namespace Game3 {
 	namespace {
@@ -37,12 +41,12 @@ namespace Game3 {
 		// Ensure the gene actually has genetic data.
 		auto data_lock = stack->data.uniqueLock();
 
-		auto *object = stack->data.if_object();
+		const auto *object = stack->data->if_object();
 		if (!object) {
 			return;
 		}
 
-		auto *data_value = object->if_contains("gene");
+		const auto *data_value = object->if_contains("gene");
 		if (!data_value) {
 			return;
 		}
@@ -76,7 +80,9 @@ namespace Game3 {
 			ERR("Gene decoding failed in Mutator::mutate: {}", err.what());
 		}
 		gene->mutate(strength);
-		gene->toJSON(*data_value);
+		stack->data.mutate([&](boost::json::value &data) {
+			gene->toJSON(data.at("gene"));
+		});
 		inventory->notifyOwner({});
 	}
 
@@ -92,7 +98,7 @@ namespace Game3 {
 			return nullptr;
 
 		auto data_lock = stack->data.sharedLock();
-		const auto *object = stack->data.if_object();
+		const auto *object = stack->data->if_object();
 		if (!object) {
 			return nullptr;
 		}
@@ -143,7 +149,7 @@ namespace Game3 {
 			return true;
 		}
 
-		player->send(make<OpenModuleForAgentPacket>(MutatorModule::ID(), getGID()));
+		player->send(make<OpenModuleForAgentPacket>(ModuleID::mutator(), getGID()));
 		FluidHoldingTileEntity::addObserver(player, true);
 		InventoriedTileEntity::addObserver(player, true);
 
@@ -2,13 +2,16 @@
 #include "entity/Player.h"
 #include "game/Game.h"
 #include "game/Inventory.h"
-#include "graphics/SpriteRenderer.h"
 #include "graphics/Tileset.h"
 #include "item/Tool.h"
 #include "lib/JSON.h"
 #include "realm/Realm.h"
 #include "tileentity/OreDeposit.h"
+
+#ifndef GAME3_HEADLESS
+#include "graphics/SpriteRenderer.h"
 #include "ui/Window.h"
+#endif
 
 namespace Game3 {
 	Ore::Ore(Identifier identifier_, ItemStackPtr stack_, Identifier tilename_, Identifier regen_tilename, float tooldown_multiplier, uint32_t max_uses, float cooldown_):
@@ -104,6 +107,7 @@ namespace Game3 {
 		return false;
 	}
 
+#ifndef GAME3_HEADLESS
 	void OreDeposit::render(SpriteRenderer &sprite_renderer) {
 		if (!isVisible())
 			return;
@@ -130,6 +134,7 @@ namespace Game3 {
 			.sizeY   = float(tilesize),
 		});
 	}
+#endif
 
 	const Ore & OreDeposit::getOre(const Game &game) const {
 		auto lock = oreType.sharedLock();
@@ -2,7 +2,6 @@
 #include "graphics/Tileset.h"
 #include "game/EnergyContainer.h"
 #include "game/Game.h"
-#include "graphics/SpriteRenderer.h"
 #include "pipes/EnergyNetwork.h"
 #include "pipes/ItemNetwork.h"
 #include "pipes/PipeNetwork.h"
@@ -10,6 +9,10 @@
 #include "tileentity/Pipe.h"
 #include "util/Reverse.h"
 
+#ifndef GAME3_HEADLESS
+#include "graphics/SpriteRenderer.h"
+#endif
+
 #include <deque>
 
 namespace Game3 {
@@ -89,6 +92,7 @@ namespace Game3 {
 		}
 	}
 
+#ifndef GAME3_HEADLESS
 	void Pipe::render(SpriteRenderer &sprite_renderer) {
 		if (!isVisible()) {
 			return;
@@ -143,8 +147,11 @@ namespace Game3 {
 			}
 		}
 	}
+#endif
 
 	void Pipe::onNeighborUpdated(Position offset) {
+		TileEntity::onNeighborUpdated(offset);
+
 		Direction direction{offset};
 
 		if (direction == Direction::Invalid || offset.taxiDistance({}) != 1) {
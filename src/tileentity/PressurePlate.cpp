@@ -1,11 +1,14 @@
 #include "graphics/Tileset.h"
 #include "entity/Player.h"
 #include "game/Game.h"
-#include "graphics/SpriteRenderer.h"
 #include "pipes/DataNetwork.h"
 #include "realm/Realm.h"
 #include "tileentity/PressurePlate.h"
 
+#ifndef GAME3_HEADLESS
+#include "graphics/SpriteRenderer.h"
+#endif
+
 namespace Game3 {
 	namespace {
 		const Identifier TILE_ID_UP = "base:tile/pressure_plate";
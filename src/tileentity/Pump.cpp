@@ -1,13 +1,17 @@
 #include "graphics/Tileset.h"
 #include "entity/Player.h"
-#include "game/ClientGame.h"
+#include "game/Game.h"
 #include "game/EnergyContainer.h"
 #include "game/ServerInventory.h"
-#include "graphics/SpriteRenderer.h"
 #include "packet/OpenModuleForAgentPacket.h"
 #include "realm/Realm.h"
 #include "tileentity/Pump.h"
-#include "ui/module/MultiModule.h"
+#include "ui/module/ModuleIDs.h"
+
+#ifndef GAME3_HEADLESS
+#include "game/ClientGame.h"
+#include "graphics/SpriteRenderer.h"
+#endif
 
 namespace Game3 {
 	namespace {
@@ -114,7 +118,7 @@ namespace Game3 {
 			return true;
 		}
 
-		player->send(make<OpenModuleForAgentPacket>(MultiModule<Substance::Energy, Substance::Fluid>::ID(), getGID()));
+		player->send(make<OpenModuleForAgentPacket>(ModuleID::multi<Substance::Energy, Substance::Fluid>(), getGID()));
 		FluidHoldingTileEntity::addObserver(player, true);
 		EnergeticTileEntity::addObserver(player, true);
 
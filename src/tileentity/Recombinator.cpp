@@ -1,9 +1,8 @@
 #include "biology/Gene.h"
 #include "entity/Player.h"
-#include "game/ClientGame.h"
 #include "game/EnergyContainer.h"
+#include "game/Game.h"
 #include "game/ServerInventory.h"
-#include "graphics/SpriteRenderer.h"
 #include "graphics/Tileset.h"
 #include "item/ContainmentOrb.h"
 #include "lib/JSON.h"
@@ -11,9 +10,14 @@
 #include "realm/Realm.h"
 #include "threading/ThreadContext.h"
 #include "tileentity/Recombinator.h"
-#include "ui/module/MicroscopeModule.h"
+#include "ui/module/ModuleIDs.h"
 #include "util/Util.h"
 
+#ifndef GAME3_HEADLESS
+#include "game/ClientGame.h"
+#include "graphics/SpriteRenderer.h"
+#endif
+
 namespace Game3 {
 	namespace {
 		constexpr std::chrono::milliseconds PERIOD{1'000};
@@ -50,15 +54,21 @@ namespace Game3 {
 			return;
 
 		Ticker ticker{*this, args};
-		enqueueTick(PERIOD);
 
 		const EnergyAmount consumed_energy = ENERGY_PER_ACTION;
 		auto energy_lock = energyContainer->uniqueLock();
-		if (consumed_energy > energyContainer->energy)
+		if (consumed_energy > energyContainer->energy) {
+			energy_lock.unlock();
+			sleepUntilEnergy(consumed_energy, PERIOD);
 			return;
+		}
 
-		if (combine())
+		if (combine()) {
 			energyContainer->energy -= consumed_energy;
+			enqueueTick(PERIOD);
+		} else {
+			sleepUntil(WakeCondition::Inventory, PERIOD);
+		}
 	}
 
 	bool Recombinator::combine() {
@@ -95,27 +105,29 @@ namespace Game3 {
 
 		for (const ItemStackPtr &stack: {first, second}) {
 			if (stack->getID() == "base:item/gene") {
-				boost::json::value &gene = stack->data.at("gene");
+				const boost::json::value &gene = stack->data->at("gene");
 				combined_genes.try_emplace(std::string(gene.at("name").as_string()), gene, stack == first);
 			} else {
-				for (const auto &[name, gene]: stack->data.at("genes").as_object())
+				for (const auto &[name, gene]: stack->data->at("genes").as_object())
 					combined_genes.try_emplace(name, gene, stack == first);
 			}
 		}
 
-		boost::json::object &genes = ensureObject(output->data.at("genes"));
-
 		bool any_from_first  = false;
 		bool any_from_second = false;
 
-		for (const auto &[name, combined]: combined_genes) {
-			const auto &[gene, from_first] = combined;
-			genes[name] = gene;
-			if (from_first)
-				any_from_first = true;
-			else
-				any_from_second = true;
-		}
+		output->data.mutate([&](boost::json::value &data) {
+			boost::json::object &genes = ensureObject(data.at("genes"));
+
+			for (const auto &[name, combined]: combined_genes) {
+				const auto &[gene, from_first] = combined;
+				genes[name] = gene;
+				if (from_first)
+					any_from_first = true;
+				else
+					any_from_second = true;
+			}
+		});
 
 		if (any_from_first)
 			inventory->erase(0);
@@ -149,7 +161,7 @@ namespace Game3 {
 			return true;
 		}
 
-		player->send(make<OpenModuleForAgentPacket>(MicroscopeModule<2, Substance::Energy>::ID(), getGID()));
+		player->send(make<OpenModuleForAgentPacket>(ModuleID::microscope<2, Substance::Energy>(), getGID()));
 		InventoriedTileEntity::addObserver(player, true);
 		EnergeticTileEntity::addObserver(player, true);
 
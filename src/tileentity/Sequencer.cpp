@@ -1,18 +1,23 @@
 #include "biology/Gene.h"
 #include "entity/Player.h"
-#include "game/ClientGame.h"
 #include "game/EnergyContainer.h"
+#include "game/Game.h"
 #include "game/ServerInventory.h"
-#include "graphics/SpriteRenderer.h"
 #include "graphics/Tileset.h"
 #include "item/ContainmentOrb.h"
+#include "lib/JSON.h"
 #include "packet/OpenModuleForAgentPacket.h"
 #include "realm/Realm.h"
 #include "threading/ThreadContext.h"
 #include "tileentity/Sequencer.h"
-#include "ui/module/MicroscopeModule.h"
+#include "ui/module/ModuleIDs.h"
 #include "util/Util.h"
 
+#ifndef GAME3_HEADLESS
+#include "game/ClientGame.h"
+#include "graphics/SpriteRenderer.h"
+#endif
+
 namespace Game3 {
 	namespace {
 		constexpr std::chrono::milliseconds PERIOD{5'000};
@@ -87,7 +92,9 @@ namespace Game3 {
 
 		const Gene &gene = *choose(gene_pointers, threadContext.rng);
 		ItemStackPtr gene_stack = ItemStack::create(getGame(), "base:item/gene");
-		gene.toJSON(gene_stack->data.at("gene"));
+		gene_stack->data.mutate([&](boost::json::value &data) {
+			gene.toJSON(ensureObject(data)["gene"]);
+		});
 
 		const bool has_leftovers = inventory->add(gene_stack) != nullptr;
 		assert(!has_leftovers);
@@ -116,7 +123,7 @@ namespace Game3 {
 			return true;
 		}
 
-		player->send(make<OpenModuleForAgentPacket>(MicroscopeModule<1, Substance::Energy>::ID(), getGID()));
+		player->send(make<OpenModuleForAgentPacket>(ModuleID::microscope<1, Substance::Energy>(), getGID()));
 		InventoriedTileEntity::addObserver(player, true);
 		EnergeticTileEntity::addObserver(player, true);
 
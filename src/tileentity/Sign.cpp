@@ -1,16 +1,19 @@
 #include "entity/Player.h"
-#include "game/ClientGame.h"
 #include "game/ServerGame.h"
-#include "graphics/SpriteRenderer.h"
 #include "graphics/Tileset.h"
 #include "lib/JSON.h"
 #include "packet/InteractPacket.h"
 #include "packet/UpdateAgentFieldPacket.h"
 #include "realm/Realm.h"
 #include "tileentity/Sign.h"
+#include "util/ConstexprHash.h"
+
+#ifndef GAME3_HEADLESS
+#include "game/ClientGame.h"
+#include "graphics/SpriteRenderer.h"
 #include "ui/Window.h"
 #include "ui/dialog/EditSignDialog.h"
-#include "util/ConstexprHash.h"
+#endif
 
 namespace Game3 {
 	Sign::Sign(Identifier tilename, Position position_, std::string text_, std::string name_):
@@ -28,7 +31,9 @@ namespace Game3 {
 			player->send(make<InteractPacket>(false, hand, modifiers, getGID()));
 		} else if (!modifiers.onlyShift()) {
 			player->showText(text, name);
-		} else {
+		}
+#ifndef GAME3_HEADLESS
+		else {
 			ClientGamePtr game = player->getGame()->toClientPointer();
 			WindowPtr window = game->getWindow();
 			window->queue([this, game](Window &window) {
@@ -39,6 +44,7 @@ namespace Game3 {
 				});
 			});
 		}
+#endif
 		return true;
 	}
 
@@ -1,10 +1,14 @@
 #include "entity/Player.h"
+#include "game/Game.h"
 #include "graphics/Tileset.h"
-#include "game/ClientGame.h"
-#include "graphics/SpriteRenderer.h"
 #include "realm/Realm.h"
 #include "tileentity/Tank.h"
 
+#ifndef GAME3_HEADLESS
+#include "game/ClientGame.h"
+#include "graphics/SpriteRenderer.h"
+#endif
+
 namespace Game3 {
 	Tank::Tank(Identifier tile_id, Position position_):
 		TileEntity(std::move(tile_id), ID(), position_, true) {}
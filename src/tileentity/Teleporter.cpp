@@ -1,11 +1,14 @@
 #include "entity/Player.h"
 #include "game/Game.h"
-#include "graphics/SpriteRenderer.h"
 #include "graphics/Tileset.h"
 #include "lib/JSON.h"
 #include "realm/Realm.h"
 #include "tileentity/Teleporter.h"
 
+#ifndef GAME3_HEADLESS
+#include "graphics/SpriteRenderer.h"
+#endif
+
 namespace Game3 {
 	Teleporter::Teleporter(Identifier tilename, Position position, RealmID targetRealm, Position targetPosition, Identifier soundSetID):
 		TileEntity(std::move(tilename), ID(), position, false),
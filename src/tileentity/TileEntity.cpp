@@ -1,5 +1,3 @@
-#include "entity/ClientPlayer.h"
-#include "game/ClientGame.h"
 #include "game/ServerGame.h"
 #include "graphics/Tileset.h"
 #include "lib/JSON.h"
@@ -9,9 +7,14 @@
 #include "realm/Realm.h"
 #include "tileentity/TileEntity.h"
 #include "tileentity/TileEntityFactory.h"
-#include "ui/Window.h"
 #include "util/Cast.h"
 
+#ifndef GAME3_HEADLESS
+#include "entity/ClientPlayer.h"
+#include "game/ClientGame.h"
+#include "ui/Window.h"
+#endif
+
 namespace Game3 {
 	void TileEntity::destroy() {
 		RealmPtr realm = getRealm();
@@ -61,6 +64,7 @@ namespace Game3 {
 		tryBroadcast();
 	}
 
+#ifndef GAME3_HEADLESS
 	void TileEntity::render(SpriteRenderer &sprite_renderer) {
 		if (!isVisible()) {
 			return;
@@ -133,6 +137,7 @@ namespace Game3 {
 	}
 
 	void TileEntity::renderLighting(const RendererContext &) {}
+#endif
 
 	void TileEntity::onOverlap(const EntityPtr &) {}
 
@@ -146,10 +151,16 @@ namespace Game3 {
 	}
 
 	void TileEntity::onRemove() {
+#ifndef GAME3_HEADLESS
 		GamePtr game = getRealm()->getGame();
 		if (game->getSide() == Side::Client) {
 			game->toClient().moduleMessage({}, shared_from_this(), "TileEntityRemoved", Side::Client);
 		}
+#endif
+	}
+
+	void TileEntity::onNeighborUpdated(Position) {
+		wake(WakeCondition::Neighbor);
 	}
 
 	void TileEntity::setRealm(const RealmPtr &realm) {
@@ -173,22 +184,26 @@ namespace Game3 {
 	bool TileEntity::isVisible() const {
 		const Position pos = getPosition();
 		RealmPtr realm = getRealm();
+#ifndef GAME3_HEADLESS
 		if (getSide() == Side::Client) {
 			GamePtr game = realm->getGame();
 			ClientGame &client_game = game->toClient();
 			return client_game.getWindow()->inBounds(pos) && ChunkRange(client_game.getPlayer()->getChunk()).contains(pos.getChunk());
 		}
+#endif
 		return realm->isVisible(pos);
 	}
 
 	bool TileEntity::isVisible(const Position &offset) const {
 		const Position pos = getPosition() + offset;
 		RealmPtr realm = getRealm();
+#ifndef GAME3_HEADLESS
 		if (getSide() == Side::Client) {
 			GamePtr game = realm->getGame();
 			ClientGame &client_game = game->toClient();
 			return client_game.getWindow()->inBounds(pos) && ChunkRange(client_game.getPlayer()->getChunk()).contains(pos.getChunk());
 		}
+#endif
 		return realm->isVisible(pos);
 	}
 
@@ -242,6 +257,30 @@ namespace Game3 {
 		tileLookupFailed = false;
 	}
 
+	bool TileEntity::wake(WakeCondition conditions) {
+		const uint8_t mask = static_cast<uint8_t>(conditions);
+		pendingWakes.fetch_or(mask);
+
+		uint8_t sleeping = sleepConditions.load();
+		do {
+			if ((sleeping & mask) == 0) {
+				return false;
+			}
+		} while (!sleepConditions.compare_exchange_weak(sleeping, 0));
+
+		GamePtr game = getGame();
+		if (const Tick period = sleepPeriod.load(); 0 < period) {
+			game->skippedTileEntityTicks += (game->getCurrentTick() - sleepTick) / period;
+		}
+
+		game->toServer().queueWake(getTickFunction());
+		return true;
+	}
+
+	bool TileEntity::isSleeping() const {
+		return sleepConditions != 0;
+	}
+
 	void TileEntity::handleMessage(const std::shared_ptr<Agent> &, const std::string &name, std::any &data) {
 		if (name == "GetName") {
 			data = Buffer{Side::Client, getName()};
@@ -325,6 +364,7 @@ namespace Game3 {
 	std::function<void(const TickArgs &)> TileEntity::getTickFunction() {
 		return [weak = getWeakSelf()](const TickArgs &args) {
 			if (TileEntityPtr tile_entity = weak.lock()) {
+				tile_entity->pendingWakes = 0;
 				tile_entity->tick(args);
 			}
 		};
@@ -338,6 +378,20 @@ namespace Game3 {
 		return getGame()->enqueue(getTickFunction());
 	}
 
+	void TileEntity::sleepUntil(WakeCondition conditions, std::chrono::nanoseconds period) {
+		assert(conditions != WakeCondition::None);
+		GamePtr game = getGame();
+		sleepTick = game->getCurrentTick();
+		sleepPeriod = game->getDelayTicks(period);
+
+		const uint8_t mask = static_cast<uint8_t>(conditions);
+		sleepConditions = mask;
+
+		if ((pendingWakes & mask) != 0) {
+			wake(conditions);
+		}
+	}
+
 	void TileEntity::absorbJSON(const GamePtr &game, const boost::json::value &json) {
 		assert(game->getSide() == Side::Server);
 		tileEntityID = boost::json::value_to<Identifier>(json.at("id"));
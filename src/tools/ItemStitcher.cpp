@@ -1,7 +1,6 @@
 #include "config.h"
 #include "util/Log.h"
 #include "game/Resource.h"
-#include "graphics/GL.h"
 #include "graphics/ItemSet.h"
 #include "graphics/Texture.h"
 #include "registry/Registries.h"
@@ -37,8 +36,8 @@ namespace Game3 {
 
 		TexturePtr texture = std::make_shared<Texture>(itemset_name);
 		texture->alpha  = true;
-		texture->filter = GL_NEAREST;
-		texture->format = GL_RGBA;
+		texture->filter = Texture::NEAREST;
+		texture->format = Texture::RGBA;
 
 		ItemSet out(itemset_name);
 		Hasher hasher(Hasher::Algorithm::SHA3_512);
@@ -179,7 +178,9 @@ namespace Game3 {
 			*png_out = std::move(ss).str();
 		}
 
+#ifndef GAME3_HEADLESS
 		texture->init(std::move(raw), dimension, dimension);
+#endif
 
 		out.cachedTexture = std::move(texture);
 
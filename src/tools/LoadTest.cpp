@@ -0,0 +1,692 @@
+#include "Constants.h"
+#include "entity/ServerPlayer.h"
+#include "game/Inventory.h"
+#include "game/ServerGame.h"
+#include "game/SimulationOptions.h"
+#include "item/PipeItem.h"
+#include "lib/JSON.h"
+#include "net/Buffer.h"
+#include "net/CertGen.h"
+#include "net/GenericClient.h"
+#include "net/Server.h"
+#include "packet/ChunkRequestPacket.h"
+#include "packet/ClickPacket.h"
+#include "packet/CommandPacket.h"
+#include "packet/LoginPacket.h"
+#include "packet/MovePlayerPacket.h"
+#include "packet/SendChatMessagePacket.h"
+#include "packet/SetActiveSlotPacket.h"
+#include "threading/Lockable.h"
+#include "threading/ThreadContext.h"
+#include "tools/LoadTest.h"
+#include "types/Direction.h"
+#include "util/Crypto.h"
+#include "util/Defer.h"
+#include "util/Math.h"
+#include "util/Util.h"
+
+#include "lib/ASIO.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <deque>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <random>
+#include <set>
+#include <thread>
+#include <tuple>
+#include <unistd.h>
+
+namespace Game3 {
+	namespace {
+		enum class Scenario {Walk, Explore, Mine, Pipes, Chat, Mixed};
+
+		/** Direct bots hand packets to the game in memory. TLS bots connect to the server's listening socket over
+		 *  loopback, so the measurements include RemoteClient's encoding, buffering and socket writes. */
+		enum class Transport {Direct, TLS};
+
+		std::optional<Scenario> parseScenario(std::string_view name) {
+			if (name == "walk")    return Scenario::Walk;
+			if (name == "explore") return Scenario::Explore;
+			if (name == "mine")    return Scenario::Mine;
+			if (name == "pipes")   return Scenario::Pipes;
+			if (name == "chat")    return Scenario::Chat;
+			if (name == "mixed")   return Scenario::Mixed;
+			return std::nullopt;
+		}
+
+		std::optional<Transport> parseTransport(std::string_view name) {
+			if (name == "direct") return Transport::Direct;
+			if (name == "tls")    return Transport::TLS;
+			return std::nullopt;
+		}
+
+		/** Reads the resident set size from /proc. Returns 0 where that isn't available. */
+		size_t getResidentBytes() {
+			std::ifstream statm("/proc/self/statm");
+			size_t total_pages = 0;
+			size_t resident_pages = 0;
+			if (!(statm >> total_pages >> resident_pages)) {
+				return 0;
+			}
+			return resident_pages * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+		}
+
+		double getPercentile(const std::vector<double> &sorted, double percentile) {
+			if (sorted.empty()) {
+				return 0;
+			}
+			return sorted[std::min(sorted.size() - 1, static_cast<size_t>(percentile * sorted.size()))];
+		}
+
+		/** A server-side client that swallows everything the server sends, counting the bytes it would have written to a socket. */
+		class LoadTestClient: public GenericClient {
+			public:
+				std::atomic_size_t bytesSent{0};
+				std::atomic_size_t packetsSent{0};
+
+				LoadTestClient(const std::shared_ptr<Server> &server, int id):
+					GenericClient(server, "loadtest", id) {}
+
+				void start() final {}
+
+				bool send(const PacketPtr &packet) final {
+					if (packet == nullptr || !packet->valid) {
+						return false;
+					}
+
+					ServerPtr server = getServer();
+					if (server == nullptr) {
+						return false;
+					}
+
+					ServerGamePtr game = server->getGame();
+					if (game == nullptr) {
+						return false;
+					}
+
+					// Encode exactly as RemoteClient does so that the serialization cost and the byte count are realistic.
+					Buffer send_buffer{Side::Client};
+					packet->encode(*game, send_buffer);
+					bytesSent += send_buffer.size() + sizeof(PacketID) + sizeof(uint32_t);
+					++packetsSent;
+					return true;
+				}
+
+				void send(std::string message, bool) final {
+					bytesSent += message.size();
+				}
+
+				void handleInput(std::string_view) final {}
+
+				bool isBuffering() const final {
+					return false;
+				}
+
+				void close() final {}
+
+				void removeSelf() final {
+					ServerPtr server = getServer();
+					if (server == nullptr) {
+						return;
+					}
+
+					if (ServerGamePtr game = server->getGame()) {
+						if (ServerPlayerPtr player = getPlayer()) {
+							game->queueRemoval(player);
+						}
+					}
+
+					server->close(shared_from_this());
+					server->getClients().withUnique([this](std::unordered_set<GenericClientPtr> &clients) {
+						clients.erase(shared_from_this());
+					});
+				}
+
+				std::unique_ptr<BufferGuard> bufferGuard() final {
+					return std::make_unique<BufferGuard>();
+				}
+		};
+
+		/** A bot's end of its connection to the server. */
+		class BotConnection {
+			public:
+				virtual ~BotConnection() = default;
+
+				virtual void send(const ServerGamePtr &, const PacketPtr &) = 0;
+				/** Returns the bot's player once the server has logged it in. */
+				virtual ServerPlayerPtr getPlayer(const ServerGamePtr &) const = 0;
+				/** Returns the number of bytes the server has sent to this bot, packet headers included. */
+				virtual size_t getBytesReceived() const = 0;
+				virtual size_t getPacketsReceived() const = 0;
+				virtual void close(const ServerGamePtr &) = 0;
+		};
+
+		/** Pairs a bot with a LoadTestClient in place of DirectLocalClient and DirectRemoteClient. DirectLocalClient
+		 *  hands everything it receives to a ClientGame, which headless builds don't have and which would make the
+		 *  test measure client-side work as well. */
+		class DirectConnection: public BotConnection {
+			public:
+				DirectConnection(const ServerPtr &server, int id):
+					client(std::make_shared<LoadTestClient>(server, id)) {
+						server->getClients().withUnique([&](std::unordered_set<GenericClientPtr> &clients) {
+							clients.insert(client);
+						});
+					}
+
+				void send(const ServerGamePtr &game, const PacketPtr &packet) final {
+					game->queuePacket(client, packet);
+				}
+
+				ServerPlayerPtr getPlayer(const ServerGamePtr &) const final {
+					return client->getPlayer();
+				}
+
+				size_t getBytesReceived() const final {
+					return client->bytesSent;
+				}
+
+				size_t getPacketsReceived() const final {
+					return client->packetsSent;
+				}
+
+				void close(const ServerGamePtr &) final {
+					client->removeSelf();
+				}
+
+			private:
+				std::shared_ptr<LoadTestClient> client;
+		};
+
+		/** Connects a bot to the server's socket over loopback TLS. Everything the server sends is read on the
+		 *  connection's own thread and thrown away after its bytes and packets are counted. */
+		class TLSConnection: public BotConnection {
+			public:
+				TLSConnection(std::string username_, uint16_t port):
+					username(std::move(username_)),
+					sslContext(asio::ssl::context::tls_client),
+					socket(ioContext, sslContext) {
+						socket.set_verify_mode(asio::ssl::verify_none);
+						socket.lowest_layer().connect(asio::ip::tcp::endpoint(asio::ip::make_address("::1"), port));
+						socket.lowest_layer().set_option(asio::ip::tcp::no_delay(true));
+						socket.handshake(asio::ssl::stream_base::client);
+						doRead();
+						thread = std::thread([this] {
+							threadContext.rename("LoadTestTLS");
+							ioContext.run();
+						});
+					}
+
+				~TLSConnection() override {
+					close(nullptr);
+				}
+
+				void send(const ServerGamePtr &game, const PacketPtr &packet) final {
+					// Framed the same way LocalClient frames packets.
+					Buffer buffer{Side::Server};
+					buffer.context = game;
+					packet->encode(*game, buffer);
+					const auto packet_id = toLittle(packet->getID());
+					const auto size = toLittle(static_cast<uint32_t>(buffer.size()));
+					const auto str = buffer.str();
+
+					std::string message;
+					message.reserve(sizeof(packet_id) + sizeof(size) + str.size());
+					message.append(reinterpret_cast<const char *>(&packet_id), sizeof(packet_id));
+					message.append(reinterpret_cast<const char *>(&size), sizeof(size));
+					message.append(str.data(), str.size());
+
+					asio::post(ioContext, [this, message = std::move(message)]() mutable {
+						outbox.push_back(std::move(message));
+						if (outbox.size() == 1) {
+							write();
+						}
+					});
+				}
+
+				ServerPlayerPtr getPlayer(const ServerGamePtr &game) const final {
+					auto lock = game->playerMap.sharedLock();
+					if (auto iter = game->playerMap.find(username); iter != game->playerMap.end()) {
+						return iter->second;
+					}
+					return nullptr;
+				}
+
+				size_t getBytesReceived() const final {
+					return bytesReceived;
+				}
+
+				size_t getPacketsReceived() const final {
+					return packetsReceived;
+				}
+
+				void close(const ServerGamePtr &) final {
+					if (!thread.joinable()) {
+						return;
+					}
+
+					// If the server already closed the connection, ioContext has run out of work and this never runs.
+					asio::post(ioContext, [this] {
+						asio::error_code ignored;
+						socket.lowest_layer().close(ignored);
+					});
+					thread.join();
+				}
+
+			private:
+				std::string username;
+				asio::io_context ioContext;
+				asio::ssl::context sslContext;
+				asio::ssl::stream<asio::ip::tcp::socket> socket;
+				std::thread thread;
+				std::array<char, 16'384> readBuffer{};
+				/** Only touched on the connection's thread. */
+				std::deque<std::string> outbox;
+				std::atomic_size_t bytesReceived{0};
+				std::atomic_size_t packetsReceived{0};
+				std::array<char, sizeof(PacketID) + sizeof(uint32_t)> header{};
+				size_t headerFill = 0;
+				size_t payloadLeft = 0;
+
+				void write() {
+					asio::async_write(socket, asio::buffer(outbox.front()), [this](const asio::error_code &errc, size_t) {
+						if (errc) {
+							outbox.clear();
+							return;
+						}
+
+						outbox.pop_front();
+						if (!outbox.empty()) {
+							write();
+						}
+					});
+				}
+
+				void doRead() {
+					socket.async_read_some(asio::buffer(readBuffer), [this](const asio::error_code &errc, size_t length) {
+						if (errc) {
+							return;
+						}
+
+						count(std::string_view(readBuffer.data(), length));
+						doRead();
+					});
+				}
+
+				/** Follows the packet framing to count whole packets. */
+				void count(std::string_view bytes) {
+					bytesReceived += bytes.size();
+
+					while (!bytes.empty()) {
+						if (headerFill < header.size()) {
+							const size_t taken = std::min(header.size() - headerFill, bytes.size());
+							std::copy_n(bytes.begin(), taken, header.begin() + headerFill);
+							headerFill += taken;
+							bytes.remove_prefix(taken);
+
+							if (headerFill == header.size()) {
+								uint32_t size{};
+								std::memcpy(&size, header.data() + sizeof(PacketID), sizeof(size));
+								payloadLeft = toLittle(size);
+								++packetsReceived;
+								if (payloadLeft == 0) {
+									headerFill = 0;
+								}
+							}
+							continue;
+						}
+
+						const size_t taken = std::min(payloadLeft, bytes.size());
+						payloadLeft -= taken;
+						bytes.remove_prefix(taken);
+						if (payloadLeft == 0) {
+							headerFill = 0;
+						}
+					}
+				}
+		};
+
+		class Bot {
+			public:
+				std::unique_ptr<BotConnection> connection;
+				Scenario scenario;
+				size_t index;
+
+				Bot(std::unique_ptr<BotConnection> connection_, Scenario scenario_, size_t index_):
+					connection(std::move(connection_)),
+					scenario(scenario_),
+					index(index_),
+					rng(index_ * 7919 + 1) {}
+
+				void act(const ServerGamePtr &game) {
+					ServerPlayerPtr player = connection->getPlayer(game);
+
+					// Login is handled on the next server tick.
+					if (!player) {
+						return;
+					}
+
+					if (!initialized) {
+						initialize(game);
+						return;
+					}
+
+					const PlayerState state = readState(*player);
+
+					switch (scenario) {
+						case Scenario::Walk:    walk(game, state); break;
+						case Scenario::Explore: explore(game, state); break;
+						case Scenario::Mine:    mine(game, state); break;
+						case Scenario::Pipes:   placePipes(game, state); break;
+						case Scenario::Chat:    chat(game); break;
+						case Scenario::Mixed:   break;
+					}
+
+					++steps;
+				}
+
+			private:
+				/** What a bot needs to know about its player, copied out while the game thread keeps running. */
+				struct PlayerState {
+					Position position;
+					RealmID realmID{};
+					InventoryPtr inventory;
+				};
+
+				std::default_random_engine rng;
+				Direction heading = Direction::Down;
+				size_t steps = 0;
+				bool initialized = false;
+				bool pipeSlotSelected = false;
+
+				void send(const ServerGamePtr &game, const PacketPtr &packet) {
+					connection->send(game, packet);
+				}
+
+				void initialize(const ServerGamePtr &game) {
+					heading = ALL_DIRECTIONS[index % ALL_DIRECTIONS.size()];
+
+					if (scenario == Scenario::Mine) {
+						// New players start with their pickaxe in the first slot.
+						send(game, make<SetActiveSlotPacket>(0));
+					} else if (scenario == Scenario::Pipes) {
+						send(game, make<CommandPacket>(-1, "give item_pipe 999"));
+					}
+
+					initialized = true;
+				}
+
+				static PlayerState readState(const ServerPlayer &player) {
+					auto player_lock = player.sharedLock();
+					return PlayerState{
+						.position = player.getPosition(),
+						.realmID = player.realmID,
+						.inventory = player.getInventory(0),
+					};
+				}
+
+				void step(const ServerGamePtr &game, const PlayerState &player, Direction direction) {
+					send(game, make<MovePlayerPacket>(player.position + direction, direction, direction));
+				}
+
+				void walk(const ServerGamePtr &game, const PlayerState &player) {
+					if (std::uniform_int_distribution(0, 3)(rng) == 0) {
+						heading = ALL_DIRECTIONS[std::uniform_int_distribution<size_t>(0, ALL_DIRECTIONS.size() - 1)(rng)];
+					}
+
+					step(game, player, heading);
+				}
+
+				void explore(const ServerGamePtr &game, const PlayerState &player) {
+					step(game, player, heading);
+
+					if (steps % 16 == 0) {
+						const Position unit = Position{} + heading;
+						const ChunkPosition ahead{player.position + unit * (2 * CHUNK_SIZE)};
+						send(game, make<ChunkRequestPacket>(player.realmID, std::set<ChunkRequest>{ChunkRequest(ahead)}, true));
+					}
+				}
+
+				void mine(const ServerGamePtr &game, const PlayerState &player) {
+					send(game, make<ClickPacket>(player.position + heading, 0.5f, 0.5f, Modifiers{}));
+
+					if (steps % 8 == 7) {
+						heading = ALL_DIRECTIONS[std::uniform_int_distribution<size_t>(0, ALL_DIRECTIONS.size() - 1)(rng)];
+						step(game, player, heading);
+					}
+				}
+
+				void placePipes(const ServerGamePtr &game, const PlayerState &player) {
+					if (!pipeSlotSelected) {
+						if (!player.inventory) {
+							return;
+						}
+
+						std::optional<Slot> slot;
+						{
+							auto inventory_lock = player.inventory->sharedLock();
+							slot = player.inventory->find(ItemPipeItem::ID());
+						}
+
+						if (!slot) {
+							return;
+						}
+						send(game, make<SetActiveSlotPacket>(*slot));
+						pipeSlotSelected = true;
+						return;
+					}
+
+					send(game, make<ClickPacket>(player.position + heading, 0.5f, 0.5f, Modifiers{}));
+					step(game, player, heading);
+
+					if (steps % 24 == 23) {
+						heading = ALL_DIRECTIONS[std::uniform_int_distribution<size_t>(0, ALL_DIRECTIONS.size() - 1)(rng)];
+					}
+				}
+
+				void chat(const ServerGamePtr &game) {
+					send(game, make<SendChatMessagePacket>(std::format("bot{} message {}", index, steps)));
+				}
+		};
+	}
+
+	int loadTest(const std::vector<std::string> &args) {
+		if (args.size() < 2) {
+			std::cerr << "Usage: --loadtest <bots> <walk|explore|mine|pipes|chat|mixed> [seconds] [direct|tls]\n";
+			return 1;
+		}
+
+		size_t bot_count{};
+		size_t duration_seconds = 60;
+
+		try {
+			bot_count = parseNumber<size_t>(args[0]);
+			if (2 < args.size()) {
+				duration_seconds = parseNumber<size_t>(args[2]);
+			}
+		} catch (const std::invalid_argument &) {
+			std::cerr << "Invalid number.\n";
+			return 1;
+		}
+
+		const std::optional<Scenario> scenario = parseScenario(args[1]);
+		if (!scenario) {
+			std::cerr << "Unknown scenario: " << args[1] << '\n';
+			return 1;
+		}
+
+		const std::string transport_name = 3 < args.size()? args[3] : "direct";
+		const std::optional<Transport> transport = parseTransport(transport_name);
+		if (!transport) {
+			std::cerr << "Unknown transport: " << transport_name << '\n';
+			return 1;
+		}
+
+		const std::filesystem::path directory = std::filesystem::temp_directory_path() / std::format("game3-loadtest-{}", std::random_device{}());
+		std::filesystem::create_directories(directory);
+		Defer cleanup([&] { std::filesystem::remove_all(directory); });
+
+		const std::filesystem::path certificate_path = directory / "loadtest.crt";
+		const std::filesystem::path key_path = directory / "loadtest.key";
+		generateCertPair(certificate_path, key_path);
+
+		// Port 0 lets the OS pick. Only TLS bots connect to it.
+		ServerPtr server = Server::create("::1", 0, certificate_path, key_path, generateSecret(8), 1);
+		auto game = std::dynamic_pointer_cast<ServerGame>(Game::create(Side::Server, std::make_pair(server, 8uz)));
+		game->openDatabase(directory / "world.game3");
+		server->weakGame = game;
+		game->initialWorldgen(1621);
+		game->initEntities();
+		game->initInteractionSets();
+
+		std::thread server_thread;
+		if (*transport == Transport::TLS) {
+			server_thread = std::thread([&] {
+				threadContext.rename("LoadTestServer");
+				server->run();
+			});
+		}
+
+		std::vector<Bot> bots;
+		bots.reserve(bot_count);
+
+		for (size_t i = 0; i < bot_count; ++i) {
+			const std::string username = std::format("bot{}", i);
+			std::unique_ptr<BotConnection> connection;
+			if (*transport == Transport::TLS) {
+				connection = std::make_unique<TLSConnection>(username, server->acceptor.local_endpoint().port());
+			} else {
+				connection = std::make_unique<DirectConnection>(server, static_cast<int>(i));
+			}
+
+			Scenario bot_scenario = *scenario;
+			if (bot_scenario == Scenario::Mixed) {
+				bot_scenario = static_cast<Scenario>(i % static_cast<size_t>(Scenario::Mixed));
+			}
+
+			connection->send(game, make<LoginPacket>(username, game->getOmnitoken(), std::format("Bot {}", i)));
+			bots.emplace_back(std::move(connection), bot_scenario, i);
+		}
+
+		std::atomic_bool running{true};
+		Lockable<std::vector<double>> tick_samples;
+
+		std::thread tick_thread([&] {
+			threadContext.rename("LoadTestTick");
+			while (running) {
+				const auto start = std::chrono::steady_clock::now();
+				game->tick();
+				const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+				tick_samples.withUnique([&](std::vector<double> &samples) {
+					samples.push_back(elapsed.count());
+				});
+				std::this_thread::sleep_for(std::chrono::milliseconds(SERVER_TICK_PERIOD));
+			}
+		});
+
+		std::thread driver_thread([&] {
+			threadContext.rename("LoadTestBots");
+			constexpr std::chrono::milliseconds action_period{250};
+			while (running) {
+				const auto start = std::chrono::steady_clock::now();
+				for (Bot &bot: bots) {
+					bot.act(game);
+				}
+				std::this_thread::sleep_until(start + action_period);
+			}
+		});
+
+		auto get_totals = [&] {
+			size_t bytes = 0;
+			size_t packets = 0;
+			size_t online = 0;
+			for (const Bot &bot: bots) {
+				bytes += bot.connection->getBytesReceived();
+				packets += bot.connection->getPacketsReceived();
+				online += bot.connection->getPlayer(game) != nullptr;
+			}
+			return std::make_tuple(bytes, packets, online);
+		};
+
+		std::vector<double> all_samples;
+		size_t peak_resident = 0;
+		size_t last_bytes = 0;
+		const auto test_start = std::chrono::steady_clock::now();
+
+		for (size_t second = 1; second <= duration_seconds; ++second) {
+			std::this_thread::sleep_until(test_start + std::chrono::seconds(second));
+
+			std::vector<double> samples = tick_samples.withUnique([](std::vector<double> &samples) {
+				return std::exchange(samples, {});
+			});
+
+			std::sort(samples.begin(), samples.end());
+			all_samples.insert(all_samples.end(), samples.begin(), samples.end());
+
+			const auto [bytes, packets, online] = get_totals();
+			const size_t resident = getResidentBytes();
+			peak_resident = std::max(peak_resident, resident);
+
+			boost::json::object line;
+			line["t"] = second;
+			line["tps"] = samples.size();
+			line["tickP50Ms"] = getPercentile(samples, 0.5);
+			line["tickP90Ms"] = getPercentile(samples, 0.9);
+			line["tickP99Ms"] = getPercentile(samples, 0.99);
+			line["tickMaxMs"] = samples.empty()? 0. : samples.back();
+			line["online"] = online;
+			line["bytesPerPlayer"] = bot_count == 0? 0 : (bytes - last_bytes) / bot_count;
+			line["packets"] = packets;
+			line["rssBytes"] = resident;
+			std::cout << boost::json::serialize(line) << std::endl;
+			last_bytes = bytes;
+		}
+
+		running = false;
+		driver_thread.join();
+		tick_thread.join();
+
+		std::sort(all_samples.begin(), all_samples.end());
+		const auto [bytes, packets, online] = get_totals();
+
+		boost::json::object summary;
+		summary["summary"] = true;
+		summary["bots"] = bot_count;
+		summary["scenario"] = args[1];
+		summary["transport"] = transport_name;
+		summary["seconds"] = duration_seconds;
+		summary["meanTps"] = duration_seconds == 0? 0. : static_cast<double>(all_samples.size()) / duration_seconds;
+		summary["tickP50Ms"] = getPercentile(all_samples, 0.5);
+		summary["tickP99Ms"] = getPercentile(all_samples, 0.99);
+		summary["tickMaxMs"] = all_samples.empty()? 0. : all_samples.back();
+		summary["totalBytesPerPlayer"] = bot_count == 0? 0 : bytes / bot_count;
+		summary["totalPackets"] = packets;
+		summary["peakRssBytes"] = peak_resident;
+		std::cout << boost::json::serialize(summary) << std::endl;
+
+		for (Bot &bot: bots) {
+			bot.connection->close(game);
+		}
+
+		game->tick();
+		bots.clear();
+
+		if (server_thread.joinable()) {
+			server->workGuard.reset();
+			server->context.stop();
+			server_thread.join();
+		}
+
+		server->weakGame.reset();
+		game.reset();
+		server.reset();
+		return 0;
+	}
+}
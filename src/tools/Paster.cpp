@@ -117,13 +117,17 @@ namespace Game3 {
 		{
 			auto pauser = realm->guardGeneration();
 
-			for (const auto &[position, layers]: tiles) {
-				const Position adjusted = anchor + position;
-				chunks.insert(adjusted.getChunk());
-				for (Layer layer: allLayers) {
-					if (destructive)
-						realm->setFluid(adjusted, FluidTile{});
-					realm->setTile(layer, adjusted, *layers.at(getIndex(layer)), true);
+			{
+				auto batch = realm->batchTileUpdates();
+
+				for (const auto &[position, layers]: tiles) {
+					const Position adjusted = anchor + position;
+					chunks.insert(adjusted.getChunk());
+					for (Layer layer: allLayers) {
+						if (destructive)
+							realm->setFluid(adjusted, FluidTile{});
+						realm->setTile(layer, adjusted, *layers.at(getIndex(layer)), true);
+					}
 				}
 			}
 
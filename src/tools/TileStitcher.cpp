@@ -1,6 +1,5 @@
 #include "config.h"
 #include "util/Log.h"
-#include "graphics/GL.h"
 #include "graphics/Texture.h"
 #include "lib/JSON.h"
 #include "tools/TileStitcher.h"
@@ -468,6 +467,7 @@ namespace Game3 {
 		out.hash = hexString(hasher.value<std::string>(), false);
 		out.ids["base:tile/empty"] = 0;
 		out.names[0] = "base:tile/empty";
+		out.compileAutotiles();
 
 		if (png_out != nullptr) {
 			std::stringstream ss;
@@ -480,15 +480,17 @@ namespace Game3 {
 			*png_out = std::move(ss).str();
 		}
 
+#ifndef GAME3_HEADLESS
 		if (side == Side::Client) {
 			auto texture = std::make_shared<Texture>(std::move(tileset_name));
 			texture->alpha = true;
-			texture->filter = GL_NEAREST;
-			texture->format = GL_RGBA;
+			texture->filter = Texture::NEAREST;
+			texture->format = Texture::RGBA;
 			texture->init(raw, dimension, dimension);
 
 			out.cachedTexture = std::move(texture);
 		}
+#endif
 
 		return out;
 	}
@@ -1,10 +1,13 @@
-#include "graphics/TextRenderer.h"
 #include "net/Buffer.h"
 #include "test/Testing.h"
 #include "types/UString.h"
 #include "util/Log.h"
 #include "util/Timer.h"
 
+#ifndef GAME3_HEADLESS
+#include "graphics/TextRenderer.h"
+#endif
+
 namespace Game3 {
 	UString::UString(Glib::ustring &&other) noexcept {
 		*this = std::move(other);
@@ -78,6 +81,7 @@ namespace Game3 {
 		return out;
 	}
 
+#ifndef GAME3_HEADLESS
 	UString UString::wrap(const TextRenderer &texter, float max_width, float text_scale) const {
 		Timer timer{"UString::wrap"};
 
@@ -192,6 +196,7 @@ namespace Game3 {
 
 		return output;
 	}
+#endif
 
 	UStringSpan UString::span(size_t pos, size_t n) {
 		auto start = std::next(begin(), pos);
@@ -359,6 +359,7 @@ namespace Game3 {
 		auto [width, height] = getDimensions();
 
 		activateContext();
+		textRenderer.resetDrawCalls();
 		batchSpriteRenderer.update(*this);
 		singleSpriteRenderer.update(*this);
 		recolor.update(*this);
@@ -1209,7 +1210,7 @@ namespace Game3 {
 
 	void Window::renderFPSCounter() {
 		auto [width, height] = getDimensions();
-		textRenderer.drawOnScreen(std::format("{:.1f} FPS", runningFPS), TextRenderOptions{
+		textRenderer.drawOnScreen(std::format("{:.1f} FPS ({} text draws)", runningFPS, textRenderer.getDrawCalls()), TextRenderOptions{
 			.x = static_cast<double>(width - 10),
 			.y = static_cast<double>(height - 10),
 			.scaleX = 0.5,
@@ -49,10 +49,8 @@ namespace Game3 {
 			input.hideDropdown();
 		});
 		std::set<UString> item_names;
-		for (const auto &recipe: game->registry<CraftingRecipeRegistry>()) {
-			for (const ItemStackPtr &stack: recipe->output) {
-				item_names.insert(UString(stack->item->identifier.str()));
-			}
+		for (const auto &[item_id, recipes]: game->registry<CraftingRecipeRegistry>().getOutputIndex()) {
+			item_names.insert(UString(item_id.str()));
 		}
 		identifierInput->setSuggestions(std::vector(std::move_iterator(item_names.begin()), std::move_iterator(item_names.end())));
 		identifierInput->insertAtEnd(vbox);
@@ -93,7 +93,7 @@ namespace Game3 {
 	}
 
 	void GeneticAnalysisModule::analyzeGene(const ItemStackPtr &stack) {
-		const auto *object = stack->data.if_object();
+		const auto *object = stack->data->if_object();
 		if (!object) {
 			return;
 		}
@@ -114,7 +114,7 @@ namespace Game3 {
 	}
 
 	void GeneticAnalysisModule::analyzeTemplate(const ItemStackPtr &stack) {
-		auto *object = stack->data.if_object();
+		const auto *object = stack->data->if_object();
 		if (!object) {
 			return;
 		}
@@ -178,9 +178,7 @@ namespace Game3 {
 		// sellCount.set_adjustment(Gtk::Adjustment::create(max, 1.0, max));
 		// sellCount->setText(std::to_string(old_value));
 
-		std::optional<double> amount = village->getResourceAmount(stack->getID());
-
-		if (std::optional<MoneyCount> sell_price = totalSellPrice(amount.value_or(0.0), -1, stack->item->basePrice, static_cast<ItemCount>(old_value), village->getGreed())) {
+		if (std::optional<MoneyCount> sell_price = village->quoteSell(stack->getID(), stack->item->basePrice, static_cast<ItemCount>(old_value))) {
 			// sellButton.setTooltipText(std::format("Price: {}", *sell_price));
 			if (old_value == 0) {
 				totalPriceLabel->setText({});
@@ -1,6 +1,7 @@
 #include "data/RegisterableIdentifier.h"
 #include "entity/ClientPlayer.h"
 #include "game/ClientGame.h"
+#include "game/Inventory.h"
 #include "graphics/RendererContext.h"
 #include "graphics/Texture.h"
 #include "threading/ThreadContext.h"
@@ -47,6 +48,7 @@ namespace Game3 {
 	void CraftingTab::render(const RendererContext &renderers, float x, float y, float width, float height) {
 		maybeRemeasure(renderers, width, height);
 		assert(firstChild != nullptr);
+		updateCraftable();
 		Tab::render(renderers, x, y, width, height);
 		firstChild->render(renderers, x, y, width, height);
 	}
@@ -64,6 +66,7 @@ namespace Game3 {
 
 	void CraftingTab::reset() {
 		recipeList->clearChildren();
+		recipeRows.clear();
 
 		ClientPlayerPtr player = ui.getPlayer();
 		if (!player) {
@@ -74,9 +77,38 @@ namespace Game3 {
 
 		for (const std::vector<CraftingRecipePtr> *set: {&known.full, &known.partial}) {
 			for (const CraftingRecipePtr &recipe: *set) {
-				recipeList->append(make<RecipeRow>(ui, selfScale, recipe));
+				auto row = make<RecipeRow>(ui, selfScale, recipe);
+				recipeList->append(row);
+				recipeRows.push_back(std::move(row));
 			}
 		}
+
+		// New rows computed their counts when they were made.
+		if (InventoryPtr inventory = player->getInventory(0)) {
+			inventoryRevision = inventory->getRevision();
+		}
+	}
+
+	void CraftingTab::updateCraftable() {
+		ClientPlayerPtr player = ui.getPlayer();
+		if (!player) {
+			return;
+		}
+
+		InventoryPtr inventory = player->getInventory(0);
+		if (!inventory) {
+			return;
+		}
+
+		const uint64_t revision = inventory->getRevision();
+		if (inventoryRevision == revision) {
+			return;
+		}
+
+		inventoryRevision = revision;
+		for (const std::shared_ptr<RecipeRow> &row: recipeRows) {
+			row->getSlider()->updateMaximum();
+		}
 	}
 
 	void CraftingTab::queueReset() {
@@ -150,6 +182,7 @@ namespace Game3 {
 		}
 
 		append(make<Spacer>(ui, Orientation::Horizontal));
-		append(make<CraftingSlider>(ui, selfScale * 0.75, recipe));
+		slider = make<CraftingSlider>(ui, selfScale * 0.75, recipe);
+		append(slider);
 	}
 }
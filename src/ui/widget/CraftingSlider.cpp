@@ -1,5 +1,6 @@
 #include "util/Log.h"
 #include "entity/ClientPlayer.h"
+#include "game/Inventory.h"
 #include "graphics/Texture.h"
 #include "packet/CraftPacket.h"
 #include "recipe/CraftingRecipe.h"
@@ -14,6 +15,9 @@
 #include "ui/UIContext.h"
 #include "util/Util.h"
 
+#include <algorithm>
+#include <limits>
+
 namespace Game3 {
 	CraftingSlider::CraftingSlider(UIContext &ui, float scale, CraftingRecipePtr recipe):
 		Grid(ui, scale),
@@ -21,6 +25,7 @@ namespace Game3 {
 
 	void CraftingSlider::init() {
 		clearChildren();
+		computeMaximum();
 
 		auto make_increment = [this](ssize_t delta) {
 			return [this, delta](Widget &) {
@@ -83,12 +88,12 @@ namespace Game3 {
 		});
 		hbox->append(std::move(craft_button));
 
-		auto max_button = make<Button>(ui, selfScale);
-		max_button->setText(std::format("{}", getMaximum()));
-		max_button->setOnClick([this](Widget &) {
+		maxButton = make<Button>(ui, selfScale);
+		maxButton->setText(std::format("{}", getMaximum()));
+		maxButton->setOnClick([this](Widget &) {
 			setValue(getMaximum());
 		});
-		hbox->append(std::move(max_button));
+		hbox->append(maxButton);
 
 		attach(std::move(hbox), 1, 1);
 
@@ -110,7 +115,43 @@ namespace Game3 {
 		ui.getPlayer()->send(make<CraftPacket>(nextID++, recipe->registryID, value));
 	}
 
+	void CraftingSlider::updateMaximum() {
+		const std::size_t old_maximum = maximum;
+		computeMaximum();
+		if (maximum == old_maximum) {
+			return;
+		}
+
+		valueSlider->setRange(1.0, static_cast<double>(maximum));
+		maxButton->setText(std::format("{}", maximum));
+		if (maximum < value) {
+			setValue(maximum);
+		}
+	}
+
+	void CraftingSlider::computeMaximum() {
+		ClientPlayerPtr player = ui.getPlayer();
+		InventoryPtr inventory = player? player->getInventory(0) : nullptr;
+		if (!inventory) {
+			maximum = DEFAULT_MAXIMUM;
+			return;
+		}
+
+		ItemCount craftable{};
+		{
+			auto inventory_lock = inventory->sharedLock();
+			craftable = inventory->craftable(*recipe);
+		}
+
+		// A recipe without inputs can be crafted any number of times. The slider needs a range of at least one.
+		if (craftable == std::numeric_limits<ItemCount>::max()) {
+			maximum = DEFAULT_MAXIMUM;
+		} else {
+			maximum = std::max<std::size_t>(1, craftable);
+		}
+	}
+
 	std::size_t CraftingSlider::getMaximum() const {
-		return 64;
+		return maximum;
 	}
 }
@@ -22,6 +22,9 @@ namespace Game3 {
 
 		const Vector2d origin(place.position);
 
+		// Damaging the ground can change hundreds of tiles with overlapping neighborhoods.
+		auto batch = place.realm->batchTileUpdates();
+
 		iterateFilledCircle<Position::IntType>(place.position.column, place.position.row, options.radius, [&, &realm = *place.realm, origin, damage_scale = options.damageScale, radius = options.radius](auto x, auto y) {
 			Position position{y, x};
 
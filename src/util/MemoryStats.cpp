@@ -0,0 +1,159 @@
+#include "util/MemoryStats.h"
+
+#include <format>
+
+namespace Game3 {
+	namespace {
+		constexpr std::array<std::string_view, MemoryStats::SUBSYSTEM_COUNT> SUBSYSTEM_NAMES{"chunks", "entities", "tileentities", "inventories", "itemdata", "network"};
+
+		void updatePeak(std::atomic_uint64_t &peak, uint64_t value) {
+			uint64_t previous = peak.load(std::memory_order_relaxed);
+			while (previous < value && !peak.compare_exchange_weak(previous, value, std::memory_order_relaxed));
+		}
+
+		std::string formatBytes(uint64_t bytes) {
+			if (bytes < 10 * 1024) {
+				return std::format("{} B", bytes);
+			}
+
+			if (bytes < 10 * 1024 * 1024) {
+				return std::format("{:.1f} KiB", bytes / 1024.);
+			}
+
+			return std::format("{:.1f} MiB", bytes / 1024. / 1024.);
+		}
+	}
+
+	void MemoryStats::add(MemorySubsystem subsystem, size_t bytes) {
+		Counters &row = (*this)[subsystem];
+		updatePeak(row.peakBytes, row.bytes.fetch_add(bytes, std::memory_order_relaxed) + bytes);
+	}
+
+	void MemoryStats::subtract(MemorySubsystem subsystem, size_t bytes) {
+		(*this)[subsystem].bytes.fetch_sub(bytes, std::memory_order_relaxed);
+	}
+
+	void MemoryStats::set(MemorySubsystem subsystem, size_t bytes) {
+		Counters &row = (*this)[subsystem];
+		row.bytes.store(bytes, std::memory_order_relaxed);
+		updatePeak(row.peakBytes, bytes);
+	}
+
+	uint64_t MemoryStats::get(MemorySubsystem subsystem) const {
+		return (*this)[subsystem].bytes.load(std::memory_order_relaxed);
+	}
+
+	void MemoryStats::setBudget(MemorySubsystem subsystem, size_t bytes) {
+		(*this)[subsystem].budgetBytes.store(bytes, std::memory_order_relaxed);
+	}
+
+	std::vector<std::string> MemoryStats::checkBudgets() {
+		std::vector<std::string> warnings;
+
+		for (size_t i = 0; i < SUBSYSTEM_COUNT; ++i) {
+			Counters &row = counters[i];
+			const uint64_t budget = row.budgetBytes.load(std::memory_order_relaxed);
+			const uint64_t bytes = row.bytes.load(std::memory_order_relaxed);
+			const bool over = budget != 0 && budget < bytes;
+
+			if (over && !row.overBudget.exchange(true)) {
+				warnings.push_back(std::format("Memory used by {} ({}) is over its budget of {}", SUBSYSTEM_NAMES[i], formatBytes(bytes), formatBytes(budget)));
+			} else if (!over) {
+				row.overBudget = false;
+			}
+		}
+
+		return warnings;
+	}
+
+	std::vector<MemoryStats::Row> MemoryStats::snapshot() const {
+		std::vector<Row> out;
+		out.reserve(SUBSYSTEM_COUNT);
+
+		for (size_t i = 0; i < SUBSYSTEM_COUNT; ++i) {
+			const Counters &row = counters[i];
+			out.push_back(Row{
+				.subsystem = static_cast<MemorySubsystem>(i),
+				.bytes = row.bytes.load(std::memory_order_relaxed),
+				.peakBytes = row.peakBytes.load(std::memory_order_relaxed),
+				.budgetBytes = row.budgetBytes.load(std::memory_order_relaxed),
+			});
+		}
+
+		return out;
+	}
+
+	std::string MemoryStats::summarize() const {
+		std::string out;
+		uint64_t total = 0;
+
+		for (const Row &row: snapshot()) {
+			total += row.bytes;
+			out += std::format("{}: {} (peak {}", getName(row.subsystem), formatBytes(row.bytes), formatBytes(row.peakBytes));
+			if (row.budgetBytes != 0) {
+				out += std::format(", budget {}", formatBytes(row.budgetBytes));
+			}
+			out += ")\n";
+		}
+
+		out += std::format("Total: {}", formatBytes(total));
+		return out;
+	}
+
+	void MemoryStats::resetPeaks() {
+		for (Counters &row: counters) {
+			row.peakBytes = row.bytes.load();
+		}
+	}
+
+	MemoryStats & MemoryStats::global() {
+		static MemoryStats stats;
+		return stats;
+	}
+
+	std::string_view MemoryStats::getName(MemorySubsystem subsystem) {
+		return SUBSYSTEM_NAMES.at(static_cast<size_t>(subsystem));
+	}
+
+	std::optional<MemorySubsystem> MemoryStats::parseSubsystem(std::string_view name) {
+		for (size_t i = 0; i < SUBSYSTEM_COUNT; ++i) {
+			if (SUBSYSTEM_NAMES[i] == name) {
+				return static_cast<MemorySubsystem>(i);
+			}
+		}
+
+		return std::nullopt;
+	}
+
+	size_t MemoryStats::estimate(const boost::json::value &json) {
+		if (const boost::json::object *object = json.if_object()) {
+			size_t out = object->capacity() * sizeof(boost::json::key_value_pair);
+			for (const auto &[key, value]: *object) {
+				out += key.size() + estimate(value);
+			}
+			return out;
+		}
+
+		if (const boost::json::array *array = json.if_array()) {
+			size_t out = array->capacity() * sizeof(boost::json::value);
+			for (const boost::json::value &value: *array) {
+				out += estimate(value);
+			}
+			return out;
+		}
+
+		if (const boost::json::string *string = json.if_string()) {
+			return string->capacity();
+		}
+
+		return 0;
+	}
+
+	MemoryStats::Counters & MemoryStats::operator[](MemorySubsystem subsystem) {
+		return counters.at(static_cast<size_t>(subsystem));
+	}
+
+	const MemoryStats::Counters & MemoryStats::operator[](MemorySubsystem subsystem) const {
+		return counters.at(static_cast<size_t>(subsystem));
+	}
+}
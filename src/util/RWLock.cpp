@@ -1,19 +1,50 @@
+#include "config.h"
 #include "util/RWLock.h"
 
+#ifdef GAME3_LOCK_PROFILING
+#include "threading/LockProfiler.h"
+#endif
+
 namespace Game3 {
-	std::shared_lock<std::shared_timed_mutex> RWLock::lockRead() {
+	std::shared_lock<std::shared_timed_mutex> RWLock::lockRead([[maybe_unused]] std::source_location location) {
 		if (std::this_thread::get_id() == writerOwner)
 			return {};
 
+#ifdef GAME3_LOCK_PROFILING
+		LockProfiler::Site *site = LockProfiler::shouldSample()? &LockProfiler::getSite(location) : nullptr;
+		const uint64_t start = site? LockProfiler::now() : 0;
+		bool contended = false;
+#endif
+
 		if (blockReaders) {
+#ifdef GAME3_LOCK_PROFILING
+			contended = true;
+#endif
 			std::unique_lock condition_lock(conditionMutex);
 			conditionVariable.wait(condition_lock, [this] { return !blockReaders; });
 		}
 
+#ifdef GAME3_LOCK_PROFILING
+		if (site) {
+			std::shared_lock lock(timedMutex, std::try_to_lock);
+			if (!lock) {
+				contended = true;
+				lock.lock();
+			}
+			site->recordAcquisition(contended, LockProfiler::now() - start);
+			return lock;
+		}
+#endif
+
 		return std::shared_lock(timedMutex);
 	}
 
-	std::unique_lock<std::shared_timed_mutex> RWLock::lockWrite(std::chrono::milliseconds patience) {
+	std::unique_lock<std::shared_timed_mutex> RWLock::lockWrite(std::chrono::milliseconds patience, [[maybe_unused]] std::source_location location) {
+#ifdef GAME3_LOCK_PROFILING
+		LockProfiler::Site *site = LockProfiler::shouldSample()? &LockProfiler::getSite(location) : nullptr;
+		const uint64_t start = site? LockProfiler::now() : 0;
+#endif
+
 		std::unique_lock writer_lock(writerMutex);
 		std::unique_lock attempted_lock(timedMutex, patience);
 		if (!attempted_lock) {
@@ -23,6 +54,15 @@ namespace Game3 {
 			conditionVariable.notify_all();
 		}
 		writerOwner = std::this_thread::get_id();
+
+#ifdef GAME3_LOCK_PROFILING
+		if (site) {
+			// Waits shorter than a microsecond are treated as uncontended, since the timed lock can't be tried first.
+			const uint64_t wait = LockProfiler::now() - start;
+			site->recordAcquisition(1'000 <= wait, wait);
+		}
+#endif
+
 		return attempted_lock;
 	}
 }
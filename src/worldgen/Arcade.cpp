@@ -4,12 +4,15 @@
 #include "tileentity/ArcadeMachine.h"
 #include "tileentity/Building.h"
 #include "tileentity/Teleporter.h"
-#include "ui/Constants.h"
 #include "util/Timer.h"
 #include "util/Util.h"
 #include "worldgen/Arcade.h"
 #include "worldgen/Indoors.h"
 
+#ifndef GAME3_HEADLESS
+#include "ui/Constants.h"
+#endif
+
 namespace Game3::WorldGen {
 	void generateArcade(const std::shared_ptr<Realm> &realm, std::default_random_engine &rng, const std::shared_ptr<Realm> &parent_realm, Index width, Index height, Position entrance) {
 		auto guard = realm->guardGeneration();
@@ -90,10 +90,8 @@ namespace Game3::WorldGen {
 				return;
 			}
 
-			chunk_position.iterate([&](const Position &position) {
-				for (Layer layer: allLayers)
-					realm->autotile(position, layer);
-			});
+			for (Layer layer: allLayers)
+				realm->autotileChunk(chunk_position, layer);
 
 			provider.updateChunk(chunk_position);
 		});